@@ -43,6 +43,7 @@
 #include "core/os/condition_variable.h"
 #include "core/os/os.h"
 #include "core/os/safe_binary_mutex.h"
+#include "core/profiling/frame_telemetry.h"
 #include "core/string/print_string.h"
 #include "core/string/translation_server.h"
 #include "core/templates/rb_set.h"
@@ -276,6 +277,9 @@ Ref<Resource> ResourceLoader::_load(const String &p_path, const String &p_origin
 	const String &original_path = p_original_path.is_empty() ? p_path : p_original_path;
 	load_nesting++;
 
+	// Nested loads are already accounted for by the outermost one on this thread.
+	FrameTelemetry::Scope telemetry_scope(FrameTelemetry::SUBSYSTEM_RESOURCE_LOADER, load_nesting == 1);
+
 	print_verbose(vformat("Loading resource: %s remapped: %s", p_path, _path_remap(p_path)));
 
 	// Try all loaders and pick the first match for the type hint
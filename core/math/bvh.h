@@ -52,6 +52,7 @@
 
 #include "core/math/bvh_tree.h"
 #include "core/math/geometry_3d.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/mutex.h"
 
 #include <climits> // INT_MAX
@@ -73,6 +74,14 @@ public:
 		_thread_safe = p_enable;
 	}
 
+	// When many items changed, cull them for new pairs on the WorkerThreadPool.
+	// The pair and unpair callbacks are still sent from the calling thread, in the same
+	// order as without it, so they don't need to be thread safe.
+	void params_set_parallel_pair_checks(bool p_enable) {
+		BVH_LOCKED_FUNCTION
+		_parallel_pair_checks = p_enable;
+	}
+
 	// these 2 are crucial for fine tuning, and can be applied manually
 	// see the variable declarations for more info.
 	void params_set_node_expansion(real_t p_value) {
@@ -437,6 +446,11 @@ private:
 			return;
 		}
 
+		if (_parallel_pair_checks && changed_items.size() >= PARALLEL_PAIR_CHECKS_MIN_ITEMS) {
+			_check_for_collisions_parallel(p_full_check);
+			return;
+		}
+
 		typename BVHTREE_CLASS::CullParams params;
 
 		params.result_count_overall = 0;
@@ -480,6 +494,52 @@ private:
 		_reset();
 	}
 
+	void _cull_changed_item(uint32_t p_index, void *p_userdata) {
+		const BVHHandle &h = changed_items[p_index];
+
+		typename BVHTREE_CLASS::CullParams params;
+		params.result_count_overall = 0;
+		params.result_max = INT_MAX;
+		params.result_array = nullptr;
+		params.subindex_array = nullptr;
+		tree.item_fill_cullparams(h, params);
+		params.abb.from(tree._pairs[h.id()].expanded_aabb);
+
+		tree.cull_aabb_hits(params, _changed_item_hits[p_index]);
+	}
+
+	// Same as _check_for_collisions(), but the tree is culled for every changed item
+	// in parallel first. Culling doesn't depend on the pairs, so sending the callbacks
+	// afterwards gives the same results.
+	void _check_for_collisions_parallel(bool p_full_check) {
+		const uint32_t changed_count = changed_items.size();
+		if (_changed_item_hits.size() < changed_count) {
+			_changed_item_hits.resize(changed_count);
+		}
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &BVH_Manager::_cull_changed_item, nullptr, changed_count, -1, true, SNAME("BVHPairChecks"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (uint32_t n = 0; n < changed_count; n++) {
+			const BVHHandle &h = changed_items[n];
+			BVHABB_CLASS abb;
+			abb.from(tree._pairs[h.id()].expanded_aabb);
+
+			_find_leavers(h, abb, p_full_check);
+
+			for (const uint32_t ref_id : _changed_item_hits[n]) {
+				if (ref_id == h.id()) {
+					continue;
+				}
+
+				BVHHandle h_collidee;
+				h_collidee.set_id(ref_id);
+				_collide(h, h_collidee);
+			}
+		}
+		_reset();
+	}
+
 public:
 	void item_get_AABB(BVHHandle p_handle, BOUNDS &r_aabb) {
 		DEV_ASSERT(!p_handle.is_invalid());
@@ -773,6 +833,11 @@ private:
 	LocalVector<BVHHandle> changed_items;
 	uint32_t _tick = 1; // Start from 1 so items with 0 indicate never updated.
 
+	static constexpr uint32_t PARALLEL_PAIR_CHECKS_MIN_ITEMS = 256;
+	bool _parallel_pair_checks = false;
+	// Cull hits of each changed item, kept across ticks to reuse the allocations.
+	LocalVector<LocalVector<uint32_t>> _changed_item_hits;
+
 	class BVHLockedFunction {
 	public:
 		BVHLockedFunction(Mutex *p_mutex, bool p_thread_safe) {
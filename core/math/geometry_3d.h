@@ -600,6 +600,40 @@ Vector<Plane> build_capsule_planes(real_t p_radius, real_t p_height, int p_sides
 
 Vector<Vector3> compute_convex_mesh_points(const Plane *p_planes, int p_plane_count);
 
+// Same as above, but appends the points to a caller provided container (e.g. a FrameLocalVector).
+template <typename TVector>
+void compute_convex_mesh_points(const Plane *p_planes, int p_plane_count, TVector &r_points) {
+	// Iterate through every unique combination of any three planes.
+	for (int i = p_plane_count - 1; i >= 0; i--) {
+		for (int j = i - 1; j >= 0; j--) {
+			for (int k = j - 1; k >= 0; k--) {
+				// Find the point where these planes all cross over (if they
+				// do at all).
+				Vector3 convex_shape_point;
+				if (p_planes[i].intersect_3(p_planes[j], p_planes[k], &convex_shape_point)) {
+					// See if any *other* plane excludes this point because it's
+					// on the wrong side.
+					bool excluded = false;
+					for (int n = 0; n < p_plane_count; n++) {
+						if (n != i && n != j && n != k) {
+							real_t dp = p_planes[n].normal.dot(convex_shape_point);
+							if (dp - p_planes[n].d > (real_t)CMP_EPSILON) {
+								excluded = true;
+								break;
+							}
+						}
+					}
+
+					// Only add the point if it passed all tests.
+					if (!excluded) {
+						r_points.push_back(convex_shape_point);
+					}
+				}
+			}
+		}
+	}
+}
+
 #define FINDMINMAX(x0, x1, x2, min, max) \
 	min = max = x0; \
 	if (x1 < min) { \
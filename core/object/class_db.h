@@ -37,6 +37,7 @@
 #include "core/string/print_string.h"
 #include "core/templates/a_hash_map.h"
 #include "core/templates/hash_set.h"
+#include "core/templates/swiss_hash_map.h"
 
 #include <type_traits>
 
@@ -125,14 +126,14 @@ public:
 
 		ObjectGDExtension *gdextension = nullptr;
 
-		HashMap<StringName, MethodBind *> method_map;
+		SwissHashMap<StringName, MethodBind *> method_map;
+		List<StringName> method_order; // Registration order, `method_map` has none.
 		HashMap<StringName, LocalVector<MethodBind *>> method_map_compatibility;
 
 		List<PropertyInfo> property_list;
 		HashMap<StringName, PropertyInfo> property_map;
 
 #ifdef DEBUG_ENABLED
-		List<StringName> method_order;
 		HashSet<StringName> methods_in_properties;
 		List<MethodInfo> virtual_methods;
 		HashMap<StringName, MethodInfo> virtual_methods_map;
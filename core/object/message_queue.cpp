@@ -31,6 +31,7 @@
 #include "message_queue.h"
 
 #include "core/config/project_settings.h"
+#include "core/profiling/frame_telemetry.h"
 #include "main/main.h"
 
 #include <cstdio>
@@ -57,6 +58,21 @@
 		mutex.unlock(); \
 	}
 
+thread_local CallQueue::Producer *CallQueue::producer_cache = nullptr;
+thread_local uint64_t CallQueue::producer_cache_serial = 0;
+thread_local CallQueue::ThreadProducers CallQueue::thread_producers;
+
+CallQueue::ThreadProducers::~ThreadProducers() {
+	for (Producer *producer : producers) {
+		// Publishes the last messages along with the state, the flushing thread reclaims the pages.
+		producer->state.store(PRODUCER_RETIRED, std::memory_order_release);
+		if (producer->refcount.unref()) {
+			// The queue is gone already.
+			memdelete(producer);
+		}
+	}
+}
+
 void CallQueue::_add_page() {
 	if (pages_used == page_bytes.size()) {
 		pages.push_back(allocator->alloc());
@@ -66,6 +82,120 @@ void CallQueue::_add_page() {
 	pages_used++;
 }
 
+CallQueue::Page *CallQueue::_alloc_producer_page() {
+	if (producer_pages_used.increment() > max_pages) {
+		producer_pages_used.decrement();
+		return nullptr;
+	}
+	Page *page = allocator->alloc();
+	memnew_placement(page->data, ProducerPageHeader);
+	return page;
+}
+
+CallQueue::Producer *CallQueue::_get_producer() {
+	if (likely(producer_cache_serial == serial)) {
+		return producer_cache;
+	}
+
+	const Thread::ID caller_id = Thread::get_caller_id();
+	Producer *producer = producers.load(std::memory_order_acquire);
+	while (producer && producer->thread_id.load(std::memory_order_relaxed) != caller_id) {
+		producer = producer->next;
+	}
+
+	if (!producer) {
+		// Only the calling thread ever takes a producer for itself, so there can't be duplicates.
+		Page *page = _alloc_producer_page();
+		if (!page) {
+			return nullptr;
+		}
+
+		// Take over a producer left by a thread that exited, so their number doesn't grow with thread churn.
+		for (Producer *idle = producers.load(std::memory_order_acquire); idle; idle = idle->next) {
+			uint32_t expected = PRODUCER_IDLE;
+			if (idle->state.compare_exchange_strong(expected, PRODUCER_CLAIMING, std::memory_order_acquire, std::memory_order_relaxed)) {
+				producer = idle;
+				break;
+			}
+		}
+
+		const bool reused = producer != nullptr;
+		if (reused) {
+			producer->refcount.ref();
+		} else {
+			producer = memnew(Producer);
+			producer->refcount.init(2);
+		}
+		producer->thread_id.store(caller_id, std::memory_order_relaxed);
+		producer->write_page = page;
+		producer->write_offset = 0;
+		producer->read_page = page;
+		producer->read_offset = 0;
+		thread_producers.producers.push_back(producer);
+
+		if (reused) {
+			producer->state.store(PRODUCER_OWNED, std::memory_order_release);
+		} else {
+			Producer *head = producers.load(std::memory_order_relaxed);
+			do {
+				producer->next = head;
+			} while (!producers.compare_exchange_weak(head, producer, std::memory_order_release, std::memory_order_relaxed));
+		}
+	}
+
+	producer_cache = producer;
+	producer_cache_serial = serial;
+	return producer;
+}
+
+uint8_t *CallQueue::_reserve_message(uint32_t p_room_needed, Producer **r_producer) {
+	if (multi_producer) {
+		Producer *producer = _get_producer();
+		if (unlikely(!producer)) {
+			return nullptr;
+		}
+		if (producer->write_offset + p_room_needed > PRODUCER_PAGE_CAPACITY) {
+			Page *page = _alloc_producer_page();
+			if (!page) {
+				return nullptr;
+			}
+			// The consumer frees the previous page once it sees this link, so it must not be touched anymore.
+			_get_producer_page_header(producer->write_page)->next.store(page, std::memory_order_release);
+			producer->write_page = page;
+			producer->write_offset = 0;
+		}
+		*r_producer = producer;
+		return _get_producer_page_data(producer->write_page) + producer->write_offset;
+	}
+
+	// The lock is kept until the message is committed.
+	LOCK_MUTEX;
+
+	_ensure_first_page();
+
+	if ((page_bytes[pages_used - 1] + p_room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
+		if (pages_used == max_pages) {
+			UNLOCK_MUTEX;
+			return nullptr;
+		}
+		_add_page();
+	}
+
+	*r_producer = nullptr;
+	return &pages[pages_used - 1]->data[page_bytes[pages_used - 1]];
+}
+
+void CallQueue::_commit_message(uint32_t p_room_needed, Producer *p_producer) {
+	if (p_producer) {
+		p_producer->write_offset += p_room_needed;
+		_get_producer_page_header(p_producer->write_page)->used.store(p_producer->write_offset, std::memory_order_release);
+		return;
+	}
+
+	page_bytes[pages_used - 1] += p_room_needed;
+	UNLOCK_MUTEX;
+}
+
 Error CallQueue::push_callp(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
 	return push_callablep(Callable(p_id, p_method), p_args, p_argcount, p_show_error);
 }
@@ -85,26 +215,17 @@ Error CallQueue::push_set(Object *p_object, const StringName &p_prop, const Vari
 Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_args, int p_argcount, bool p_show_error) {
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
 
-	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
+	const uint32_t page_capacity = multi_producer ? PRODUCER_PAGE_CAPACITY : uint32_t(PAGE_SIZE_BYTES);
+	ERR_FAIL_COND_V_MSG(room_needed > page_capacity, ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(page_capacity) + " bytes), consider passing less arguments.");
 
-	LOCK_MUTEX;
-
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	Producer *producer = nullptr;
+	uint8_t *buffer_end = _reserve_message(room_needed, &producer);
+	if (unlikely(!buffer_end)) {
+		fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = p_argcount;
 	msg->callable = p_callable;
@@ -125,37 +246,26 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 		*v = *p_args[i];
 	}
 
-	page_bytes[pages_used - 1] += room_needed;
-
-	UNLOCK_MUTEX;
+	_commit_message(room_needed, producer);
 
 	return OK;
 }
 
 Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			String type;
-			if (ObjectDB::get_instance(p_id)) {
-				type = ObjectDB::get_instance(p_id)->get_class();
-			}
-			fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
+	Producer *producer = nullptr;
+	uint8_t *buffer_end = _reserve_message(room_needed, &producer);
+	if (unlikely(!buffer_end)) {
+		String type;
+		if (ObjectDB::get_instance(p_id)) {
+			type = ObjectDB::get_instance(p_id)->get_class();
 		}
-		_add_page();
+		fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = 1;
 	msg->callable = Callable(p_id, p_prop);
@@ -166,32 +276,23 @@ Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant
 	Variant *v = memnew_placement(buffer_end, Variant);
 	*v = p_value;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	_commit_message(room_needed, producer);
 
 	return OK;
 }
 
 Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message);
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	Producer *producer = nullptr;
+	uint8_t *buffer_end = _reserve_message(room_needed, &producer);
+	if (unlikely(!buffer_end)) {
+		fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 
 	msg->type = TYPE_NOTIFICATION;
@@ -199,8 +300,7 @@ Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	//msg->target;
 	msg->notification = p_notification;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	_commit_message(room_needed, producer);
 
 	return OK;
 }
@@ -222,11 +322,141 @@ void CallQueue::_call_function(const Callable &p_callable, const Variant *p_args
 	}
 }
 
+void CallQueue::_execute_message(Message *p_message) {
+	Object *target = p_message->callable.get_object();
+
+	switch (p_message->type & FLAG_MASK) {
+		case TYPE_CALL: {
+			if (target || (p_message->type & FLAG_NULL_IS_OK)) {
+				Variant *args = (Variant *)(p_message + 1);
+				_call_function(p_message->callable, args, p_message->args, p_message->type & FLAG_SHOW_ERROR);
+			}
+		} break;
+		case TYPE_NOTIFICATION: {
+			if (target) {
+				target->notification(p_message->notification);
+			}
+		} break;
+		case TYPE_SET: {
+			if (target) {
+				Variant *arg = (Variant *)(p_message + 1);
+				target->set(p_message->callable.get_method(), *arg);
+			}
+		} break;
+	}
+
+	_destroy_message(p_message);
+}
+
+void CallQueue::_destroy_message(Message *p_message) {
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		Variant *args = (Variant *)(p_message + 1);
+		for (int k = 0; k < p_message->args; k++) {
+			args[k].~Variant();
+		}
+	}
+
+	p_message->~Message();
+}
+
+bool CallQueue::_consume_producer(Producer *p_producer, bool p_execute) {
+	const uint32_t state = p_producer->state.load(std::memory_order_acquire);
+	if (state != PRODUCER_OWNED && state != PRODUCER_RETIRED) {
+		return false;
+	}
+
+	bool consumed = false;
+	while (true) {
+		ProducerPageHeader *header = _get_producer_page_header(p_producer->read_page);
+		if (p_producer->read_offset < header->used.load(std::memory_order_acquire)) {
+			Message *message = (Message *)(_get_producer_page_data(p_producer->read_page) + p_producer->read_offset);
+			// Pre-advance, so a call can push more messages to this queue.
+			p_producer->read_offset += _get_message_size(message);
+			if (p_execute) {
+				_execute_message(message);
+			} else {
+				_destroy_message(message);
+			}
+			consumed = true;
+			continue;
+		}
+
+		Page *next = header->next.load(std::memory_order_acquire);
+		if (!next) {
+			break;
+		}
+		// The producer publishes the last message of a page before linking the next one, so check again.
+		if (p_producer->read_offset < header->used.load(std::memory_order_acquire)) {
+			continue;
+		}
+		allocator->free(p_producer->read_page);
+		producer_pages_used.decrement();
+		p_producer->read_page = next;
+		p_producer->read_offset = 0;
+	}
+	return consumed;
+}
+
+bool CallQueue::_reclaim_producer(Producer *p_producer, bool p_execute) {
+	if (p_producer->state.load(std::memory_order_acquire) != PRODUCER_RETIRED) {
+		return false;
+	}
+
+	// Its thread exited, so everything it pushed is visible now and nothing more will come.
+	const bool consumed = _consume_producer(p_producer, p_execute);
+	allocator->free(p_producer->read_page);
+	producer_pages_used.decrement();
+	p_producer->read_page = nullptr;
+	p_producer->read_offset = 0;
+	p_producer->write_page = nullptr;
+	p_producer->write_offset = 0;
+	p_producer->state.store(PRODUCER_IDLE, std::memory_order_release);
+	return consumed;
+}
+
+Error CallQueue::_flush_producers() {
+	LOCK_MUTEX;
+	if (flushing) {
+		UNLOCK_MUTEX;
+		return ERR_BUSY;
+	}
+	flushing = true;
+	UNLOCK_MUTEX;
+
+	// Keep going until a whole pass finds nothing, so messages pushed while flushing are run too.
+	bool consumed = true;
+	while (consumed) {
+		consumed = false;
+		for (Producer *producer = producers.load(std::memory_order_acquire); producer; producer = producer->next) {
+			consumed |= _consume_producer(producer, true);
+			consumed |= _reclaim_producer(producer, true);
+		}
+	}
+
+	LOCK_MUTEX;
+	flushing = false;
+	UNLOCK_MUTEX;
+	return OK;
+}
+
+void CallQueue::_clear_producers() {
+	for (Producer *producer = producers.load(std::memory_order_acquire); producer; producer = producer->next) {
+		_consume_producer(producer, false);
+		_reclaim_producer(producer, false);
+	}
+}
+
 Error CallQueue::flush() {
 	if (!Main::is_iterating()) {
 		return ERR_BUSY;
 	}
 
+	FrameTelemetry::Scope telemetry_scope(FrameTelemetry::SUBSYSTEM_MESSAGE_QUEUE, this == MessageQueue::main_singleton);
+
+	if (multi_producer) {
+		return _flush_producers();
+	}
+
 	LOCK_MUTEX;
 
 	if (pages.is_empty()) {
@@ -252,46 +482,12 @@ Error CallQueue::flush() {
 
 		Message *message = (Message *)&page->data[offset];
 
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			advance += sizeof(Variant) * message->args;
-		}
-
 		//pre-advance so this function is reentrant
-		offset += advance;
-
-		Object *target = message->callable.get_object();
+		offset += _get_message_size(message);
 
 		UNLOCK_MUTEX;
 
-		switch (message->type & FLAG_MASK) {
-			case TYPE_CALL: {
-				if (target || (message->type & FLAG_NULL_IS_OK)) {
-					Variant *args = (Variant *)(message + 1);
-					_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
-				}
-			} break;
-			case TYPE_NOTIFICATION: {
-				if (target) {
-					target->notification(message->notification);
-				}
-			} break;
-			case TYPE_SET: {
-				if (target) {
-					Variant *arg = (Variant *)(message + 1);
-					target->set(message->callable.get_method(), *arg);
-				}
-			} break;
-		}
-
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			Variant *args = (Variant *)(message + 1);
-			for (int k = 0; k < message->args; k++) {
-				args[k].~Variant();
-			}
-		}
-
-		message->~Message();
+		_execute_message(message);
 
 		LOCK_MUTEX;
 		if (offset == page_bytes[i]) {
@@ -311,6 +507,10 @@ Error CallQueue::flush() {
 void CallQueue::clear() {
 	LOCK_MUTEX;
 
+	if (multi_producer) {
+		_clear_producers();
+	}
+
 	if (pages.is_empty()) {
 		UNLOCK_MUTEX;
 		return; // Nothing to clear.
@@ -325,21 +525,9 @@ void CallQueue::clear() {
 
 			Message *message = (Message *)&page->data[offset];
 
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
-
-			offset += advance;
-
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
-				}
-			}
+			offset += _get_message_size(message);
 
-			message->~Message();
+			_destroy_message(message);
 		}
 	}
 
@@ -356,6 +544,51 @@ void CallQueue::statistics() {
 	HashMap<Callable, int> call_count;
 	int null_count = 0;
 
+	auto count_message = [&](const Message *p_message) {
+		Object *target = p_message->callable.get_object();
+
+		bool null_target = true;
+		switch (p_message->type & FLAG_MASK) {
+			case TYPE_CALL: {
+				if (target || (p_message->type & FLAG_NULL_IS_OK)) {
+					if (!call_count.has(p_message->callable)) {
+						call_count[p_message->callable] = 0;
+					}
+
+					call_count[p_message->callable]++;
+					null_target = false;
+				}
+			} break;
+			case TYPE_NOTIFICATION: {
+				if (target) {
+					if (!notify_count.has(p_message->notification)) {
+						notify_count[p_message->notification] = 0;
+					}
+
+					notify_count[p_message->notification]++;
+					null_target = false;
+				}
+			} break;
+			case TYPE_SET: {
+				if (target) {
+					StringName t = p_message->callable.get_method();
+					if (!set_count.has(t)) {
+						set_count[t] = 0;
+					}
+
+					set_count[t]++;
+					null_target = false;
+				}
+			} break;
+		}
+		if (null_target) {
+			// Object was deleted.
+			fprintf(stdout, "Object was deleted while awaiting a callback.\n");
+
+			null_count++;
+		}
+	};
+
 	for (uint32_t i = 0; i < pages_used; i++) {
 		uint32_t offset = 0;
 		while (offset < page_bytes[i]) {
@@ -365,55 +598,9 @@ void CallQueue::statistics() {
 
 			Message *message = (Message *)&page->data[offset];
 
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
-
-			Object *target = message->callable.get_object();
+			count_message(message);
 
-			bool null_target = true;
-			switch (message->type & FLAG_MASK) {
-				case TYPE_CALL: {
-					if (target || (message->type & FLAG_NULL_IS_OK)) {
-						if (!call_count.has(message->callable)) {
-							call_count[message->callable] = 0;
-						}
-
-						call_count[message->callable]++;
-						null_target = false;
-					}
-				} break;
-				case TYPE_NOTIFICATION: {
-					if (target) {
-						if (!notify_count.has(message->notification)) {
-							notify_count[message->notification] = 0;
-						}
-
-						notify_count[message->notification]++;
-						null_target = false;
-					}
-				} break;
-				case TYPE_SET: {
-					if (target) {
-						StringName t = message->callable.get_method();
-						if (!set_count.has(t)) {
-							set_count[t] = 0;
-						}
-
-						set_count[t]++;
-						null_target = false;
-					}
-				} break;
-			}
-			if (null_target) {
-				// Object was deleted.
-				fprintf(stdout, "Object was deleted while awaiting a callback.\n");
-
-				null_count++;
-			}
-
-			offset += advance;
+			offset += _get_message_size(message);
 
 			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
 				Variant *args = (Variant *)(message + 1);
@@ -427,6 +614,49 @@ void CallQueue::statistics() {
 	}
 
 	fprintf(stdout, "TOTAL PAGES: %d (%d bytes).\n", pages_used, pages_used * PAGE_SIZE_BYTES);
+
+	if (multi_producer) {
+		fprintf(stdout, "PER-THREAD PAGES: %d (%d bytes).\n", producer_pages_used.get(), producer_pages_used.get() * PAGE_SIZE_BYTES);
+
+		// Holding the mutex keeps a flush from starting, but pages can't be read while one is running.
+		if (flushing) {
+			fprintf(stdout, "Per-thread pages are being flushed.\n");
+		} else {
+			int idle_count = 0;
+			for (const Producer *producer = producers.load(std::memory_order_acquire); producer; producer = producer->next) {
+				const uint32_t state = producer->state.load(std::memory_order_acquire);
+				if (state != PRODUCER_OWNED && state != PRODUCER_RETIRED) {
+					idle_count++;
+					continue;
+				}
+
+				// Messages are only read here, they are still run or cleared later.
+				int producer_pages = 0;
+				int producer_messages = 0;
+				uint32_t producer_bytes = 0;
+				Page *page = producer->read_page;
+				uint32_t offset = producer->read_offset;
+				while (page) {
+					const ProducerPageHeader *header = _get_producer_page_header(page);
+					const uint32_t used = header->used.load(std::memory_order_acquire);
+					producer_pages++;
+					while (offset < used) {
+						const Message *message = (const Message *)(_get_producer_page_data(page) + offset);
+						count_message(message);
+						offset += _get_message_size(message);
+						producer_messages++;
+					}
+					producer_bytes += used;
+					page = header->next.load(std::memory_order_acquire);
+					offset = 0;
+				}
+
+				fprintf(stdout, "PRODUCER thread %s%s: %d pages, %d pending messages (%d bytes used).\n", itos(producer->thread_id.load(std::memory_order_relaxed)).utf8().get_data(), state == PRODUCER_RETIRED ? " (exited)" : "", producer_pages, producer_messages, producer_bytes);
+			}
+			fprintf(stdout, "IDLE PRODUCERS: %d.\n", idle_count);
+		}
+	}
+
 	fprintf(stdout, "NULL count: %d.\n", null_count);
 
 	for (const KeyValue<StringName, int> &E : set_count) {
@@ -449,6 +679,17 @@ bool CallQueue::is_flushing() const {
 }
 
 bool CallQueue::has_messages() const {
+	for (const Producer *producer = producers.load(std::memory_order_acquire); producer; producer = producer->next) {
+		const uint32_t state = producer->state.load(std::memory_order_acquire);
+		if (state != PRODUCER_OWNED && state != PRODUCER_RETIRED) {
+			continue;
+		}
+		const ProducerPageHeader *header = _get_producer_page_header(producer->read_page);
+		if (producer->read_offset < header->used.load(std::memory_order_acquire) || header->next.load(std::memory_order_acquire)) {
+			return true;
+		}
+	}
+
 	if (pages_used == 0) {
 		return false;
 	}
@@ -460,10 +701,10 @@ bool CallQueue::has_messages() const {
 }
 
 int CallQueue::get_max_buffer_usage() const {
-	return pages.size() * PAGE_SIZE_BYTES;
+	return (pages.size() + producer_pages_used.get()) * PAGE_SIZE_BYTES;
 }
 
-CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const String &p_error_text) {
+CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const String &p_error_text, bool p_multi_producer) {
 	if (p_custom_allocator) {
 		allocator = p_custom_allocator;
 		allocator_is_custom = true;
@@ -473,6 +714,10 @@ CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const
 	}
 	max_pages = p_max_pages;
 	error_text = p_error_text;
+
+	multi_producer = p_multi_producer;
+	static SafeNumeric<uint64_t> last_serial;
+	serial = last_serial.increment();
 }
 
 CallQueue::~CallQueue() {
@@ -481,6 +726,17 @@ CallQueue::~CallQueue() {
 	for (uint32_t i = 0; i < pages.size(); i++) {
 		allocator->free(pages[i]);
 	}
+	Producer *producer = producers.load(std::memory_order_acquire);
+	while (producer) {
+		Producer *next = producer->next;
+		if (producer->read_page) {
+			allocator->free(producer->read_page);
+		}
+		if (producer->refcount.unref()) {
+			memdelete(producer);
+		}
+		producer = next;
+	}
 	if (!allocator_is_custom) {
 		memdelete(allocator);
 	}
@@ -509,7 +765,8 @@ void MessageQueue::set_thread_singleton_override(CallQueue *p_thread_singleton)
 MessageQueue::MessageQueue() :
 		CallQueue(nullptr,
 				int(GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "memory/limits/message_queue/max_size_mb", PROPERTY_HINT_RANGE, "1,512,1,or_greater"), 32)) * 1024 * 1024 / PAGE_SIZE_BYTES,
-				"Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_mb' in project settings.") {
+				"Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_mb' in project settings.",
+				GLOBAL_DEF_RST("threading/message_queue/per_thread_buffers", false)) {
 	ERR_FAIL_COND_MSG(main_singleton != nullptr, "A MessageQueue singleton already exists.");
 	main_singleton = this;
 }
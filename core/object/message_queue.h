@@ -32,10 +32,14 @@
 
 #include "core/object/object_id.h"
 #include "core/os/mutex.h"
+#include "core/os/thread.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 
+#include <atomic>
+
 class Object;
 
 class CallQueue {
@@ -89,6 +93,56 @@ private:
 		};
 	};
 
+	// Multi-producer mode: every pushing thread gets its own chain of pages, so producers never contend
+	// with each other. Only the producer appends to its last page, publishing how much of it is in use;
+	// only the flushing thread consumes from the first one. Messages keep their order per producer.
+	struct ProducerPageHeader {
+		std::atomic<uint32_t> used = 0; // Bytes of messages after this header that are ready to be consumed.
+		std::atomic<Page *> next = nullptr; // Set once the producer moved on to a new page.
+	};
+
+	static constexpr uint32_t PRODUCER_PAGE_CAPACITY = PAGE_SIZE_BYTES - sizeof(ProducerPageHeader);
+
+	enum ProducerState : uint32_t {
+		PRODUCER_OWNED, // Pushed to by its thread.
+		PRODUCER_RETIRED, // Its thread exited, the messages left are still to be consumed.
+		PRODUCER_IDLE, // Drained and without pages, can be taken over by another thread.
+		PRODUCER_CLAIMING, // Being taken over by a thread.
+	};
+
+	struct Producer {
+		std::atomic<Thread::ID> thread_id = Thread::UNASSIGNED_ID;
+		std::atomic<uint32_t> state = PRODUCER_OWNED;
+		SafeRefCount refcount; // Held by the queue, and by the owning thread until it exits.
+		Producer *next = nullptr; // Never changes after the producer is published.
+		// Producer side.
+		Page *write_page = nullptr;
+		uint32_t write_offset = 0;
+		// Consumer side. No pages while idle.
+		Page *read_page = nullptr;
+		uint32_t read_offset = 0;
+	};
+
+	// Retires the producers of a thread when it exits, so they are reused instead of piling up.
+	struct ThreadProducers {
+		LocalVector<Producer *> producers;
+		~ThreadProducers();
+	};
+
+	bool multi_producer = false;
+	uint64_t serial = 0; // Unique per queue, to validate the thread-local producer cache.
+	std::atomic<Producer *> producers = nullptr;
+	SafeNumeric<uint32_t> producer_pages_used;
+
+	static thread_local Producer *producer_cache;
+	static thread_local uint64_t producer_cache_serial;
+	static thread_local ThreadProducers thread_producers;
+
+	_FORCE_INLINE_ static ProducerPageHeader *_get_producer_page_header(Page *p_page) { return (ProducerPageHeader *)p_page->data; }
+	_FORCE_INLINE_ static uint8_t *_get_producer_page_data(Page *p_page) { return p_page->data + sizeof(ProducerPageHeader); }
+	Page *_alloc_producer_page();
+	Producer *_get_producer();
+
 	_FORCE_INLINE_ void _ensure_first_page() {
 		if (unlikely(pages.is_empty())) {
 			pages.push_back(allocator->alloc());
@@ -99,6 +153,23 @@ private:
 
 	void _add_page();
 
+	uint8_t *_reserve_message(uint32_t p_room_needed, Producer **r_producer);
+	void _commit_message(uint32_t p_room_needed, Producer *p_producer);
+	_FORCE_INLINE_ static uint32_t _get_message_size(const Message *p_message) {
+		uint32_t size = sizeof(Message);
+		if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+			size += sizeof(Variant) * p_message->args;
+		}
+		return size;
+	}
+	void _execute_message(Message *p_message);
+	static void _destroy_message(Message *p_message);
+
+	bool _consume_producer(Producer *p_producer, bool p_execute);
+	bool _reclaim_producer(Producer *p_producer, bool p_execute);
+	Error _flush_producers();
+	void _clear_producers();
+
 	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
 
 	String error_text;
@@ -143,7 +214,7 @@ public:
 	bool is_flushing() const;
 	int get_max_buffer_usage() const;
 
-	CallQueue(Allocator *p_custom_allocator = nullptr, uint32_t p_max_pages = 8192, const String &p_error_text = String());
+	CallQueue(Allocator *p_custom_allocator = nullptr, uint32_t p_max_pages = 8192, const String &p_error_text = String(), bool p_multi_producer = false);
 	virtual ~CallQueue();
 };
 
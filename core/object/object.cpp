@@ -2380,15 +2380,23 @@ void postinitialize_handler(Object *p_object) {
 }
 
 void ObjectDB::debug_objects(DebugFunc p_func, void *p_user_data) {
-	spin_lock.lock();
+	for (Shard &shard : shards) {
+		shard.spin_lock.lock();
+	}
 
-	for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-		if (object_slots[i].validator) {
-			p_func(object_slots[i].object, p_user_data);
-			count--;
+	const uint32_t count = MIN(block_count.load(std::memory_order_relaxed), (uint32_t)OBJECTDB_BLOCK_COUNT);
+	for (uint32_t i = 0; i < count; i++) {
+		ObjectSlot *block = blocks[i].load(std::memory_order_acquire);
+		for (uint32_t j = 0; block && j < OBJECTDB_BLOCK_SIZE; j++) {
+			if (block[j].tag.load(std::memory_order_relaxed)) {
+				p_func(block[j].object.load(std::memory_order_relaxed), p_user_data);
+			}
 		}
 	}
-	spin_lock.unlock();
+
+	for (Shard &shard : shards) {
+		shard.spin_lock.unlock();
+	}
 }
 
 #ifdef TOOLS_ENABLED
@@ -2437,91 +2445,120 @@ void Object::get_argument_options(const StringName &p_function, int p_idx, List<
 }
 #endif
 
-SpinLock ObjectDB::spin_lock;
-uint32_t ObjectDB::slot_count = 0;
-uint32_t ObjectDB::slot_max = 0;
-ObjectDB::ObjectSlot *ObjectDB::object_slots = nullptr;
-uint64_t ObjectDB::validator_counter = 0;
+std::atomic<ObjectDB::ObjectSlot *> ObjectDB::blocks[OBJECTDB_BLOCK_COUNT] = {};
+uint8_t ObjectDB::block_shards[OBJECTDB_BLOCK_COUNT] = {};
+std::atomic<uint32_t> ObjectDB::block_count = 0;
+std::atomic<uint32_t> ObjectDB::next_thread_shard = 0;
+ObjectDB::Shard ObjectDB::shards[OBJECTDB_SHARD_COUNT];
 
 int ObjectDB::get_object_count() {
-	return slot_count;
+	uint32_t count = 0;
+	for (const Shard &shard : shards) {
+		count += shard.count.load(std::memory_order_relaxed);
+	}
+	return count;
+}
+
+ObjectDB::Shard &ObjectDB::_get_thread_shard() {
+	static thread_local uint32_t thread_shard = UINT32_MAX;
+	if (unlikely(thread_shard == UINT32_MAX)) {
+		thread_shard = next_thread_shard.fetch_add(1, std::memory_order_relaxed) % OBJECTDB_SHARD_COUNT;
+	}
+	return shards[thread_shard];
 }
 
 ObjectID ObjectDB::add_instance(Object *p_object) {
-	spin_lock.lock();
-	if (unlikely(slot_count == slot_max)) {
-		CRASH_COND(slot_count == (1 << OBJECTDB_SLOT_MAX_COUNT_BITS));
+	Shard &shard = _get_thread_shard();
+	shard.spin_lock.lock();
 
-		uint32_t new_slot_max = slot_max > 0 ? slot_max * 2 : 1;
-		object_slots = (ObjectSlot *)memrealloc(object_slots, sizeof(ObjectSlot) * new_slot_max);
-		for (uint32_t i = slot_max; i < new_slot_max; i++) {
-			object_slots[i].object = nullptr;
-			object_slots[i].is_ref_counted = false;
-			object_slots[i].next_free = i;
-			object_slots[i].validator = 0;
+	uint32_t slot;
+	if (shard.free_head != 0) {
+		slot = shard.free_head - 1;
+		shard.free_head = blocks[slot >> OBJECTDB_BLOCK_BITS].load(std::memory_order_relaxed)[slot & (OBJECTDB_BLOCK_SIZE - 1)].next_free;
+	} else {
+		if (unlikely(shard.bump_next == shard.bump_end)) {
+			uint32_t block_index = block_count.fetch_add(1, std::memory_order_relaxed);
+			CRASH_COND_MSG(block_index >= OBJECTDB_BLOCK_COUNT, "Too many objects.");
+
+			ObjectSlot *block = (ObjectSlot *)memalloc(sizeof(ObjectSlot) * OBJECTDB_BLOCK_SIZE);
+			for (uint32_t i = 0; i < OBJECTDB_BLOCK_SIZE; i++) {
+				memnew_placement(&block[i], ObjectSlot);
+				block[i].tag.store(0, std::memory_order_relaxed);
+				block[i].object.store(nullptr, std::memory_order_relaxed);
+				block[i].next_free = 0;
+			}
+			block_shards[block_index] = &shard - shards;
+			blocks[block_index].store(block, std::memory_order_release);
+
+			shard.bump_next = block_index << OBJECTDB_BLOCK_BITS;
+			shard.bump_end = shard.bump_next + OBJECTDB_BLOCK_SIZE;
 		}
-		slot_max = new_slot_max;
+		slot = shard.bump_next++;
 	}
 
-	uint32_t slot = object_slots[slot_count].next_free;
-	if (object_slots[slot].object != nullptr) {
-		spin_lock.unlock();
-		ERR_FAIL_COND_V(object_slots[slot].object != nullptr, ObjectID());
-	}
-	object_slots[slot].object = p_object;
-	object_slots[slot].is_ref_counted = p_object->is_ref_counted();
-	validator_counter = (validator_counter + 1) & OBJECTDB_VALIDATOR_MASK;
-	if (unlikely(validator_counter == 0)) {
-		validator_counter = 1;
+	ObjectSlot &object_slot = blocks[slot >> OBJECTDB_BLOCK_BITS].load(std::memory_order_relaxed)[slot & (OBJECTDB_BLOCK_SIZE - 1)];
+	if (object_slot.object.load(std::memory_order_relaxed) != nullptr) {
+		shard.spin_lock.unlock();
+		ERR_FAIL_COND_V(object_slot.object.load(std::memory_order_relaxed) != nullptr, ObjectID());
 	}
-	object_slots[slot].validator = validator_counter;
 
-	uint64_t id = validator_counter;
-	id <<= OBJECTDB_SLOT_MAX_COUNT_BITS;
-	id |= uint64_t(slot);
+	shard.validator_counter = (shard.validator_counter + 1) & OBJECTDB_VALIDATOR_MASK;
+	if (unlikely(shard.validator_counter == 0)) {
+		shard.validator_counter = 1;
+	}
 
+	uint64_t tag = shard.validator_counter;
 	if (p_object->is_ref_counted()) {
-		id |= OBJECTDB_REFERENCE_BIT;
+		tag |= OBJECTDB_REFERENCE_BIT >> OBJECTDB_SLOT_MAX_COUNT_BITS;
 	}
 
-	slot_count++;
+	// Publish the object before the tag, see get_instance().
+	object_slot.object.store(p_object, std::memory_order_release);
+	object_slot.tag.store(tag, std::memory_order_release);
 
-	spin_lock.unlock();
+	shard.count.fetch_add(1, std::memory_order_relaxed);
 
-	return ObjectID(id);
+	shard.spin_lock.unlock();
+
+	return ObjectID((tag << OBJECTDB_SLOT_MAX_COUNT_BITS) | uint64_t(slot));
 }
 
 void ObjectDB::remove_instance(Object *p_object) {
 	uint64_t t = p_object->get_instance_id();
 	uint32_t slot = t & OBJECTDB_SLOT_MAX_COUNT_MASK; //slot is always valid on valid object
+	uint32_t block_index = slot >> OBJECTDB_BLOCK_BITS;
+
+	// The slot goes back to the shard it came from, which may not be this thread's.
+	Shard &shard = shards[block_shards[block_index]];
+	ObjectSlot &object_slot = blocks[block_index].load(std::memory_order_relaxed)[slot & (OBJECTDB_BLOCK_SIZE - 1)];
 
-	spin_lock.lock();
+	shard.spin_lock.lock();
 
 #ifdef DEBUG_ENABLED
 
-	if (object_slots[slot].object != p_object) {
-		spin_lock.unlock();
-		ERR_FAIL_COND(object_slots[slot].object != p_object);
+	if (object_slot.object.load(std::memory_order_relaxed) != p_object) {
+		shard.spin_lock.unlock();
+		ERR_FAIL_COND(object_slot.object.load(std::memory_order_relaxed) != p_object);
 	}
 	{
-		uint64_t validator = (t >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
-		if (object_slots[slot].validator != validator) {
-			spin_lock.unlock();
-			ERR_FAIL_COND(object_slots[slot].validator != validator);
+		uint64_t tag = t >> OBJECTDB_SLOT_MAX_COUNT_BITS;
+		if (object_slot.tag.load(std::memory_order_relaxed) != tag) {
+			shard.spin_lock.unlock();
+			ERR_FAIL_COND(object_slot.tag.load(std::memory_order_relaxed) != tag);
 		}
 	}
 
 #endif
-	//decrease slot count
-	slot_count--;
+	//invalidate before clearing the object, so lookups racing with this fail
+	object_slot.tag.store(0, std::memory_order_release);
+	object_slot.object.store(nullptr, std::memory_order_release);
+
 	//set the free slot properly
-	object_slots[slot_count].next_free = slot;
-	//invalidate, so checks against it fail
-	object_slots[slot].validator = 0;
-	object_slots[slot].is_ref_counted = false;
-	object_slots[slot].object = nullptr;
+	object_slot.next_free = shard.free_head;
+	shard.free_head = slot + 1;
+	shard.count.fetch_sub(1, std::memory_order_relaxed);
 
-	spin_lock.unlock();
+	shard.spin_lock.unlock();
 }
 
 void ObjectDB::setup() {
@@ -2529,7 +2566,12 @@ void ObjectDB::setup() {
 }
 
 void ObjectDB::cleanup() {
-	spin_lock.lock();
+	for (Shard &shard : shards) {
+		shard.spin_lock.lock();
+	}
+
+	const uint32_t slot_count = get_object_count();
+	const uint32_t used_blocks = MIN(block_count.load(std::memory_order_relaxed), (uint32_t)OBJECTDB_BLOCK_COUNT);
 
 	if (slot_count > 0) {
 		WARN_PRINT(vformat("%d ObjectDB %s leaked at exit (run with `--verbose` for details).", slot_count, slot_count == 1 ? "instance was" : "instances were"));
@@ -2541,9 +2583,11 @@ void ObjectDB::cleanup() {
 			MethodBind *resource_get_path = ClassDB::get_method("Resource", "get_path");
 			Callable::CallError call_error;
 
-			for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-				if (object_slots[i].validator) {
-					Object *obj = object_slots[i].object;
+			for (uint32_t i = 0, count = slot_count; i < (used_blocks << OBJECTDB_BLOCK_BITS) && count != 0; i++) {
+				const ObjectSlot &object_slot = blocks[i >> OBJECTDB_BLOCK_BITS].load(std::memory_order_relaxed)[i & (OBJECTDB_BLOCK_SIZE - 1)];
+				const uint64_t tag = object_slot.tag.load(std::memory_order_relaxed);
+				if (tag) {
+					Object *obj = object_slot.object.load(std::memory_order_relaxed);
 
 					String extra_info;
 					if (obj->is_class("Node")) {
@@ -2556,7 +2600,7 @@ void ObjectDB::cleanup() {
 						extra_info = " - Reference count: " + itos((static_cast<RefCounted *>(obj))->get_reference_count());
 					}
 
-					uint64_t id = uint64_t(i) | (uint64_t(object_slots[i].validator) << OBJECTDB_SLOT_MAX_COUNT_BITS) | (object_slots[i].is_ref_counted ? OBJECTDB_REFERENCE_BIT : 0);
+					uint64_t id = uint64_t(i) | (tag << OBJECTDB_SLOT_MAX_COUNT_BITS);
 					DEV_ASSERT(id == (uint64_t)obj->get_instance_id()); // We could just use the id from the object, but this check may help catching memory corruption catastrophes.
 					print_line("Leaked instance: " + String(obj->get_class()) + ":" + uitos(id) + extra_info);
 
@@ -2567,9 +2611,19 @@ void ObjectDB::cleanup() {
 		}
 	}
 
-	if (object_slots) {
-		memfree(object_slots);
+	for (uint32_t i = 0; i < used_blocks; i++) {
+		ObjectSlot *block = blocks[i].exchange(nullptr, std::memory_order_acq_rel);
+		if (block) {
+			memfree(block);
+		}
 	}
+	block_count.store(0, std::memory_order_relaxed);
 
-	spin_lock.unlock();
+	for (Shard &shard : shards) {
+		shard.free_head = 0;
+		shard.bump_next = 0;
+		shard.bump_end = 0;
+		shard.count.store(0, std::memory_order_relaxed);
+		shard.spin_lock.unlock();
+	}
 }
@@ -878,24 +878,43 @@ class ObjectDB {
 #define OBJECTDB_SLOT_MAX_COUNT_BITS 24
 #define OBJECTDB_SLOT_MAX_COUNT_MASK ((uint64_t(1) << OBJECTDB_SLOT_MAX_COUNT_BITS) - 1)
 #define OBJECTDB_REFERENCE_BIT (uint64_t(1) << (OBJECTDB_SLOT_MAX_COUNT_BITS + OBJECTDB_VALIDATOR_BITS))
+// Slots live in fixed-size blocks that are never moved or freed while running,
+// so lookups can read them without taking a lock.
+#define OBJECTDB_BLOCK_BITS 10
+#define OBJECTDB_BLOCK_SIZE (1 << OBJECTDB_BLOCK_BITS)
+#define OBJECTDB_BLOCK_COUNT (1 << (OBJECTDB_SLOT_MAX_COUNT_BITS - OBJECTDB_BLOCK_BITS))
+#define OBJECTDB_SHARD_COUNT 16
+
+	struct ObjectSlot {
+		// Upper bits of the ID of the object in this slot (validator and reference bit), 0 if the slot is free.
+		std::atomic<uint64_t> tag;
+		std::atomic<Object *> object;
+		uint32_t next_free; // Only accessed with the owning shard locked.
+	};
 
-	struct ObjectSlot { // 128 bits per slot.
-		uint64_t validator : OBJECTDB_VALIDATOR_BITS;
-		uint64_t next_free : OBJECTDB_SLOT_MAX_COUNT_BITS;
-		uint64_t is_ref_counted : 1;
-		Object *object = nullptr;
+	// Each thread allocates slots from its own shard, so objects can be created
+	// and freed on different threads without contending on a single lock.
+	// Everything here is constant-initialized, so objects can be created during static initialization.
+	struct alignas(Thread::CACHE_LINE_BYTES) Shard {
+		SpinLock spin_lock;
+		uint32_t free_head = 0; // Free slot index plus one, 0 if there are none.
+		uint32_t bump_next = 0; // Unused slots of the last block taken by this shard.
+		uint32_t bump_end = 0;
+		std::atomic<uint32_t> count = 0; // Written with the lock held, read without it by get_object_count().
+		uint64_t validator_counter = 0;
 	};
 
-	static SpinLock spin_lock;
-	static uint32_t slot_count;
-	static uint32_t slot_max;
-	static ObjectSlot *object_slots;
-	static uint64_t validator_counter;
+	static std::atomic<ObjectSlot *> blocks[OBJECTDB_BLOCK_COUNT];
+	static uint8_t block_shards[OBJECTDB_BLOCK_COUNT];
+	static std::atomic<uint32_t> block_count;
+	static std::atomic<uint32_t> next_thread_shard;
+	static Shard shards[OBJECTDB_SHARD_COUNT];
 
 	friend class Object;
 	friend void unregister_core_types();
 	static void cleanup();
 
+	static Shard &_get_thread_shard();
 	static ObjectID add_instance(Object *p_object);
 	static void remove_instance(Object *p_object);
 
@@ -905,24 +924,29 @@ class ObjectDB {
 public:
 	typedef void (*DebugFunc)(Object *p_obj, void *p_user_data);
 
+	// Wait-free. As with any lookup, the returned object may still be freed by
+	// another thread afterwards; synchronizing that is up to the caller.
 	_ALWAYS_INLINE_ static Object *get_instance(ObjectID p_instance_id) {
 		uint64_t id = p_instance_id;
 		uint32_t slot = id & OBJECTDB_SLOT_MAX_COUNT_MASK;
+		uint64_t tag = id >> OBJECTDB_SLOT_MAX_COUNT_BITS;
 
-		ERR_FAIL_COND_V(slot >= slot_max, nullptr); // This should never happen unless RID is corrupted.
-
-		spin_lock.lock();
-
-		uint64_t validator = (id >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
-
-		if (unlikely(object_slots[slot].validator != validator)) {
-			spin_lock.unlock();
+		ObjectSlot *block = blocks[slot >> OBJECTDB_BLOCK_BITS].load(std::memory_order_acquire);
+		if (unlikely(tag == 0 || block == nullptr)) {
 			return nullptr;
 		}
 
-		Object *object = object_slots[slot].object;
-
-		spin_lock.unlock();
+		// The tag is stored after the object when adding and cleared before it
+		// when removing, so if it matches both before and after reading the
+		// object, the object belongs to this ID.
+		ObjectSlot &object_slot = block[slot & (OBJECTDB_BLOCK_SIZE - 1)];
+		if (unlikely(object_slot.tag.load(std::memory_order_acquire) != tag)) {
+			return nullptr;
+		}
+		Object *object = object_slot.object.load(std::memory_order_acquire);
+		if (unlikely(object_slot.tag.load(std::memory_order_relaxed) != tag)) {
+			return nullptr;
+		}
 
 		return object;
 	}
@@ -36,6 +36,7 @@
 #include "core/os/os.h"
 #include "core/os/safe_binary_mutex.h"
 #include "core/os/thread_safe.h"
+#include "core/templates/frame_arena.h"
 
 WorkerThreadPool::Task *const WorkerThreadPool::ThreadData::YIELDING = (Task *)1;
 
@@ -90,6 +91,11 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 	bool low_priority = p_task->low_priority;
 #endif
 
+	// Tasks can run across frame boundaries, so don't let the frame arena be reset under them.
+	FrameArena::Hold frame_arena_hold;
+
+	LocalVector<Task *> ready_tasks; // Dependents that can start now that this has completed.
+
 	if (p_task->group) {
 		// Handling a group
 		bool do_post = false;
@@ -120,12 +126,23 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 			memdelete(p_task->template_userdata); // This is no longer needed at this point, so get rid of it.
 		}
 
+		uint32_t finished_count = 1;
 		if (do_post) {
-			p_task->group->done_semaphore.post();
-			p_task->group->completed.set_to(true);
+			Group *group = p_task->group;
+			group->done_semaphore.post();
+			group->completed.set_to(true);
+
+			MutexLock task_lock(task_mutex);
+			group->dependents_resolved = true;
+			_resolve_dependents(group->dependents, ready_tasks);
+			if (group->consumed) {
+				// Nobody will wait for it, so act as the waiting user too.
+				groups.erase(group->self);
+				finished_count = 2;
+			}
 		}
 		uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
-		uint32_t finished_users = p_task->group->finished.increment();
+		uint32_t finished_users = p_task->group->finished.add(finished_count);
 
 		if (finished_users == max_users) {
 			// Get rid of the group, because nobody else is using it.
@@ -160,6 +177,11 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 				threads[i].signaled = true;
 			}
 		}
+		_resolve_dependents(p_task->dependents, ready_tasks);
+		if (p_task->consumed && p_task->waiting_pool == 0 && p_task->waiting_user == 0) {
+			tasks.erase(p_task->self);
+			task_allocator.free(p_task);
+		}
 	}
 
 #ifdef THREADS_ENABLED
@@ -181,6 +203,10 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 	set_current_thread_safe_for_nodes(safe_for_nodes_backup);
 	MessageQueue::set_thread_singleton_override(call_queue_backup);
 #endif
+
+	if (!ready_tasks.is_empty()) {
+		_post_ready_tasks(ready_tasks);
+	}
 }
 
 void WorkerThreadPool::_thread_function(void *p_user) {
@@ -188,8 +214,9 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 	Thread::set_name(vformat("WorkerThread %d", thread_data->index));
 
 	while (true) {
-		Task *task_to_process = nullptr;
-		{
+		// Fast path: keep working on tasks from this thread's work queue, or stolen from others', without locking.
+		Task *task_to_process = thread_data->pool->_pop_work_queue_task(thread_data);
+		if (!task_to_process) {
 			// Create the lock outside the inner loop so it isn't needlessly unlocked and relocked
 			//  when no task was found to process, and the loop is re-entered.
 			MutexLock lock(thread_data->pool->task_mutex);
@@ -202,17 +229,23 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 
 				thread_data->signaled = false;
 
-				if (!thread_data->pool->task_queue.first()) {
-					// There wasn't a task available yet.
-					// Let's wait for the next notification, then recheck.
-					thread_data->cond_var.wait(lock);
-					continue;
+				if (thread_data->pool->task_queue.first()) {
+					// Got a task to process! Remove it from the queue, then break into the task handling section.
+					task_to_process = thread_data->pool->task_queue.first()->self();
+					thread_data->pool->task_queue.remove(thread_data->pool->task_queue.first());
+					break;
 				}
 
-				// Got a task to process! Remove it from the queue, then break into the task handling section.
-				task_to_process = thread_data->pool->task_queue.first()->self();
-				thread_data->pool->task_queue.remove(thread_data->pool->task_queue.first());
-				break;
+				// Work queues are only pushed to with the lock held, and notifications are sent under it too,
+				// so checking them again here can't miss a task posted since the fast path above.
+				task_to_process = thread_data->pool->_pop_work_queue_task(thread_data);
+				if (task_to_process) {
+					break;
+				}
+
+				// There wasn't a task available yet.
+				// Let's wait for the next notification, then recheck.
+				thread_data->cond_var.wait(lock);
 			}
 		}
 
@@ -246,9 +279,16 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 
 	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
 
+	// High priority tasks posted from a pool thread go to its own work queue. It will likely run them itself
+	// while awaiting them, and other threads steal from there without contending on the injection queue.
+	// Low priority tasks need the promotion bookkeeping, so they always go through the injection queues.
+	bool use_work_queue = caller_pool_thread && p_high_priority && !p_pump_task;
+
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
-		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
+		if (use_work_queue && caller_pool_thread->work_queue.push(p_tasks[i])) {
+			to_process++;
+		} else if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
 			task_queue.add_last(&p_tasks[i]->task_elem);
 			if (!p_high_priority) {
 				low_priority_threads_used++;
@@ -340,11 +380,144 @@ bool WorkerThreadPool::_try_promote_low_priority_task() {
 	}
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
-	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
+WorkerThreadPool::Task *WorkerThreadPool::_pop_work_queue_task(ThreadData *p_thread_data) {
+	Task *task = nullptr;
+	if (p_thread_data->work_queue.pop(task)) {
+		return task;
+	}
+
+	// Steal from the other threads, starting at the next one so thieves spread across victims.
+	uint32_t thread_count = threads.size();
+	for (uint32_t i = 1; i < thread_count; i++) {
+		ThreadData &victim = threads[(p_thread_data->index + i) % thread_count];
+		if (victim.work_queue.steal(task)) {
+			return task;
+		}
+	}
+	return nullptr;
+}
+
+bool WorkerThreadPool::_are_work_queues_empty() const {
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		if (!threads[i].work_queue.is_empty()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Must be called with the task mutex held, before the new task or group gets its ID.
+uint32_t WorkerThreadPool::_register_dependencies(Span<TaskID> p_dependencies, Task *p_task, Group *p_group) {
+	uint32_t pending = 0;
+	for (const TaskID dependency_id : p_dependencies) {
+		if (Task **taskp = tasks.getptr(dependency_id)) {
+			Task *dependency = *taskp;
+			dependency->consumed = true;
+			if (!dependency->completed) {
+				if (p_task) {
+					dependency->dependents.tasks.push_back(p_task);
+				} else {
+					dependency->dependents.groups.push_back(p_group);
+				}
+				pending++;
+			} else if (dependency->waiting_pool == 0 && dependency->waiting_user == 0) {
+				tasks.erase(dependency_id);
+				task_allocator.free(dependency);
+			}
+		} else if (Group **groupp = groups.getptr(dependency_id)) {
+			Group *dependency = *groupp;
+			if (!dependency->awaited) {
+				dependency->consumed = true;
+			}
+			if (!dependency->dependents_resolved) {
+				if (p_task) {
+					dependency->dependents.tasks.push_back(p_task);
+				} else {
+					dependency->dependents.groups.push_back(p_group);
+				}
+				pending++;
+			} else if (dependency->consumed) {
+				// It completed before anything depended on it and nobody awaits it, so act as the waiting user.
+				groups.erase(dependency_id);
+				if (dependency->finished.increment() == dependency->tasks_used + 1) {
+					group_allocator.free(dependency);
+				}
+			}
+		} else {
+			// IDs are never reused, so one that was handed out but can't be found belongs to something that
+			// already completed and was reclaimed.
+			ERR_CONTINUE_MSG(dependency_id <= 0 || dependency_id >= (TaskID)last_task, vformat("Invalid task or group ID to depend on: %d.", dependency_id));
+		}
+	}
+	return pending;
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task) {
+// Must be called with the task mutex held.
+void WorkerThreadPool::_resolve_dependents(Dependents &p_dependents, LocalVector<Task *> &r_ready_tasks) {
+	for (Task *dependent : p_dependents.tasks) {
+		DEV_ASSERT(dependent->pending_dependencies > 0);
+		dependent->pending_dependencies--;
+		if (dependent->pending_dependencies == 0) {
+			r_ready_tasks.push_back(dependent);
+		}
+	}
+	for (Group *dependent : p_dependents.groups) {
+		DEV_ASSERT(dependent->pending_dependencies > 0);
+		dependent->pending_dependencies--;
+		if (dependent->pending_dependencies == 0) {
+			if (dependent->deferred_tasks.is_empty()) {
+				_complete_deferred_empty_group(dependent, r_ready_tasks);
+			} else {
+				for (Task *task : dependent->deferred_tasks) {
+					r_ready_tasks.push_back(task);
+				}
+				dependent->deferred_tasks.clear();
+			}
+		}
+	}
+	p_dependents.tasks.clear();
+	p_dependents.groups.clear();
+}
+
+// Groups without elements have no tasks that could complete them, so that's done right when their dependencies are.
+// Must be called with the task mutex held.
+void WorkerThreadPool::_complete_deferred_empty_group(Group *p_group, LocalVector<Task *> &r_ready_tasks) {
+	p_group->done_semaphore.post();
+	p_group->completed.set_to(true);
+	p_group->dependents_resolved = true;
+	_resolve_dependents(p_group->dependents, r_ready_tasks);
+	if (p_group->consumed) {
+		groups.erase(p_group->self);
+		if (p_group->finished.increment() == p_group->tasks_used + 1) {
+			group_allocator.free(p_group);
+		}
+	}
+}
+
+void WorkerThreadPool::_post_ready_tasks(LocalVector<Task *> &p_tasks) {
+	MutexLock<BinaryMutex> lock(task_mutex);
+
+	// Each priority has to be posted separately.
+	uint32_t high_priority_count = 0;
+	for (uint32_t i = 0; i < p_tasks.size(); i++) {
+		if (!p_tasks[i]->low_priority) {
+			SWAP(p_tasks[i], p_tasks[high_priority_count]);
+			high_priority_count++;
+		}
+	}
+	if (high_priority_count) {
+		_post_tasks(p_tasks.ptr(), high_priority_count, true, lock, false);
+	}
+	if (high_priority_count < p_tasks.size()) {
+		_post_tasks(p_tasks.ptr() + high_priority_count, p_tasks.size() - high_priority_count, false, lock, false);
+	}
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description, Span<TaskID> p_dependencies) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, false, p_dependencies);
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task, Span<TaskID> p_dependencies) {
 	MutexLock<BinaryMutex> lock(task_mutex);
 
 	// Get a free task
@@ -357,6 +530,8 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 	task->description = p_description;
 	task->template_userdata = p_template_userdata;
 	task->is_pump_task = p_pump_task;
+	task->low_priority = !p_high_priority;
+	task->pending_dependencies = _register_dependencies(p_dependencies, task, nullptr);
 	tasks.insert(id, task);
 
 #ifdef THREADS_ENABLED
@@ -377,7 +552,9 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 	}
 #endif
 
-	_post_tasks(&task, 1, p_high_priority, lock, p_pump_task);
+	if (task->pending_dependencies == 0) {
+		_post_tasks(&task, 1, p_high_priority, lock, p_pump_task);
+	}
 
 	return id;
 }
@@ -390,6 +567,10 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_task_bind(const Callable &p_actio
 	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, false);
 }
 
+WorkerThreadPool::TaskID WorkerThreadPool::add_task_with_dependencies(const Callable &p_action, const Vector<TaskID> &p_dependencies, bool p_high_priority, const String &p_description) {
+	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, false, p_dependencies);
+}
+
 bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
 	MutexLock task_lock(task_mutex);
 	const Task *const *taskp = tasks.getptr(p_task_id);
@@ -529,7 +710,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = (task_queue.first() || !_are_work_queues_empty()) ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
@@ -547,7 +728,10 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				}
 			}
 
-			if (p_caller_pool_thread->pool->task_queue.first()) {
+			// Own work queue first, since the awaited task is most likely there.
+			task_to_process = _pop_work_queue_task(p_caller_pool_thread);
+
+			if (!task_to_process && task_queue.first()) {
 				task_to_process = task_queue.first()->self();
 				if ((p_task == ThreadData::YIELDING || p_caller_pool_thread->has_pump_task == true) && task_to_process->is_pump_task) {
 					task_to_process = nullptr;
@@ -600,7 +784,7 @@ bool WorkerThreadPool::_handle_runlevel(ThreadData *p_thread_data, MutexLock<Bin
 		} break;
 		case RUNLEVEL_PRE_EXIT_LANGUAGES: {
 			if (!p_thread_data->pre_exited_languages) {
-				if (!task_queue.first() && !low_priority_task_queue.first()) {
+				if (!task_queue.first() && !low_priority_task_queue.first() && _are_work_queues_empty()) {
 					p_thread_data->pre_exited_languages = true;
 					runlevel_data.pre_exit_languages.num_idle_threads++;
 					control_cond_var.notify_all();
@@ -663,7 +847,7 @@ void WorkerThreadPool::notify_yield_over(TaskID p_task_id) {
 	td.cond_var.notify_one();
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, Span<TaskID> p_dependencies) {
 	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
 	if (p_tasks < 0) {
 		p_tasks = MAX(1u, threads.size());
@@ -672,6 +856,7 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 	MutexLock<BinaryMutex> lock(task_mutex);
 
 	Group *group = group_allocator.alloc();
+	group->pending_dependencies = _register_dependencies(p_dependencies, nullptr, group);
 	GroupID id = last_task++;
 	group->max = p_elements;
 	group->self = id;
@@ -679,8 +864,12 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 	Task **tasks_posted = nullptr;
 	if (p_elements == 0) {
 		// Should really not call it with zero Elements, but at least it should work.
-		group->completed.set_to(true);
-		group->done_semaphore.post();
+		// With dependencies, it's a handy join point, completed once they all are.
+		if (group->pending_dependencies == 0) {
+			group->completed.set_to(true);
+			group->done_semaphore.post();
+			group->dependents_resolved = true;
+		}
 		group->tasks_used = 0;
 		p_tasks = 0;
 		if (p_template_userdata) {
@@ -698,6 +887,7 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 			task->group = group;
 			task->callable = p_callable;
 			task->template_userdata = p_template_userdata;
+			task->low_priority = !p_high_priority;
 			tasks_posted[i] = task;
 			// No task ID is used.
 		}
@@ -705,19 +895,29 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 
 	groups[id] = group;
 
-	_post_tasks(tasks_posted, p_tasks, p_high_priority, lock, false);
+	if (group->pending_dependencies == 0) {
+		_post_tasks(tasks_posted, p_tasks, p_high_priority, lock, false);
+	} else {
+		for (int i = 0; i < p_tasks; i++) {
+			group->deferred_tasks.push_back(tasks_posted[i]);
+		}
+	}
 
 	return id;
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
-	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description);
+WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, Span<TaskID> p_dependencies) {
+	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
 }
 
 WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_action, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
 	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description);
 }
 
+WorkerThreadPool::GroupID WorkerThreadPool::add_group_task_with_dependencies(const Callable &p_action, int p_elements, const Vector<TaskID> &p_dependencies, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+}
+
 uint32_t WorkerThreadPool::get_group_processed_element_count(GroupID p_group) const {
 	MutexLock task_lock(task_mutex);
 	const Group *const *groupp = groups.getptr(p_group);
@@ -739,6 +939,13 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 #ifdef THREADS_ENABLED
 	task_mutex.lock();
 	Group **groupp = groups.getptr(p_group);
+	if (groupp) {
+		if ((*groupp)->consumed) {
+			task_mutex.unlock();
+			ERR_FAIL_MSG("This group is a dependency of another task or group, which should be awaited instead.");
+		}
+		(*groupp)->awaited = true;
+	}
 	task_mutex.unlock();
 	if (!groupp) {
 		ERR_FAIL_MSG("Invalid Group ID.");
@@ -919,6 +1126,9 @@ void WorkerThreadPool::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_group_processed_element_count", "group_id"), &WorkerThreadPool::get_group_processed_element_count);
 	ClassDB::bind_method(D_METHOD("wait_for_group_task_completion", "group_id"), &WorkerThreadPool::wait_for_group_task_completion);
 	ClassDB::bind_method(D_METHOD("get_caller_group_id"), &WorkerThreadPool::get_caller_group_id);
+
+	ClassDB::bind_method(D_METHOD("add_task_with_dependencies", "action", "dependencies", "high_priority", "description"), &WorkerThreadPool::add_task_with_dependencies, DEFVAL(false), DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("add_group_task_with_dependencies", "action", "elements", "dependencies", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_group_task_with_dependencies, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
 }
 
 WorkerThreadPool *WorkerThreadPool::get_named_pool(const StringName &p_name) {
@@ -39,6 +39,7 @@
 #include "core/templates/paged_allocator.h"
 #include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
+#include "core/templates/work_stealing_deque.h"
 #include "core/variant/callable.h"
 
 class WorkerThreadPool : public Object {
@@ -60,6 +61,16 @@ private:
 		virtual ~BaseTemplateUserdata() {}
 	};
 
+	struct Group;
+
+	// What to notify once a task or group completes, when other ones were added depending on it.
+	struct Dependents {
+		LocalVector<Task *> tasks;
+		LocalVector<Group *> groups;
+
+		_FORCE_INLINE_ bool is_empty() const { return tasks.is_empty() && groups.is_empty(); }
+	};
+
 	struct Group {
 		GroupID self = -1;
 		SafeNumeric<uint32_t> index;
@@ -69,6 +80,12 @@ private:
 		SafeFlag completed;
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
+		uint32_t pending_dependencies = 0;
+		LocalVector<Task *> deferred_tasks; // Posted once all dependencies complete.
+		Dependents dependents;
+		bool dependents_resolved = false;
+		bool consumed = false; // Used as a dependency and not awaited, so reclaimed on completion.
+		bool awaited = false;
 	};
 
 	struct Task {
@@ -82,6 +99,7 @@ private:
 		bool completed : 1;
 		bool pending_notify_yield_over : 1;
 		bool is_pump_task : 1;
+		bool consumed : 1; // Used as a dependency, so reclaimed on completion if not awaited.
 		Group *group = nullptr;
 		SelfList<Task> task_elem;
 		uint32_t waiting_pool = 0;
@@ -89,12 +107,15 @@ private:
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
 		int pool_thread_index = -1;
+		uint32_t pending_dependencies = 0;
+		Dependents dependents;
 
 		void free_template_userdata();
 		Task() :
 				completed(false),
 				pending_notify_yield_over(false),
 				is_pump_task(false),
+				consumed(false),
 				task_elem(this) {}
 	};
 
@@ -104,6 +125,7 @@ private:
 	PagedAllocator<Task, false, TASKS_PAGE_SIZE> task_allocator;
 	PagedAllocator<Group, false, GROUPS_PAGE_SIZE> group_allocator;
 
+	// Injection queues, for tasks posted from outside the pool (or which can't go to a thread's work queue).
 	SelfList<Task>::List low_priority_task_queue;
 	SelfList<Task>::List task_queue;
 
@@ -123,6 +145,7 @@ private:
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
 		WorkerThreadPool *pool = nullptr;
+		WorkStealingDeque<Task *> work_queue; // High priority tasks posted from this thread. Only this thread pushes; any can steal.
 
 		ThreadData() :
 				signaled(false),
@@ -183,6 +206,14 @@ private:
 
 	bool _try_promote_low_priority_task();
 
+	Task *_pop_work_queue_task(ThreadData *p_thread_data);
+	bool _are_work_queues_empty() const;
+
+	uint32_t _register_dependencies(Span<TaskID> p_dependencies, Task *p_task, Group *p_group);
+	void _resolve_dependents(Dependents &p_dependents, LocalVector<Task *> &r_ready_tasks);
+	void _complete_deferred_empty_group(Group *p_group, LocalVector<Task *> &r_ready_tasks);
+	void _post_ready_tasks(LocalVector<Task *> &p_tasks);
+
 	static WorkerThreadPool *singleton;
 
 #ifdef THREADS_ENABLED
@@ -194,8 +225,8 @@ private:
 	static thread_local UnlockableLocks unlockable_locks[MAX_UNLOCKABLE_LOCKS];
 #endif
 
-	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task = false);
-	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description);
+	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task = false, Span<TaskID> p_dependencies = Span<TaskID>());
+	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, Span<TaskID> p_dependencies = Span<TaskID>());
 
 	template <typename C, typename M, typename U>
 	struct TaskUserData : public BaseTemplateUserdata {
@@ -233,18 +264,24 @@ protected:
 	static void _bind_methods();
 
 public:
+	// Tasks and groups can be made to depend on previously added ones, by passing their IDs as `p_dependencies`.
+	// They won't start until all of them are completed. Dependencies are consumed: unless something else is
+	// already awaiting them, they are reclaimed once completed, so only the last tasks or groups of the graph
+	// have to (and can) be awaited.
+
 	template <typename C, typename M, typename U>
-	TaskID add_template_task(C *p_instance, M p_method, U p_userdata, bool p_high_priority = false, const String &p_description = String()) {
+	TaskID add_template_task(C *p_instance, M p_method, U p_userdata, bool p_high_priority = false, const String &p_description = String(), Span<TaskID> p_dependencies = Span<TaskID>()) {
 		typedef TaskUserData<C, M, U> TUD;
 		TUD *ud = memnew(TUD);
 		ud->instance = p_instance;
 		ud->method = p_method;
 		ud->userdata = p_userdata;
-		return _add_task(Callable(), nullptr, nullptr, ud, p_high_priority, p_description);
+		return _add_task(Callable(), nullptr, nullptr, ud, p_high_priority, p_description, false, p_dependencies);
 	}
-	TaskID add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String());
+	TaskID add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String(), Span<TaskID> p_dependencies = Span<TaskID>());
 	TaskID add_task(const Callable &p_action, bool p_high_priority = false, const String &p_description = String(), bool p_pump_task = false);
 	TaskID add_task_bind(const Callable &p_action, bool p_high_priority = false, const String &p_description = String());
+	TaskID add_task_with_dependencies(const Callable &p_action, const Vector<TaskID> &p_dependencies, bool p_high_priority = false, const String &p_description = String());
 
 	bool is_task_completed(TaskID p_task_id) const;
 	Error wait_for_task_completion(TaskID p_task_id);
@@ -253,16 +290,17 @@ public:
 	void notify_yield_over(TaskID p_task_id);
 
 	template <typename C, typename M, typename U>
-	GroupID add_template_group_task(C *p_instance, M p_method, U p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String()) {
+	GroupID add_template_group_task(C *p_instance, M p_method, U p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String(), Span<TaskID> p_dependencies = Span<TaskID>()) {
 		typedef GroupUserData<C, M, U> GroupUD;
 		GroupUD *ud = memnew(GroupUD);
 		ud->instance = p_instance;
 		ud->method = p_method;
 		ud->userdata = p_userdata;
-		return _add_group_task(Callable(), nullptr, nullptr, ud, p_elements, p_tasks, p_high_priority, p_description);
+		return _add_group_task(Callable(), nullptr, nullptr, ud, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
 	}
-	GroupID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+	GroupID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String(), Span<TaskID> p_dependencies = Span<TaskID>());
 	GroupID add_group_task(const Callable &p_action, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+	GroupID add_group_task_with_dependencies(const Callable &p_action, int p_elements, const Vector<TaskID> &p_dependencies, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
 	uint32_t get_group_processed_element_count(GroupID p_group) const;
 	bool is_group_task_completed(GroupID p_group) const;
 	void wait_for_group_task_completion(GroupID p_group);
@@ -30,6 +30,7 @@
 
 #include "memory.h"
 
+#include "core/os/small_object_allocator.h"
 #include "core/profiling/profiling.h"
 #include "core/templates/safe_refcount.h"
 
@@ -38,12 +39,56 @@
 #endif
 
 #include <cstdlib>
+#include <cstring>
 
 #ifdef DEBUG_ENABLED
 static SafeNumeric<uint64_t> _current_mem_usage;
 static SafeNumeric<uint64_t> _max_mem_usage;
+static thread_local uint64_t _thread_alloc_count = 0;
 #endif
 
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+// The size header is always needed, as it tells which allocator a block comes from.
+#define ALWAYS_PREPAD
+#elif defined(DEBUG_ENABLED)
+#define ALWAYS_PREPAD
+#endif
+
+// Set in the size header of blocks owned by the SmallObjectAllocator.
+static constexpr uint64_t SMALL_BLOCK_FLAG = uint64_t(1) << 63;
+
+template <bool p_ensure_zero>
+_FORCE_INLINE_ static void *_alloc_block(size_t p_bytes, bool &r_small_block) {
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+	if (p_bytes <= SmallObjectAllocator::MAX_BLOCK_BYTES && SmallObjectAllocator::is_enabled()) {
+		void *mem = SmallObjectAllocator::alloc(p_bytes);
+		if constexpr (p_ensure_zero) {
+			if (mem) {
+				memset(mem, 0, p_bytes);
+			}
+		}
+		r_small_block = true;
+		return mem;
+	}
+#endif
+	r_small_block = false;
+	if constexpr (p_ensure_zero) {
+		return calloc(1, p_bytes);
+	} else {
+		return malloc(p_bytes);
+	}
+}
+
+_FORCE_INLINE_ static void _free_block(void *p_mem, uint64_t p_size_header) {
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+	if (p_size_header & SMALL_BLOCK_FLAG) {
+		SmallObjectAllocator::free(p_mem, (p_size_header & ~SMALL_BLOCK_FLAG) + Memory::DATA_OFFSET);
+		return;
+	}
+#endif
+	free(p_mem);
+}
+
 void *Memory::alloc_aligned_static(size_t p_bytes, size_t p_alignment) {
 	DEV_ASSERT(Math::is_power_of_2(p_alignment));
 
@@ -80,27 +125,27 @@ void Memory::free_aligned_static(void *p_memory) {
 
 template <bool p_ensure_zero>
 void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
-#ifdef DEBUG_ENABLED
+#ifdef ALWAYS_PREPAD
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
 #endif
 
-	void *mem;
-	if constexpr (p_ensure_zero) {
-		mem = calloc(1, p_bytes + (prepad ? DATA_OFFSET : 0));
-	} else {
-		mem = malloc(p_bytes + (prepad ? DATA_OFFSET : 0));
-	}
+	bool small_block;
+	void *mem = _alloc_block<p_ensure_zero>(p_bytes + (prepad ? DATA_OFFSET : 0), small_block);
 
 	ERR_FAIL_NULL_V(mem, nullptr);
 	GodotProfileAlloc(mem, p_bytes + (prepad ? DATA_OFFSET : 0));
 
+#ifdef DEBUG_ENABLED
+	_thread_alloc_count++;
+#endif
+
 	if (prepad) {
 		uint8_t *s8 = (uint8_t *)mem;
 
 		uint64_t *s = (uint64_t *)(s8 + SIZE_OFFSET);
-		*s = p_bytes;
+		*s = p_bytes | (small_block ? SMALL_BLOCK_FLAG : 0);
 
 #ifdef DEBUG_ENABLED
 		uint64_t new_mem_usage = _current_mem_usage.add(p_bytes);
@@ -120,9 +165,15 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 		return alloc_static(p_bytes, p_pad_align);
 	}
 
+#ifdef DEBUG_ENABLED
+	if (p_bytes != 0) {
+		_thread_alloc_count++;
+	}
+#endif
+
 	uint8_t *mem = (uint8_t *)p_memory;
 
-#ifdef DEBUG_ENABLED
+#ifdef ALWAYS_PREPAD
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -131,34 +182,59 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 	if (prepad) {
 		mem -= DATA_OFFSET;
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
+		const uint64_t size_header = *s;
+		const uint64_t prev_bytes = size_header & ~SMALL_BLOCK_FLAG;
 
 #ifdef DEBUG_ENABLED
-		if (p_bytes > *s) {
-			uint64_t new_mem_usage = _current_mem_usage.add(p_bytes - *s);
+		if (p_bytes > prev_bytes) {
+			uint64_t new_mem_usage = _current_mem_usage.add(p_bytes - prev_bytes);
 			_max_mem_usage.exchange_if_greater(new_mem_usage);
 		} else {
-			_current_mem_usage.sub(*s - p_bytes);
+			_current_mem_usage.sub(prev_bytes - p_bytes);
 		}
 #endif
 
 		if (p_bytes == 0) {
 			GodotProfileFree(mem);
-			free(mem);
+			_free_block(mem, size_header);
 			return nullptr;
-		} else {
-			*s = p_bytes;
+		}
 
-			GodotProfileFree(mem);
-			mem = (uint8_t *)realloc(mem, p_bytes + DATA_OFFSET);
-			ERR_FAIL_NULL_V(mem, nullptr);
-			GodotProfileAlloc(mem, p_bytes + DATA_OFFSET);
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+		if (size_header & SMALL_BLOCK_FLAG) {
+			if (p_bytes + DATA_OFFSET <= SmallObjectAllocator::MAX_BLOCK_BYTES && SmallObjectAllocator::get_size_class(p_bytes + DATA_OFFSET) == SmallObjectAllocator::get_size_class(prev_bytes + DATA_OFFSET)) {
+				// Still fits in the same block.
+				*s = p_bytes | SMALL_BLOCK_FLAG;
+				return mem + DATA_OFFSET;
+			}
 
-			s = (uint64_t *)(mem + SIZE_OFFSET);
+			bool small_block;
+			uint8_t *new_mem = (uint8_t *)_alloc_block<false>(p_bytes + DATA_OFFSET, small_block);
+			ERR_FAIL_NULL_V(new_mem, nullptr);
+			GodotProfileAlloc(new_mem, p_bytes + DATA_OFFSET);
 
-			*s = p_bytes;
+			// Copy the header too, it may hold more than the size.
+			memcpy(new_mem, mem, DATA_OFFSET + MIN(prev_bytes, (uint64_t)p_bytes));
+			*(uint64_t *)(new_mem + SIZE_OFFSET) = p_bytes | (small_block ? SMALL_BLOCK_FLAG : 0);
 
-			return mem + DATA_OFFSET;
+			GodotProfileFree(mem);
+			_free_block(mem, size_header);
+			return new_mem + DATA_OFFSET;
 		}
+#endif
+
+		*s = p_bytes;
+
+		GodotProfileFree(mem);
+		mem = (uint8_t *)realloc(mem, p_bytes + DATA_OFFSET);
+		ERR_FAIL_NULL_V(mem, nullptr);
+		GodotProfileAlloc(mem, p_bytes + DATA_OFFSET);
+
+		s = (uint64_t *)(mem + SIZE_OFFSET);
+
+		*s = p_bytes;
+
+		return mem + DATA_OFFSET;
 	} else {
 		GodotProfileFree(mem);
 		mem = (uint8_t *)realloc(mem, p_bytes);
@@ -175,7 +251,7 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_ptr;
 
-#ifdef DEBUG_ENABLED
+#ifdef ALWAYS_PREPAD
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -184,13 +260,13 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 	if (prepad) {
 		mem -= DATA_OFFSET;
 
+		const uint64_t size_header = *(uint64_t *)(mem + SIZE_OFFSET);
 #ifdef DEBUG_ENABLED
-		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
-		_current_mem_usage.sub(*s);
+		_current_mem_usage.sub(size_header & ~SMALL_BLOCK_FLAG);
 #endif
 
 		GodotProfileFree(mem);
-		free(mem);
+		_free_block(mem, size_header);
 	} else {
 		GodotProfileFree(mem);
 		free(mem);
@@ -217,6 +293,14 @@ uint64_t Memory::get_mem_max_usage() {
 #endif
 }
 
+uint64_t Memory::get_thread_alloc_count() {
+#ifdef DEBUG_ENABLED
+	return _thread_alloc_count;
+#else
+	return 0;
+#endif
+}
+
 _GlobalNil::_GlobalNil() {
 	left = this;
 	right = this;
@@ -96,6 +96,8 @@ void free_aligned_static(void *p_memory);
 uint64_t get_mem_available();
 uint64_t get_mem_usage();
 uint64_t get_mem_max_usage();
+// Number of allocations and reallocations made by the calling thread. Only counted in debug builds.
+uint64_t get_thread_alloc_count();
 }; //namespace Memory
 
 class DefaultAllocator {
@@ -0,0 +1,219 @@
+/**************************************************************************/
+/*  small_object_allocator.cpp                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "small_object_allocator.h"
+
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+
+#include "core/os/spin_lock.h"
+
+#include <atomic>
+#include <cstdlib>
+
+struct FreeBlock {
+	FreeBlock *next;
+};
+
+// Blocks moved between a thread cache and the shared bins at once, and how many of them a
+// thread cache keeps at most before giving some back.
+static constexpr uint32_t TRANSFER_BYTES = 8 * 1024;
+static constexpr uint32_t SLAB_BYTES = 64 * 1024;
+
+_FORCE_INLINE_ static uint32_t get_transfer_count(uint32_t p_size_class) {
+	return MAX(TRANSFER_BYTES / SmallObjectAllocator::get_size_class_bytes(p_size_class), 8u);
+}
+
+struct CentralBin {
+	SpinLock lock;
+	FreeBlock *free_list = nullptr;
+	uint8_t *slab_pos = nullptr;
+	uint8_t *slab_end = nullptr;
+};
+
+static CentralBin central_bins[SmallObjectAllocator::SIZE_CLASS_COUNT];
+
+static std::atomic<bool> enabled = true;
+
+// Takes up to p_count blocks, linked together. Returns how many were taken.
+static uint32_t central_take(uint32_t p_size_class, uint32_t p_count, FreeBlock *&r_head) {
+	const uint32_t block_bytes = SmallObjectAllocator::get_size_class_bytes(p_size_class);
+	CentralBin &bin = central_bins[p_size_class];
+
+	FreeBlock *head = nullptr;
+	uint32_t taken = 0;
+
+	bin.lock.lock();
+	while (taken < p_count && bin.free_list) {
+		FreeBlock *block = bin.free_list;
+		bin.free_list = block->next;
+		block->next = head;
+		head = block;
+		taken++;
+	}
+	while (taken < p_count) {
+		if (bin.slab_pos + block_bytes > bin.slab_end) {
+			uint8_t *slab = (uint8_t *)malloc(SLAB_BYTES);
+			if (!slab) {
+				break;
+			}
+			bin.slab_pos = slab;
+			bin.slab_end = slab + SLAB_BYTES;
+		}
+		FreeBlock *block = (FreeBlock *)bin.slab_pos;
+		bin.slab_pos += block_bytes;
+		block->next = head;
+		head = block;
+		taken++;
+	}
+	bin.lock.unlock();
+
+	r_head = head;
+	return taken;
+}
+
+static void central_give(uint32_t p_size_class, FreeBlock *p_head, FreeBlock *p_tail) {
+	CentralBin &bin = central_bins[p_size_class];
+	bin.lock.lock();
+	p_tail->next = bin.free_list;
+	bin.free_list = p_head;
+	bin.lock.unlock();
+}
+
+// Must stay trivially constructible and destructible, so it's usable at any point of the
+// thread's lifetime. Blocks are handed back by ThreadCacheReleaser when the thread exits.
+struct ThreadCache {
+	struct Bin {
+		FreeBlock *head;
+		uint32_t count;
+	};
+
+	Bin bins[SmallObjectAllocator::SIZE_CLASS_COUNT];
+	bool registered;
+	bool released;
+
+	void give_back(uint32_t p_size_class, uint32_t p_count) {
+		Bin &bin = bins[p_size_class];
+		FreeBlock *head = bin.head;
+		FreeBlock *tail = head;
+		for (uint32_t i = 1; i < p_count; i++) {
+			tail = tail->next;
+		}
+		bin.head = tail->next;
+		bin.count -= p_count;
+		central_give(p_size_class, head, tail);
+	}
+};
+
+static thread_local ThreadCache thread_cache;
+
+struct ThreadCacheReleaser {
+	bool used = false;
+
+	~ThreadCacheReleaser() {
+		for (uint32_t i = 0; i < SmallObjectAllocator::SIZE_CLASS_COUNT; i++) {
+			if (thread_cache.bins[i].count) {
+				thread_cache.give_back(i, thread_cache.bins[i].count);
+			}
+		}
+		// Whatever is freed from now on goes straight to the shared bins.
+		thread_cache.released = true;
+	}
+};
+
+static thread_local ThreadCacheReleaser thread_cache_releaser;
+
+_FORCE_INLINE_ static void register_thread_cache() {
+	if (unlikely(!thread_cache.registered)) {
+		// First use of the cache in this thread. Touching the releaser registers its destructor.
+		thread_cache_releaser.used = true;
+		thread_cache.registered = true;
+	}
+}
+
+static void *alloc_slow(uint32_t p_size_class) {
+	if (unlikely(thread_cache.released)) {
+		FreeBlock *block = nullptr;
+		central_take(p_size_class, 1, block);
+		return block;
+	}
+	register_thread_cache();
+
+	ThreadCache::Bin &bin = thread_cache.bins[p_size_class];
+	bin.count = central_take(p_size_class, get_transfer_count(p_size_class), bin.head);
+	if (unlikely(!bin.head)) {
+		return nullptr;
+	}
+	FreeBlock *block = bin.head;
+	bin.head = block->next;
+	bin.count--;
+	return block;
+}
+
+bool SmallObjectAllocator::is_enabled() {
+	return enabled.load(std::memory_order_relaxed);
+}
+
+void SmallObjectAllocator::set_enabled(bool p_enabled) {
+	enabled.store(p_enabled, std::memory_order_relaxed);
+}
+
+void *SmallObjectAllocator::alloc(size_t p_bytes) {
+	const uint32_t size_class = get_size_class(p_bytes);
+	ThreadCache::Bin &bin = thread_cache.bins[size_class];
+	FreeBlock *block = bin.head;
+	if (likely(block)) {
+		bin.head = block->next;
+		bin.count--;
+		return block;
+	}
+	return alloc_slow(size_class);
+}
+
+void SmallObjectAllocator::free(void *p_block, size_t p_bytes) {
+	const uint32_t size_class = get_size_class(p_bytes);
+	FreeBlock *block = (FreeBlock *)p_block;
+	if (unlikely(thread_cache.released)) {
+		central_give(size_class, block, block);
+		return;
+	}
+	register_thread_cache();
+
+	ThreadCache::Bin &bin = thread_cache.bins[size_class];
+	block->next = bin.head;
+	bin.head = block;
+	bin.count++;
+
+	const uint32_t transfer_count = get_transfer_count(size_class);
+	if (unlikely(bin.count > transfer_count * 2)) {
+		thread_cache.give_back(size_class, transfer_count);
+	}
+}
+
+#endif // SMALL_OBJECT_ALLOCATOR_ENABLED
@@ -0,0 +1,67 @@
+/**************************************************************************/
+/*  small_object_allocator.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/typedefs.h"
+
+// Allocator for small blocks, used by `Memory::alloc_static()` when Godot is built
+// with `small_object_allocator=yes`.
+//
+// Blocks are grouped in size classes. Every thread keeps a cache of free blocks for
+// each class, so most allocations and frees don't need any synchronization. Caches
+// are refilled from (and overflow into) shared bins, which carve new blocks out of
+// slabs allocated with `malloc()`. Slabs are never given back to the system.
+class SmallObjectAllocator {
+public:
+	static constexpr size_t MAX_BLOCK_BYTES = 1024;
+	static constexpr uint32_t SIZE_CLASS_COUNT = 28;
+
+	// 16-byte steps up to 256 bytes, then 64-byte steps up to MAX_BLOCK_BYTES.
+	_FORCE_INLINE_ static uint32_t get_size_class(size_t p_bytes) {
+		if (p_bytes <= 256) {
+			return p_bytes ? uint32_t((p_bytes - 1) >> 4) : 0;
+		}
+		return 16 + uint32_t((p_bytes - 257) >> 6);
+	}
+
+	_FORCE_INLINE_ static uint32_t get_size_class_bytes(uint32_t p_size_class) {
+		return p_size_class < 16 ? (p_size_class + 1) << 4 : 256 + ((p_size_class - 15) << 6);
+	}
+
+	static bool is_enabled();
+	// Blocks allocated before disabling remain valid and can be freed normally.
+	static void set_enabled(bool p_enabled);
+
+	// p_bytes must not be bigger than MAX_BLOCK_BYTES.
+	static void *alloc(size_t p_bytes);
+	// p_bytes must be the size that was passed to alloc().
+	static void free(void *p_block, size_t p_bytes);
+};
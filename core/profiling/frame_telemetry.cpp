@@ -0,0 +1,304 @@
+/**************************************************************************/
+/*  frame_telemetry.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_telemetry.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/marshalls.h"
+#include "core/io/stream_peer_uds.h"
+#include "core/os/os.h"
+
+SafeFlag FrameTelemetry::enabled;
+SafeNumeric<uint64_t> FrameTelemetry::accumulated[SUBSYSTEM_MAX];
+FrameTelemetry::Format FrameTelemetry::format = FrameTelemetry::FORMAT_BINARY;
+uint64_t FrameTelemetry::flush_interval_usec = 1000000;
+uint64_t FrameTelemetry::last_flush_usec = 0;
+uint64_t FrameTelemetry::frames = 0;
+uint64_t FrameTelemetry::totals[SUBSYSTEM_MAX] = {};
+uint32_t FrameTelemetry::interval_max[SUBSYSTEM_MAX] = {};
+String FrameTelemetry::output_path;
+Ref<FileAccess> FrameTelemetry::file;
+Ref<StreamPeerUDS> FrameTelemetry::socket;
+LocalVector<uint8_t> FrameTelemetry::pending;
+uint64_t FrameTelemetry::dropped_records = 0;
+
+static const char *subsystem_names[FrameTelemetry::SUBSYSTEM_MAX] = {
+	"frame",
+	"physics",
+	"physics_process",
+	"process",
+	"navigation",
+	"message_queue",
+	"script",
+	"resource_loader",
+};
+
+const char *FrameTelemetry::get_subsystem_name(Subsystem p_subsystem) {
+	ERR_FAIL_INDEX_V(p_subsystem, SUBSYSTEM_MAX, "");
+	return subsystem_names[p_subsystem];
+}
+
+uint64_t FrameTelemetry::_get_ticks_usec() {
+	return OS::get_singleton()->get_ticks_usec();
+}
+
+void FrameTelemetry::encode_binary_header(LocalVector<uint8_t> &r_buffer) {
+	uint8_t buf[4];
+	r_buffer.push_back('G');
+	r_buffer.push_back('D');
+	r_buffer.push_back('T');
+	r_buffer.push_back('M');
+	encode_uint32(BINARY_VERSION, buf);
+	for (uint8_t b : buf) {
+		r_buffer.push_back(b);
+	}
+	encode_uint32(SUBSYSTEM_MAX, buf);
+	for (uint8_t b : buf) {
+		r_buffer.push_back(b);
+	}
+	for (int i = 0; i < SUBSYSTEM_MAX; i++) {
+		const uint32_t len = strlen(subsystem_names[i]);
+		encode_uint32(len, buf);
+		for (uint8_t b : buf) {
+			r_buffer.push_back(b);
+		}
+		for (uint32_t j = 0; j < len; j++) {
+			r_buffer.push_back(subsystem_names[i][j]);
+		}
+	}
+}
+
+void FrameTelemetry::encode_binary_record(LocalVector<uint8_t> &r_buffer, uint64_t p_frame, uint64_t p_timestamp, const uint32_t *p_usec) {
+	const uint32_t ofs = r_buffer.size();
+	r_buffer.resize(ofs + 16 + SUBSYSTEM_MAX * 4);
+	uint8_t *w = r_buffer.ptr() + ofs;
+	w += encode_uint64(p_frame, w);
+	w += encode_uint64(p_timestamp, w);
+	for (int i = 0; i < SUBSYSTEM_MAX; i++) {
+		w += encode_uint32(p_usec[i], w);
+	}
+}
+
+String FrameTelemetry::encode_openmetrics(uint64_t p_frames, const uint64_t *p_total_usec, const uint32_t *p_max_usec) {
+	String text;
+	text += "# TYPE godot_frames counter\n";
+	text += "# HELP godot_frames Number of frames processed.\n";
+	text += "godot_frames_total " + itos(p_frames) + "\n";
+
+	text += "# TYPE godot_subsystem_seconds counter\n";
+	text += "# UNIT godot_subsystem_seconds seconds\n";
+	text += "# HELP godot_subsystem_seconds Cumulative time spent in each subsystem.\n";
+	for (int i = 0; i < SUBSYSTEM_MAX; i++) {
+		text += vformat("godot_subsystem_seconds_total{subsystem=\"%s\"} %s\n", subsystem_names[i], String::num(p_total_usec[i] / 1000000.0, 6));
+	}
+
+	text += "# TYPE godot_subsystem_max_seconds gauge\n";
+	text += "# UNIT godot_subsystem_max_seconds seconds\n";
+	text += "# HELP godot_subsystem_max_seconds Longest single frame time spent in each subsystem since the previous report.\n";
+	for (int i = 0; i < SUBSYSTEM_MAX; i++) {
+		text += vformat("godot_subsystem_max_seconds{subsystem=\"%s\"} %s\n", subsystem_names[i], String::num(p_max_usec[i] / 1000000.0, 6));
+	}
+
+	text += "# EOF\n";
+	return text;
+}
+
+void FrameTelemetry::_append_openmetrics() {
+	const CharString text = encode_openmetrics(frames, totals, interval_max).utf8();
+	if (socket.is_null()) {
+		// Files only ever hold the latest snapshot.
+		pending.clear();
+	}
+	if (pending.size() + text.length() > MAX_PENDING_BYTES) {
+		dropped_records++;
+		return;
+	}
+	const uint32_t ofs = pending.size();
+	pending.resize(ofs + text.length());
+	memcpy(pending.ptr() + ofs, text.get_data(), text.length());
+}
+
+void FrameTelemetry::_connect_socket() {
+	socket.instantiate();
+	if (socket->connect_to_host(output_path.trim_prefix(UNIX_SOCKET_PREFIX)) != OK) {
+		socket->disconnect_from_host();
+		return;
+	}
+	// A new connection starts a new stream.
+	pending.clear();
+	if (format == FORMAT_BINARY) {
+		encode_binary_header(pending);
+	}
+}
+
+Error FrameTelemetry::start(const String &p_path, Format p_format, uint64_t p_flush_interval_msec) {
+	ERR_FAIL_COND_V(p_path.is_empty(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_INDEX_V(p_format, FORMAT_OPENMETRICS + 1, ERR_INVALID_PARAMETER);
+	stop();
+
+	output_path = p_path;
+	format = p_format;
+	flush_interval_usec = MAX(p_flush_interval_msec, (uint64_t)1) * 1000;
+	frames = 0;
+	dropped_records = 0;
+	for (int i = 0; i < SUBSYSTEM_MAX; i++) {
+		accumulated[i].set(0);
+		totals[i] = 0;
+		interval_max[i] = 0;
+	}
+
+	if (output_path.begins_with(UNIX_SOCKET_PREFIX)) {
+		// Connection failures are retried on every flush, so the receiving end
+		// may be started after the engine.
+		_connect_socket();
+	} else if (format == FORMAT_BINARY) {
+		Error err;
+		file = FileAccess::open(output_path, FileAccess::WRITE, &err);
+		ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Cannot open frame telemetry output file \"%s\".", output_path));
+		encode_binary_header(pending);
+	}
+
+	last_flush_usec = _get_ticks_usec();
+	enabled.set();
+	return OK;
+}
+
+void FrameTelemetry::stop() {
+	if (!is_enabled()) {
+		return;
+	}
+	enabled.clear();
+
+	if (format == FORMAT_OPENMETRICS) {
+		_append_openmetrics();
+	}
+	_flush();
+	if (dropped_records > 0) {
+		WARN_PRINT(vformat("Frame telemetry dropped %d records because the output could not keep up.", dropped_records));
+	}
+
+	if (socket.is_valid()) {
+		socket->disconnect_from_host();
+		socket.unref();
+	}
+	file.unref();
+	pending.reset();
+	output_path = String();
+}
+
+void FrameTelemetry::_flush() {
+	if (socket.is_valid()) {
+		socket->poll();
+		const StreamPeerSocket::Status status = socket->get_status();
+		if (status == StreamPeerSocket::STATUS_NONE || status == StreamPeerSocket::STATUS_ERROR) {
+			_connect_socket();
+			return;
+		}
+		if (status != StreamPeerSocket::STATUS_CONNECTED || pending.is_empty()) {
+			return;
+		}
+		int sent = 0;
+		if (socket->put_partial_data(pending.ptr(), pending.size(), sent) != OK) {
+			socket->disconnect_from_host();
+			return;
+		}
+		if (sent > 0) {
+			const uint32_t remaining = pending.size() - sent;
+			memmove(pending.ptr(), pending.ptr() + sent, remaining);
+			pending.resize(remaining);
+		}
+		return;
+	}
+
+	if (format == FORMAT_BINARY) {
+		if (file.is_valid() && !pending.is_empty()) {
+			file->store_buffer(pending.ptr(), pending.size());
+			file->flush();
+		}
+		pending.clear();
+		return;
+	}
+
+	// OpenMetrics snapshots replace the previous one, so scrapers reading the
+	// file (e.g. a textfile collector) never see a partially written report.
+	const String tmp_path = output_path + ".tmp";
+	Ref<FileAccess> f = FileAccess::open(tmp_path, FileAccess::WRITE);
+	if (f.is_valid()) {
+		f->store_buffer(pending.ptr(), pending.size());
+		f->close();
+		Ref<DirAccess> da = DirAccess::create_for_path(output_path);
+		if (da.is_valid()) {
+			da->rename(tmp_path, output_path);
+		}
+	}
+	pending.clear();
+}
+
+void FrameTelemetry::end_frame(uint64_t p_frame_usec) {
+	if (!is_enabled()) {
+		return;
+	}
+
+	const uint64_t now = _get_ticks_usec();
+
+	uint32_t usec[SUBSYSTEM_MAX];
+	for (int i = 0; i < SUBSYSTEM_MAX; i++) {
+		uint64_t value = accumulated[i].get();
+		accumulated[i].sub(value);
+		if (i == SUBSYSTEM_FRAME) {
+			value += p_frame_usec;
+		}
+		totals[i] += value;
+		usec[i] = MIN(value, (uint64_t)UINT32_MAX);
+		interval_max[i] = MAX(interval_max[i], usec[i]);
+	}
+
+	if (format == FORMAT_BINARY) {
+		if (pending.size() < MAX_PENDING_BYTES) {
+			encode_binary_record(pending, frames, now, usec);
+		} else {
+			dropped_records++;
+		}
+	}
+	frames++;
+
+	if (now - last_flush_usec < flush_interval_usec) {
+		return;
+	}
+	last_flush_usec = now;
+
+	if (format == FORMAT_OPENMETRICS) {
+		_append_openmetrics();
+		for (int i = 0; i < SUBSYSTEM_MAX; i++) {
+			interval_max[i] = 0;
+		}
+	}
+	_flush();
+}
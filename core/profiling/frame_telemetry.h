@@ -0,0 +1,142 @@
+/**************************************************************************/
+/*  frame_telemetry.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/file_access.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+class StreamPeerUDS;
+
+// Always-on per-frame timing counters, usable in release builds without a
+// debugger attached. Each subsystem accumulates the microseconds spent in it
+// during the current frame; Main calls end_frame() once per iteration to emit
+// a record to the configured output. Counters may overlap: e.g. script time is
+// also included in the process and physics process time that triggered it.
+class FrameTelemetry {
+public:
+	enum Subsystem {
+		SUBSYSTEM_FRAME,
+		SUBSYSTEM_PHYSICS,
+		SUBSYSTEM_PHYSICS_PROCESS,
+		SUBSYSTEM_PROCESS,
+		SUBSYSTEM_NAVIGATION,
+		SUBSYSTEM_MESSAGE_QUEUE,
+		SUBSYSTEM_SCRIPT,
+		SUBSYSTEM_RESOURCE_LOADER,
+		SUBSYSTEM_MAX,
+	};
+
+	enum Format {
+		FORMAT_BINARY,
+		FORMAT_OPENMETRICS,
+	};
+
+	// Binary stream layout (little endian):
+	//   header: "GDTM", u32 version, u32 subsystem count, then per subsystem u32 length + UTF-8 name.
+	//   record: u64 frame, u64 timestamp usec, then per subsystem u32 usec.
+	static constexpr uint32_t BINARY_VERSION = 1;
+
+	// Prefix selecting a Unix domain socket instead of a file as output.
+	static constexpr const char *UNIX_SOCKET_PREFIX = "unix:";
+
+	class Scope {
+		Subsystem subsystem;
+		uint64_t begin_usec;
+
+	public:
+		_FORCE_INLINE_ Scope(Subsystem p_subsystem, bool p_active = true) :
+				subsystem(p_subsystem), begin_usec(p_active ? begin() : 0) {}
+		_FORCE_INLINE_ ~Scope() { end(subsystem, begin_usec); }
+	};
+
+private:
+	static SafeFlag enabled;
+	static SafeNumeric<uint64_t> accumulated[SUBSYSTEM_MAX];
+
+	static Format format;
+	static uint64_t flush_interval_usec;
+	static uint64_t last_flush_usec;
+	static uint64_t frames;
+
+	// Totals since start and maximums since the last flush, for OpenMetrics.
+	static uint64_t totals[SUBSYSTEM_MAX];
+	static uint32_t interval_max[SUBSYSTEM_MAX];
+
+	static String output_path;
+	static Ref<FileAccess> file;
+	static Ref<StreamPeerUDS> socket;
+	static LocalVector<uint8_t> pending;
+	static uint64_t dropped_records;
+
+	// Output that can't be written right away (e.g. socket not ready) is
+	// buffered up to this size, then new records are dropped. The frame never
+	// blocks on telemetry output.
+	static constexpr uint32_t MAX_PENDING_BYTES = 1024 * 1024;
+
+	static uint64_t _get_ticks_usec();
+	static void _connect_socket();
+	static void _append_openmetrics();
+	static void _flush();
+
+public:
+	static const char *get_subsystem_name(Subsystem p_subsystem);
+
+	_FORCE_INLINE_ static bool is_enabled() { return enabled.is_set(); }
+
+	// Thread-safe, so worker threads (e.g. threaded resource loads) can report.
+	_FORCE_INLINE_ static void add_time(Subsystem p_subsystem, uint64_t p_usec) {
+		accumulated[p_subsystem].add(p_usec);
+	}
+
+	// Returns a start timestamp for end(), or 0 when telemetry is disabled so
+	// that the clock isn't read at all.
+	_FORCE_INLINE_ static uint64_t begin() {
+		return is_enabled() ? _get_ticks_usec() : 0;
+	}
+	_FORCE_INLINE_ static void end(Subsystem p_subsystem, uint64_t p_begin_usec) {
+		if (p_begin_usec != 0) {
+			add_time(p_subsystem, _get_ticks_usec() - p_begin_usec);
+		}
+	}
+
+	// `p_path` is a file path, or `unix:<path>` to stream to a Unix domain socket.
+	static Error start(const String &p_path, Format p_format, uint64_t p_flush_interval_msec = 1000);
+	static void stop();
+
+	// Closes the current frame. Must be called from the main thread.
+	static void end_frame(uint64_t p_frame_usec);
+
+	// Encoding helpers, exposed for tests and external tooling.
+	static void encode_binary_header(LocalVector<uint8_t> &r_buffer);
+	static void encode_binary_record(LocalVector<uint8_t> &r_buffer, uint64_t p_frame, uint64_t p_timestamp, const uint32_t *p_usec);
+	static String encode_openmetrics(uint64_t p_frames, const uint64_t *p_total_usec, const uint32_t *p_max_usec);
+};
@@ -32,38 +32,249 @@
 
 #include "core/os/mutex.h"
 #include "core/os/os.h"
+#include "core/os/thread.h"
 #include "core/string/print_string.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
 
 struct StringName::Table {
-	constexpr static uint32_t TABLE_BITS = 16;
-	constexpr static uint32_t TABLE_LEN = 1 << TABLE_BITS;
-	constexpr static uint32_t TABLE_MASK = TABLE_LEN - 1;
+	// Names are spread over shards, each with its own lock for insertions and
+	// removals, and its own bucket array that grows with the number of names.
+	// Lookups don't lock anything: they register in the reader count of the
+	// current epoch of the shard. Removed names and old bucket arrays are
+	// retired instead of freed, and reclaimed once the epoch has advanced past
+	// every lookup that may still see them.
+	constexpr static uint32_t SHARD_BITS = 6;
+	constexpr static uint32_t SHARD_COUNT = 1 << SHARD_BITS;
+	constexpr static uint32_t INITIAL_BUCKET_COUNT = 1024; // 64 Ki buckets in total, like the old fixed table.
+
+	struct Buckets {
+		uint32_t mask = 0;
+		std::atomic<_Data *> *heads = nullptr;
+	};
+
+	struct alignas(Thread::CACHE_LINE_BYTES) Shard {
+		std::atomic<uint32_t> epoch = 0;
+		std::atomic<uint32_t> readers[2] = {};
+		std::atomic<Buckets *> buckets = nullptr;
+
+		BinaryMutex mutex;
+		uint32_t count = 0;
+		PagedAllocator<_Data, false, 256> allocator;
+		// Indexed by the parity of the epoch they were retired in.
+		LocalVector<_Data *> retired_names[2];
+		LocalVector<Buckets *> retired_buckets[2];
+	};
+
+	static Shard shards[SHARD_COUNT];
+
+	static _FORCE_INLINE_ Shard &get_shard(uint32_t p_hash) {
+		// The lower bits pick the bucket. Short names have few upper bits set, so mix them first.
+		return shards[hash_fmix32(p_hash) >> (32 - SHARD_BITS)];
+	}
+
+	static Buckets *alloc_buckets(uint32_t p_count) {
+		Buckets *buckets = (Buckets *)memalloc(sizeof(Buckets) + sizeof(std::atomic<_Data *>) * p_count);
+		memnew_placement(buckets, Buckets);
+		buckets->mask = p_count - 1;
+		buckets->heads = (std::atomic<_Data *> *)(buckets + 1);
+		for (uint32_t i = 0; i < p_count; i++) {
+			memnew_placement(&buckets->heads[i], std::atomic<_Data *>(nullptr));
+		}
+		return buckets;
+	}
+
+	static _FORCE_INLINE_ uint32_t read_lock(Shard &p_shard) {
+		while (true) {
+			const uint32_t epoch = p_shard.epoch.load();
+			p_shard.readers[epoch & 1].fetch_add(1);
+			// If a removal started in between, it may not have seen us.
+			if (likely(p_shard.epoch.load() == epoch)) {
+				return epoch;
+			}
+			p_shard.readers[epoch & 1].fetch_sub(1);
+		}
+	}
+
+	static _FORCE_INLINE_ void read_unlock(Shard &p_shard, uint32_t p_epoch) {
+		p_shard.readers[p_epoch & 1].fetch_sub(1);
+	}
+
+	// Must be called with the shard locked.
+	static void free_retired(Shard &p_shard, uint32_t p_parity) {
+		for (_Data *data : p_shard.retired_names[p_parity]) {
+			p_shard.allocator.free(data);
+		}
+		p_shard.retired_names[p_parity].clear();
+		for (Buckets *buckets : p_shard.retired_buckets[p_parity]) {
+			memfree(buckets);
+		}
+		p_shard.retired_buckets[p_parity].clear();
+	}
+
+	// Must be called with the shard locked, after retiring something.
+	// Once the lookups of the previous epoch are done, advances the epoch
+	// and frees what was retired during the previous one: only lookups of
+	// that epoch, or older ones that already finished, could still see it.
+	// If lookups are still running, this is retried on the next removal
+	// rather than waiting for them.
+	static void reclaim(Shard &p_shard) {
+		const uint32_t epoch = p_shard.epoch.load();
+		const uint32_t previous = (epoch + 1) & 1;
+		if (p_shard.readers[previous].load() != 0) {
+			return;
+		}
+		p_shard.epoch.store(epoch + 1);
+		free_retired(p_shard, previous);
+	}
+
+	// Returns a new reference to a live name, or nullptr.
+	template <typename T>
+	static _Data *find(const Buckets *p_buckets, const T &p_name, uint32_t p_hash) {
+		_Data *data = p_buckets->heads[p_hash & p_buckets->mask].load(std::memory_order_acquire);
+		while (data) {
+			// Compare hash first. A name whose refcount dropped to zero is being removed, skip it.
+			if (data->hash == p_hash && data->name == p_name && data->refcount.ref()) {
+				return data;
+			}
+			data = data->next.load(std::memory_order_acquire);
+		}
+		return nullptr;
+	}
+
+	// Must be called with the shard locked.
+	static void grow(Shard &p_shard) {
+		Buckets *old_buckets = p_shard.buckets.load(std::memory_order_relaxed);
+		Buckets *new_buckets = alloc_buckets((old_buckets->mask + 1) * 2);
+
+		// Readers walking the old chains may jump to a new one and miss a
+		// name, that's fine since misses are always confirmed with the lock.
+		for (uint32_t i = 0; i <= old_buckets->mask; i++) {
+			_Data *data = old_buckets->heads[i].load(std::memory_order_relaxed);
+			while (data) {
+				_Data *next = data->next.load(std::memory_order_relaxed);
+				std::atomic<_Data *> &head = new_buckets->heads[data->hash & new_buckets->mask];
+				_Data *head_data = head.load(std::memory_order_relaxed);
+				data->prev = nullptr;
+				data->next.store(head_data, std::memory_order_release);
+				if (head_data) {
+					head_data->prev = data;
+				}
+				head.store(data, std::memory_order_relaxed);
+				data = next;
+			}
+		}
+
+		p_shard.buckets.store(new_buckets, std::memory_order_release);
+		p_shard.retired_buckets[p_shard.epoch.load() & 1].push_back(old_buckets);
+		reclaim(p_shard);
+	}
 
-	static inline _Data *table[TABLE_LEN];
-	static inline BinaryMutex mutex;
-	static inline PagedAllocator<_Data> allocator;
+	template <typename T>
+	static _Data *intern(const T &p_name, uint32_t p_hash, bool p_static) {
+		Shard &shard = get_shard(p_hash);
+
+		const uint32_t epoch = read_lock(shard);
+		_Data *data = find(shard.buckets.load(std::memory_order_acquire), p_name, p_hash);
+		read_unlock(shard, epoch);
+
+		if (!data) {
+			MutexLock lock(shard.mutex);
+			Buckets *buckets = shard.buckets.load(std::memory_order_relaxed);
+			data = find(buckets, p_name, p_hash);
+
+			if (!data) {
+				data = shard.allocator.alloc();
+				data->name = p_name;
+				data->refcount.init();
+				data->static_count.set(p_static ? 1 : 0);
+				data->hash = p_hash;
+#ifdef DEBUG_ENABLED
+				if (unlikely(debug_stringname)) {
+					// Keep in memory, force static.
+					data->refcount.ref();
+					data->static_count.increment();
+				}
+#endif
+
+				std::atomic<_Data *> &head = buckets->heads[p_hash & buckets->mask];
+				_Data *head_data = head.load(std::memory_order_relaxed);
+				data->prev = nullptr;
+				data->next.store(head_data, std::memory_order_relaxed);
+				if (head_data) {
+					head_data->prev = data;
+				}
+				head.store(data, std::memory_order_release);
+
+				shard.count++;
+				if (shard.count > buckets->mask + 1) {
+					grow(shard);
+				}
+				return data;
+			}
+		}
+
+		// Exists.
+		if (p_static) {
+			data->static_count.increment();
+		}
+#ifdef DEBUG_ENABLED
+		if (unlikely(debug_stringname)) {
+			data->debug_references.increment();
+		}
+#endif
+		return data;
+	}
+
+	static void release(_Data *p_data) {
+		Shard &shard = get_shard(p_data->hash);
+		MutexLock lock(shard.mutex);
+
+		if (CoreGlobals::leak_reporting_enabled && p_data->static_count.get() > 0) {
+			ERR_PRINT("BUG: Unreferenced static string to 0: " + p_data->name);
+		}
+
+		_Data *next = p_data->next.load(std::memory_order_relaxed);
+		if (p_data->prev) {
+			p_data->prev->next.store(next, std::memory_order_release);
+		} else {
+			Buckets *buckets = shard.buckets.load(std::memory_order_relaxed);
+			buckets->heads[p_data->hash & buckets->mask].store(next, std::memory_order_release);
+		}
+
+		if (next) {
+			next->prev = p_data->prev;
+		}
+		shard.count--;
+
+		shard.retired_names[shard.epoch.load() & 1].push_back(p_data);
+		reclaim(shard);
+	}
 };
 
+StringName::Table::Shard StringName::Table::shards[StringName::Table::SHARD_COUNT];
+
 void StringName::setup() {
 	ERR_FAIL_COND(configured);
-	for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-		Table::table[i] = nullptr;
+	for (Table::Shard &shard : Table::shards) {
+		shard.buckets.store(Table::alloc_buckets(Table::INITIAL_BUCKET_COUNT));
 	}
 	configured = true;
 }
 
 void StringName::cleanup() {
-	MutexLock lock(Table::mutex);
-
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
 		Vector<_Data *> data;
-		for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-			_Data *d = Table::table[i];
-			while (d) {
-				data.push_back(d);
-				d = d->next;
+		for (Table::Shard &shard : Table::shards) {
+			MutexLock lock(shard.mutex);
+			Table::Buckets *buckets = shard.buckets.load();
+			for (uint32_t i = 0; i <= buckets->mask; i++) {
+				_Data *d = buckets->heads[i].load();
+				while (d) {
+					data.push_back(d);
+					d = d->next.load();
+				}
 			}
 		}
 
@@ -73,10 +284,10 @@ void StringName::cleanup() {
 		int unreferenced_stringnames = 0;
 		int rarely_referenced_stringnames = 0;
 		for (int i = 0; i < data.size(); i++) {
-			print_line(itos(i + 1) + ": " + data[i]->name + " - " + itos(data[i]->debug_references));
-			if (data[i]->debug_references == 0) {
+			print_line(itos(i + 1) + ": " + data[i]->name + " - " + itos(data[i]->debug_references.get()));
+			if (data[i]->debug_references.get() == 0) {
 				unreferenced_stringnames += 1;
-			} else if (data[i]->debug_references < 5) {
+			} else if (data[i]->debug_references.get() < 5) {
 				rarely_referenced_stringnames += 1;
 			}
 		}
@@ -86,20 +297,30 @@ void StringName::cleanup() {
 	}
 #endif
 	int lost_strings = 0;
-	for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-		while (Table::table[i]) {
-			_Data *d = Table::table[i];
-			if (d->static_count.get() != d->refcount.get()) {
-				lost_strings++;
-
-				if (OS::get_singleton()->is_stdout_verbose()) {
-					print_line(vformat("Orphan StringName: %s (static: %d, total: %d)", d->name, d->static_count.get(), d->refcount.get()));
+	for (Table::Shard &shard : Table::shards) {
+		MutexLock lock(shard.mutex);
+		Table::Buckets *buckets = shard.buckets.load();
+		for (uint32_t i = 0; i <= buckets->mask; i++) {
+			_Data *d = buckets->heads[i].load();
+			while (d) {
+				if (d->static_count.get() != d->refcount.get()) {
+					lost_strings++;
+
+					if (OS::get_singleton()->is_stdout_verbose()) {
+						print_line(vformat("Orphan StringName: %s (static: %d, total: %d)", d->name, d->static_count.get(), d->refcount.get()));
+					}
 				}
-			}
 
-			Table::table[i] = Table::table[i]->next;
-			Table::allocator.free(d);
+				_Data *next = d->next.load();
+				shard.allocator.free(d);
+				d = next;
+			}
 		}
+		Table::free_retired(shard, 0);
+		Table::free_retired(shard, 1);
+		memfree(buckets);
+		shard.buckets.store(nullptr);
+		shard.count = 0;
 	}
 	if (lost_strings) {
 		print_verbose(vformat("StringName: %d unclaimed string names at exit.", lost_strings));
@@ -111,22 +332,7 @@ void StringName::unref() {
 	ERR_FAIL_COND(!configured);
 
 	if (_data && _data->refcount.unref()) {
-		MutexLock lock(Table::mutex);
-
-		if (CoreGlobals::leak_reporting_enabled && _data->static_count.get() > 0) {
-			ERR_PRINT("BUG: Unreferenced static string to 0: " + _data->name);
-		}
-		if (_data->prev) {
-			_data->prev->next = _data->next;
-		} else {
-			const uint32_t idx = _data->hash & Table::TABLE_MASK;
-			Table::table[idx] = _data->next;
-		}
-
-		if (_data->next) {
-			_data->next->prev = _data->prev;
-		}
-		Table::allocator.free(_data);
+		Table::release(_data);
 	}
 
 	_data = nullptr;
@@ -211,52 +417,7 @@ StringName::StringName(const char *p_name, bool p_static) {
 		return; //empty, ignore
 	}
 
-	const uint32_t hash = String::hash(p_name);
-	const uint32_t idx = hash & Table::TABLE_MASK;
-
-	MutexLock lock(Table::mutex);
-	_data = Table::table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->name == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = Table::allocator.alloc();
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->next = Table::table[idx];
-	_data->prev = nullptr;
-
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-	if (Table::table[idx]) {
-		Table::table[idx]->prev = _data;
-	}
-	Table::table[idx] = _data;
+	_data = Table::intern(p_name, String::hash(p_name), p_static);
 }
 
 StringName::StringName(const String &p_name, bool p_static) {
@@ -268,51 +429,7 @@ StringName::StringName(const String &p_name, bool p_static) {
 		return;
 	}
 
-	const uint32_t hash = p_name.hash();
-	const uint32_t idx = hash & Table::TABLE_MASK;
-
-	MutexLock lock(Table::mutex);
-	_data = Table::table[idx];
-
-	while (_data) {
-		if (_data->hash == hash && _data->name == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = Table::allocator.alloc();
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->next = Table::table[idx];
-	_data->prev = nullptr;
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-
-	if (Table::table[idx]) {
-		Table::table[idx]->prev = _data;
-	}
-	Table::table[idx] = _data;
+	_data = Table::intern(p_name, p_name.hash(), p_static);
 }
 
 bool operator==(const String &p_name, const StringName &p_string_name) {
@@ -45,12 +45,12 @@ class [[nodiscard]] StringName {
 		SafeNumeric<uint32_t> static_count;
 		String name;
 #ifdef DEBUG_ENABLED
-		uint32_t debug_references = 0;
+		SafeNumeric<uint32_t> debug_references;
 #endif
 
 		uint32_t hash = 0;
 		_Data *prev = nullptr;
-		_Data *next = nullptr;
+		std::atomic<_Data *> next = nullptr; // Read without locking by lookups.
 	};
 
 	_Data *_data = nullptr;
@@ -66,7 +66,7 @@ class [[nodiscard]] StringName {
 #ifdef DEBUG_ENABLED
 	struct DebugSortReferences {
 		bool operator()(const _Data *p_left, const _Data *p_right) const {
-			return p_left->debug_references > p_right->debug_references;
+			return p_left->debug_references.get() > p_right->debug_references.get();
 		}
 	};
 
@@ -0,0 +1,110 @@
+/**************************************************************************/
+/*  frame_arena.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_arena.h"
+
+SafeNumeric<uint64_t> FrameArena::current_frame;
+
+static thread_local FrameArena thread_arena;
+
+FrameArena &FrameArena::get_thread_arena() {
+	return thread_arena;
+}
+
+void FrameArena::advance_frame() {
+	current_frame.increment();
+}
+
+void *FrameArena::_alloc_slow(size_t p_bytes) {
+	// Move on to the next chunk big enough, allocating it if needed. Chunks after the current one
+	// are unused, so they can be reordered freely.
+	const uint32_t next_index = chunks.is_empty() ? 0 : chunk_index + 1;
+	uint32_t found = next_index;
+	while (found < chunks.size() && chunks[found].capacity < p_bytes) {
+		found++;
+	}
+	if (found == chunks.size()) {
+		Chunk chunk;
+		chunk.capacity = MAX(CHUNK_SIZE, p_bytes);
+		chunk.data = (uint8_t *)memalloc(chunk.capacity);
+		CRASH_COND_MSG(!chunk.data, "Out of memory");
+		chunks.push_back(chunk);
+		chunk_allocation_count++;
+	}
+	if (found != next_index) {
+		SWAP(chunks[found], chunks[next_index]);
+	}
+
+	chunk_index = next_index;
+	offset = p_bytes;
+	return chunks[chunk_index].data;
+}
+
+void *FrameArena::realloc(void *p_memory, size_t p_prev_bytes, size_t p_bytes) {
+	if (p_memory) {
+		_check_frame();
+		uint8_t *mem = (uint8_t *)p_memory;
+		if (chunk_index < chunks.size() && mem + p_prev_bytes == chunks[chunk_index].data + offset && mem + p_bytes <= chunks[chunk_index].data + chunks[chunk_index].capacity) {
+			offset = (mem - chunks[chunk_index].data) + p_bytes;
+			return p_memory;
+		}
+	}
+
+	void *new_memory = alloc(p_bytes);
+	if (p_memory) {
+		memcpy(new_memory, p_memory, MIN(p_prev_bytes, p_bytes));
+	}
+	return new_memory;
+}
+
+void FrameArena::rewind(const Marker &p_marker) {
+	DEV_ASSERT(p_marker.chunk_index < chunk_index || (p_marker.chunk_index == chunk_index && p_marker.offset <= offset));
+	chunk_index = p_marker.chunk_index;
+	offset = p_marker.offset;
+}
+
+void FrameArena::reset() {
+	chunk_index = 0;
+	offset = 0;
+}
+
+size_t FrameArena::get_used_bytes() const {
+	size_t used = offset;
+	for (uint32_t i = 0; i < chunk_index; i++) {
+		used += chunks[i].capacity;
+	}
+	return used;
+}
+
+FrameArena::~FrameArena() {
+	for (const Chunk &chunk : chunks) {
+		memfree(chunk.data);
+	}
+}
@@ -0,0 +1,174 @@
+/**************************************************************************/
+/*  frame_arena.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/memory.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+// Bump allocator for transient data that doesn't outlive the current frame.
+//
+// Every thread has its own arena (see get_thread_arena()), so allocating doesn't need
+// any synchronization. Memory is never freed individually. Instead, once a new frame
+// starts (see advance_frame(), called from Main::iteration()), each arena is reset as
+// a whole the next time its thread allocates from it, unless it is held.
+//
+// Scope holds the arena and gives back everything allocated within it when it ends,
+// which makes it usable from code that doesn't run in sync with frames (e.g. physics or
+// rendering on their own threads). WorkerThreadPool holds the arena of its threads while
+// they run a task, so tasks spanning a frame boundary aren't affected.
+//
+// The chunks backing an arena are kept across resets: once warmed up, allocating
+// from an arena doesn't touch the heap at all.
+//
+// WARNING: Containers using the arena must not be used after the frame (or Scope) they
+// were allocated in ended, and must not grow within a Scope they were created outside of.
+class FrameArena {
+public:
+	static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+	struct Marker {
+		uint32_t chunk_index = 0;
+		size_t offset = 0;
+	};
+
+private:
+	struct Chunk {
+		uint8_t *data = nullptr;
+		size_t capacity = 0;
+	};
+
+	static SafeNumeric<uint64_t> current_frame;
+
+	LocalVector<Chunk> chunks;
+	uint32_t chunk_index = 0;
+	size_t offset = 0;
+	uint64_t frame = 0;
+	uint32_t hold_count = 0;
+	uint64_t chunk_allocation_count = 0;
+
+	_FORCE_INLINE_ void _check_frame() {
+		if (unlikely(frame != current_frame.get()) && hold_count == 0) {
+			reset();
+			frame = current_frame.get();
+		}
+	}
+
+	void *_alloc_slow(size_t p_bytes);
+
+public:
+	static FrameArena &get_thread_arena();
+	static void advance_frame();
+
+	_FORCE_INLINE_ void *alloc(size_t p_bytes) {
+		_check_frame();
+		const size_t aligned_offset = Memory::get_aligned_address(offset, Memory::MAX_ALIGN);
+		if (likely(chunk_index < chunks.size() && aligned_offset + p_bytes <= chunks[chunk_index].capacity)) {
+			offset = aligned_offset + p_bytes;
+			return chunks[chunk_index].data + aligned_offset;
+		}
+		return _alloc_slow(p_bytes);
+	}
+	// Grows in place if p_memory is the last allocation. Nothing is freed.
+	void *realloc(void *p_memory, size_t p_prev_bytes, size_t p_bytes);
+
+	_FORCE_INLINE_ Marker get_marker() const { return { chunk_index, offset }; }
+	void rewind(const Marker &p_marker);
+	void reset();
+
+	// While held, the arena isn't reset when a new frame starts.
+	_FORCE_INLINE_ void hold() { hold_count++; }
+	_FORCE_INLINE_ void release() {
+		DEV_ASSERT(hold_count > 0);
+		hold_count--;
+	}
+
+	// Number of chunks ever allocated from the heap, and memory used in the current frame.
+	uint64_t get_chunk_allocation_count() const { return chunk_allocation_count; }
+	size_t get_used_bytes() const;
+
+	class Scope {
+		FrameArena &arena;
+		Marker marker;
+
+	public:
+		Scope() :
+				arena(get_thread_arena()) {
+			arena._check_frame();
+			arena.hold();
+			marker = arena.get_marker();
+		}
+		~Scope() {
+			arena.rewind(marker);
+			arena.release();
+		}
+	};
+
+	class Hold {
+		FrameArena &arena;
+
+	public:
+		Hold() :
+				arena(get_thread_arena()) {
+			arena._check_frame();
+			arena.hold();
+		}
+		~Hold() { arena.release(); }
+	};
+
+	FrameArena() = default;
+	~FrameArena();
+};
+
+// Allocation policy for LocalVector.
+class FrameArenaAllocator {
+public:
+	_FORCE_INLINE_ static void *realloc(void *p_memory, size_t p_prev_bytes, size_t p_bytes) { return FrameArena::get_thread_arena().realloc(p_memory, p_prev_bytes, p_bytes); }
+	_FORCE_INLINE_ static void free(void *p_memory) {}
+};
+
+// Allocator for the elements of HashMap and other containers taking a typed allocator.
+template <typename T>
+class FrameArenaTypedAllocator {
+	static_assert(alignof(T) <= Memory::MAX_ALIGN);
+
+public:
+	template <typename... Args>
+	_FORCE_INLINE_ T *new_allocation(const Args &&...p_args) { return memnew_placement(FrameArena::get_thread_arena().alloc(sizeof(T)), T(p_args...)); }
+	_FORCE_INLINE_ void delete_allocation(T *p_allocation) { p_allocation->~T(); }
+};
+
+template <typename T, typename U = uint32_t>
+using FrameLocalVector = LocalVector<T, U, false, false, FrameArenaAllocator>;
+
+template <typename TKey, typename TValue, typename Hasher = HashMapHasherDefault, typename Comparator = HashMapComparatorDefault<TKey>>
+using FrameHashMap = HashMap<TKey, TValue, Hasher, Comparator, FrameArenaTypedAllocator<HashMapElement<TKey, TValue>>>;
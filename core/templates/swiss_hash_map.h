@@ -0,0 +1,653 @@
+/**************************************************************************/
+/*  swiss_hash_map.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/math_funcs_binary.h"
+#include "core/os/memory.h"
+#include "core/string/print_string.h" // IWYU pragma: keep. `WARN_VERBOSE` macro.
+#include "core/templates/hashfuncs.h"
+#include "core/templates/pair.h"
+
+#include <initializer_list>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SWISS_HASH_MAP_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * A group of control bytes of a SwissHashMap, which are probed all at once.
+ * Each control byte is either EMPTY, DELETED, or holds the 7 upper bits of the
+ * hash of the element stored in the matching slot. The match functions return
+ * a bitmask with one bit (SSE2) or one byte (portable fallback) per slot, use
+ * `get_lowest_index()` to turn it into a slot index within the group.
+ */
+struct SwissHashMapGroup {
+	static constexpr int8_t EMPTY = -128; // 0b10000000
+	static constexpr int8_t DELETED = -2; // 0b11111110
+
+#ifdef SWISS_HASH_MAP_SSE2
+	static constexpr uint32_t WIDTH = 16;
+	static constexpr uint32_t MASK_SHIFT = 0;
+
+	__m128i ctrl;
+
+	_FORCE_INLINE_ explicit SwissHashMapGroup(const int8_t *p_ctrl) {
+		ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_ctrl));
+	}
+
+	_FORCE_INLINE_ uint64_t match(int8_t p_h2) const {
+		return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(p_h2), ctrl));
+	}
+
+	_FORCE_INLINE_ uint64_t match_empty() const {
+		return match(EMPTY);
+	}
+
+	_FORCE_INLINE_ uint64_t match_empty_or_deleted() const {
+		return (uint32_t)_mm_movemask_epi8(ctrl);
+	}
+#else
+	// Portable fallback, probes 8 control bytes at once in a 64-bit integer.
+	static constexpr uint32_t WIDTH = 8;
+	static constexpr uint32_t MASK_SHIFT = 3;
+	static constexpr uint64_t LSBS = 0x0101010101010101ULL;
+	static constexpr uint64_t MSBS = 0x8080808080808080ULL;
+
+	uint64_t ctrl;
+
+	_FORCE_INLINE_ explicit SwissHashMapGroup(const int8_t *p_ctrl) {
+		memcpy(&ctrl, p_ctrl, sizeof(ctrl));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+		ctrl = BSWAP64(ctrl);
+#endif
+	}
+
+	// May report false positives, but only for full slots following a real
+	// match. They are harmless because keys are always compared afterwards.
+	_FORCE_INLINE_ uint64_t match(int8_t p_h2) const {
+		const uint64_t x = ctrl ^ (LSBS * (uint8_t)p_h2);
+		return (x - LSBS) & ~x & MSBS;
+	}
+
+	_FORCE_INLINE_ uint64_t match_empty() const {
+		// EMPTY is the only value with the high bit set and the second lowest bit clear.
+		return ctrl & ~(ctrl << 6) & MSBS;
+	}
+
+	_FORCE_INLINE_ uint64_t match_empty_or_deleted() const {
+		return ctrl & MSBS;
+	}
+#endif // SWISS_HASH_MAP_SSE2
+
+	static _FORCE_INLINE_ uint32_t get_lowest_index(uint64_t p_mask) {
+#if defined(__GNUC__)
+		return (uint32_t)__builtin_ctzll(p_mask) >> MASK_SHIFT;
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+		unsigned long index;
+		_BitScanForward64(&index, p_mask);
+		return (uint32_t)index >> MASK_SHIFT;
+#else
+		uint32_t index = 0;
+		while (!(p_mask & 1)) {
+			p_mask >>= 1;
+			index++;
+		}
+		return index >> MASK_SHIFT;
+#endif
+	}
+};
+
+/**
+ * An open-addressing hash map in the style of "Swiss tables". Elements are
+ * stored inline in a flat slot array, next to an array of one-byte control
+ * values which is probed a whole group at a time (with SSE2 where available,
+ * otherwise with 64-bit integer tricks). Lookups compare keys only for the
+ * few slots whose control byte matches the hash, and misses usually end
+ * after a single group.
+ *
+ * It has the same API as HashMap for lookups, insertion, erasure and
+ * iteration, with these differences:
+ *   - Iteration follows slot order, not insertion order. Use HashMap when the
+ *     order matters (for example, when it ends up visible to users).
+ *   - Inserting may move all elements, invalidating pointers and iterators.
+ *     Erasing never moves elements, so it is fine to `remove()` the current
+ *     element while iterating.
+ *   - Like AHashMap, elements are relocated with memcpy() when growing, so
+ *     keys and values must not rely on their own address.
+ */
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class SwissHashMap {
+public:
+	// Must be a power of two and at least `SwissHashMapGroup::WIDTH`.
+	static constexpr uint32_t INITIAL_CAPACITY = 16;
+	static_assert(INITIAL_CAPACITY >= SwissHashMapGroup::WIDTH);
+
+private:
+	typedef KeyValue<TKey, TValue> MapKeyValue;
+
+	MapKeyValue *_slots = nullptr;
+	int8_t *_ctrl = nullptr;
+
+	// Power of two. When nothing is allocated yet, the capacity to allocate on the first insertion.
+	uint32_t _capacity = INITIAL_CAPACITY;
+	uint32_t _size = 0;
+	// How many EMPTY slots can still be filled before the load factor is exceeded.
+	uint32_t _growth_left = 0;
+
+	static _FORCE_INLINE_ int8_t _get_h2(uint32_t p_hash) {
+		// The lower bits pick the group, so the control byte uses the upper ones.
+		return (int8_t)(p_hash >> 25);
+	}
+
+	static _FORCE_INLINE_ uint32_t _get_max_load(uint32_t p_capacity) {
+		return p_capacity - p_capacity / 8; // 87.5%, leaves at least one EMPTY slot so probing always ends.
+	}
+
+	static uint32_t _get_capacity_for(uint32_t p_count) {
+		uint32_t capacity = MAX(INITIAL_CAPACITY, Math::next_power_of_2(p_count));
+		while (_get_max_load(capacity) < p_count) {
+			capacity *= 2;
+		}
+		return capacity;
+	}
+
+	bool _lookup_idx(const TKey &p_key, uint32_t p_hash, uint32_t &r_idx) const {
+		if (unlikely(_ctrl == nullptr)) {
+			return false; // Failed lookups, no elements.
+		}
+
+		const uint32_t group_mask = _capacity / SwissHashMapGroup::WIDTH - 1;
+		const int8_t h2 = _get_h2(p_hash);
+		uint32_t group = p_hash & group_mask;
+
+		// Triangular probing, visits every group once since the group count is a power of two.
+		for (uint32_t step = 1;; step++) {
+			const uint32_t base = group * SwissHashMapGroup::WIDTH;
+			const SwissHashMapGroup control(_ctrl + base);
+
+			for (uint64_t mask = control.match(h2); mask != 0; mask &= mask - 1) {
+				const uint32_t idx = base + SwissHashMapGroup::get_lowest_index(mask);
+				if (Comparator::compare(_slots[idx].key, p_key)) {
+					r_idx = idx;
+					return true;
+				}
+			}
+
+			if (control.match_empty() != 0) {
+				return false;
+			}
+
+			group = (group + step) & group_mask;
+		}
+	}
+
+	uint32_t _find_free_idx(uint32_t p_hash) const {
+		const uint32_t group_mask = _capacity / SwissHashMapGroup::WIDTH - 1;
+		uint32_t group = p_hash & group_mask;
+
+		for (uint32_t step = 1;; step++) {
+			const uint32_t base = group * SwissHashMapGroup::WIDTH;
+			const uint64_t mask = SwissHashMapGroup(_ctrl + base).match_empty_or_deleted();
+			if (mask != 0) {
+				return base + SwissHashMapGroup::get_lowest_index(mask);
+			}
+
+			group = (group + step) & group_mask;
+		}
+	}
+
+	void _allocate(uint32_t p_capacity) {
+		_capacity = p_capacity;
+		_ctrl = reinterpret_cast<int8_t *>(Memory::alloc_static(sizeof(int8_t) * _capacity));
+		_slots = reinterpret_cast<MapKeyValue *>(Memory::alloc_static(sizeof(MapKeyValue) * _capacity));
+		memset(_ctrl, SwissHashMapGroup::EMPTY, sizeof(int8_t) * _capacity);
+		_growth_left = _get_max_load(_capacity);
+	}
+
+	void _resize_and_rehash(uint32_t p_new_capacity) {
+		MapKeyValue *old_slots = _slots;
+		int8_t *old_ctrl = _ctrl;
+		const uint32_t old_capacity = _capacity;
+
+		_allocate(p_new_capacity);
+
+		for (uint32_t i = 0; i < old_capacity; i++) {
+			if (old_ctrl[i] < 0) {
+				continue;
+			}
+
+			const uint32_t hash = Hasher::hash(old_slots[i].key);
+			const uint32_t idx = _find_free_idx(hash);
+			_ctrl[idx] = _get_h2(hash);
+			memcpy((void *)&_slots[idx], (const void *)&old_slots[i], sizeof(MapKeyValue));
+		}
+		_growth_left -= _size;
+
+		Memory::free_static(old_slots);
+		Memory::free_static(old_ctrl);
+	}
+
+	uint32_t _insert_element(const TKey &p_key, const TValue &p_value, uint32_t p_hash) {
+		if (unlikely(_ctrl == nullptr)) {
+			// Allocate on demand to save memory.
+			_allocate(_capacity);
+		}
+
+		uint32_t idx = _find_free_idx(p_hash);
+		if (unlikely(_growth_left == 0 && _ctrl[idx] == SwissHashMapGroup::EMPTY)) {
+			// Out of EMPTY slots. Grow if the map is actually full, otherwise
+			// rehashing at the same capacity is enough to clear the DELETED ones.
+			_resize_and_rehash(_size >= _get_max_load(_capacity) / 2 ? _capacity * 2 : _capacity);
+			idx = _find_free_idx(p_hash);
+		}
+
+		if (_ctrl[idx] == SwissHashMapGroup::EMPTY) {
+			_growth_left--;
+		}
+		_ctrl[idx] = _get_h2(p_hash);
+		memnew_placement(&_slots[idx], MapKeyValue(p_key, p_value));
+		_size++;
+		return idx;
+	}
+
+	void _erase_idx(uint32_t p_idx) {
+		_slots[p_idx].key.~TKey();
+		_slots[p_idx].value.~TValue();
+
+		// A probe sequence only continues past full groups, so if the group
+		// still has an EMPTY slot, no lookup can depend on this one being full.
+		const uint32_t base = p_idx & ~(SwissHashMapGroup::WIDTH - 1);
+		if (SwissHashMapGroup(_ctrl + base).match_empty() != 0) {
+			_ctrl[p_idx] = SwissHashMapGroup::EMPTY;
+			_growth_left++;
+		} else {
+			_ctrl[p_idx] = SwissHashMapGroup::DELETED;
+		}
+		_size--;
+	}
+
+	void _init_from(const SwissHashMap &p_other) {
+		_capacity = p_other._capacity;
+		if (p_other._ctrl == nullptr) {
+			return;
+		}
+
+		_allocate(_capacity);
+		memcpy(_ctrl, p_other._ctrl, sizeof(int8_t) * _capacity);
+		for (uint32_t i = 0; i < _capacity; i++) {
+			if (_ctrl[i] >= 0) {
+				memnew_placement(&_slots[i], MapKeyValue(p_other._slots[i]));
+			}
+		}
+		_size = p_other._size;
+		_growth_left = p_other._growth_left;
+	}
+
+	void _destroy_elements() {
+		if constexpr (!(std::is_trivially_destructible_v<TKey> && std::is_trivially_destructible_v<TValue>)) {
+			for (uint32_t i = 0; i < _capacity; i++) {
+				if (_ctrl[i] >= 0) {
+					_slots[i].key.~TKey();
+					_slots[i].value.~TValue();
+				}
+			}
+		}
+	}
+
+public:
+	/* Standard Godot Container API */
+
+	_FORCE_INLINE_ uint32_t get_capacity() const { return _capacity; }
+	_FORCE_INLINE_ uint32_t size() const { return _size; }
+
+	_FORCE_INLINE_ bool is_empty() const {
+		return _size == 0;
+	}
+
+	void clear() {
+		if (_ctrl == nullptr || _size == 0) {
+			return;
+		}
+
+		_destroy_elements();
+		memset(_ctrl, SwissHashMapGroup::EMPTY, sizeof(int8_t) * _capacity);
+		_size = 0;
+		_growth_left = _get_max_load(_capacity);
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t idx = 0;
+		bool exists = _lookup_idx(p_key, Hasher::hash(p_key), idx);
+		CRASH_COND_MSG(!exists, "SwissHashMap key not found.");
+		return _slots[idx].value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t idx = 0;
+		bool exists = _lookup_idx(p_key, Hasher::hash(p_key), idx);
+		CRASH_COND_MSG(!exists, "SwissHashMap key not found.");
+		return _slots[idx].value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t idx = 0;
+		bool exists = _lookup_idx(p_key, Hasher::hash(p_key), idx);
+
+		if (exists) {
+			return &_slots[idx].value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t idx = 0;
+		bool exists = _lookup_idx(p_key, Hasher::hash(p_key), idx);
+
+		if (exists) {
+			return &_slots[idx].value;
+		}
+		return nullptr;
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		uint32_t idx = 0;
+		return _lookup_idx(p_key, Hasher::hash(p_key), idx);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t idx = 0;
+		bool exists = _lookup_idx(p_key, Hasher::hash(p_key), idx);
+
+		if (!exists) {
+			return false;
+		}
+
+		_erase_idx(idx);
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	// If adding a known (possibly large) number of elements at once, must be larger than old capacity.
+	void reserve(uint32_t p_new_capacity) {
+		const uint32_t new_capacity = _get_capacity_for(p_new_capacity);
+		if (_ctrl == nullptr) {
+			_capacity = new_capacity;
+			return; // Unallocated yet.
+		}
+
+		if (new_capacity <= _capacity) {
+			if (p_new_capacity < size()) {
+				WARN_VERBOSE("reserve() called with a capacity smaller than the current size. This is likely a mistake.");
+			}
+			return;
+		}
+
+		_resize_and_rehash(new_capacity);
+	}
+
+	/** Iterator API **/
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const MapKeyValue &operator*() const {
+			return slots[idx];
+		}
+		_FORCE_INLINE_ const MapKeyValue *operator->() const {
+			return &slots[idx];
+		}
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			do {
+				idx++;
+			} while (idx < capacity && ctrl[idx] < 0);
+			return *this;
+		}
+		_FORCE_INLINE_ ConstIterator &operator--() {
+			do {
+				idx--;
+			} while (idx < capacity && ctrl[idx] < 0);
+			if (idx > capacity) {
+				idx = capacity;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &b) const { return slots == b.slots && idx == b.idx; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &b) const { return slots != b.slots || idx != b.idx; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return idx < capacity;
+		}
+
+		_FORCE_INLINE_ ConstIterator(const MapKeyValue *p_slots, const int8_t *p_ctrl, uint32_t p_idx, uint32_t p_capacity) :
+				slots(p_slots), ctrl(p_ctrl), idx(p_idx), capacity(p_capacity) {}
+		_FORCE_INLINE_ ConstIterator() {}
+
+	private:
+		const MapKeyValue *slots = nullptr;
+		const int8_t *ctrl = nullptr;
+		uint32_t idx = 0;
+		uint32_t capacity = 0;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ MapKeyValue &operator*() const {
+			return slots[idx];
+		}
+		_FORCE_INLINE_ MapKeyValue *operator->() const {
+			return &slots[idx];
+		}
+		_FORCE_INLINE_ Iterator &operator++() {
+			do {
+				idx++;
+			} while (idx < capacity && ctrl[idx] < 0);
+			return *this;
+		}
+		_FORCE_INLINE_ Iterator &operator--() {
+			do {
+				idx--;
+			} while (idx < capacity && ctrl[idx] < 0);
+			if (idx > capacity) {
+				idx = capacity;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return slots == b.slots && idx == b.idx; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return slots != b.slots || idx != b.idx; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return idx < capacity;
+		}
+
+		_FORCE_INLINE_ Iterator(MapKeyValue *p_slots, const int8_t *p_ctrl, uint32_t p_idx, uint32_t p_capacity) :
+				slots(p_slots), ctrl(p_ctrl), idx(p_idx), capacity(p_capacity) {}
+		_FORCE_INLINE_ Iterator() {}
+
+		operator ConstIterator() const {
+			return ConstIterator(slots, ctrl, idx, capacity);
+		}
+
+	private:
+		MapKeyValue *slots = nullptr;
+		const int8_t *ctrl = nullptr;
+		uint32_t idx = 0;
+		uint32_t capacity = 0;
+	};
+
+	_FORCE_INLINE_ Iterator begin() {
+		Iterator it(_slots, _ctrl, UINT32_MAX, _ctrl ? _capacity : 0);
+		return ++it;
+	}
+	_FORCE_INLINE_ Iterator end() {
+		const uint32_t capacity = _ctrl ? _capacity : 0;
+		return Iterator(_slots, _ctrl, capacity, capacity);
+	}
+
+	Iterator find(const TKey &p_key) {
+		uint32_t idx = 0;
+		bool exists = _lookup_idx(p_key, Hasher::hash(p_key), idx);
+		if (!exists) {
+			return end();
+		}
+		return Iterator(_slots, _ctrl, idx, _capacity);
+	}
+
+	void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			_erase_idx(&*p_iter - _slots);
+		}
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		ConstIterator it(_slots, _ctrl, UINT32_MAX, _ctrl ? _capacity : 0);
+		return ++it;
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		const uint32_t capacity = _ctrl ? _capacity : 0;
+		return ConstIterator(_slots, _ctrl, capacity, capacity);
+	}
+
+	ConstIterator find(const TKey &p_key) const {
+		uint32_t idx = 0;
+		bool exists = _lookup_idx(p_key, Hasher::hash(p_key), idx);
+		if (!exists) {
+			return end();
+		}
+		return ConstIterator(_slots, _ctrl, idx, _capacity);
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		uint32_t idx = 0;
+		bool exists = _lookup_idx(p_key, Hasher::hash(p_key), idx);
+		CRASH_COND(!exists);
+		return _slots[idx].value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		uint32_t idx = 0;
+		uint32_t hash = Hasher::hash(p_key);
+		bool exists = _lookup_idx(p_key, hash, idx);
+
+		if (!exists) {
+			idx = _insert_element(p_key, TValue(), hash);
+		}
+		return _slots[idx].value;
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t idx = 0;
+		uint32_t hash = Hasher::hash(p_key);
+		bool exists = _lookup_idx(p_key, hash, idx);
+
+		if (!exists) {
+			idx = _insert_element(p_key, p_value, hash);
+		} else {
+			_slots[idx].value = p_value;
+		}
+		return Iterator(_slots, _ctrl, idx, _capacity);
+	}
+
+	// Inserts an element without checking if it already exists.
+	Iterator insert_new(const TKey &p_key, const TValue &p_value) {
+		DEV_ASSERT(!has(p_key));
+		uint32_t idx = _insert_element(p_key, p_value, Hasher::hash(p_key));
+		return Iterator(_slots, _ctrl, idx, _capacity);
+	}
+
+	/* Constructors */
+
+	SwissHashMap(SwissHashMap &&p_other) {
+		_slots = p_other._slots;
+		_ctrl = p_other._ctrl;
+		_capacity = p_other._capacity;
+		_size = p_other._size;
+		_growth_left = p_other._growth_left;
+
+		p_other._slots = nullptr;
+		p_other._ctrl = nullptr;
+		p_other._capacity = INITIAL_CAPACITY;
+		p_other._size = 0;
+		p_other._growth_left = 0;
+	}
+
+	explicit SwissHashMap(const SwissHashMap &p_other) {
+		_init_from(p_other);
+	}
+
+	void operator=(const SwissHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+
+		reset();
+		_init_from(p_other);
+	}
+
+	SwissHashMap(uint32_t p_initial_capacity) {
+		_capacity = _get_capacity_for(p_initial_capacity);
+	}
+
+	SwissHashMap() {}
+
+	SwissHashMap(std::initializer_list<KeyValue<TKey, TValue>> p_init) {
+		reserve(p_init.size());
+		for (const KeyValue<TKey, TValue> &E : p_init) {
+			insert(E.key, E.value);
+		}
+	}
+
+	void reset() {
+		if (_ctrl != nullptr) {
+			_destroy_elements();
+			Memory::free_static(_slots);
+			Memory::free_static(_ctrl);
+			_slots = nullptr;
+			_ctrl = nullptr;
+		}
+		_capacity = INITIAL_CAPACITY;
+		_size = 0;
+		_growth_left = 0;
+	}
+
+	~SwissHashMap() {
+		reset();
+	}
+};
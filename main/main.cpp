@@ -54,9 +54,11 @@
 #include "core/os/os.h"
 #include "core/os/process_id.h"
 #include "core/os/time.h"
+#include "core/profiling/frame_telemetry.h"
 #include "core/profiling/profiling.h"
 #include "core/register_core_types.h"
 #include "core/string/translation_server.h"
+#include "core/templates/frame_arena.h"
 #include "core/variant/variant_parser.h"
 #include "core/version.h"
 #include "drivers/register_driver_types.h"
@@ -284,6 +286,8 @@ static int fixed_fps = -1;
 static MovieWriter *movie_writer = nullptr;
 static bool disable_vsync = false;
 static bool print_fps = false;
+static String telemetry_path;
+static int telemetry_format = -1;
 #ifdef TOOLS_ENABLED
 static bool editor_pseudolocalization = false;
 static bool dump_gdextension_interface = false;
@@ -684,6 +688,8 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("--fixed-fps <fps>", "Force a fixed number of frames per second. This setting disables real-time synchronization.\n");
 	print_help_option("--delta-smoothing <enable>", "Enable or disable frame delta smoothing [\"enable\", \"disable\"].\n");
 	print_help_option("--print-fps", "Print the frames per second to the stdout.\n");
+	print_help_option("--telemetry <path>", "Stream per-frame subsystem timings to a file, or to a Unix domain socket with \"unix:<path>\".\n");
+	print_help_option("--telemetry-format <format>", "Frame telemetry output format [\"binary\", \"openmetrics\"].\n");
 #ifdef TOOLS_ENABLED
 	print_help_option("--editor-pseudolocalization", "Enable pseudolocalization for the editor and the project manager.\n", CLI_OPTION_AVAILABILITY_EDITOR);
 #endif
@@ -731,6 +737,7 @@ void Main::print_help(const char *p_binary) {
 #endif // TOOLS_ENABLED
 #ifdef TESTS_ENABLED
 	print_help_option("--test [--help]", "Run unit tests. Use --test --help for more information.\n");
+	print_help_option("--test --benchmark [--help]", "Run benchmarks. Use --test --benchmark --help for more information.\n");
 #endif // TESTS_ENABLED
 	OS::get_singleton()->print("\n");
 }
@@ -1971,6 +1978,30 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 			disable_vsync = true;
 		} else if (arg == "--print-fps") {
 			print_fps = true;
+		} else if (arg == "--telemetry") {
+			if (N) {
+				telemetry_path = N->get();
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing <path> argument for --telemetry <path>.\n");
+				goto error;
+			}
+		} else if (arg == "--telemetry-format") {
+			if (N) {
+				const String format = N->get().to_lower();
+				N = N->next();
+				if (format == "binary") {
+					telemetry_format = FrameTelemetry::FORMAT_BINARY;
+				} else if (format == "openmetrics") {
+					telemetry_format = FrameTelemetry::FORMAT_OPENMETRICS;
+				} else {
+					OS::get_singleton()->print("Unknown --telemetry-format argument \"%s\", aborting.\n", format.ascii().get_data());
+					goto error;
+				}
+			} else {
+				OS::get_singleton()->print("Missing --telemetry-format argument, aborting.\n");
+				goto error;
+			}
 #ifdef TOOLS_ENABLED
 		} else if (arg == "--editor-pseudolocalization") {
 			editor_pseudolocalization = true;
@@ -2315,6 +2346,10 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 	GLOBAL_DEF("debug/file_logging/log_path", "user://logs/godot.log");
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "debug/file_logging/max_log_files", PROPERTY_HINT_RANGE, "0,20,1,or_greater"), 5);
 
+	GLOBAL_DEF("debug/telemetry/output_path", "");
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "debug/telemetry/format", PROPERTY_HINT_ENUM, "Binary,OpenMetrics"), 0);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "debug/telemetry/flush_interval_msec", PROPERTY_HINT_RANGE, "1,10000,1,or_greater"), 1000);
+
 	// If `--log-file` is used to override the log path, allow creating logs for the project manager or editor
 	// and even if file logging is disabled in the Project Settings.
 	// `--log-file` can be used with any path (including absolute paths outside the project folder),
@@ -4509,6 +4544,11 @@ int Main::start() {
 					}
 				}
 
+#ifdef MODULE_GDSCRIPT_ENABLED
+				// Autoload constants must exist before scripts are compiled.
+				GDScriptLanguage::get_singleton()->preload_project_scripts();
+#endif // MODULE_GDSCRIPT_ENABLED
+
 				//second pass, load into global constants
 				List<Node *> to_add;
 				for (const KeyValue<StringName, ProjectSettings::AutoloadInfo> &E : autoloads) {
@@ -4881,6 +4921,17 @@ int Main::start() {
 	}
 #endif
 
+	// The project setting is ignored for the editor and project manager, like file logging.
+	if (telemetry_path.is_empty() && !editor && !project_manager) {
+		telemetry_path = GLOBAL_GET("debug/telemetry/output_path");
+	}
+	if (!telemetry_path.is_empty()) {
+		if (telemetry_format < 0) {
+			telemetry_format = GLOBAL_GET("debug/telemetry/format");
+		}
+		FrameTelemetry::start(telemetry_path, FrameTelemetry::Format(telemetry_format), GLOBAL_GET("debug/telemetry/flush_interval_msec"));
+	}
+
 	OS::get_singleton()->benchmark_end_measure("Startup", "Main::Start");
 	OS::get_singleton()->benchmark_dump();
 
@@ -4921,6 +4972,9 @@ bool Main::iteration() {
 	GodotProfileZoneGroupedFirst(_profile_zone, "prepare");
 	iterating++;
 
+	// Anything allocated from frame arenas during the previous iteration is now discarded.
+	FrameArena::advance_frame();
+
 	const uint64_t ticks = OS::get_singleton()->get_ticks_usec();
 	Engine::get_singleton()->_frame_ticks = ticks;
 	main_timer_sync.set_cpu_ticks_usec(ticks);
@@ -4983,6 +5037,8 @@ bool Main::iteration() {
 		GodotProfileZoneGrouped(_physics_zone, "main loop iteration prepare");
 		OS::get_singleton()->get_main_loop()->iteration_prepare();
 
+		uint64_t telemetry_begin = FrameTelemetry::begin();
+
 #ifndef PHYSICS_3D_DISABLED
 		GodotProfileZoneGrouped(_physics_zone, "PhysicsServer3D::sync");
 		PhysicsServer3D::get_singleton()->sync();
@@ -4995,8 +5051,13 @@ bool Main::iteration() {
 		PhysicsServer2D::get_singleton()->flush_queries();
 #endif // PHYSICS_2D_DISABLED
 
+		FrameTelemetry::end(FrameTelemetry::SUBSYSTEM_PHYSICS, telemetry_begin);
+		telemetry_begin = FrameTelemetry::begin();
+
 		GodotProfileZoneGrouped(_physics_zone, "physics_process");
-		if (OS::get_singleton()->get_main_loop()->physics_process(physics_step * time_scale)) {
+		const bool physics_process_exit = OS::get_singleton()->get_main_loop()->physics_process(physics_step * time_scale);
+		FrameTelemetry::end(FrameTelemetry::SUBSYSTEM_PHYSICS_PROCESS, telemetry_begin);
+		if (physics_process_exit) {
 #ifndef PHYSICS_3D_DISABLED
 			PhysicsServer3D::get_singleton()->end_sync();
 #endif // PHYSICS_3D_DISABLED
@@ -5023,10 +5084,15 @@ bool Main::iteration() {
 
 		navigation_process_ticks = MAX(navigation_process_ticks, OS::get_singleton()->get_ticks_usec() - navigation_begin); // keep the largest one for reference
 		navigation_process_max = MAX(OS::get_singleton()->get_ticks_usec() - navigation_begin, navigation_process_max);
+		if (FrameTelemetry::is_enabled()) {
+			FrameTelemetry::add_time(FrameTelemetry::SUBSYSTEM_NAVIGATION, OS::get_singleton()->get_ticks_usec() - navigation_begin);
+		}
 
 		message_queue->flush();
 #endif // !defined(NAVIGATION_2D_DISABLED) || !defined(NAVIGATION_3D_DISABLED)
 
+		telemetry_begin = FrameTelemetry::begin();
+
 #ifndef PHYSICS_3D_DISABLED
 		GodotProfileZoneGrouped(_profile_zone, "3D physics");
 		PhysicsServer3D::get_singleton()->end_sync();
@@ -5039,6 +5105,8 @@ bool Main::iteration() {
 		PhysicsServer2D::get_singleton()->step(physics_step * time_scale);
 #endif // PHYSICS_2D_DISABLED
 
+		FrameTelemetry::end(FrameTelemetry::SUBSYSTEM_PHYSICS, telemetry_begin);
+
 		message_queue->flush();
 
 		GodotProfileZoneGrouped(_profile_zone, "main loop iteration end");
@@ -5057,11 +5125,16 @@ bool Main::iteration() {
 	uint64_t process_begin = OS::get_singleton()->get_ticks_usec();
 
 	GodotProfileZoneGrouped(_profile_zone, "process");
+	uint64_t telemetry_begin = FrameTelemetry::begin();
 	if (OS::get_singleton()->get_main_loop()->process(process_step * time_scale)) {
 		exit = true;
 	}
+	FrameTelemetry::end(FrameTelemetry::SUBSYSTEM_PROCESS, telemetry_begin);
 	message_queue->flush();
 
+#if !defined(NAVIGATION_2D_DISABLED) || !defined(NAVIGATION_3D_DISABLED)
+	telemetry_begin = FrameTelemetry::begin();
+#endif // !defined(NAVIGATION_2D_DISABLED) || !defined(NAVIGATION_3D_DISABLED)
 #ifndef NAVIGATION_2D_DISABLED
 	GodotProfileZoneGrouped(_profile_zone, "process 2D navigation");
 	NavigationServer2D::get_singleton()->process(process_step * time_scale);
@@ -5070,6 +5143,9 @@ bool Main::iteration() {
 	GodotProfileZoneGrouped(_profile_zone, "process 3D navigation");
 	NavigationServer3D::get_singleton()->process(process_step * time_scale);
 #endif // NAVIGATION_3D_DISABLED
+#if !defined(NAVIGATION_2D_DISABLED) || !defined(NAVIGATION_3D_DISABLED)
+	FrameTelemetry::end(FrameTelemetry::SUBSYSTEM_NAVIGATION, telemetry_begin);
+#endif // !defined(NAVIGATION_2D_DISABLED) || !defined(NAVIGATION_3D_DISABLED)
 
 	GodotProfileZoneGrouped(_profile_zone, "RenderingServer::sync");
 	RenderingServer::get_singleton()->sync(); //sync if still drawing from previous frames.
@@ -5113,6 +5189,8 @@ bool Main::iteration() {
 		EngineDebugger::get_singleton()->iteration(frame_time, process_ticks, physics_process_ticks, physics_step);
 	}
 
+	FrameTelemetry::end_frame(OS::get_singleton()->get_ticks_usec() - ticks);
+
 	frames++;
 	Engine::get_singleton()->_process_frames++;
 
@@ -5218,6 +5296,8 @@ void Main::cleanup(bool p_force) {
 		ERR_FAIL_COND(!_start_success);
 	}
 
+	FrameTelemetry::stop();
+
 	// Printing in the usual way can become problematic during/after cleanup.
 	CoreGlobals::print_ready = false;
 
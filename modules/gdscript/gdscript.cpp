@@ -31,6 +31,7 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_binary_bytecode.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
@@ -54,6 +55,7 @@
 #include "core/config/project_settings.h"
 #include "core/core_constants.h"
 #include "core/io/file_access.h"
+#include "core/os/os.h"
 #include "scene/resources/packed_scene.h"
 #include "scene/scene_string_names.h"
 
@@ -772,6 +774,8 @@ Error GDScript::reload(bool p_keep_state) {
 	}
 #endif
 
+	// Parsed and analyzed ahead of time by `GDScriptCache::preload_scripts()`, if any.
+	Ref<GDScriptParserRef> preloaded_parser;
 	{
 		String source_path = path;
 		if (source_path.is_empty()) {
@@ -782,21 +786,22 @@ Error GDScript::reload(bool p_keep_state) {
 				MutexLock lock(GDScriptCache::singleton->mutex);
 				GDScriptCache::singleton->shallow_gdscript_cache[source_path] = Ref<GDScript>(this);
 			}
+			uint32_t source_hash;
+			if (!binary_tokens.is_empty()) {
+				source_hash = hash_djb2_buffer(binary_tokens.ptr(), binary_tokens.size());
+			} else {
+				source_hash = source.hash();
+			}
 			if (GDScriptCache::has_parser(source_path)) {
 				Error err = OK;
 				Ref<GDScriptParserRef> parser_ref = GDScriptCache::get_parser(source_path, GDScriptParserRef::EMPTY, err);
 				if (parser_ref.is_valid()) {
-					uint32_t source_hash;
-					if (!binary_tokens.is_empty()) {
-						source_hash = hash_djb2_buffer(binary_tokens.ptr(), binary_tokens.size());
-					} else {
-						source_hash = source.hash();
-					}
 					if (parser_ref->get_source_hash() != source_hash) {
 						GDScriptCache::remove_parser(source_path);
 					}
 				}
 			}
+			preloaded_parser = GDScriptCache::take_preloaded_parser(source_path, source_hash);
 		}
 	}
 
@@ -809,38 +814,60 @@ Error GDScript::reload(bool p_keep_state) {
 #endif
 
 	valid = false;
-	GDScriptParser parser;
-	Error err;
-	if (!binary_tokens.is_empty()) {
-		err = parser.parse_binary(binary_tokens, path);
-	} else {
-		err = parser.parse(source, path, false);
-	}
-	if (err) {
-		if (EngineDebugger::is_active()) {
-			GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser.get_errors().front()->get().start_line, "Parser Error: " + parser.get_errors().front()->get().message);
+
+	// Exported compiled bytecode skips parsing and compiling, but only for scripts that were never compiled.
+	if (!compiled_bytecode.is_empty()) {
+		if (instances.first() == nullptr && member_functions.is_empty() && GDScriptBinaryBytecode::load(this, compiled_bytecode) == OK) {
+			can_run = ScriptServer::is_scripting_enabled() || is_tool();
+			if (can_run) {
+				Error err = _static_init();
+				if (err) {
+					return err;
+				}
+			}
+			reloading = false;
+			return OK;
 		}
-		// TODO: Show all error messages.
-		_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), parser.get_errors().front()->get().start_line, ("Parse Error: " + parser.get_errors().front()->get().message).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
-		reloading = false;
-		return ERR_PARSE_ERROR;
+		print_verbose(vformat("GDScript: Compiled bytecode of \"%s\" could not be loaded, compiling from binary tokens.", path));
+		compiled_bytecode.clear();
+		valid = false;
 	}
 
-	GDScriptAnalyzer analyzer(&parser);
-	err = analyzer.analyze();
-
-	if (err) {
-		if (EngineDebugger::is_active()) {
-			GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser.get_errors().front()->get().start_line, "Parser Error: " + parser.get_errors().front()->get().message);
+	GDScriptParser local_parser;
+	GDScriptParser &parser = preloaded_parser.is_valid() ? *preloaded_parser->get_parser() : local_parser;
+	Error err = OK;
+	if (preloaded_parser.is_null()) {
+		if (!binary_tokens.is_empty()) {
+			err = parser.parse_binary(binary_tokens, path);
+		} else {
+			err = parser.parse(source, path, false);
 		}
+		if (err) {
+			if (EngineDebugger::is_active()) {
+				GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser.get_errors().front()->get().start_line, "Parser Error: " + parser.get_errors().front()->get().message);
+			}
+			// TODO: Show all error messages.
+			_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), parser.get_errors().front()->get().start_line, ("Parse Error: " + parser.get_errors().front()->get().message).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
+			reloading = false;
+			return ERR_PARSE_ERROR;
+		}
+
+		GDScriptAnalyzer analyzer(&parser);
+		err = analyzer.analyze();
 
-		const List<GDScriptParser::ParserError>::Element *e = parser.get_errors().front();
-		while (e != nullptr) {
-			_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), e->get().start_line, ("Parse Error: " + e->get().message).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
-			e = e->next();
+		if (err) {
+			if (EngineDebugger::is_active()) {
+				GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser.get_errors().front()->get().start_line, "Parser Error: " + parser.get_errors().front()->get().message);
+			}
+
+			const List<GDScriptParser::ParserError>::Element *e = parser.get_errors().front();
+			while (e != nullptr) {
+				_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), e->get().start_line, ("Parse Error: " + e->get().message).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
+				e = e->next();
+			}
+			reloading = false;
+			return ERR_PARSE_ERROR;
 		}
-		reloading = false;
-		return ERR_PARSE_ERROR;
 	}
 
 	can_run = ScriptServer::is_scripting_enabled() || parser.is_tool();
@@ -1170,6 +1197,14 @@ const Vector<uint8_t> &GDScript::get_binary_tokens_source() const {
 	return binary_tokens;
 }
 
+void GDScript::set_compiled_bytecode_source(const Vector<uint8_t> &p_compiled_bytecode) {
+	compiled_bytecode = p_compiled_bytecode;
+}
+
+const Vector<uint8_t> &GDScript::get_compiled_bytecode_source() const {
+	return compiled_bytecode;
+}
+
 Vector<uint8_t> GDScript::get_as_binary_tokens() const {
 	GDScriptTokenizerBuffer tokenizer;
 	return tokenizer.parse_code_string(source, GDScriptTokenizerBuffer::COMPRESS_NONE);
@@ -1430,6 +1465,7 @@ void GDScript::clear() {
 		return;
 	}
 	clearing = true;
+	GDScriptFunction::invalidate_inline_caches();
 
 	RBSet<GDScriptFunction *> functions_to_clear;
 
@@ -1510,6 +1546,8 @@ GDScript::~GDScript() {
 		return;
 	}
 	destructing = true;
+	// The address of this script may be reused by another one.
+	GDScriptFunction::invalidate_inline_caches();
 
 	if (is_print_verbose_enabled()) {
 		MutexLock lock(func_ptrs_to_update_mutex);
@@ -2190,11 +2228,45 @@ void GDScriptLanguage::init() {
 	}
 #endif // DEBUG_ENABLED
 
+	if (sampling_profiler) {
+		GDScriptSamplingProfiler::start(sampling_profiler_interval_usec);
+	}
+
+	// Not in the editor, where scripts are edited and their native code would be outdated anyway.
+	if (!aot_library_path.is_empty() && !Engine::get_singleton()->is_editor_hint()) {
+		GDScriptAOT::load_library(aot_library_path);
+	}
+
 #ifdef TESTS_ENABLED
 	GDScriptTests::GDScriptTestRunner::handle_cmdline();
 #endif // TESTS_ENABLED
 }
 
+void GDScriptLanguage::preload_project_scripts() {
+	if (!parallel_preload) {
+		return;
+	}
+
+	// Global classes and autoloads are the roots, the cache follows their dependencies.
+	Vector<String> paths;
+	LocalVector<StringName> global_classes;
+	ScriptServer::get_global_class_list(global_classes);
+	for (const StringName &class_name : global_classes) {
+		if (ScriptServer::get_global_class_language(class_name) == get_name()) {
+			paths.push_back(ScriptServer::get_global_class_path(class_name));
+		}
+	}
+	for (const KeyValue<StringName, ProjectSettings::AutoloadInfo> &E : ProjectSettings::get_singleton()->get_autoload_list()) {
+		if (E.value.path.has_extension("gd")) {
+			paths.push_back(E.value.path);
+		}
+	}
+
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	GDScriptCache::preload_scripts(paths);
+	print_verbose(vformat("GDScript: Preloaded project scripts in %.1f ms.", (OS::get_singleton()->get_ticks_usec() - begin) / 1000.0));
+}
+
 #ifdef TOOLS_ENABLED
 void GDScriptLanguage::_extension_loaded(const Ref<GDExtension> &p_extension) {
 	List<StringName> class_list;
@@ -2231,6 +2303,13 @@ void GDScriptLanguage::finish() {
 	}
 	finishing = true;
 
+	if (GDScriptSamplingProfiler::is_running()) {
+		GDScriptSamplingProfiler::stop();
+		print_verbose(vformat("GDScript sampling profiler: %d samples, %d usec spent sampling.", GDScriptSamplingProfiler::get_sample_count(), GDScriptSamplingProfiler::get_sampling_usec()));
+		GDScriptSamplingProfiler::save_folded_stacks(sampling_profiler_output_path);
+		GDScriptSamplingProfiler::clear();
+	}
+
 	// Clear the cache before parsing the script_list
 	GDScriptCache::clear();
 
@@ -2264,6 +2343,8 @@ void GDScriptLanguage::finish() {
 	}
 	script_list.clear();
 	function_list.clear();
+	GDScriptFunction::_clear_frame_pool();
+	GDScriptAOT::unload_library();
 
 	finishing = false;
 }
@@ -2870,6 +2951,12 @@ GDScriptLanguage::GDScriptLanguage() {
 	_debug_max_call_stack = GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "debug/settings/gdscript/max_call_stack", PROPERTY_HINT_RANGE, "512," + itos(GDScriptFunction::MAX_CALL_DEPTH - 1) + ",1"), 1024);
 	track_call_stack = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_call_stacks", false);
 	track_locals = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_local_variables", false);
+	optimize_bytecode = GLOBAL_DEF_RST("debug/settings/gdscript/optimize_bytecode", false);
+	parallel_preload = GLOBAL_DEF_RST("debug/settings/gdscript/parallel_preload", false);
+	sampling_profiler = GLOBAL_DEF_RST("debug/settings/gdscript/sampling_profiler", false);
+	sampling_profiler_interval_usec = GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "debug/settings/gdscript/sampling_profiler_interval_usec", PROPERTY_HINT_RANGE, "100,100000,1"), GDScriptSamplingProfiler::DEFAULT_INTERVAL_USEC);
+	sampling_profiler_output_path = GLOBAL_DEF_RST(PropertyInfo(Variant::STRING, "debug/settings/gdscript/sampling_profiler_output_path", PROPERTY_HINT_SAVE_FILE, "*.folded"), "user://gdscript_samples.folded");
+	aot_library_path = GLOBAL_DEF_RST(PropertyInfo(Variant::STRING, "debug/settings/gdscript/aot_library_path", PROPERTY_HINT_GLOBAL_FILE, "*.so,*.dll,*.dylib"), "");
 
 #ifdef DEBUG_ENABLED
 	track_call_stack = true;
@@ -31,6 +31,7 @@
 #pragma once
 
 #include "gdscript_function.h"
+#include "gdscript_sampling_profiler.h"
 
 #include "core/debugger/engine_debugger.h"
 #include "core/debugger/script_debugger.h"
@@ -87,6 +88,7 @@ class GDScript : public Script {
 	friend class GDScriptLambdaCallable;
 	friend class GDScriptLambdaSelfCallable;
 	friend class GDScriptLanguage;
+	friend class GDScriptBinaryBytecode;
 	friend struct GDScriptUtilityFunctionsDefinitions;
 
 	Ref<GDScriptNativeClass> native;
@@ -178,6 +180,7 @@ private:
 	//exported members
 	String source;
 	Vector<uint8_t> binary_tokens;
+	Vector<uint8_t> compiled_bytecode;
 	String path;
 	bool path_valid = false; // False if using default path.
 	StringName local_name; // Inner class identifier or `class_name`.
@@ -306,6 +309,8 @@ public:
 
 	void set_binary_tokens_source(const Vector<uint8_t> &p_binary_tokens);
 	const Vector<uint8_t> &get_binary_tokens_source() const;
+	void set_compiled_bytecode_source(const Vector<uint8_t> &p_compiled_bytecode);
+	const Vector<uint8_t> &get_compiled_bytecode_source() const;
 	Vector<uint8_t> get_as_binary_tokens() const;
 
 	bool get_property_default_value(const StringName &p_property, Variant &r_value) const override;
@@ -366,6 +371,20 @@ class GDScriptInstance : public ScriptInstance {
 	// Replacing `SelfList` with a better implementation could save 16bytes from the self and list pointer.
 	SelfList<GDScriptInstance> script_instance_list; // Linked list of instances with the same script.
 
+	// Nodes found by `$Path` sites in this instance's functions, keyed by function and
+	// instruction. An entry is valid while the epoch and the owner's subtree version match.
+	struct NodeCacheEntry {
+		const GDScriptFunction *function = nullptr;
+		int ip = -1;
+		uint32_t epoch = 0;
+		uint64_t subtree_version = 0;
+		Object *node = nullptr;
+	};
+
+	static constexpr uint32_t NODE_CACHE_MAX_ENTRIES = 32;
+
+	LocalVector<NodeCacheEntry> node_cache;
+
 	void _call_implicit_ready_recursively(GDScript *p_script);
 
 public:
@@ -409,6 +428,7 @@ public:
 
 class GDScriptLanguage : public ScriptLanguage {
 	friend class GDScriptFunctionState;
+	friend class GDScriptSamplingProfiler;
 
 	static GDScriptLanguage *singleton;
 
@@ -439,6 +459,12 @@ class GDScriptLanguage : public ScriptLanguage {
 
 	bool track_call_stack = false;
 	bool track_locals = false;
+	bool optimize_bytecode = false;
+	bool parallel_preload = false;
+	bool sampling_profiler = false;
+	uint32_t sampling_profiler_interval_usec = GDScriptSamplingProfiler::DEFAULT_INTERVAL_USEC;
+	String sampling_profiler_output_path;
+	String aot_library_path;
 
 	static CallLevel *_get_stack_level(uint32_t p_level);
 
@@ -506,6 +532,10 @@ public:
 		call_level->ip = p_ip;
 		call_level->line = p_line;
 		_call_stack_size++;
+
+		if (call_level->prev == nullptr) {
+			GDScriptSamplingProfiler::sync_thread();
+		}
 	}
 
 	_FORCE_INLINE_ void exit_function() {
@@ -571,6 +601,10 @@ public:
 
 	_FORCE_INLINE_ bool should_track_call_stack() const { return track_call_stack; }
 	_FORCE_INLINE_ bool should_track_locals() const { return track_locals; }
+	_FORCE_INLINE_ bool should_optimize_bytecode() const { return optimize_bytecode; }
+	void set_optimize_bytecode(bool p_enable) { optimize_bytecode = p_enable; }
+
+	void preload_project_scripts();
 	_FORCE_INLINE_ int get_global_array_size() const { return global_array.size(); }
 	_FORCE_INLINE_ Variant *get_global_array() { return _global_array; }
 	_FORCE_INLINE_ const HashMap<StringName, int> &get_global_map() const { return globals; }
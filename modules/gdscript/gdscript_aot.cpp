@@ -0,0 +1,1100 @@
+/**************************************************************************/
+/*  gdscript_aot.cpp                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_aot.h"
+
+#include "gdscript.h"
+#include "gdscript_cache.h"
+#include "gdscript_parser.h"
+
+#include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+
+#ifdef TOOLS_ENABLED
+#include "scene/main/scene_tree.h"
+#endif
+
+enum AOTType {
+	AOT_NONE,
+	AOT_BOOL,
+	AOT_INT,
+	AOT_FLOAT,
+};
+
+static constexpr int AOT_MAX_ARGUMENTS = 16;
+
+static AOTType _aot_type(const GDScriptParser::DataType &p_type) {
+	if (!p_type.is_hard_type() || p_type.kind != GDScriptParser::DataType::BUILTIN) {
+		return AOT_NONE;
+	}
+	switch (p_type.builtin_type) {
+		case Variant::BOOL:
+			return AOT_BOOL;
+		case Variant::INT:
+			return AOT_INT;
+		case Variant::FLOAT:
+			return AOT_FLOAT;
+		default:
+			return AOT_NONE;
+	}
+}
+
+static const char *_aot_c_type(AOTType p_type) {
+	switch (p_type) {
+		case AOT_BOOL:
+			return "bool";
+		case AOT_INT:
+			return "int64_t";
+		case AOT_FLOAT:
+			return "double";
+		default:
+			return "void";
+	}
+}
+
+static const char *_aot_value_field(AOTType p_type) {
+	switch (p_type) {
+		case AOT_BOOL:
+			return "b";
+		case AOT_INT:
+			return "i";
+		default:
+			return "f";
+	}
+}
+
+// Variant utility functions with a direct C++ equivalent of the same semantics.
+struct AOTUtility {
+	const char *name;
+	const char *function;
+	AOTType return_type;
+	int argument_count;
+	AOTType argument_types[3];
+};
+
+static const AOTUtility aot_utilities[] = {
+	{ "sin", "std::sin", AOT_FLOAT, 1, { AOT_FLOAT } },
+	{ "cos", "std::cos", AOT_FLOAT, 1, { AOT_FLOAT } },
+	{ "tan", "std::tan", AOT_FLOAT, 1, { AOT_FLOAT } },
+	{ "atan", "std::atan", AOT_FLOAT, 1, { AOT_FLOAT } },
+	{ "atan2", "std::atan2", AOT_FLOAT, 2, { AOT_FLOAT, AOT_FLOAT } },
+	{ "sqrt", "std::sqrt", AOT_FLOAT, 1, { AOT_FLOAT } },
+	{ "pow", "std::pow", AOT_FLOAT, 2, { AOT_FLOAT, AOT_FLOAT } },
+	{ "exp", "std::exp", AOT_FLOAT, 1, { AOT_FLOAT } },
+	{ "log", "std::log", AOT_FLOAT, 1, { AOT_FLOAT } },
+	{ "fmod", "std::fmod", AOT_FLOAT, 2, { AOT_FLOAT, AOT_FLOAT } },
+	{ "floorf", "std::floor", AOT_FLOAT, 1, { AOT_FLOAT } },
+	{ "ceilf", "std::ceil", AOT_FLOAT, 1, { AOT_FLOAT } },
+	{ "roundf", "std::round", AOT_FLOAT, 1, { AOT_FLOAT } },
+	{ "absf", "std::fabs", AOT_FLOAT, 1, { AOT_FLOAT } },
+	{ "absi", "gdaot_absi", AOT_INT, 1, { AOT_INT } },
+	{ "minf", "gdaot_min<double>", AOT_FLOAT, 2, { AOT_FLOAT, AOT_FLOAT } },
+	{ "maxf", "gdaot_max<double>", AOT_FLOAT, 2, { AOT_FLOAT, AOT_FLOAT } },
+	{ "mini", "gdaot_min<int64_t>", AOT_INT, 2, { AOT_INT, AOT_INT } },
+	{ "maxi", "gdaot_max<int64_t>", AOT_INT, 2, { AOT_INT, AOT_INT } },
+	{ "clampf", "gdaot_clamp<double>", AOT_FLOAT, 3, { AOT_FLOAT, AOT_FLOAT, AOT_FLOAT } },
+	{ "clampi", "gdaot_clamp<int64_t>", AOT_INT, 3, { AOT_INT, AOT_INT, AOT_INT } },
+};
+
+// Declarations shared by every generated file, must match `GDScriptAOTABI`.
+static const char *aot_preamble = R"(#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_WIN32)
+#define GDAOT_EXPORT __declspec(dllexport)
+#else
+#define GDAOT_EXPORT __attribute__((visibility("default")))
+#endif
+
+union GDScriptAOTValue {
+	int64_t i;
+	double f;
+	uint8_t b;
+};
+
+struct GDScriptAOTContext {
+	int32_t error;
+	int32_t depth;
+};
+
+typedef void (*GDScriptAOTCall)(const GDScriptAOTValue *p_args, GDScriptAOTValue *r_return, GDScriptAOTContext *p_context);
+
+struct GDScriptAOTFunction {
+	const char *name;
+	GDScriptAOTCall call;
+};
+
+struct GDScriptAOTScript {
+	const char *path;
+	uint64_t hash;
+	uint32_t function_count;
+	const GDScriptAOTFunction *functions;
+};
+
+struct GDScriptAOTLibrary {
+	uint32_t version;
+	uint32_t script_count;
+	const GDScriptAOTScript *scripts;
+};
+
+// Anything the VM would report as an error (or handles in a way that isn't replicated here)
+// sets the context error, and the call is run again on the VM. Translated functions have no
+// side effects, so that is always safe.
+#define GDAOT_MAX_DEPTH 1024
+#define GDAOT_FAIL() \
+	{ \
+		p_context->error = 1; \
+		return 0; \
+	}
+#define GDAOT_CHECK() \
+	if (p_context->error != 0) { \
+		return 0; \
+	}
+
+struct GDScriptAOTDepth {
+	GDScriptAOTContext *context;
+	explicit GDScriptAOTDepth(GDScriptAOTContext *p_context) :
+			context(p_context) { context->depth++; }
+	~GDScriptAOTDepth() { context->depth--; }
+};
+
+#define GDAOT_ENTER() \
+	GDScriptAOTDepth gdaot_depth(p_context); \
+	if (p_context->depth > GDAOT_MAX_DEPTH) { \
+		GDAOT_FAIL(); \
+	}
+
+static inline double gdaot_f64(uint64_t p_bits) {
+	double value;
+	memcpy(&value, &p_bits, sizeof(value));
+	return value;
+}
+
+// Integer arithmetic wraps around like in the VM.
+static inline int64_t gdaot_add(int64_t a, int64_t b) { return (int64_t)((uint64_t)a + (uint64_t)b); }
+static inline int64_t gdaot_sub(int64_t a, int64_t b) { return (int64_t)((uint64_t)a - (uint64_t)b); }
+static inline int64_t gdaot_mul(int64_t a, int64_t b) { return (int64_t)((uint64_t)a * (uint64_t)b); }
+static inline int64_t gdaot_neg(int64_t a) { return (int64_t)(0 - (uint64_t)a); }
+static inline int64_t gdaot_absi(int64_t a) { return a < 0 ? gdaot_neg(a) : a; }
+
+static inline int64_t gdaot_div(GDScriptAOTContext *p_context, int64_t a, int64_t b) {
+	if (b == 0 || (b == -1 && a == INT64_MIN)) {
+		GDAOT_FAIL();
+	}
+	return a / b;
+}
+
+static inline int64_t gdaot_mod(GDScriptAOTContext *p_context, int64_t a, int64_t b) {
+	if (b == 0 || (b == -1 && a == INT64_MIN)) {
+		GDAOT_FAIL();
+	}
+	return a % b;
+}
+
+static inline int64_t gdaot_shl(GDScriptAOTContext *p_context, int64_t a, int64_t b) {
+	if (a < 0 || b < 0 || b > 63) {
+		GDAOT_FAIL();
+	}
+	return (int64_t)((uint64_t)a << b);
+}
+
+static inline int64_t gdaot_shr(GDScriptAOTContext *p_context, int64_t a, int64_t b) {
+	if (a < 0 || b < 0 || b > 63) {
+		GDAOT_FAIL();
+	}
+	return a >> b;
+}
+
+template <typename T>
+static inline T gdaot_min(T a, T b) { return a < b ? a : b; }
+template <typename T>
+static inline T gdaot_max(T a, T b) { return a > b ? a : b; }
+template <typename T>
+static inline T gdaot_clamp(T v, T lo, T hi) { return v < lo ? lo : (v > hi ? hi : v); }
+)";
+
+// Lowers one function. Fails (leaving it to the VM) on anything outside the supported subset.
+class GDScriptAOTFunctionTranslator {
+	const GDScriptParser::FunctionNode *function = nullptr;
+	const HashMap<StringName, const GDScriptParser::FunctionNode *> *callable = nullptr;
+
+	String code;
+	String error;
+	int indent = 1;
+	int loop_depth = 0;
+
+	bool _fail(const String &p_error) {
+		if (error.is_empty()) {
+			error = p_error;
+		}
+		return false;
+	}
+
+	void _line(const String &p_line) {
+		code += String("\t").repeat(indent) + p_line + "\n";
+	}
+
+	static bool _is_valid_name(const StringName &p_name) {
+		return String(p_name).is_valid_ascii_identifier();
+	}
+
+	static String _local(const StringName &p_name) {
+		return "v_" + String(p_name);
+	}
+
+	bool _convert(String &r_code, AOTType p_from, AOTType p_to) {
+		if (p_from == p_to) {
+			return true;
+		}
+		if (p_from == AOT_INT && p_to == AOT_FLOAT) {
+			r_code = "double(" + r_code + ")";
+			return true;
+		}
+		return _fail("Unsupported implicit conversion.");
+	}
+
+	static String _truthy(const String &p_code, AOTType p_type) {
+		switch (p_type) {
+			case AOT_INT:
+				return "(" + p_code + " != 0)";
+			case AOT_FLOAT:
+				return "(" + p_code + " != 0.0)";
+			default:
+				return p_code;
+		}
+	}
+
+	bool _literal(const Variant &p_value, String &r_code, AOTType &r_type) {
+		switch (p_value.get_type()) {
+			case Variant::BOOL:
+				r_code = bool(p_value) ? "true" : "false";
+				r_type = AOT_BOOL;
+				return true;
+			case Variant::INT: {
+				const int64_t value = p_value;
+				if (value == INT64_MIN) {
+					r_code = "INT64_MIN";
+				} else if (value < 0) {
+					r_code = "(-INT64_C(" + itos(-value) + "))";
+				} else {
+					r_code = "INT64_C(" + itos(value) + ")";
+				}
+				r_type = AOT_INT;
+				return true;
+			}
+			case Variant::FLOAT: {
+				// Bit pattern, so the value is exactly the same as in the VM.
+				const double value = p_value;
+				uint64_t bits;
+				memcpy(&bits, &value, sizeof(bits));
+				r_code = "gdaot_f64(UINT64_C(0x" + String::num_uint64(bits, 16) + "))";
+				r_type = AOT_FLOAT;
+				return true;
+			}
+			default:
+				return _fail(vformat("Unsupported constant of type %s.", Variant::get_type_name(p_value.get_type())));
+		}
+	}
+
+	bool _binary(Variant::Operator p_op, String p_left, AOTType p_left_type, String p_right, AOTType p_right_type, String &r_code, AOTType &r_type) {
+		const bool both_int = p_left_type == AOT_INT && p_right_type == AOT_INT;
+		const bool numeric = p_left_type != AOT_BOOL && p_right_type != AOT_BOOL;
+
+		switch (p_op) {
+			case Variant::OP_ADD:
+			case Variant::OP_SUBTRACT:
+			case Variant::OP_MULTIPLY:
+			case Variant::OP_DIVIDE: {
+				if (!numeric) {
+					return _fail("Unsupported operand types.");
+				}
+				if (both_int) {
+					static const char *functions[] = { "gdaot_add(", "gdaot_sub(", "gdaot_mul(", "gdaot_div(p_context, " };
+					r_code = String(functions[p_op - Variant::OP_ADD]) + p_left + ", " + p_right + ")";
+					r_type = AOT_INT;
+					return true;
+				}
+				static const char *operators[] = { " + ", " - ", " * ", " / " };
+				_convert(p_left, p_left_type, AOT_FLOAT);
+				_convert(p_right, p_right_type, AOT_FLOAT);
+				r_code = "(" + p_left + operators[p_op - Variant::OP_ADD] + p_right + ")";
+				r_type = AOT_FLOAT;
+				return true;
+			}
+			case Variant::OP_MODULE:
+			case Variant::OP_SHIFT_LEFT:
+			case Variant::OP_SHIFT_RIGHT:
+			case Variant::OP_BIT_AND:
+			case Variant::OP_BIT_OR:
+			case Variant::OP_BIT_XOR: {
+				if (!both_int) {
+					return _fail("Unsupported operand types.");
+				}
+				if (p_op == Variant::OP_MODULE) {
+					r_code = "gdaot_mod(p_context, " + p_left + ", " + p_right + ")";
+				} else if (p_op == Variant::OP_SHIFT_LEFT) {
+					r_code = "gdaot_shl(p_context, " + p_left + ", " + p_right + ")";
+				} else if (p_op == Variant::OP_SHIFT_RIGHT) {
+					r_code = "gdaot_shr(p_context, " + p_left + ", " + p_right + ")";
+				} else {
+					const char *op = p_op == Variant::OP_BIT_AND ? " & " : (p_op == Variant::OP_BIT_OR ? " | " : " ^ ");
+					r_code = "(" + p_left + op + p_right + ")";
+				}
+				r_type = AOT_INT;
+				return true;
+			}
+			case Variant::OP_EQUAL:
+			case Variant::OP_NOT_EQUAL:
+			case Variant::OP_LESS:
+			case Variant::OP_LESS_EQUAL:
+			case Variant::OP_GREATER:
+			case Variant::OP_GREATER_EQUAL: {
+				static const char *operators[] = { " == ", " != ", " < ", " <= ", " > ", " >= " };
+				if (p_left_type == AOT_BOOL && p_right_type == AOT_BOOL) {
+					if (p_op != Variant::OP_EQUAL && p_op != Variant::OP_NOT_EQUAL) {
+						return _fail("Unsupported operand types.");
+					}
+				} else if (numeric) {
+					if (!both_int) {
+						_convert(p_left, p_left_type, AOT_FLOAT);
+						_convert(p_right, p_right_type, AOT_FLOAT);
+					}
+				} else {
+					return _fail("Unsupported operand types.");
+				}
+				r_code = "(" + p_left + operators[p_op - Variant::OP_EQUAL] + p_right + ")";
+				r_type = AOT_BOOL;
+				return true;
+			}
+			case Variant::OP_AND:
+			case Variant::OP_OR:
+				r_code = "(" + _truthy(p_left, p_left_type) + (p_op == Variant::OP_AND ? " && " : " || ") + _truthy(p_right, p_right_type) + ")";
+				r_type = AOT_BOOL;
+				return true;
+			default:
+				return _fail(vformat("Unsupported operator \"%s\".", Variant::get_operator_name(p_op)));
+		}
+	}
+
+	bool _arguments(const Vector<GDScriptParser::ExpressionNode *> &p_arguments, const AOTType *p_types, String &r_code) {
+		for (int i = 0; i < p_arguments.size(); i++) {
+			String argument;
+			AOTType type;
+			if (!_expression(p_arguments[i], argument, type) || !_convert(argument, type, p_types[i])) {
+				return false;
+			}
+			r_code += ", " + argument;
+		}
+		return true;
+	}
+
+	bool _call(const GDScriptParser::CallNode *p_call, String &r_code, AOTType &r_type) {
+		if (p_call->is_super || p_call->get_callee_type() != GDScriptParser::Node::IDENTIFIER) {
+			return _fail("Only calls to utility functions and static functions of the same script are supported.");
+		}
+
+		// Utility functions take precedence over script functions, like in the compiler.
+		if (Variant::has_utility_function(p_call->function_name)) {
+			for (const AOTUtility &utility : aot_utilities) {
+				if (p_call->function_name != utility.name || p_call->arguments.size() != utility.argument_count) {
+					continue;
+				}
+				String arguments;
+				if (!_arguments(p_call->arguments, utility.argument_types, arguments)) {
+					return false;
+				}
+				r_code = String(utility.function) + "(" + arguments.substr(2) + ")";
+				r_type = utility.return_type;
+				return true;
+			}
+			return _fail(vformat("Unsupported utility function \"%s()\".", p_call->function_name));
+		}
+
+		const GDScriptParser::FunctionNode *const *callee = callable->getptr(p_call->function_name);
+		if (callee == nullptr) {
+			return _fail(vformat("Call to \"%s()\", which is not a translated static function.", p_call->function_name));
+		}
+		if (p_call->arguments.size() != (*callee)->parameters.size()) {
+			return _fail("Default arguments are not supported.");
+		}
+
+		AOTType types[AOT_MAX_ARGUMENTS];
+		for (int i = 0; i < (*callee)->parameters.size(); i++) {
+			types[i] = _aot_type((*callee)->parameters[i]->get_datatype());
+		}
+		String arguments;
+		if (!_arguments(p_call->arguments, types, arguments)) {
+			return false;
+		}
+		r_code = "f_" + String(p_call->function_name) + "(p_context" + arguments + ")";
+		r_type = _aot_type((*callee)->get_datatype());
+		return true;
+	}
+
+	bool _expression(const GDScriptParser::ExpressionNode *p_expression, String &r_code, AOTType &r_type) {
+		if (p_expression->is_constant) {
+			return _literal(p_expression->reduced_value, r_code, r_type);
+		}
+
+		r_type = _aot_type(p_expression->get_datatype());
+		if (r_type == AOT_NONE) {
+			return _fail("Expression is not statically typed as bool, int or float.");
+		}
+
+		switch (p_expression->type) {
+			case GDScriptParser::Node::IDENTIFIER: {
+				const GDScriptParser::IdentifierNode *identifier = static_cast<const GDScriptParser::IdentifierNode *>(p_expression);
+				switch (identifier->source) {
+					case GDScriptParser::IdentifierNode::FUNCTION_PARAMETER:
+					case GDScriptParser::IdentifierNode::LOCAL_VARIABLE:
+					case GDScriptParser::IdentifierNode::LOCAL_ITERATOR:
+						r_code = _local(identifier->name);
+						return true;
+					default:
+						return _fail(vformat("Access to \"%s\", which is not a local variable.", identifier->name));
+				}
+			}
+			case GDScriptParser::Node::BINARY_OPERATOR: {
+				const GDScriptParser::BinaryOpNode *binary = static_cast<const GDScriptParser::BinaryOpNode *>(p_expression);
+				String left, right;
+				AOTType left_type, right_type;
+				if (!_expression(binary->left_operand, left, left_type) || !_expression(binary->right_operand, right, right_type)) {
+					return false;
+				}
+				AOTType result_type;
+				if (!_binary(binary->variant_op, left, left_type, right, right_type, r_code, result_type)) {
+					return false;
+				}
+				return _convert(r_code, result_type, r_type);
+			}
+			case GDScriptParser::Node::UNARY_OPERATOR: {
+				const GDScriptParser::UnaryOpNode *unary = static_cast<const GDScriptParser::UnaryOpNode *>(p_expression);
+				String operand;
+				AOTType operand_type;
+				if (!_expression(unary->operand, operand, operand_type)) {
+					return false;
+				}
+				switch (unary->variant_op) {
+					case Variant::OP_NEGATE:
+						if (operand_type == AOT_BOOL) {
+							return _fail("Unsupported operand type.");
+						}
+						r_code = operand_type == AOT_INT ? "gdaot_neg(" + operand + ")" : "(-" + operand + ")";
+						return _convert(r_code, operand_type, r_type);
+					case Variant::OP_POSITIVE:
+						if (operand_type == AOT_BOOL) {
+							return _fail("Unsupported operand type.");
+						}
+						r_code = operand;
+						return _convert(r_code, operand_type, r_type);
+					case Variant::OP_BIT_NEGATE:
+						if (operand_type != AOT_INT) {
+							return _fail("Unsupported operand type.");
+						}
+						r_code = "(~" + operand + ")";
+						return _convert(r_code, AOT_INT, r_type);
+					case Variant::OP_NOT:
+						r_code = "(!" + _truthy(operand, operand_type) + ")";
+						return _convert(r_code, AOT_BOOL, r_type);
+					default:
+						return _fail("Unsupported unary operator.");
+				}
+			}
+			case GDScriptParser::Node::TERNARY_OPERATOR: {
+				const GDScriptParser::TernaryOpNode *ternary = static_cast<const GDScriptParser::TernaryOpNode *>(p_expression);
+				String condition, true_expr, false_expr;
+				AOTType condition_type, true_type, false_type;
+				if (!_expression(ternary->condition, condition, condition_type) || !_expression(ternary->true_expr, true_expr, true_type) || !_expression(ternary->false_expr, false_expr, false_type)) {
+					return false;
+				}
+				if (!_convert(true_expr, true_type, r_type) || !_convert(false_expr, false_type, r_type)) {
+					return false;
+				}
+				r_code = "(" + _truthy(condition, condition_type) + " ? " + true_expr + " : " + false_expr + ")";
+				return true;
+			}
+			case GDScriptParser::Node::CALL: {
+				AOTType call_type;
+				if (!_call(static_cast<const GDScriptParser::CallNode *>(p_expression), r_code, call_type)) {
+					return false;
+				}
+				return _convert(r_code, call_type, r_type);
+			}
+			default:
+				return _fail("Unsupported expression.");
+		}
+	}
+
+	bool _assignment(const GDScriptParser::AssignmentNode *p_assignment) {
+		if (p_assignment->assignee->type != GDScriptParser::Node::IDENTIFIER) {
+			return _fail("Only assignments to local variables are supported.");
+		}
+		String target;
+		AOTType target_type;
+		if (!_expression(p_assignment->assignee, target, target_type)) {
+			return false;
+		}
+
+		String value;
+		AOTType value_type;
+		if (!_expression(p_assignment->assigned_value, value, value_type)) {
+			return false;
+		}
+		if (p_assignment->operation != GDScriptParser::AssignmentNode::OP_NONE) {
+			String result;
+			if (!_binary(p_assignment->variant_op, target, target_type, value, value_type, result, value_type)) {
+				return false;
+			}
+			value = result;
+		}
+		if (!_convert(value, value_type, target_type)) {
+			return false;
+		}
+		_line(target + " = " + value + ";");
+		_line("GDAOT_CHECK();");
+		return true;
+	}
+
+	bool _for(const GDScriptParser::ForNode *p_for) {
+		if (_aot_type(p_for->variable->get_datatype()) != AOT_INT || !_is_valid_name(p_for->variable->name)) {
+			return _fail("Only integer ranges can be iterated.");
+		}
+
+		String from = "INT64_C(0)", to, step = "INT64_C(1)";
+		AOTType type;
+		const GDScriptParser::ExpressionNode *list = p_for->list;
+		const GDScriptParser::CallNode *range = nullptr;
+		if (list->type == GDScriptParser::Node::CALL) {
+			const GDScriptParser::CallNode *call = static_cast<const GDScriptParser::CallNode *>(list);
+			if (call->get_callee_type() == GDScriptParser::Node::IDENTIFIER && call->function_name == SNAME("range")) {
+				range = call;
+			}
+		}
+
+		if (range != nullptr) {
+			String arguments[3];
+			for (int i = 0; i < range->arguments.size(); i++) {
+				if (i >= 3 || !_expression(range->arguments[i], arguments[i], type) || type != AOT_INT) {
+					return _fail("Only integer ranges can be iterated.");
+				}
+			}
+			switch (range->arguments.size()) {
+				case 1:
+					to = arguments[0];
+					break;
+				case 2:
+					from = arguments[0];
+					to = arguments[1];
+					break;
+				case 3:
+					from = arguments[0];
+					to = arguments[1];
+					step = arguments[2];
+					break;
+				default:
+					return _fail("Only integer ranges can be iterated.");
+			}
+		} else {
+			if (!_expression(list, to, type) || type != AOT_INT) {
+				return _fail("Only integer ranges can be iterated.");
+			}
+		}
+
+		const String suffix = itos(loop_depth);
+		_line("{");
+		indent++;
+		_line("const int64_t from" + suffix + " = " + from + ";");
+		_line("const int64_t to" + suffix + " = " + to + ";");
+		_line("const int64_t step" + suffix + " = " + step + ";");
+		_line("GDAOT_CHECK();");
+		_line("if (step" + suffix + " == 0) {");
+		_line("\tGDAOT_FAIL();");
+		_line("}");
+		_line(vformat("for (int64_t i%s = from%s; step%s > 0 ? i%s < to%s : i%s > to%s; i%s = gdaot_add(i%s, step%s)) {", suffix, suffix, suffix, suffix, suffix, suffix, suffix, suffix, suffix, suffix));
+		indent++;
+		_line("int64_t " + _local(p_for->variable->name) + " = i" + suffix + ";");
+		_line("(void)" + _local(p_for->variable->name) + ";");
+		loop_depth++;
+		const bool ok = _suite(p_for->loop);
+		loop_depth--;
+		indent--;
+		_line("}");
+		indent--;
+		_line("}");
+		return ok;
+	}
+
+	bool _statement(const GDScriptParser::Node *p_statement) {
+		switch (p_statement->type) {
+			case GDScriptParser::Node::PASS:
+			case GDScriptParser::Node::CONSTANT: // Uses are folded.
+				return true;
+			case GDScriptParser::Node::BREAK:
+				_line("break;");
+				return true;
+			case GDScriptParser::Node::CONTINUE:
+				_line("continue;");
+				return true;
+			case GDScriptParser::Node::VARIABLE: {
+				const GDScriptParser::VariableNode *variable = static_cast<const GDScriptParser::VariableNode *>(p_statement);
+				const AOTType type = _aot_type(variable->get_datatype());
+				if (type == AOT_NONE || !_is_valid_name(variable->identifier->name)) {
+					return _fail(vformat("Variable \"%s\" is not statically typed as bool, int or float.", variable->identifier->name));
+				}
+				String value = type == AOT_FLOAT ? "0.0" : (type == AOT_BOOL ? "false" : "INT64_C(0)");
+				if (variable->initializer) {
+					AOTType value_type;
+					if (!_expression(variable->initializer, value, value_type) || !_convert(value, value_type, type)) {
+						return false;
+					}
+				}
+				_line(String(_aot_c_type(type)) + " " + _local(variable->identifier->name) + " = " + value + ";");
+				_line("GDAOT_CHECK();");
+				return true;
+			}
+			case GDScriptParser::Node::ASSIGNMENT:
+				return _assignment(static_cast<const GDScriptParser::AssignmentNode *>(p_statement));
+			case GDScriptParser::Node::CALL: {
+				String call;
+				AOTType type;
+				if (!_call(static_cast<const GDScriptParser::CallNode *>(p_statement), call, type)) {
+					return false;
+				}
+				_line("(void)" + call + ";");
+				_line("GDAOT_CHECK();");
+				return true;
+			}
+			case GDScriptParser::Node::RETURN: {
+				const GDScriptParser::ReturnNode *return_n = static_cast<const GDScriptParser::ReturnNode *>(p_statement);
+				if (return_n->return_value == nullptr) {
+					return _fail("Missing return value.");
+				}
+				String value;
+				AOTType type;
+				if (!_expression(return_n->return_value, value, type) || !_convert(value, type, _aot_type(function->get_datatype()))) {
+					return false;
+				}
+				_line("{");
+				_line("\tconst " + String(_aot_c_type(_aot_type(function->get_datatype()))) + " value = " + value + ";");
+				_line("\tGDAOT_CHECK();");
+				_line("\treturn value;");
+				_line("}");
+				return true;
+			}
+			case GDScriptParser::Node::IF: {
+				const GDScriptParser::IfNode *if_n = static_cast<const GDScriptParser::IfNode *>(p_statement);
+				String condition;
+				AOTType type;
+				if (!_expression(if_n->condition, condition, type)) {
+					return false;
+				}
+				_line("{");
+				indent++;
+				_line("const bool condition = " + _truthy(condition, type) + ";");
+				_line("GDAOT_CHECK();");
+				_line("if (condition) {");
+				indent++;
+				if (!_suite(if_n->true_block)) {
+					return false;
+				}
+				indent--;
+				if (if_n->false_block) {
+					_line("} else {");
+					indent++;
+					if (!_suite(if_n->false_block)) {
+						return false;
+					}
+					indent--;
+				}
+				_line("}");
+				indent--;
+				_line("}");
+				return true;
+			}
+			case GDScriptParser::Node::WHILE: {
+				const GDScriptParser::WhileNode *while_n = static_cast<const GDScriptParser::WhileNode *>(p_statement);
+				String condition;
+				AOTType type;
+				if (!_expression(while_n->condition, condition, type)) {
+					return false;
+				}
+				_line("for (;;) {");
+				indent++;
+				_line("const bool condition = " + _truthy(condition, type) + ";");
+				_line("GDAOT_CHECK();");
+				_line("if (!condition) {");
+				_line("\tbreak;");
+				_line("}");
+				loop_depth++;
+				const bool ok = _suite(while_n->loop);
+				loop_depth--;
+				indent--;
+				_line("}");
+				return ok;
+			}
+			case GDScriptParser::Node::FOR:
+				return _for(static_cast<const GDScriptParser::ForNode *>(p_statement));
+			default:
+				return _fail("Unsupported statement.");
+		}
+	}
+
+	bool _suite(const GDScriptParser::SuiteNode *p_suite) {
+		for (const GDScriptParser::Node *statement : p_suite->statements) {
+			if (!_statement(statement)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+public:
+	// Returns the parameter list and return type of a function that may be translated, or an error.
+	static String check_signature(const GDScriptParser::FunctionNode *p_function) {
+		if (p_function->is_coroutine || p_function->is_vararg() || p_function->is_abstract || p_function->body == nullptr) {
+			return "Coroutines, variadic and abstract functions are not supported.";
+		}
+		if (!_is_valid_name(p_function->identifier->name)) {
+			return "The function name is not an ASCII identifier.";
+		}
+		if (_aot_type(p_function->get_datatype()) == AOT_NONE) {
+			return "The return type is not bool, int or float.";
+		}
+		if (p_function->parameters.size() > AOT_MAX_ARGUMENTS) {
+			return "Too many parameters.";
+		}
+		for (const GDScriptParser::ParameterNode *parameter : p_function->parameters) {
+			if (_aot_type(parameter->get_datatype()) == AOT_NONE || !_is_valid_name(parameter->identifier->name)) {
+				return vformat("Parameter \"%s\" is not statically typed as bool, int or float.", parameter->identifier->name);
+			}
+			if (parameter->initializer) {
+				return "Default arguments are not supported.";
+			}
+		}
+		return String();
+	}
+
+	bool translate() {
+		const AOTType return_type = _aot_type(function->get_datatype());
+		String signature = String(_aot_c_type(return_type)) + " f_" + String(function->identifier->name) + "(GDScriptAOTContext *p_context";
+		for (const GDScriptParser::ParameterNode *parameter : function->parameters) {
+			signature += String(", ") + _aot_c_type(_aot_type(parameter->get_datatype())) + " " + _local(parameter->identifier->name);
+		}
+		signature += ")";
+
+		code = "static " + signature + " {\n";
+		_line("GDAOT_ENTER();");
+		if (!_suite(function->body)) {
+			return false;
+		}
+		_line("return 0;");
+		code += "}\n";
+		return true;
+	}
+
+	String get_declaration() const {
+		return code.substr(0, code.find(" {\n")) + ";\n";
+	}
+
+	String get_wrapper() const {
+		const String name = function->identifier->name;
+		String call = "f_" + name + "(p_context";
+		for (int i = 0; i < function->parameters.size(); i++) {
+			const AOTType type = _aot_type(function->parameters[i]->get_datatype());
+			call += vformat(", p_args[%d].%s", i, _aot_value_field(type));
+			if (type == AOT_BOOL) {
+				call += " != 0";
+			}
+		}
+		call += ")";
+
+		String wrapper = "static void c_" + name + "(const GDScriptAOTValue *p_args, GDScriptAOTValue *r_return, GDScriptAOTContext *p_context) {\n";
+		wrapper += vformat("\tr_return->%s = %s;\n", _aot_value_field(_aot_type(function->get_datatype())), call);
+		wrapper += "}\n";
+		return wrapper;
+	}
+
+	StringName get_name() const { return function->identifier->name; }
+	const String &get_code() const { return code; }
+	const String &get_error() const { return error; }
+
+	GDScriptAOTFunctionTranslator(const GDScriptParser::FunctionNode *p_function, const HashMap<StringName, const GDScriptParser::FunctionNode *> &p_callable) :
+			function(p_function), callable(&p_callable) {}
+	GDScriptAOTFunctionTranslator() {}
+};
+
+void *GDScriptAOT::library_handle = nullptr;
+HashMap<String, GDScriptAOT::ScriptEntry> GDScriptAOT::scripts;
+
+GDScriptAOT::Translation GDScriptAOT::translate(const GDScriptParser *p_parser) {
+	Translation translation;
+	const GDScriptParser::ClassNode *root = p_parser->get_tree();
+	if (root == nullptr) {
+		return translation;
+	}
+
+	// Functions calling each other must be translated together, so retry without the
+	// failed ones until the set is stable.
+	HashMap<StringName, const GDScriptParser::FunctionNode *> candidates;
+	for (const GDScriptParser::ClassNode::Member &member : root->members) {
+		if (member.type != GDScriptParser::ClassNode::Member::FUNCTION) {
+			continue;
+		}
+		const String signature_error = GDScriptAOTFunctionTranslator::check_signature(member.function);
+		if (signature_error.is_empty()) {
+			candidates.insert(member.function->identifier->name, member.function);
+		} else {
+			translation.skipped.insert(member.function->identifier->name, signature_error);
+		}
+	}
+
+	HashMap<StringName, const GDScriptParser::FunctionNode *> callable;
+	LocalVector<GDScriptAOTFunctionTranslator> translators;
+	bool stable = false;
+	while (!stable) {
+		stable = true;
+		callable.clear();
+		for (const KeyValue<StringName, const GDScriptParser::FunctionNode *> &E : candidates) {
+			if (E.value->is_static) {
+				// Non-static functions may be overridden, so calls to them are left dynamic.
+				callable.insert(E.key, E.value);
+			}
+		}
+
+		translators.clear();
+		for (const KeyValue<StringName, const GDScriptParser::FunctionNode *> &E : candidates) {
+			GDScriptAOTFunctionTranslator translator(E.value, callable);
+			if (translator.translate()) {
+				translators.push_back(translator);
+			} else {
+				const StringName name = E.key;
+				translation.skipped.insert(name, translator.get_error());
+				candidates.erase(name);
+				stable = false;
+				break;
+			}
+		}
+	}
+
+	if (translators.is_empty()) {
+		return translation;
+	}
+
+	// Sorted, so the code (and its hash) doesn't depend on declaration order.
+	struct TranslatorSort {
+		bool operator()(const GDScriptAOTFunctionTranslator &p_a, const GDScriptAOTFunctionTranslator &p_b) const {
+			return StringName::AlphCompare()(p_a.get_name(), p_b.get_name());
+		}
+	};
+	translators.sort_custom<TranslatorSort>();
+
+	String &code = translation.code;
+	for (const GDScriptAOTFunctionTranslator &translator : translators) {
+		code += translator.get_declaration();
+	}
+	for (const GDScriptAOTFunctionTranslator &translator : translators) {
+		code += "\n" + translator.get_code();
+	}
+	for (const GDScriptAOTFunctionTranslator &translator : translators) {
+		code += "\n" + translator.get_wrapper();
+	}
+
+	code += "\nstatic const GDScriptAOTFunction functions[] = {\n";
+	for (const GDScriptAOTFunctionTranslator &translator : translators) {
+		translation.functions.push_back(translator.get_name());
+		code += vformat("\t{ \"%s\", &c_%s },\n", translator.get_name(), translator.get_name());
+	}
+	code += "};\n";
+
+	return translation;
+}
+
+#ifdef TOOLS_ENABLED
+static void _find_scripts(const String &p_dir, Vector<String> &r_paths) {
+	Ref<DirAccess> dir = DirAccess::open(p_dir);
+	if (dir.is_null()) {
+		return;
+	}
+
+	dir->list_dir_begin();
+	for (String name = dir->get_next(); !name.is_empty(); name = dir->get_next()) {
+		if (name.begins_with(".")) {
+			continue;
+		}
+		const String path = p_dir.path_join(name);
+		if (dir->current_is_dir()) {
+			_find_scripts(path, r_paths);
+		} else if (name.get_extension() == "gd") {
+			r_paths.push_back(path);
+		}
+	}
+	dir->list_dir_end();
+}
+
+Error GDScriptAOT::generate(const String &p_output_path) {
+	Vector<String> paths;
+	_find_scripts("res://", paths);
+	paths.sort();
+
+	String namespaces;
+	String table;
+	int script_count = 0;
+	int function_count = 0;
+	int skipped_count = 0;
+
+	for (const String &path : paths) {
+		Error err = OK;
+		Ref<GDScriptParserRef> parser_ref = GDScriptCache::get_parser(path, GDScriptParserRef::FULLY_SOLVED, err);
+		if (err != OK || parser_ref.is_null()) {
+			WARN_PRINT(vformat(R"(GDScript AOT: Skipping "%s", it has errors.)", path));
+			continue;
+		}
+
+		const Translation translation = translate(parser_ref->get_parser());
+		for (const KeyValue<StringName, String> &E : translation.skipped) {
+			print_verbose(vformat("GDScript AOT: %s::%s() stays on the VM: %s", path, E.key, E.value));
+		}
+		skipped_count += translation.skipped.size();
+		if (translation.functions.is_empty()) {
+			continue;
+		}
+
+		const String namespace_name = "gdaot_" + itos(script_count);
+		namespaces += vformat("\n// %s\nnamespace %s {\n\n%s\n} // namespace %s\n", path, namespace_name, translation.code, namespace_name);
+		table += vformat("\t{ \"%s\", UINT64_C(0x%s), %d, %s::functions },\n", path.c_escape(), String::num_uint64(translation.code.hash64(), 16), translation.functions.size(), namespace_name);
+		script_count++;
+		function_count += translation.functions.size();
+	}
+
+	String output = "// Generated by the GDScript AOT translator (--gdscript-aot), do not edit.\n";
+	output += "// Build it as a shared library and set it in \"debug/settings/gdscript/aot_library_path\".\n\n";
+	output += aot_preamble;
+	output += namespaces;
+	if (script_count > 0) {
+		output += "\nstatic const GDScriptAOTScript gdaot_scripts[] = {\n" + table + "};\n";
+	}
+	output += vformat("\nstatic const GDScriptAOTLibrary gdaot_library = { %d, %d, %s };\n", GDScriptAOTABI::VERSION, script_count, script_count > 0 ? "gdaot_scripts" : "nullptr");
+	output += "\nextern \"C\" GDAOT_EXPORT const GDScriptAOTLibrary *gdscript_aot_get_library() {\n\treturn &gdaot_library;\n}\n";
+
+	Error err = OK;
+	Ref<FileAccess> file = FileAccess::open(p_output_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(file.is_null(), err, vformat(R"(GDScript AOT: Cannot write "%s".)", p_output_path));
+	file->store_string(output);
+
+	print_line(vformat(R"(GDScript AOT: Translated %d functions of %d scripts to "%s", %d functions stay on the VM.)", function_count, script_count, p_output_path, skipped_count));
+	return OK;
+}
+
+// Like `--export-release`, the editor quits once the code is generated.
+void GDScriptAOT::handle_cmdline() {
+	const List<String> cmdline_args = OS::get_singleton()->get_cmdline_args();
+	for (const List<String>::Element *E = cmdline_args.front(); E; E = E->next()) {
+		if (E->get() == "--gdscript-aot") {
+			Error err = ERR_INVALID_PARAMETER;
+			if (E->next() == nullptr) {
+				ERR_PRINT(R"(Missing output path after "--gdscript-aot".)");
+			} else {
+				err = generate(E->next()->get());
+			}
+			SceneTree::get_singleton()->quit(err == OK ? EXIT_SUCCESS : EXIT_FAILURE);
+			return;
+		}
+	}
+}
+#endif // TOOLS_ENABLED
+
+Error GDScriptAOT::load_library(const String &p_path) {
+	ERR_FAIL_COND_V_MSG(library_handle != nullptr, ERR_ALREADY_IN_USE, "A GDScript AOT library is already loaded.");
+
+	const String path = ProjectSettings::get_singleton()->globalize_path(p_path);
+	void *handle = nullptr;
+	Error err = OS::get_singleton()->open_dynamic_library(path, handle);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat(R"(Cannot open the GDScript AOT library "%s".)", path));
+
+	void *symbol = nullptr;
+	err = OS::get_singleton()->get_dynamic_library_symbol_handle(handle, "gdscript_aot_get_library", symbol);
+	if (err != OK) {
+		OS::get_singleton()->close_dynamic_library(handle);
+		ERR_FAIL_V_MSG(err, vformat(R"("%s" is not a GDScript AOT library.)", path));
+	}
+
+	const GDScriptAOTABI::Library *library = reinterpret_cast<GDScriptAOTABI::GetLibrary>(symbol)();
+	if (library == nullptr || library->version != GDScriptAOTABI::VERSION) {
+		OS::get_singleton()->close_dynamic_library(handle);
+		ERR_FAIL_V_MSG(ERR_INVALID_DATA, vformat(R"(The GDScript AOT library "%s" was generated by an incompatible engine version.)", path));
+	}
+
+	for (uint32_t i = 0; i < library->script_count; i++) {
+		const GDScriptAOTABI::Script &script = library->scripts[i];
+		scripts.insert(String::utf8(script.path), { script.hash, &script });
+	}
+	library_handle = handle;
+
+	print_verbose(vformat(R"(GDScript AOT: Loaded native code for %d scripts from "%s".)", library->script_count, path));
+	return OK;
+}
+
+void GDScriptAOT::unload_library() {
+	if (library_handle == nullptr) {
+		return;
+	}
+	scripts.clear();
+	OS::get_singleton()->close_dynamic_library(library_handle);
+	library_handle = nullptr;
+}
+
+void GDScriptAOT::attach(const GDScriptParser *p_parser, GDScript *p_script) {
+	if (library_handle == nullptr) {
+		return;
+	}
+	const ScriptEntry *entry = scripts.getptr(p_script->get_script_path());
+	if (entry == nullptr) {
+		return;
+	}
+
+	// The script may have changed since the library was built, only the exact same code can be used.
+	const Translation translation = translate(p_parser);
+	if (translation.code.hash64() != entry->hash) {
+		print_verbose(vformat(R"(GDScript AOT: "%s" changed since it was translated, it runs on the VM.)", p_script->get_script_path()));
+		return;
+	}
+
+	const HashMap<StringName, GDScriptFunction *> &functions = p_script->get_member_functions();
+	for (uint32_t i = 0; i < entry->script->function_count; i++) {
+		const GDScriptAOTABI::Function &native = entry->script->functions[i];
+		GDScriptFunction *const *function = functions.getptr(StringName(native.name));
+		if (function != nullptr) {
+			(*function)->aot_call = native.call;
+		}
+	}
+}
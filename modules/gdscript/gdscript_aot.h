@@ -0,0 +1,120 @@
+/**************************************************************************/
+/*  gdscript_aot.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/string/string_name.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+
+class GDScript;
+class GDScriptParser;
+
+// Binary interface of native libraries produced by the GDScript AOT translator.
+// Generated code declares the same layout in its preamble (see `GDScriptAOT::generate()`),
+// so the library doesn't depend on engine headers. Bump `VERSION` on any change.
+struct GDScriptAOTABI {
+	static constexpr uint32_t VERSION = 1;
+
+	union Value {
+		int64_t i;
+		double f;
+		uint8_t b;
+	};
+
+	struct Context {
+		int32_t error; // Set when the function must run on the VM instead, which then reports the error.
+		int32_t depth;
+	};
+
+	typedef void (*Call)(const Value *p_args, Value *r_return, Context *p_context);
+
+	struct Function {
+		const char *name;
+		Call call;
+	};
+
+	struct Script {
+		const char *path;
+		uint64_t hash;
+		uint32_t function_count;
+		const Function *functions;
+	};
+
+	struct Library {
+		uint32_t version;
+		uint32_t script_count;
+		const Script *scripts;
+	};
+
+	typedef const Library *(*GetLibrary)();
+};
+
+// Ahead-of-time translation of statically typed GDScript functions to C++.
+//
+// Functions whose parameters, locals and return value are all `int`, `float` or `bool`
+// are lowered to plain C++, along with the control flow, operators, math utility functions
+// and calls to other translated static functions of the same script they use. Everything
+// else (other types, members, signals, coroutines...) keeps running on the VM.
+//
+// `--gdscript-aot <file.cpp>` writes the translation of every project script. Once built as a
+// shared library and set in `debug/settings/gdscript/aot_library_path`, it's loaded at
+// startup and its functions replace the bytecode of the scripts that were not modified
+// since: each script is translated again when compiled and must hash to the same code.
+class GDScriptAOT {
+	struct ScriptEntry {
+		uint64_t hash = 0;
+		const GDScriptAOTABI::Script *script = nullptr;
+	};
+
+	static void *library_handle;
+	static HashMap<String, ScriptEntry> scripts;
+
+public:
+	struct Translation {
+		String code; // Body of the script namespace, the input of the hash.
+		Vector<StringName> functions;
+		HashMap<StringName, String> skipped; // Function name to reason.
+	};
+
+	static Translation translate(const GDScriptParser *p_parser);
+
+#ifdef TOOLS_ENABLED
+	static Error generate(const String &p_output_path);
+	static void handle_cmdline();
+#endif
+
+	static Error load_library(const String &p_path);
+	static void unload_library();
+	static bool is_library_loaded() { return library_handle != nullptr; }
+
+	// Makes the translated functions of a freshly compiled script run natively.
+	static void attach(const GDScriptParser *p_parser, GDScript *p_script);
+};
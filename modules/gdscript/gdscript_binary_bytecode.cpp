@@ -0,0 +1,1711 @@
+/**************************************************************************/
+/*  gdscript_binary_bytecode.cpp                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_binary_bytecode.h"
+
+#include "gdscript_cache.h"
+#include "gdscript_tokenizer_buffer.h"
+#include "gdscript_utility_functions.h"
+
+#include "core/io/compression.h"
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "core/object/class_db.h"
+#include "core/templates/rb_map.h"
+#include "core/version.h"
+
+#ifdef TOOLS_ENABLED
+
+void GDScriptBinaryBytecode::Writer::put_u8(uint8_t p_value) {
+	buffer.push_back(p_value);
+}
+
+void GDScriptBinaryBytecode::Writer::put_u32(uint32_t p_value) {
+	const int64_t position = buffer.size();
+	buffer.resize(position + 4);
+	encode_uint32(p_value, &buffer.write[position]);
+}
+
+void GDScriptBinaryBytecode::Writer::put_string(const String &p_string) {
+	const CharString utf8 = p_string.utf8();
+	put_u32(utf8.length());
+	if (utf8.length() > 0) {
+		const int64_t position = buffer.size();
+		buffer.resize(position + utf8.length());
+		memcpy(&buffer.write[position], utf8.get_data(), utf8.length());
+	}
+}
+
+void GDScriptBinaryBytecode::Writer::put_data(const Vector<uint8_t> &p_data) {
+	put_u32(p_data.size());
+	buffer.append_array(p_data);
+}
+
+#endif // TOOLS_ENABLED
+
+uint8_t GDScriptBinaryBytecode::Reader::get_u8() {
+	if (failed || position + 1 > size) {
+		failed = true;
+		return 0;
+	}
+	return data[position++];
+}
+
+uint32_t GDScriptBinaryBytecode::Reader::get_u32() {
+	if (failed || position + 4 > size) {
+		failed = true;
+		return 0;
+	}
+	const uint32_t value = decode_uint32(&data[position]);
+	position += 4;
+	return value;
+}
+
+Variant::Type GDScriptBinaryBytecode::Reader::get_type() {
+	const uint32_t type = get_u32();
+	if (type >= Variant::VARIANT_MAX) {
+		failed = true;
+		return Variant::NIL;
+	}
+	return Variant::Type(type);
+}
+
+String GDScriptBinaryBytecode::Reader::get_string() {
+	const uint32_t length = get_u32();
+	if (failed || position + length > size) {
+		failed = true;
+		return String();
+	}
+	const String string = String::utf8(reinterpret_cast<const char *>(&data[position]), length);
+	position += length;
+	return string;
+}
+
+bool GDScriptBinaryBytecode::Reader::get_count(uint32_t &r_count, uint32_t p_min_item_size) {
+	r_count = get_u32();
+	// Reject counts the remaining data can't hold, so a corrupted buffer can't cause huge allocations.
+	if (failed || uint64_t(r_count) * MAX(p_min_item_size, 1u) > uint64_t(size - position)) {
+		failed = true;
+		return false;
+	}
+	return true;
+}
+
+uint32_t GDScriptBinaryBytecode::_get_engine_hash() {
+	// Opcodes, addressing and pointer table descriptors are only meaningful to the build that wrote them.
+	uint32_t hash = String(GODOT_VERSION_FULL_BUILD).hash();
+	hash = hash_murmur3_one_32(String(GODOT_VERSION_HASH).hash(), hash);
+	hash = hash_murmur3_one_32(GDScriptTokenizerBuffer::TOKENIZER_VERSION, hash);
+	hash = hash_murmur3_one_32(GDScriptFunction::OPCODE_END, hash);
+	hash = hash_murmur3_one_32(GDScriptFunction::ADDR_BITS, hash);
+	hash = hash_murmur3_one_32(GDScriptFunction::FIXED_ADDRESSES_MAX, hash);
+	hash = hash_murmur3_one_32(Variant::VARIANT_MAX, hash);
+	hash = hash_murmur3_one_32(Variant::OP_MAX, hash);
+#ifdef DEBUG_ENABLED
+	// Debug builds emit opcodes (asserts, breakpoints, line changes) that release builds don't have.
+	hash = hash_murmur3_one_32(1, hash);
+#else
+	hash = hash_murmur3_one_32(0, hash);
+#endif
+	return hash_fmix32(hash);
+}
+
+Error GDScriptBinaryBytecode::_split(const Vector<uint8_t> &p_buffer, ScriptData &r_data) {
+	ERR_FAIL_COND_V(!is_compiled_bytecode(p_buffer), ERR_INVALID_DATA);
+
+	Reader reader;
+	reader.data = p_buffer.ptr();
+	reader.size = p_buffer.size();
+	reader.position = HEADER_SIZE - 4;
+
+	uint32_t tokens_size = 0;
+	if (!reader.get_count(tokens_size, 1)) {
+		return ERR_INVALID_DATA;
+	}
+	r_data.binary_tokens = p_buffer.slice(reader.position, reader.position + tokens_size);
+	reader.position += tokens_size;
+
+	uint32_t tree_size = 0;
+	if (!reader.get_count(tree_size, 1)) {
+		return ERR_INVALID_DATA;
+	}
+	r_data.tree = &reader.data[reader.position];
+	r_data.tree_size = tree_size;
+	reader.position += tree_size;
+
+	r_data.payload_hash = reader.get_u32();
+	r_data.decompressed_size = reader.get_u32();
+	if (reader.failed) {
+		return ERR_INVALID_DATA;
+	}
+	r_data.payload = &reader.data[reader.position];
+	r_data.payload_size = reader.size - reader.position;
+	return OK;
+}
+
+#ifdef TOOLS_ENABLED
+
+// Reverse lookup of the validated function pointers stored in `GDScriptFunction`,
+// so they can be written as descriptors and resolved again when loading.
+struct GDScriptPointerNames {
+	struct OperatorName {
+		Variant::Operator op = Variant::OP_MAX;
+		Variant::Type type_a = Variant::NIL;
+		Variant::Type type_b = Variant::NIL;
+	};
+
+	struct MemberName {
+		Variant::Type type = Variant::NIL;
+		StringName name;
+	};
+
+	struct ConstructorName {
+		Variant::Type type = Variant::NIL;
+		int index = 0;
+	};
+
+	RBMap<Variant::ValidatedOperatorEvaluator, OperatorName> operators;
+	RBMap<Variant::ValidatedSetter, MemberName> setters;
+	RBMap<Variant::ValidatedGetter, MemberName> getters;
+	RBMap<Variant::ValidatedKeyedSetter, Variant::Type> keyed_setters;
+	RBMap<Variant::ValidatedKeyedGetter, Variant::Type> keyed_getters;
+	RBMap<Variant::ValidatedIndexedSetter, Variant::Type> indexed_setters;
+	RBMap<Variant::ValidatedIndexedGetter, Variant::Type> indexed_getters;
+	RBMap<Variant::ValidatedBuiltInMethod, MemberName> builtin_methods;
+	RBMap<Variant::ValidatedConstructor, ConstructorName> constructors;
+	RBMap<Variant::ValidatedUtilityFunction, StringName> utilities;
+	RBMap<GDScriptUtilityFunctions::FunctionPtr, StringName> gds_utilities;
+
+	GDScriptPointerNames() {
+		// Several descriptors may share a pointer, any of them resolves to the same function.
+		for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+			const Variant::Type type = Variant::Type(i);
+
+			for (int j = 0; j < Variant::VARIANT_MAX; j++) {
+				for (int op = 0; op < Variant::OP_MAX; op++) {
+					Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(Variant::Operator(op), type, Variant::Type(j));
+					if (evaluator != nullptr && !operators.has(evaluator)) {
+						operators.insert(evaluator, { Variant::Operator(op), type, Variant::Type(j) });
+					}
+				}
+			}
+
+			List<StringName> members;
+			Variant::get_member_list(type, &members);
+			for (const StringName &member : members) {
+				Variant::ValidatedSetter setter = Variant::get_member_validated_setter(type, member);
+				if (setter != nullptr && !setters.has(setter)) {
+					setters.insert(setter, { type, member });
+				}
+				Variant::ValidatedGetter getter = Variant::get_member_validated_getter(type, member);
+				if (getter != nullptr && !getters.has(getter)) {
+					getters.insert(getter, { type, member });
+				}
+			}
+
+			Variant::ValidatedKeyedSetter keyed_setter = Variant::get_member_validated_keyed_setter(type);
+			if (keyed_setter != nullptr && !keyed_setters.has(keyed_setter)) {
+				keyed_setters.insert(keyed_setter, type);
+			}
+			Variant::ValidatedKeyedGetter keyed_getter = Variant::get_member_validated_keyed_getter(type);
+			if (keyed_getter != nullptr && !keyed_getters.has(keyed_getter)) {
+				keyed_getters.insert(keyed_getter, type);
+			}
+			Variant::ValidatedIndexedSetter indexed_setter = Variant::get_member_validated_indexed_setter(type);
+			if (indexed_setter != nullptr && !indexed_setters.has(indexed_setter)) {
+				indexed_setters.insert(indexed_setter, type);
+			}
+			Variant::ValidatedIndexedGetter indexed_getter = Variant::get_member_validated_indexed_getter(type);
+			if (indexed_getter != nullptr && !indexed_getters.has(indexed_getter)) {
+				indexed_getters.insert(indexed_getter, type);
+			}
+
+			List<StringName> methods;
+			Variant::get_builtin_method_list(type, &methods);
+			for (const StringName &method : methods) {
+				Variant::ValidatedBuiltInMethod builtin_method = Variant::get_validated_builtin_method(type, method);
+				if (builtin_method != nullptr && !builtin_methods.has(builtin_method)) {
+					builtin_methods.insert(builtin_method, { type, method });
+				}
+			}
+
+			for (int j = 0; j < Variant::get_constructor_count(type); j++) {
+				Variant::ValidatedConstructor constructor = Variant::get_validated_constructor(type, j);
+				if (constructor != nullptr && !constructors.has(constructor)) {
+					constructors.insert(constructor, { type, j });
+				}
+			}
+		}
+
+		List<StringName> functions;
+		Variant::get_utility_function_list(&functions);
+		for (const StringName &function : functions) {
+			Variant::ValidatedUtilityFunction utility = Variant::get_validated_utility_function(function);
+			if (utility != nullptr && !utilities.has(utility)) {
+				utilities.insert(utility, function);
+			}
+		}
+
+		functions.clear();
+		GDScriptUtilityFunctions::get_function_list(&functions);
+		for (const StringName &function : functions) {
+			GDScriptUtilityFunctions::FunctionPtr gds_utility = GDScriptUtilityFunctions::get_function(function);
+			if (gds_utility != nullptr && !gds_utilities.has(gds_utility)) {
+				gds_utilities.insert(gds_utility, function);
+			}
+		}
+	}
+};
+
+static const GDScriptPointerNames &_get_pointer_names() {
+	static const GDScriptPointerNames names;
+	return names;
+}
+
+bool GDScriptBinaryBytecode::_put_script_ref(Writer &p_writer, const Script *p_script) {
+	if (p_script == nullptr) {
+		p_writer.put_u8(0);
+		return true;
+	}
+
+	// GDScript classes are stored as the path of the file and the fully qualified name inside it.
+	const GDScript *gdscript = Object::cast_to<GDScript>(p_script);
+	if (gdscript != nullptr) {
+		const GDScript *root = gdscript;
+		while (root->_owner != nullptr) {
+			root = root->_owner;
+		}
+		const String path = root->get_script_path();
+		if (!path.begins_with("res://") || path.contains("::")) {
+			p_writer.error = vformat(R"(Script "%s" is not saved to a file.)", gdscript->fully_qualified_name);
+			return false;
+		}
+		p_writer.put_u8(1);
+		p_writer.put_string(path);
+		p_writer.put_string(gdscript->fully_qualified_name);
+		return true;
+	}
+
+	const String path = p_script->get_path();
+	if (!path.begins_with("res://") || p_script->is_built_in()) {
+		p_writer.error = "Built-in scripts can't be referenced from compiled bytecode.";
+		return false;
+	}
+	p_writer.put_u8(2);
+	p_writer.put_string(path);
+	return true;
+}
+
+bool GDScriptBinaryBytecode::_put_variant(Writer &p_writer, const Variant &p_value) {
+	switch (p_value.get_type()) {
+		case Variant::OBJECT: {
+			Object *object = p_value.get_validated_object();
+			if (object == nullptr) {
+				p_writer.put_u8(TAG_NULL_OBJECT);
+				return true;
+			}
+			const GDScriptNativeClass *native_class = Object::cast_to<GDScriptNativeClass>(object);
+			if (native_class != nullptr) {
+				p_writer.put_u8(TAG_NATIVE_CLASS);
+				p_writer.put_string(native_class->get_name());
+				return true;
+			}
+			const Script *script = Object::cast_to<Script>(object);
+			if (script != nullptr) {
+				p_writer.put_u8(TAG_SCRIPT);
+				return _put_script_ref(p_writer, script);
+			}
+			const Resource *resource = Object::cast_to<Resource>(object);
+			if (resource != nullptr && resource->get_path().begins_with("res://") && !resource->is_built_in()) {
+				p_writer.put_u8(TAG_RESOURCE);
+				p_writer.put_string(resource->get_path());
+				return true;
+			}
+			p_writer.error = vformat(R"(Constant of type "%s" can't be stored in compiled bytecode.)", object->get_class());
+			return false;
+		}
+		case Variant::ARRAY: {
+			const Array array = p_value;
+			p_writer.put_u8(TAG_ARRAY);
+			p_writer.put_u32(array.get_typed_builtin());
+			p_writer.put_string(array.get_typed_class_name());
+			if (!_put_script_ref(p_writer, Object::cast_to<Script>(array.get_typed_script().get_validated_object()))) {
+				return false;
+			}
+			p_writer.put_u8(array.is_read_only());
+			p_writer.put_u32(array.size());
+			for (const Variant &element : array) {
+				if (!_put_variant(p_writer, element)) {
+					return false;
+				}
+			}
+			return true;
+		}
+		case Variant::DICTIONARY: {
+			const Dictionary dictionary = p_value;
+			p_writer.put_u8(TAG_DICTIONARY);
+			p_writer.put_u32(dictionary.get_typed_key_builtin());
+			p_writer.put_string(dictionary.get_typed_key_class_name());
+			if (!_put_script_ref(p_writer, Object::cast_to<Script>(dictionary.get_typed_key_script().get_validated_object()))) {
+				return false;
+			}
+			p_writer.put_u32(dictionary.get_typed_value_builtin());
+			p_writer.put_string(dictionary.get_typed_value_class_name());
+			if (!_put_script_ref(p_writer, Object::cast_to<Script>(dictionary.get_typed_value_script().get_validated_object()))) {
+				return false;
+			}
+			p_writer.put_u8(dictionary.is_read_only());
+			p_writer.put_u32(dictionary.size());
+			for (const KeyValue<Variant, Variant> &E : dictionary) {
+				if (!_put_variant(p_writer, E.key) || !_put_variant(p_writer, E.value)) {
+					return false;
+				}
+			}
+			return true;
+		}
+		case Variant::RID:
+		case Variant::CALLABLE:
+		case Variant::SIGNAL: {
+			p_writer.error = vformat(R"(Constant of type "%s" can't be stored in compiled bytecode.)", Variant::get_type_name(p_value.get_type()));
+			return false;
+		}
+		default: {
+			int length = 0;
+			Error err = encode_variant(p_value, nullptr, length, false);
+			if (err != OK) {
+				p_writer.error = "Error when trying to encode Variant.";
+				return false;
+			}
+			p_writer.put_u8(TAG_VALUE);
+			const int64_t position = p_writer.buffer.size();
+			p_writer.buffer.resize(position + length);
+			encode_variant(p_value, &p_writer.buffer.write[position], length, false);
+			return true;
+		}
+	}
+}
+
+bool GDScriptBinaryBytecode::_put_data_type(Writer &p_writer, const GDScriptDataType &p_type) {
+	p_writer.put_u8(p_type.kind);
+	p_writer.put_u32(p_type.builtin_type);
+	p_writer.put_string(p_type.native_type);
+	const bool has_script = p_type.kind == GDScriptDataType::SCRIPT || p_type.kind == GDScriptDataType::GDSCRIPT;
+	if (!_put_script_ref(p_writer, has_script ? p_type.script_type : nullptr)) {
+		return false;
+	}
+	p_writer.put_u32(p_type.container_element_types.size());
+	for (const GDScriptDataType &element_type : p_type.container_element_types) {
+		if (!_put_data_type(p_writer, element_type)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool GDScriptBinaryBytecode::_put_property_info(Writer &p_writer, const PropertyInfo &p_info) {
+	p_writer.put_u32(p_info.type);
+	p_writer.put_string(p_info.name);
+	p_writer.put_string(p_info.class_name);
+	p_writer.put_u32(p_info.hint);
+	p_writer.put_string(p_info.hint_string);
+	p_writer.put_u32(p_info.usage);
+	return true;
+}
+
+bool GDScriptBinaryBytecode::_put_method_info(Writer &p_writer, const MethodInfo &p_info) {
+	p_writer.put_string(p_info.name);
+	p_writer.put_u32(p_info.flags);
+	_put_property_info(p_writer, p_info.return_val);
+	p_writer.put_u32(p_info.arguments.size());
+	for (const PropertyInfo &argument : p_info.arguments) {
+		_put_property_info(p_writer, argument);
+	}
+	p_writer.put_u32(p_info.default_arguments.size());
+	for (const Variant &default_argument : p_info.default_arguments) {
+		if (!_put_variant(p_writer, default_argument)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool GDScriptBinaryBytecode::_put_member_info(Writer &p_writer, const StringName &p_name, const GDScript::MemberInfo &p_info) {
+	p_writer.put_string(p_name);
+	p_writer.put_u32(p_info.index);
+	p_writer.put_string(p_info.setter);
+	p_writer.put_string(p_info.getter);
+	return _put_data_type(p_writer, p_info.data_type) && _put_property_info(p_writer, p_info.property_info);
+}
+
+bool GDScriptBinaryBytecode::_put_function(Writer &p_writer, const GDScriptFunction *p_function) {
+	p_writer.put_string(p_function->name);
+	p_writer.put_u8(p_function->_static);
+	p_writer.put_u32(p_function->argument_types.size());
+	for (const GDScriptDataType &argument_type : p_function->argument_types) {
+		if (!_put_data_type(p_writer, argument_type)) {
+			return false;
+		}
+	}
+	if (!_put_data_type(p_writer, p_function->return_type) || !_put_method_info(p_writer, p_function->method_info) || !_put_variant(p_writer, p_function->rpc_config)) {
+		return false;
+	}
+
+	p_writer.put_u32(p_function->_initial_line);
+	p_writer.put_u32(p_function->_argument_count);
+	p_writer.put_u32(p_function->_vararg_index);
+	p_writer.put_u32(p_function->_stack_size);
+	p_writer.put_u32(p_function->_instruction_args_size);
+
+	p_writer.put_u32(p_function->temporary_slots.size());
+	for (const Pair<int, Variant::Type> &slot : p_function->temporary_slots) {
+		p_writer.put_u32(slot.first);
+		p_writer.put_u32(slot.second);
+	}
+
+	p_writer.put_u32(p_function->stack_debug.size());
+	for (const GDScriptFunction::StackDebug &sd : p_function->stack_debug) {
+		p_writer.put_u32(sd.line);
+		p_writer.put_u32(sd.pos);
+		p_writer.put_u8(sd.added);
+		p_writer.put_string(sd.identifier);
+	}
+
+	p_writer.put_u32(p_function->code.size());
+	for (const int &word : p_function->code) {
+		p_writer.put_u32(word);
+	}
+	p_writer.put_u32(p_function->default_arguments.size());
+	for (const int &default_argument : p_function->default_arguments) {
+		p_writer.put_u32(default_argument);
+	}
+
+	p_writer.put_u32(p_function->constants.size());
+	for (const Variant &constant : p_function->constants) {
+		if (!_put_variant(p_writer, constant)) {
+			return false;
+		}
+	}
+	p_writer.put_u32(p_function->constant_map.size());
+	for (const KeyValue<StringName, Variant> &E : p_function->constant_map) {
+		p_writer.put_string(E.key);
+		if (!_put_variant(p_writer, E.value)) {
+			return false;
+		}
+	}
+	p_writer.put_u32(p_function->global_names.size());
+	for (const StringName &global_name : p_function->global_names) {
+		p_writer.put_string(global_name);
+	}
+
+	const GDScriptPointerNames &names = _get_pointer_names();
+
+	p_writer.put_u32(p_function->operator_funcs.size());
+	for (const Variant::ValidatedOperatorEvaluator &evaluator : p_function->operator_funcs) {
+		const RBMap<Variant::ValidatedOperatorEvaluator, GDScriptPointerNames::OperatorName>::Element *E = names.operators.find(evaluator);
+		if (E == nullptr) {
+			p_writer.error = "Unknown validated operator.";
+			return false;
+		}
+		p_writer.put_u32(E->value().op);
+		p_writer.put_u32(E->value().type_a);
+		p_writer.put_u32(E->value().type_b);
+	}
+
+	p_writer.put_u32(p_function->setters.size());
+	for (const Variant::ValidatedSetter &setter : p_function->setters) {
+		const RBMap<Variant::ValidatedSetter, GDScriptPointerNames::MemberName>::Element *E = names.setters.find(setter);
+		if (E == nullptr) {
+			p_writer.error = "Unknown validated setter.";
+			return false;
+		}
+		p_writer.put_u32(E->value().type);
+		p_writer.put_string(E->value().name);
+	}
+
+	p_writer.put_u32(p_function->getters.size());
+	for (const Variant::ValidatedGetter &getter : p_function->getters) {
+		const RBMap<Variant::ValidatedGetter, GDScriptPointerNames::MemberName>::Element *E = names.getters.find(getter);
+		if (E == nullptr) {
+			p_writer.error = "Unknown validated getter.";
+			return false;
+		}
+		p_writer.put_u32(E->value().type);
+		p_writer.put_string(E->value().name);
+	}
+
+	p_writer.put_u32(p_function->keyed_setters.size());
+	for (const Variant::ValidatedKeyedSetter &keyed_setter : p_function->keyed_setters) {
+		const RBMap<Variant::ValidatedKeyedSetter, Variant::Type>::Element *E = names.keyed_setters.find(keyed_setter);
+		if (E == nullptr) {
+			p_writer.error = "Unknown validated keyed setter.";
+			return false;
+		}
+		p_writer.put_u32(E->value());
+	}
+
+	p_writer.put_u32(p_function->keyed_getters.size());
+	for (const Variant::ValidatedKeyedGetter &keyed_getter : p_function->keyed_getters) {
+		const RBMap<Variant::ValidatedKeyedGetter, Variant::Type>::Element *E = names.keyed_getters.find(keyed_getter);
+		if (E == nullptr) {
+			p_writer.error = "Unknown validated keyed getter.";
+			return false;
+		}
+		p_writer.put_u32(E->value());
+	}
+
+	p_writer.put_u32(p_function->indexed_setters.size());
+	for (const Variant::ValidatedIndexedSetter &indexed_setter : p_function->indexed_setters) {
+		const RBMap<Variant::ValidatedIndexedSetter, Variant::Type>::Element *E = names.indexed_setters.find(indexed_setter);
+		if (E == nullptr) {
+			p_writer.error = "Unknown validated indexed setter.";
+			return false;
+		}
+		p_writer.put_u32(E->value());
+	}
+
+	p_writer.put_u32(p_function->indexed_getters.size());
+	for (const Variant::ValidatedIndexedGetter &indexed_getter : p_function->indexed_getters) {
+		const RBMap<Variant::ValidatedIndexedGetter, Variant::Type>::Element *E = names.indexed_getters.find(indexed_getter);
+		if (E == nullptr) {
+			p_writer.error = "Unknown validated indexed getter.";
+			return false;
+		}
+		p_writer.put_u32(E->value());
+	}
+
+	p_writer.put_u32(p_function->builtin_methods.size());
+	for (const Variant::ValidatedBuiltInMethod &builtin_method : p_function->builtin_methods) {
+		const RBMap<Variant::ValidatedBuiltInMethod, GDScriptPointerNames::MemberName>::Element *E = names.builtin_methods.find(builtin_method);
+		if (E == nullptr) {
+			p_writer.error = "Unknown validated built-in method.";
+			return false;
+		}
+		p_writer.put_u32(E->value().type);
+		p_writer.put_string(E->value().name);
+	}
+
+	p_writer.put_u32(p_function->constructors.size());
+	for (const Variant::ValidatedConstructor &constructor : p_function->constructors) {
+		const RBMap<Variant::ValidatedConstructor, GDScriptPointerNames::ConstructorName>::Element *E = names.constructors.find(constructor);
+		if (E == nullptr) {
+			p_writer.error = "Unknown validated constructor.";
+			return false;
+		}
+		p_writer.put_u32(E->value().type);
+		p_writer.put_u32(E->value().index);
+	}
+
+	p_writer.put_u32(p_function->utilities.size());
+	for (const Variant::ValidatedUtilityFunction &utility : p_function->utilities) {
+		const RBMap<Variant::ValidatedUtilityFunction, StringName>::Element *E = names.utilities.find(utility);
+		if (E == nullptr) {
+			p_writer.error = "Unknown validated utility function.";
+			return false;
+		}
+		p_writer.put_string(E->value());
+	}
+
+	p_writer.put_u32(p_function->gds_utilities.size());
+	for (const GDScriptUtilityFunctions::FunctionPtr &gds_utility : p_function->gds_utilities) {
+		const RBMap<GDScriptUtilityFunctions::FunctionPtr, StringName>::Element *E = names.gds_utilities.find(gds_utility);
+		if (E == nullptr) {
+			p_writer.error = "Unknown GDScript utility function.";
+			return false;
+		}
+		p_writer.put_string(E->value());
+	}
+
+	p_writer.put_u32(p_function->methods.size());
+	for (const MethodBind *method : p_function->methods) {
+		p_writer.put_string(method->get_instance_class());
+		p_writer.put_string(method->get_name());
+	}
+
+	p_writer.put_u32(p_function->lambdas.size());
+	for (const GDScriptFunction *lambda : p_function->lambdas) {
+		const GDScript::LambdaInfo *info = lambda->_script->lambda_info.getptr(const_cast<GDScriptFunction *>(lambda));
+		p_writer.put_u32(info != nullptr ? info->capture_count : 0);
+		p_writer.put_u8(info != nullptr && info->use_self);
+		if (!_put_function(p_writer, lambda)) {
+			return false;
+		}
+	}
+
+	p_writer.put_u32(p_function->_inline_caches_count);
+	return true;
+}
+
+void GDScriptBinaryBytecode::_put_class_tree(Writer &p_writer, const GDScript *p_script) {
+	p_writer.put_string(p_script->fully_qualified_name);
+	p_writer.put_string(p_script->local_name);
+	p_writer.put_string(p_script->global_name);
+	p_writer.put_string(p_script->simplified_icon_path);
+	p_writer.put_u32(p_script->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		p_writer.put_string(E.key);
+		_put_class_tree(p_writer, E.value.ptr());
+	}
+}
+
+bool GDScriptBinaryBytecode::_put_class(Writer &p_writer, const GDScript *p_script) {
+	p_writer.put_u8(p_script->tool);
+	p_writer.put_u8(p_script->_is_abstract);
+	p_writer.put_string(p_script->native.is_valid() ? String(p_script->native->get_name()) : String());
+	if (!_put_script_ref(p_writer, p_script->base.ptr())) {
+		return false;
+	}
+
+	p_writer.put_u32(p_script->member_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->member_indices) {
+		if (!_put_member_info(p_writer, E.key, E.value)) {
+			return false;
+		}
+	}
+	p_writer.put_u32(p_script->members.size());
+	for (const StringName &member : p_script->members) {
+		p_writer.put_string(member);
+	}
+	p_writer.put_u32(p_script->static_variables_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->static_variables_indices) {
+		if (!_put_member_info(p_writer, E.key, E.value)) {
+			return false;
+		}
+	}
+
+	p_writer.put_u32(p_script->constants.size());
+	for (const KeyValue<StringName, Variant> &E : p_script->constants) {
+		p_writer.put_string(E.key);
+		if (!_put_variant(p_writer, E.value)) {
+			return false;
+		}
+	}
+	p_writer.put_u32(p_script->_signals.size());
+	for (const KeyValue<StringName, MethodInfo> &E : p_script->_signals) {
+		p_writer.put_string(E.key);
+		if (!_put_method_info(p_writer, E.value)) {
+			return false;
+		}
+	}
+	if (!_put_variant(p_writer, p_script->rpc_config)) {
+		return false;
+	}
+
+	p_writer.put_u32(p_script->member_functions.size());
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+		if (!_put_function(p_writer, E.value)) {
+			return false;
+		}
+	}
+	const GDScriptFunction *special_functions[] = { p_script->implicit_initializer, p_script->implicit_ready, p_script->static_initializer };
+	for (const GDScriptFunction *function : special_functions) {
+		p_writer.put_u8(function != nullptr);
+		if (function != nullptr && !_put_function(p_writer, function)) {
+			return false;
+		}
+	}
+
+	p_writer.put_u32(p_script->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		p_writer.put_string(E.key);
+		if (!_put_class(p_writer, E.value.ptr())) {
+			return false;
+		}
+	}
+	return true;
+}
+
+#endif // TOOLS_ENABLED
+
+Ref<Script> GDScriptBinaryBytecode::_get_script_ref(Reader &p_reader, bool &r_local) {
+	r_local = false;
+	switch (p_reader.get_u8()) {
+		case 0: {
+			return Ref<Script>();
+		}
+		case 1: {
+			const String path = p_reader.get_string();
+			const String fully_qualified_name = p_reader.get_string();
+			if (p_reader.failed) {
+				return Ref<Script>();
+			}
+
+			GDScript *root = p_reader.root;
+			Ref<GDScript> external;
+			if (path == root->get_script_path()) {
+				r_local = true;
+			} else {
+				// Same as the compiler, other scripts are loaded shallowly and finished after this one.
+				Error err = OK;
+				external = GDScriptCache::get_shallow_script(path, err, root->get_script_path());
+				if (err != OK || external.is_null()) {
+					p_reader.failed = true;
+					return Ref<Script>();
+				}
+				root = external.ptr();
+			}
+
+			GDScript *script = root->find_class(fully_qualified_name);
+			if (script == nullptr) {
+				p_reader.failed = true;
+				return Ref<Script>();
+			}
+			return Ref<Script>(script);
+		}
+		case 2: {
+			const String path = p_reader.get_string();
+			if (p_reader.failed) {
+				return Ref<Script>();
+			}
+			Ref<Script> script = ResourceLoader::load(path, "Script");
+			if (script.is_null()) {
+				p_reader.failed = true;
+			}
+			return script;
+		}
+	}
+	p_reader.failed = true;
+	return Ref<Script>();
+}
+
+bool GDScriptBinaryBytecode::_get_variant(Reader &p_reader, Variant &r_value) {
+	switch (p_reader.get_u8()) {
+		case TAG_VALUE: {
+			if (p_reader.failed) {
+				return false;
+			}
+			int length = 0;
+			Error err = decode_variant(r_value, &p_reader.data[p_reader.position], p_reader.size - p_reader.position, &length, false);
+			if (err != OK) {
+				p_reader.failed = true;
+				return false;
+			}
+			p_reader.position += length;
+			return true;
+		}
+		case TAG_NULL_OBJECT: {
+			r_value = Variant((Object *)nullptr);
+			return true;
+		}
+		case TAG_SCRIPT: {
+			bool local = false;
+			r_value = _get_script_ref(p_reader, local);
+			return !p_reader.failed;
+		}
+		case TAG_RESOURCE: {
+			const String path = p_reader.get_string();
+			if (p_reader.failed) {
+				return false;
+			}
+			// Same as `preload()`, see `GDScriptAnalyzer::reduce_preload()`.
+			const String type = ResourceLoader::get_resource_type(path);
+			Error err = OK;
+			Ref<Resource> resource = ResourceLoader::load(path, type, ResourceFormatLoader::CACHE_MODE_REUSE, &err);
+			if (err == ERR_BUSY) {
+				resource = ResourceLoader::ensure_resource_ref_override_for_outer_load(path, type);
+			}
+			if (resource.is_null()) {
+				p_reader.failed = true;
+				return false;
+			}
+			r_value = resource;
+			return true;
+		}
+		case TAG_NATIVE_CLASS: {
+			const StringName name = p_reader.get_string();
+			const HashMap<StringName, int> &global_map = GDScriptLanguage::get_singleton()->get_global_map();
+			HashMap<StringName, int>::ConstIterator E = global_map.find(name);
+			if (p_reader.failed || !E) {
+				p_reader.failed = true;
+				return false;
+			}
+			r_value = GDScriptLanguage::get_singleton()->get_global_array()[E->value];
+			if (Object::cast_to<GDScriptNativeClass>(r_value.get_validated_object()) == nullptr) {
+				p_reader.failed = true;
+				return false;
+			}
+			return true;
+		}
+		case TAG_ARRAY: {
+			const Variant::Type type = p_reader.get_type();
+			const StringName class_name = p_reader.get_string();
+			bool local = false;
+			const Ref<Script> script = _get_script_ref(p_reader, local);
+			const bool read_only = p_reader.get_u8();
+			uint32_t count = 0;
+			if (!p_reader.get_count(count, 1)) {
+				return false;
+			}
+
+			Array array;
+			if (type != Variant::NIL) {
+				array.set_typed(type, class_name, script.is_valid() ? Variant(script) : Variant());
+			}
+			for (uint32_t i = 0; i < count; i++) {
+				Variant element;
+				if (!_get_variant(p_reader, element)) {
+					return false;
+				}
+				array.push_back(element);
+			}
+			if (read_only) {
+				array.make_read_only();
+			}
+			r_value = array;
+			return true;
+		}
+		case TAG_DICTIONARY: {
+			bool local = false;
+			const Variant::Type key_type = p_reader.get_type();
+			const StringName key_class_name = p_reader.get_string();
+			const Ref<Script> key_script = _get_script_ref(p_reader, local);
+			const Variant::Type value_type = p_reader.get_type();
+			const StringName value_class_name = p_reader.get_string();
+			const Ref<Script> value_script = _get_script_ref(p_reader, local);
+			const bool read_only = p_reader.get_u8();
+			uint32_t count = 0;
+			if (!p_reader.get_count(count, 2)) {
+				return false;
+			}
+
+			Dictionary dictionary;
+			if (key_type != Variant::NIL || value_type != Variant::NIL) {
+				dictionary.set_typed(key_type, key_class_name, key_script.is_valid() ? Variant(key_script) : Variant(), value_type, value_class_name, value_script.is_valid() ? Variant(value_script) : Variant());
+			}
+			for (uint32_t i = 0; i < count; i++) {
+				Variant key;
+				Variant value;
+				if (!_get_variant(p_reader, key) || !_get_variant(p_reader, value)) {
+					return false;
+				}
+				dictionary[key] = value;
+			}
+			if (read_only) {
+				dictionary.make_read_only();
+			}
+			r_value = dictionary;
+			return true;
+		}
+	}
+	p_reader.failed = true;
+	return false;
+}
+
+bool GDScriptBinaryBytecode::_get_data_type(Reader &p_reader, GDScriptDataType &r_type) {
+	const uint8_t kind = p_reader.get_u8();
+	if (kind > GDScriptDataType::GDSCRIPT) {
+		p_reader.failed = true;
+		return false;
+	}
+	r_type.kind = GDScriptDataType::Kind(kind);
+	r_type.builtin_type = p_reader.get_type();
+	r_type.native_type = p_reader.get_string();
+
+	bool local = false;
+	Ref<Script> script = _get_script_ref(p_reader, local);
+	if (p_reader.failed) {
+		return false;
+	}
+	r_type.script_type = script.ptr();
+	if (!local) {
+		// Only hold a strong reference to scripts from other files, to avoid cyclic references (same as the compiler).
+		r_type.script_type_ref = script;
+	}
+
+	uint32_t count = 0;
+	if (!p_reader.get_count(count, 13)) {
+		return false;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		GDScriptDataType element_type;
+		if (!_get_data_type(p_reader, element_type)) {
+			return false;
+		}
+		r_type.set_container_element_type(i, element_type);
+	}
+	return !p_reader.failed;
+}
+
+bool GDScriptBinaryBytecode::_get_property_info(Reader &p_reader, PropertyInfo &r_info) {
+	r_info.type = p_reader.get_type();
+	r_info.name = p_reader.get_string();
+	r_info.class_name = p_reader.get_string();
+	r_info.hint = PropertyHint(p_reader.get_u32());
+	r_info.hint_string = p_reader.get_string();
+	r_info.usage = p_reader.get_u32();
+	return !p_reader.failed;
+}
+
+bool GDScriptBinaryBytecode::_get_method_info(Reader &p_reader, MethodInfo &r_info) {
+	r_info.name = p_reader.get_string();
+	r_info.flags = p_reader.get_u32();
+	if (!_get_property_info(p_reader, r_info.return_val)) {
+		return false;
+	}
+
+	uint32_t count = 0;
+	if (!p_reader.get_count(count, 24)) {
+		return false;
+	}
+	r_info.arguments.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		if (!_get_property_info(p_reader, r_info.arguments.write[i])) {
+			return false;
+		}
+	}
+
+	if (!p_reader.get_count(count, 1)) {
+		return false;
+	}
+	r_info.default_arguments.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		if (!_get_variant(p_reader, r_info.default_arguments.write[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool GDScriptBinaryBytecode::_get_member_info(Reader &p_reader, StringName &r_name, GDScript::MemberInfo &r_info) {
+	r_name = p_reader.get_string();
+	r_info.index = p_reader.get_i32();
+	r_info.setter = p_reader.get_string();
+	r_info.getter = p_reader.get_string();
+	return _get_data_type(p_reader, r_info.data_type) && _get_property_info(p_reader, r_info.property_info);
+}
+
+bool GDScriptBinaryBytecode::_get_function_tables(Reader &p_reader, GDScriptFunction *p_function) {
+	uint32_t count = 0;
+
+	if (!p_reader.get_count(count, 12)) {
+		return false;
+	}
+	p_function->operator_funcs.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		const uint32_t op = p_reader.get_u32();
+		const Variant::Type type_a = p_reader.get_type();
+		const Variant::Type type_b = p_reader.get_type();
+		if (p_reader.failed || op >= Variant::OP_MAX) {
+			return false;
+		}
+		p_function->operator_funcs.write[i] = Variant::get_validated_operator_evaluator(Variant::Operator(op), type_a, type_b);
+		if (p_function->operator_funcs[i] == nullptr) {
+			return false;
+		}
+#ifdef DEBUG_ENABLED
+		p_function->operator_names.push_back(Variant::get_operator_name(Variant::Operator(op)));
+#endif
+	}
+
+	if (!p_reader.get_count(count, 8)) {
+		return false;
+	}
+	p_function->setters.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		const Variant::Type type = p_reader.get_type();
+		const StringName member = p_reader.get_string();
+		p_function->setters.write[i] = Variant::get_member_validated_setter(type, member);
+		if (p_reader.failed || p_function->setters[i] == nullptr) {
+			return false;
+		}
+#ifdef DEBUG_ENABLED
+		p_function->setter_names.push_back(member);
+#endif
+	}
+
+	if (!p_reader.get_count(count, 8)) {
+		return false;
+	}
+	p_function->getters.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		const Variant::Type type = p_reader.get_type();
+		const StringName member = p_reader.get_string();
+		p_function->getters.write[i] = Variant::get_member_validated_getter(type, member);
+		if (p_reader.failed || p_function->getters[i] == nullptr) {
+			return false;
+		}
+#ifdef DEBUG_ENABLED
+		p_function->getter_names.push_back(member);
+#endif
+	}
+
+	if (!p_reader.get_count(count, 4)) {
+		return false;
+	}
+	p_function->keyed_setters.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		p_function->keyed_setters.write[i] = Variant::get_member_validated_keyed_setter(p_reader.get_type());
+		if (p_reader.failed || p_function->keyed_setters[i] == nullptr) {
+			return false;
+		}
+	}
+
+	if (!p_reader.get_count(count, 4)) {
+		return false;
+	}
+	p_function->keyed_getters.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		p_function->keyed_getters.write[i] = Variant::get_member_validated_keyed_getter(p_reader.get_type());
+		if (p_reader.failed || p_function->keyed_getters[i] == nullptr) {
+			return false;
+		}
+	}
+
+	if (!p_reader.get_count(count, 4)) {
+		return false;
+	}
+	p_function->indexed_setters.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		p_function->indexed_setters.write[i] = Variant::get_member_validated_indexed_setter(p_reader.get_type());
+		if (p_reader.failed || p_function->indexed_setters[i] == nullptr) {
+			return false;
+		}
+	}
+
+	if (!p_reader.get_count(count, 4)) {
+		return false;
+	}
+	p_function->indexed_getters.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		p_function->indexed_getters.write[i] = Variant::get_member_validated_indexed_getter(p_reader.get_type());
+		if (p_reader.failed || p_function->indexed_getters[i] == nullptr) {
+			return false;
+		}
+	}
+
+	if (!p_reader.get_count(count, 8)) {
+		return false;
+	}
+	p_function->builtin_methods.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		const Variant::Type type = p_reader.get_type();
+		const StringName method = p_reader.get_string();
+		p_function->builtin_methods.write[i] = Variant::get_validated_builtin_method(type, method);
+		if (p_reader.failed || p_function->builtin_methods[i] == nullptr) {
+			return false;
+		}
+#ifdef DEBUG_ENABLED
+		p_function->builtin_methods_names.push_back(method);
+#endif
+	}
+
+	if (!p_reader.get_count(count, 8)) {
+		return false;
+	}
+	p_function->constructors.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		const Variant::Type type = p_reader.get_type();
+		const int index = p_reader.get_i32();
+		if (p_reader.failed || index < 0 || index >= Variant::get_constructor_count(type)) {
+			return false;
+		}
+		p_function->constructors.write[i] = Variant::get_validated_constructor(type, index);
+		if (p_function->constructors[i] == nullptr) {
+			return false;
+		}
+#ifdef DEBUG_ENABLED
+		p_function->constructors_names.push_back(Variant::get_type_name(type));
+#endif
+	}
+
+	if (!p_reader.get_count(count, 4)) {
+		return false;
+	}
+	p_function->utilities.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		const StringName utility = p_reader.get_string();
+		p_function->utilities.write[i] = Variant::get_validated_utility_function(utility);
+		if (p_reader.failed || p_function->utilities[i] == nullptr) {
+			return false;
+		}
+#ifdef DEBUG_ENABLED
+		p_function->utilities_names.push_back(utility);
+#endif
+	}
+
+	if (!p_reader.get_count(count, 4)) {
+		return false;
+	}
+	p_function->gds_utilities.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		const StringName gds_utility = p_reader.get_string();
+		p_function->gds_utilities.write[i] = GDScriptUtilityFunctions::get_function(gds_utility);
+		if (p_reader.failed || p_function->gds_utilities[i] == nullptr) {
+			return false;
+		}
+#ifdef DEBUG_ENABLED
+		p_function->gds_utilities_names.push_back(gds_utility);
+#endif
+	}
+
+	if (!p_reader.get_count(count, 8)) {
+		return false;
+	}
+	p_function->methods.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		const StringName class_name = p_reader.get_string();
+		const StringName method = p_reader.get_string();
+		p_function->methods.write[i] = ClassDB::get_method(class_name, method);
+		if (p_reader.failed || p_function->methods[i] == nullptr) {
+			return false;
+		}
+	}
+
+	p_function->_operator_funcs_count = p_function->operator_funcs.size();
+	p_function->_operator_funcs_ptr = p_function->operator_funcs.is_empty() ? nullptr : p_function->operator_funcs.ptr();
+	p_function->_setters_count = p_function->setters.size();
+	p_function->_setters_ptr = p_function->setters.is_empty() ? nullptr : p_function->setters.ptr();
+	p_function->_getters_count = p_function->getters.size();
+	p_function->_getters_ptr = p_function->getters.is_empty() ? nullptr : p_function->getters.ptr();
+	p_function->_keyed_setters_count = p_function->keyed_setters.size();
+	p_function->_keyed_setters_ptr = p_function->keyed_setters.is_empty() ? nullptr : p_function->keyed_setters.ptr();
+	p_function->_keyed_getters_count = p_function->keyed_getters.size();
+	p_function->_keyed_getters_ptr = p_function->keyed_getters.is_empty() ? nullptr : p_function->keyed_getters.ptr();
+	p_function->_indexed_setters_count = p_function->indexed_setters.size();
+	p_function->_indexed_setters_ptr = p_function->indexed_setters.is_empty() ? nullptr : p_function->indexed_setters.ptr();
+	p_function->_indexed_getters_count = p_function->indexed_getters.size();
+	p_function->_indexed_getters_ptr = p_function->indexed_getters.is_empty() ? nullptr : p_function->indexed_getters.ptr();
+	p_function->_builtin_methods_count = p_function->builtin_methods.size();
+	p_function->_builtin_methods_ptr = p_function->builtin_methods.is_empty() ? nullptr : p_function->builtin_methods.ptr();
+	p_function->_constructors_count = p_function->constructors.size();
+	p_function->_constructors_ptr = p_function->constructors.is_empty() ? nullptr : p_function->constructors.ptr();
+	p_function->_utilities_count = p_function->utilities.size();
+	p_function->_utilities_ptr = p_function->utilities.is_empty() ? nullptr : p_function->utilities.ptr();
+	p_function->_gds_utilities_count = p_function->gds_utilities.size();
+	p_function->_gds_utilities_ptr = p_function->gds_utilities.is_empty() ? nullptr : p_function->gds_utilities.ptr();
+	p_function->_methods_count = p_function->methods.size();
+	p_function->_methods_ptr = p_function->methods.is_empty() ? nullptr : p_function->methods.ptrw();
+	return true;
+}
+
+GDScriptFunction *GDScriptBinaryBytecode::_get_function(Reader &p_reader, GDScript *p_script, bool p_lambda) {
+	GDScriptFunction *function = memnew(GDScriptFunction);
+	function->_script = p_script;
+	function->source = p_script->get_script_path();
+	function->name = p_reader.get_string();
+	function->_static = p_reader.get_u8();
+
+	bool valid = true;
+	uint32_t count = 0;
+
+	if (p_reader.get_count(count, 13)) {
+		function->argument_types.resize(count);
+		for (uint32_t i = 0; valid && i < count; i++) {
+			valid = _get_data_type(p_reader, function->argument_types.write[i]);
+		}
+	}
+	valid = valid && _get_data_type(p_reader, function->return_type) && _get_method_info(p_reader, function->method_info) && _get_variant(p_reader, function->rpc_config);
+
+	function->_initial_line = p_reader.get_i32();
+	function->_argument_count = p_reader.get_i32();
+	function->_vararg_index = p_reader.get_i32();
+	function->_stack_size = p_reader.get_i32();
+	function->_instruction_args_size = p_reader.get_i32();
+
+	if (valid && p_reader.get_count(count, 8)) {
+		for (uint32_t i = 0; i < count; i++) {
+			const int address = p_reader.get_i32();
+			const Variant::Type type = p_reader.get_type();
+			function->temporary_slots.push_back(Pair(address, type));
+		}
+	}
+
+	if (valid && p_reader.get_count(count, 13)) {
+		for (uint32_t i = 0; i < count; i++) {
+			GDScriptFunction::StackDebug sd;
+			sd.line = p_reader.get_i32();
+			sd.pos = p_reader.get_i32();
+			sd.added = p_reader.get_u8();
+			sd.identifier = p_reader.get_string();
+			function->stack_debug.push_back(sd);
+		}
+	}
+
+	if (valid && p_reader.get_count(count, 4)) {
+		function->code.resize(count);
+		for (uint32_t i = 0; i < count; i++) {
+			function->code.write[i] = p_reader.get_i32();
+		}
+	}
+	if (valid && p_reader.get_count(count, 4)) {
+		function->default_arguments.resize(count);
+		for (uint32_t i = 0; i < count; i++) {
+			function->default_arguments.write[i] = p_reader.get_i32();
+		}
+	}
+
+	if (valid && p_reader.get_count(count, 1)) {
+		function->constants.resize(count);
+		for (uint32_t i = 0; valid && i < count; i++) {
+			valid = _get_variant(p_reader, function->constants.write[i]);
+		}
+	}
+	if (valid && p_reader.get_count(count, 5)) {
+		for (uint32_t i = 0; valid && i < count; i++) {
+			const StringName constant_name = p_reader.get_string();
+			Variant value;
+			valid = _get_variant(p_reader, value);
+			function->constant_map.insert(constant_name, value);
+		}
+	}
+	if (valid && p_reader.get_count(count, 4)) {
+		function->global_names.resize(count);
+		for (uint32_t i = 0; i < count; i++) {
+			function->global_names.write[i] = p_reader.get_string();
+		}
+	}
+
+	valid = valid && !p_reader.failed && _get_function_tables(p_reader, function);
+
+	if (valid && p_reader.get_count(count, 6)) {
+		function->lambdas.resize(count);
+		for (uint32_t i = 0; i < count; i++) {
+			function->lambdas.write[i] = nullptr;
+		}
+		for (uint32_t i = 0; valid && i < count; i++) {
+			GDScript::LambdaInfo info;
+			info.capture_count = p_reader.get_i32();
+			info.use_self = p_reader.get_u8();
+			GDScriptFunction *lambda = p_reader.failed ? nullptr : _get_function(p_reader, p_script, true);
+			if (lambda == nullptr) {
+				valid = false;
+				break;
+			}
+			function->lambdas.write[i] = lambda;
+			p_script->lambda_info.insert(lambda, info);
+		}
+	}
+
+	const int inline_caches_count = p_reader.get_i32();
+
+	if (!valid || p_reader.failed || inline_caches_count < 0) {
+		// Lambdas read so far are owned by the function and freed with it.
+		Vector<GDScriptFunction *> lambdas;
+		for (GDScriptFunction *lambda : function->lambdas) {
+			if (lambda != nullptr) {
+				p_script->lambda_info.erase(lambda);
+				lambdas.push_back(lambda);
+			}
+		}
+		function->lambdas = lambdas;
+		memdelete(function);
+		p_reader.failed = true;
+		return nullptr;
+	}
+
+	function->_code_size = function->code.size();
+	function->_code_ptr = function->code.is_empty() ? nullptr : function->code.ptrw();
+	function->_default_arg_count = function->default_arguments.is_empty() ? 0 : function->default_arguments.size() - 1;
+	function->_default_arg_ptr = function->default_arguments.is_empty() ? nullptr : function->default_arguments.ptr();
+	function->_constant_count = function->constants.size();
+	function->_constants_ptr = function->constants.is_empty() ? nullptr : function->constants.ptrw();
+	function->_global_names_count = function->global_names.size();
+	function->_global_names_ptr = function->global_names.is_empty() ? nullptr : function->global_names.ptr();
+	function->_lambdas_count = function->lambdas.size();
+	function->_lambdas_ptr = function->lambdas.is_empty() ? nullptr : function->lambdas.ptrw();
+	if (inline_caches_count > 0) {
+		function->inline_caches.resize(inline_caches_count);
+		function->_inline_caches_ptr = function->inline_caches.ptr();
+	}
+	function->_inline_caches_count = inline_caches_count;
+
+#ifdef DEBUG_ENABLED
+	function->func_cname = (String(function->source) + " - " + String(function->name)).utf8();
+	function->_func_cname = function->func_cname.get_data();
+
+	if (EngineDebugger::is_active()) {
+		// Same signature as the compiler, except for the line, which is the one of the function rather than its body.
+		String signature = p_script->get_script_path() + "::" + itos(function->_initial_line);
+		if (p_script->local_name != StringName()) {
+			signature += "::" + String(p_script->local_name) + "." + String(function->name);
+		} else {
+			signature += "::" + String(function->name);
+		}
+		if (p_lambda) {
+			signature += "(lambda)";
+		}
+		function->profile.signature = signature;
+	}
+#endif
+
+	if (!_validate_function(function)) {
+		for (GDScriptFunction *lambda : function->lambdas) {
+			p_script->lambda_info.erase(lambda);
+		}
+		memdelete(function);
+		p_reader.failed = true;
+		return nullptr;
+	}
+	return function;
+}
+
+bool GDScriptBinaryBytecode::_validate_function(const GDScriptFunction *p_function) {
+	// Structural checks only: operands are not decoded, the bytecode is trusted once the file validates.
+	if (p_function->_code_size == 0 || p_function->code[0] < 0 || p_function->code[0] > GDScriptFunction::OPCODE_END) {
+		return false;
+	}
+	if (p_function->_stack_size < GDScriptFunction::FIXED_ADDRESSES_MAX || p_function->_stack_size > GDScriptFunction::ADDR_MASK) {
+		return false;
+	}
+	if (p_function->_instruction_args_size < 0 || p_function->_argument_count < 0 || p_function->_argument_count != p_function->argument_types.size()) {
+		return false;
+	}
+	if (p_function->_argument_count + GDScriptFunction::FIXED_ADDRESSES_MAX > p_function->_stack_size || p_function->_vararg_index >= p_function->_stack_size) {
+		return false;
+	}
+	if (p_function->_default_arg_count > p_function->_argument_count) {
+		return false;
+	}
+	for (const int &default_argument : p_function->default_arguments) {
+		if (default_argument < 0 || default_argument >= p_function->_code_size) {
+			return false;
+		}
+	}
+	for (const Pair<int, Variant::Type> &slot : p_function->temporary_slots) {
+		if (slot.first < GDScriptFunction::FIXED_ADDRESSES_MAX || slot.first >= p_function->_stack_size) {
+			return false;
+		}
+	}
+	for (const GDScriptFunction::StackDebug &sd : p_function->stack_debug) {
+		if (sd.pos < 0 || sd.pos >= p_function->_stack_size) {
+			return false;
+		}
+	}
+	return true;
+}
+
+Error GDScriptBinaryBytecode::_get_class_tree(Reader &p_reader, GDScript *p_script) {
+	// Mirrors `GDScriptCompiler::make_scripts()`.
+	p_script->fully_qualified_name = p_reader.get_string();
+	p_script->local_name = p_reader.get_string();
+	p_script->global_name = p_reader.get_string();
+	p_script->simplified_icon_path = p_reader.get_string();
+
+	HashMap<StringName, Ref<GDScript>> old_subclasses;
+	old_subclasses = p_script->subclasses;
+	p_script->subclasses.clear();
+
+	uint32_t count = 0;
+	if (!p_reader.get_count(count, 20)) {
+		return ERR_INVALID_DATA;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		const StringName name = p_reader.get_string();
+		if (p_reader.failed) {
+			return ERR_INVALID_DATA;
+		}
+
+		Ref<GDScript> subclass;
+		if (old_subclasses.has(name)) {
+			subclass = old_subclasses[name];
+		} else {
+			subclass = GDScriptLanguage::get_singleton()->get_orphan_subclass(p_script->fully_qualified_name + "::" + String(name));
+		}
+		if (subclass.is_null()) {
+			subclass.instantiate();
+		}
+
+		subclass->_owner = p_script;
+		subclass->path = p_script->path;
+		p_script->subclasses.insert(name, subclass);
+
+		Error err = _get_class_tree(p_reader, subclass.ptr());
+		if (err) {
+			return err;
+		}
+	}
+	return p_reader.failed ? ERR_INVALID_DATA : OK;
+}
+
+Error GDScriptBinaryBytecode::_get_class(Reader &p_reader, GDScript *p_script) {
+	// Only classes that were never compiled are loaded from bytecode, see `GDScript::reload()`.
+	ERR_FAIL_COND_V(!p_script->member_functions.is_empty() || p_script->implicit_initializer != nullptr, ERR_ALREADY_IN_USE);
+
+	p_script->tool = p_reader.get_u8();
+	p_script->_is_abstract = p_reader.get_u8();
+
+	const StringName native_name = p_reader.get_string();
+	HashMap<StringName, int>::ConstIterator native = GDScriptLanguage::get_singleton()->get_global_map().find(native_name);
+	if (p_reader.failed || !native) {
+		return ERR_INVALID_DATA;
+	}
+	p_script->native = GDScriptLanguage::get_singleton()->get_global_array()[native->value];
+	if (p_script->native.is_null()) {
+		return ERR_INVALID_DATA;
+	}
+
+	bool local = false;
+	Ref<Script> base = _get_script_ref(p_reader, local);
+	if (p_reader.failed || (base.is_valid() && Object::cast_to<GDScript>(base.ptr()) == nullptr)) {
+		return ERR_INVALID_DATA;
+	}
+	p_script->base = base;
+
+	uint32_t count = 0;
+	if (!p_reader.get_count(count, 32)) {
+		return ERR_INVALID_DATA;
+	}
+	p_script->member_indices.clear();
+	for (uint32_t i = 0; i < count; i++) {
+		StringName name;
+		GDScript::MemberInfo info;
+		if (!_get_member_info(p_reader, name, info)) {
+			return ERR_INVALID_DATA;
+		}
+		p_script->member_indices.insert(name, info);
+	}
+	if (!p_reader.get_count(count, 4)) {
+		return ERR_INVALID_DATA;
+	}
+	p_script->members.clear();
+	for (uint32_t i = 0; i < count; i++) {
+		p_script->members.insert(p_reader.get_string());
+	}
+	if (!p_reader.get_count(count, 32)) {
+		return ERR_INVALID_DATA;
+	}
+	p_script->static_variables_indices.clear();
+	for (uint32_t i = 0; i < count; i++) {
+		StringName name;
+		GDScript::MemberInfo info;
+		if (!_get_member_info(p_reader, name, info)) {
+			return ERR_INVALID_DATA;
+		}
+		p_script->static_variables_indices.insert(name, info);
+	}
+	p_script->static_variables.resize(p_script->static_variables_indices.size());
+
+	if (!p_reader.get_count(count, 5)) {
+		return ERR_INVALID_DATA;
+	}
+	p_script->constants.clear();
+	for (uint32_t i = 0; i < count; i++) {
+		const StringName name = p_reader.get_string();
+		Variant value;
+		if (!_get_variant(p_reader, value)) {
+			return ERR_INVALID_DATA;
+		}
+		p_script->constants.insert(name, value);
+	}
+	if (!p_reader.get_count(count, 12)) {
+		return ERR_INVALID_DATA;
+	}
+	p_script->_signals.clear();
+	for (uint32_t i = 0; i < count; i++) {
+		const StringName name = p_reader.get_string();
+		MethodInfo info;
+		if (!_get_method_info(p_reader, info)) {
+			return ERR_INVALID_DATA;
+		}
+		p_script->_signals[name] = info;
+	}
+	Variant rpc_config;
+	if (!_get_variant(p_reader, rpc_config) || rpc_config.get_type() != Variant::DICTIONARY) {
+		return ERR_INVALID_DATA;
+	}
+	p_script->rpc_config = rpc_config;
+
+	if (!p_reader.get_count(count, 8)) {
+		return ERR_INVALID_DATA;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		GDScriptFunction *function = _get_function(p_reader, p_script, false);
+		if (function == nullptr) {
+			return ERR_INVALID_DATA;
+		}
+		p_script->member_functions[function->name] = function;
+	}
+	HashMap<StringName, GDScriptFunction *>::Iterator initializer = p_script->member_functions.find(GDScriptLanguage::get_singleton()->strings._init);
+	p_script->initializer = initializer ? initializer->value : nullptr;
+
+	GDScriptFunction **special_functions[] = { &p_script->implicit_initializer, &p_script->implicit_ready, &p_script->static_initializer };
+	for (GDScriptFunction **function : special_functions) {
+		if (p_reader.get_u8()) {
+			*function = _get_function(p_reader, p_script, false);
+			if (*function == nullptr) {
+				return ERR_INVALID_DATA;
+			}
+		}
+	}
+
+	if (!p_reader.get_count(count, 4)) {
+		return ERR_INVALID_DATA;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		const StringName name = p_reader.get_string();
+		HashMap<StringName, Ref<GDScript>>::Iterator subclass = p_script->subclasses.find(name);
+		if (p_reader.failed || !subclass) {
+			return ERR_INVALID_DATA;
+		}
+		Error err = _get_class(p_reader, subclass->value.ptr());
+		if (err) {
+			return err;
+		}
+	}
+
+	p_script->_static_default_init();
+
+	p_script->valid = true;
+	return OK;
+}
+
+bool GDScriptBinaryBytecode::is_compiled_bytecode(const Vector<uint8_t> &p_buffer) {
+	return p_buffer.size() >= HEADER_SIZE && p_buffer[0] == 'G' && p_buffer[1] == 'D' && p_buffer[2] == 'S' && p_buffer[3] == 'B';
+}
+
+bool GDScriptBinaryBytecode::is_compatible(const Vector<uint8_t> &p_buffer) {
+	return is_compiled_bytecode(p_buffer) && decode_uint32(&p_buffer[4]) == FORMAT_VERSION && decode_uint32(&p_buffer[8]) == _get_engine_hash();
+}
+
+Vector<uint8_t> GDScriptBinaryBytecode::get_binary_tokens(const Vector<uint8_t> &p_buffer) {
+	ScriptData data;
+	if (_split(p_buffer, data) != OK) {
+		return Vector<uint8_t>();
+	}
+	return data.binary_tokens;
+}
+
+Error GDScriptBinaryBytecode::make_scripts(GDScript *p_script, const Vector<uint8_t> &p_buffer) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+	if (!is_compatible(p_buffer)) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+
+	ScriptData data;
+	Error err = _split(p_buffer, data);
+	if (err) {
+		return err;
+	}
+
+	Reader reader;
+	reader.data = data.tree;
+	reader.size = data.tree_size;
+	reader.root = p_script;
+	return _get_class_tree(reader, p_script);
+}
+
+Error GDScriptBinaryBytecode::load(GDScript *p_script, const Vector<uint8_t> &p_buffer) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+	if (!is_compatible(p_buffer)) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+
+	ScriptData data;
+	Error err = _split(p_buffer, data);
+	if (err) {
+		return err;
+	}
+	if (hash_djb2_buffer(data.payload, data.payload_size) != data.payload_hash) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	Vector<uint8_t> payload;
+	payload.resize(data.decompressed_size);
+	const int64_t result = Compression::decompress(payload.ptrw(), payload.size(), data.payload, data.payload_size, Compression::MODE_ZSTD);
+	if (result != data.decompressed_size) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	// Members and functions are about to change, drop what VM inline caches remember about them.
+	GDScriptFunction::invalidate_inline_caches();
+
+	Reader tree;
+	tree.data = data.tree;
+	tree.size = data.tree_size;
+	tree.root = p_script;
+	p_script->_owner = nullptr;
+	err = _get_class_tree(tree, p_script);
+	if (err) {
+		return err;
+	}
+
+	Reader reader;
+	reader.data = payload.ptr();
+	reader.size = payload.size();
+	reader.root = p_script;
+	err = _get_class(reader, p_script);
+	if (err) {
+		return err;
+	}
+	const bool static_script = reader.get_u8();
+	if (reader.failed || reader.position != reader.size) {
+		p_script->valid = false;
+		return ERR_FILE_CORRUPT;
+	}
+
+	if (static_script) {
+		GDScriptCache::add_static_script(p_script);
+	}
+	return GDScriptCache::finish_compiling(p_script->path);
+}
+
+#ifdef TOOLS_ENABLED
+
+Vector<uint8_t> GDScriptBinaryBytecode::save(GDScript *p_script, const Vector<uint8_t> &p_binary_tokens, String &r_error) {
+	ERR_FAIL_NULL_V(p_script, Vector<uint8_t>());
+	if (!p_script->is_valid()) {
+		r_error = "Script is not compiled.";
+		return Vector<uint8_t>();
+	}
+
+	Writer tree;
+	_put_class_tree(tree, p_script);
+
+	Writer payload;
+	if (!_put_class(payload, p_script)) {
+		r_error = payload.error;
+		return Vector<uint8_t>();
+	}
+	payload.put_u8(GDScriptCache::singleton->static_gdscript_cache.has(p_script->fully_qualified_name));
+
+	Vector<uint8_t> compressed;
+	compressed.resize(Compression::get_max_compressed_buffer_size(payload.buffer.size(), Compression::MODE_ZSTD));
+	const int64_t compressed_size = Compression::compress(compressed.ptrw(), payload.buffer.ptr(), payload.buffer.size(), Compression::MODE_ZSTD);
+	if (compressed_size < 0) {
+		r_error = "Error compressing GDScript bytecode.";
+		return Vector<uint8_t>();
+	}
+	compressed.resize(compressed_size);
+
+	Writer writer;
+	writer.put_u8('G');
+	writer.put_u8('D');
+	writer.put_u8('S');
+	writer.put_u8('B');
+	writer.put_u32(FORMAT_VERSION);
+	writer.put_u32(_get_engine_hash());
+	writer.put_data(p_binary_tokens);
+	writer.put_data(tree.buffer);
+	writer.put_u32(hash_djb2_buffer(compressed.ptr(), compressed.size()));
+	writer.put_u32(payload.buffer.size());
+	writer.buffer.append_array(compressed);
+	return writer.buffer;
+}
+
+#endif // TOOLS_ENABLED
@@ -0,0 +1,141 @@
+/**************************************************************************/
+/*  gdscript_binary_bytecode.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "gdscript.h"
+
+// Fully compiled GDScript, as written by the `MODE_SCRIPT_COMPILED_BYTECODE` export mode.
+//
+// The buffer stores the bytecode, constants and tables of every function of a script
+// (and of its inner classes), so loading it skips the parser, the analyzer and the
+// compiler. Pointer tables (validated operators, setters, method binds...) are stored
+// as descriptors and resolved again when loading.
+//
+// Layout:
+// - `GDSB` magic, format version, and engine build hash.
+// - Binary tokens of the script, used instead when the bytecode can't be loaded.
+// - Class tree (names and inner classes), read when the script is loaded shallowly.
+// - Hash, decompressed size, and ZSTD-compressed payload with the class bodies.
+//
+// The bytecode is only loaded by the engine build that wrote it, with the same debug
+// state. Any other build, or a payload that does not validate, falls back to the
+// binary tokens. Since the editor compiles debug bytecode, only debug exports use
+// this format; release exports only store the compressed binary tokens.
+class GDScriptBinaryBytecode {
+public:
+	static constexpr uint32_t FORMAT_VERSION = 1;
+	static constexpr int HEADER_SIZE = 16;
+
+private:
+	enum VariantTag {
+		TAG_VALUE,
+		TAG_NULL_OBJECT,
+		TAG_SCRIPT,
+		TAG_RESOURCE,
+		TAG_NATIVE_CLASS,
+		TAG_ARRAY,
+		TAG_DICTIONARY,
+	};
+
+	struct Writer {
+		Vector<uint8_t> buffer;
+		String error;
+
+		void put_u8(uint8_t p_value);
+		void put_u32(uint32_t p_value);
+		void put_string(const String &p_string);
+		void put_data(const Vector<uint8_t> &p_data);
+	};
+
+	struct Reader {
+		const uint8_t *data = nullptr;
+		int64_t size = 0;
+		int64_t position = 0;
+		bool failed = false;
+		GDScript *root = nullptr;
+
+		uint8_t get_u8();
+		uint32_t get_u32();
+		int32_t get_i32() { return (int32_t)get_u32(); }
+		Variant::Type get_type();
+		String get_string();
+		bool get_count(uint32_t &r_count, uint32_t p_min_item_size);
+	};
+
+	struct ScriptData {
+		Vector<uint8_t> binary_tokens;
+		const uint8_t *tree = nullptr;
+		int64_t tree_size = 0;
+		const uint8_t *payload = nullptr;
+		int64_t payload_size = 0;
+		uint32_t payload_hash = 0;
+		uint32_t decompressed_size = 0;
+	};
+
+	static uint32_t _get_engine_hash();
+	static Error _split(const Vector<uint8_t> &p_buffer, ScriptData &r_data);
+
+#ifdef TOOLS_ENABLED
+	static bool _put_script_ref(Writer &p_writer, const Script *p_script);
+	static bool _put_variant(Writer &p_writer, const Variant &p_value);
+	static bool _put_data_type(Writer &p_writer, const GDScriptDataType &p_type);
+	static bool _put_property_info(Writer &p_writer, const PropertyInfo &p_info);
+	static bool _put_method_info(Writer &p_writer, const MethodInfo &p_info);
+	static bool _put_member_info(Writer &p_writer, const StringName &p_name, const GDScript::MemberInfo &p_info);
+	static bool _put_function(Writer &p_writer, const GDScriptFunction *p_function);
+	static void _put_class_tree(Writer &p_writer, const GDScript *p_script);
+	static bool _put_class(Writer &p_writer, const GDScript *p_script);
+#endif
+
+	static Ref<Script> _get_script_ref(Reader &p_reader, bool &r_local);
+	static bool _get_variant(Reader &p_reader, Variant &r_value);
+	static bool _get_data_type(Reader &p_reader, GDScriptDataType &r_type);
+	static bool _get_property_info(Reader &p_reader, PropertyInfo &r_info);
+	static bool _get_method_info(Reader &p_reader, MethodInfo &r_info);
+	static bool _get_member_info(Reader &p_reader, StringName &r_name, GDScript::MemberInfo &r_info);
+	static bool _get_function_tables(Reader &p_reader, GDScriptFunction *p_function);
+	static GDScriptFunction *_get_function(Reader &p_reader, GDScript *p_script, bool p_lambda);
+	static Error _get_class_tree(Reader &p_reader, GDScript *p_script);
+	static Error _get_class(Reader &p_reader, GDScript *p_script);
+	static bool _validate_function(const GDScriptFunction *p_function);
+
+public:
+	static bool is_compiled_bytecode(const Vector<uint8_t> &p_buffer);
+	static bool is_compatible(const Vector<uint8_t> &p_buffer);
+	static Vector<uint8_t> get_binary_tokens(const Vector<uint8_t> &p_buffer);
+
+	static Error make_scripts(GDScript *p_script, const Vector<uint8_t> &p_buffer);
+	static Error load(GDScript *p_script, const Vector<uint8_t> &p_buffer);
+
+#ifdef TOOLS_ENABLED
+	static Vector<uint8_t> save(GDScript *p_script, const Vector<uint8_t> &p_binary_tokens, String &r_error);
+#endif
+};
@@ -0,0 +1,1185 @@
+/**************************************************************************/
+/*  gdscript_byte_code_optimizer.cpp                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_byte_code_optimizer.h"
+
+#include "gdscript_byte_codegen.h"
+
+// Upper bound on the number of times the pass pipeline is repeated, since
+// each pass can expose new opportunities to the others.
+static constexpr int MAX_ROUNDS = 4;
+
+static _FORCE_INLINE_ bool bitset_get(const uint64_t *p_bits, int p_index) {
+	return (p_bits[p_index >> 6] >> (p_index & 63)) & 1;
+}
+
+static _FORCE_INLINE_ void bitset_set(uint64_t *p_bits, int p_index) {
+	p_bits[p_index >> 6] |= uint64_t(1) << (p_index & 63);
+}
+
+static _FORCE_INLINE_ bool is_foldable_type(Variant::Type p_type) {
+	// Reference and object types can't be shared through the constant table,
+	// since folding would turn a fresh value into one shared by every call.
+	return p_type < Variant::RID;
+}
+
+int GDScriptByteCodeOptimizer::_get_temporary(int p_address) const {
+	if (((p_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS) != GDScriptFunction::ADDR_TYPE_STACK) {
+		return -1;
+	}
+	const int index = (p_address & GDScriptFunction::ADDR_MASK) - temporaries_base;
+	return (index >= 0 && index < temporary_count) ? index : -1;
+}
+
+bool GDScriptByteCodeOptimizer::_is_pure_temporary(int p_temporary) const {
+	// Temporaries pooled by built-in type never hold objects, so removing or
+	// sharing their stores can't change when a `RefCounted` is released.
+	const GDScriptByteCodeGenerator::StackSlot &slot = codegen->temporaries[p_temporary];
+	return slot.type != Variant::NIL && !slot.can_contain_object && !adjusted_temporaries[p_temporary];
+}
+
+bool GDScriptByteCodeOptimizer::_get_constant_value(int p_address, Variant &r_value) const {
+	if (((p_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS) != GDScriptFunction::ADDR_TYPE_CONSTANT) {
+		return false;
+	}
+	const int index = p_address & GDScriptFunction::ADDR_MASK;
+	if (index >= constants.size()) {
+		return false;
+	}
+	r_value = constants[index];
+	return true;
+}
+
+bool GDScriptByteCodeOptimizer::_get_operator(const Instruction &p_instruction, Variant::Operator &r_operator) const {
+	const int operator_word = code[p_instruction.position + 4];
+	if (p_instruction.opcode == GDScriptFunction::OPCODE_OPERATOR) {
+		r_operator = (Variant::Operator)operator_word;
+		return true;
+	}
+	const Variant::Operator *op = codegen->operator_func_operators.getptr(operator_word);
+	if (!op) {
+		return false;
+	}
+	r_operator = *op;
+	return true;
+}
+
+int GDScriptByteCodeOptimizer::_add_constant(const Variant &p_value) {
+	const int index = codegen->get_constant_pos(p_value);
+	if (index == constants.size()) {
+		constants.push_back(p_value);
+	}
+	return index | (GDScriptFunction::ADDR_TYPE_CONSTANT << GDScriptFunction::ADDR_BITS);
+}
+
+// Decodes an instruction laid out as `opcode, count, address * count, trailing words`,
+// where `p_trailing_words` matches the final `ip +=` of the VM implementation.
+// All addresses are marked as read, callers adjust the written ones.
+bool GDScriptByteCodeOptimizer::_decode_var_args(Instruction &r_instruction, int p_trailing_words) const {
+	if (r_instruction.position + 1 >= code.size()) {
+		return false;
+	}
+	const int count = code[r_instruction.position + 1];
+	if (count < 1) {
+		return false;
+	}
+	r_instruction.length = 1 + count + p_trailing_words;
+	for (int i = 0; i < count; i++) {
+		r_instruction.operands.push_back({ 2 + i, ACCESS_READ });
+	}
+	return true;
+}
+
+bool GDScriptByteCodeOptimizer::_decode_instruction(int p_position, Instruction &r_instruction) const {
+	r_instruction.opcode = (GDScriptFunction::Opcode)code[p_position];
+	r_instruction.position = p_position;
+	r_instruction.length = 0;
+	r_instruction.jump_offset = -1;
+	r_instruction.removed = false;
+	r_instruction.operands.clear();
+
+#define READ(m_offset) r_instruction.operands.push_back({ m_offset, ACCESS_READ })
+#define WRITE(m_offset) r_instruction.operands.push_back({ m_offset, ACCESS_WRITE })
+#define READ_WRITE(m_offset) r_instruction.operands.push_back({ m_offset, ACCESS_READ_WRITE })
+#define LAST_OPERAND(m_from_end) r_instruction.operands[r_instruction.operands.size() - (m_from_end)].access
+
+	const GDScriptFunction::Opcode opcode = r_instruction.opcode;
+	switch (opcode) {
+		case GDScriptFunction::OPCODE_OPERATOR: {
+			constexpr int _pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(int);
+			r_instruction.length = 7 + _pointer_size;
+			READ(1);
+			READ(2);
+			WRITE(3);
+		} break;
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED: {
+			r_instruction.length = 5;
+			READ(1);
+			READ(2);
+			WRITE(3);
+		} break;
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT: {
+			r_instruction.length = 8;
+			r_instruction.jump_offset = 7;
+			READ(1);
+			READ(2);
+			WRITE(3);
+			READ(6);
+		} break;
+		case GDScriptFunction::OPCODE_TYPE_TEST_BUILTIN:
+		case GDScriptFunction::OPCODE_TYPE_TEST_NATIVE: {
+			r_instruction.length = 4;
+			WRITE(1);
+			READ(2);
+		} break;
+		case GDScriptFunction::OPCODE_TYPE_TEST_SCRIPT: {
+			r_instruction.length = 4;
+			WRITE(1);
+			READ(2);
+			READ(3);
+		} break;
+		case GDScriptFunction::OPCODE_TYPE_TEST_ARRAY: {
+			r_instruction.length = 6;
+			WRITE(1);
+			READ(2);
+			READ(3);
+		} break;
+		case GDScriptFunction::OPCODE_TYPE_TEST_DICTIONARY: {
+			r_instruction.length = 9;
+			WRITE(1);
+			READ(2);
+			READ(3);
+			READ(4);
+		} break;
+		case GDScriptFunction::OPCODE_SET_KEYED: {
+			r_instruction.length = 4;
+			READ_WRITE(1);
+			READ(2);
+			READ(3);
+		} break;
+		case GDScriptFunction::OPCODE_SET_KEYED_VALIDATED:
+		case GDScriptFunction::OPCODE_SET_INDEXED_VALIDATED: {
+			r_instruction.length = 5;
+			READ_WRITE(1);
+			READ(2);
+			READ(3);
+		} break;
+		case GDScriptFunction::OPCODE_GET_KEYED: {
+			r_instruction.length = 4;
+			READ(1);
+			READ(2);
+			WRITE(3);
+		} break;
+		case GDScriptFunction::OPCODE_GET_KEYED_VALIDATED:
+		case GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED: {
+			r_instruction.length = 5;
+			READ(1);
+			READ(2);
+			WRITE(3);
+		} break;
+		case GDScriptFunction::OPCODE_SET_NAMED:
+		case GDScriptFunction::OPCODE_SET_NAMED_VALIDATED: {
+			// Only the unvalidated version has an inline cache index.
+			r_instruction.length = opcode == GDScriptFunction::OPCODE_SET_NAMED ? 5 : 4;
+			READ_WRITE(1);
+			READ(2);
+		} break;
+		case GDScriptFunction::OPCODE_GET_NAMED:
+		case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED: {
+			r_instruction.length = opcode == GDScriptFunction::OPCODE_GET_NAMED ? 5 : 4;
+			READ(1);
+			WRITE(2);
+		} break;
+		case GDScriptFunction::OPCODE_SET_MEMBER: {
+			r_instruction.length = 3;
+			READ(1);
+		} break;
+		case GDScriptFunction::OPCODE_GET_MEMBER: {
+			r_instruction.length = 3;
+			WRITE(1);
+		} break;
+		case GDScriptFunction::OPCODE_SET_STATIC_VARIABLE: {
+			r_instruction.length = 4;
+			READ(1);
+			READ(2);
+		} break;
+		case GDScriptFunction::OPCODE_GET_STATIC_VARIABLE: {
+			r_instruction.length = 4;
+			WRITE(1);
+			READ(2);
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN: {
+			r_instruction.length = 3;
+			WRITE(1);
+			READ(2);
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_NULL:
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE: {
+			r_instruction.length = 2;
+			WRITE(1);
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN: {
+			r_instruction.length = 4;
+			WRITE(1);
+			READ(2);
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_NATIVE:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_SCRIPT: {
+			r_instruction.length = 4;
+			WRITE(1);
+			READ(2);
+			READ(3);
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_ARRAY: {
+			r_instruction.length = 6;
+			WRITE(1);
+			READ(2);
+			READ(3);
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_DICTIONARY: {
+			r_instruction.length = 9;
+			WRITE(1);
+			READ(2);
+			READ(3);
+			READ(4);
+		} break;
+		case GDScriptFunction::OPCODE_CAST_TO_BUILTIN: {
+			r_instruction.length = 4;
+			READ(1);
+			WRITE(2);
+		} break;
+		case GDScriptFunction::OPCODE_CAST_TO_NATIVE:
+		case GDScriptFunction::OPCODE_CAST_TO_SCRIPT: {
+			r_instruction.length = 4;
+			READ(1);
+			WRITE(2);
+			READ(3);
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT:
+		case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED: {
+			if (!_decode_var_args(r_instruction, 3)) {
+				return false;
+			}
+			LAST_OPERAND(1) = ACCESS_WRITE;
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT_ARRAY:
+		case GDScriptFunction::OPCODE_CONSTRUCT_DICTIONARY: {
+			if (!_decode_var_args(r_instruction, 2)) {
+				return false;
+			}
+			LAST_OPERAND(1) = ACCESS_WRITE;
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT_TYPED_ARRAY: {
+			// Arguments, target, script type.
+			if (!_decode_var_args(r_instruction, 4) || r_instruction.operands.size() < 2) {
+				return false;
+			}
+			LAST_OPERAND(2) = ACCESS_WRITE;
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT_TYPED_DICTIONARY: {
+			// Arguments, target, key script type, value script type.
+			if (!_decode_var_args(r_instruction, 6) || r_instruction.operands.size() < 3) {
+				return false;
+			}
+			LAST_OPERAND(3) = ACCESS_WRITE;
+		} break;
+		case GDScriptFunction::OPCODE_CALL:
+		case GDScriptFunction::OPCODE_CALL_RETURN:
+		case GDScriptFunction::OPCODE_CALL_ASYNC:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_RET:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN:
+		case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED: {
+			// Arguments, base, return. The base may be modified in place by the call.
+			// Unvalidated calls also have an inline cache index.
+			const bool cached = opcode == GDScriptFunction::OPCODE_CALL || opcode == GDScriptFunction::OPCODE_CALL_RETURN || opcode == GDScriptFunction::OPCODE_CALL_ASYNC;
+			if (!_decode_var_args(r_instruction, cached ? 4 : 3) || r_instruction.operands.size() < 2) {
+				return false;
+			}
+			LAST_OPERAND(2) = ACCESS_READ_WRITE;
+			LAST_OPERAND(1) = opcode == GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN ? ACCESS_READ_WRITE : ACCESS_WRITE;
+		} break;
+		case GDScriptFunction::OPCODE_CALL_BUILTIN_STATIC: {
+			if (!_decode_var_args(r_instruction, 4)) {
+				return false;
+			}
+			LAST_OPERAND(1) = ACCESS_WRITE;
+		} break;
+		case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC:
+		case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN:
+		case GDScriptFunction::OPCODE_CALL_UTILITY:
+		case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED:
+		case GDScriptFunction::OPCODE_CALL_GDSCRIPT_UTILITY:
+		case GDScriptFunction::OPCODE_CALL_SELF_BASE:
+		case GDScriptFunction::OPCODE_CREATE_LAMBDA:
+		case GDScriptFunction::OPCODE_CREATE_SELF_LAMBDA: {
+			if (!_decode_var_args(r_instruction, 3)) {
+				return false;
+			}
+			LAST_OPERAND(1) = ACCESS_WRITE;
+		} break;
+		case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_NO_RETURN: {
+			// The return address is reserved but not necessarily written.
+			if (!_decode_var_args(r_instruction, 3)) {
+				return false;
+			}
+			LAST_OPERAND(1) = ACCESS_READ_WRITE;
+		} break;
+		case GDScriptFunction::OPCODE_AWAIT: {
+			// Decoded together with the `OPCODE_AWAIT_RESUME` that always follows it,
+			// since the VM may write the result and skip over it.
+			if (p_position + 2 >= code.size() || code[p_position + 2] != GDScriptFunction::OPCODE_AWAIT_RESUME) {
+				return false;
+			}
+			r_instruction.length = 4;
+			READ(1);
+			WRITE(3);
+		} break;
+		case GDScriptFunction::OPCODE_JUMP: {
+			r_instruction.length = 2;
+			r_instruction.jump_offset = 1;
+		} break;
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+		case GDScriptFunction::OPCODE_JUMP_IF_SHARED: {
+			r_instruction.length = 3;
+			r_instruction.jump_offset = 2;
+			READ(1);
+		} break;
+		case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT:
+		case GDScriptFunction::OPCODE_BREAKPOINT:
+		case GDScriptFunction::OPCODE_END: {
+			r_instruction.length = 1;
+		} break;
+		case GDScriptFunction::OPCODE_RETURN: {
+			r_instruction.length = 2;
+			READ(1);
+		} break;
+		case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN: {
+			r_instruction.length = 3;
+			READ(1);
+		} break;
+		case GDScriptFunction::OPCODE_RETURN_TYPED_NATIVE:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_SCRIPT: {
+			r_instruction.length = 3;
+			READ(1);
+			READ(2);
+		} break;
+		case GDScriptFunction::OPCODE_RETURN_TYPED_ARRAY: {
+			r_instruction.length = 5;
+			READ(1);
+			READ(2);
+		} break;
+		case GDScriptFunction::OPCODE_RETURN_TYPED_DICTIONARY: {
+			r_instruction.length = 8;
+			READ(1);
+			READ(2);
+			READ(3);
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_RANGE: {
+			r_instruction.length = 7;
+			r_instruction.jump_offset = 6;
+			READ_WRITE(1);
+			READ(2);
+			READ(3);
+			READ(4);
+			READ_WRITE(5); // Left untouched when the loop is skipped.
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_RANGE: {
+			r_instruction.length = 6;
+			r_instruction.jump_offset = 5;
+			READ_WRITE(1);
+			READ(2);
+			READ(3);
+			READ_WRITE(4);
+		} break;
+		case GDScriptFunction::OPCODE_STORE_GLOBAL:
+		case GDScriptFunction::OPCODE_STORE_NAMED_GLOBAL: {
+			r_instruction.length = 3;
+			WRITE(1);
+		} break;
+		case GDScriptFunction::OPCODE_GET_NODE_CACHED: {
+			r_instruction.length = 3;
+			READ(1);
+			WRITE(2);
+		} break;
+		case GDScriptFunction::OPCODE_ASSERT: {
+			r_instruction.length = 3;
+			READ(1);
+			READ(2);
+		} break;
+		case GDScriptFunction::OPCODE_LINE: {
+			r_instruction.length = 2;
+		} break;
+		default: {
+			if ((opcode >= GDScriptFunction::OPCODE_ITERATE_BEGIN && opcode <= GDScriptFunction::OPCODE_ITERATE_BEGIN_OBJECT) ||
+					(opcode >= GDScriptFunction::OPCODE_ITERATE && opcode <= GDScriptFunction::OPCODE_ITERATE_OBJECT)) {
+				r_instruction.length = 5;
+				r_instruction.jump_offset = 4;
+				READ_WRITE(1);
+				READ(2);
+				READ_WRITE(3); // Left untouched when the loop ends.
+			} else if (opcode >= GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL && opcode <= GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY) {
+				r_instruction.length = 2;
+				WRITE(1);
+			} else if (opcode >= GDScriptFunction::OPCODE_GET_INDEXED_ARRAY && opcode <= GDScriptFunction::OPCODE_GET_INDEXED_PACKED_VECTOR3_ARRAY_IN_BOUNDS) {
+				r_instruction.length = 4;
+				READ(1);
+				READ(2);
+				WRITE(3);
+			} else if (opcode >= GDScriptFunction::OPCODE_SET_INDEXED_TYPED_ARRAY && opcode <= GDScriptFunction::OPCODE_SET_INDEXED_PACKED_VECTOR3_ARRAY_IN_BOUNDS) {
+				r_instruction.length = 4;
+				READ_WRITE(1);
+				READ(2);
+				READ(3);
+			} else {
+				// Includes a stray `OPCODE_AWAIT_RESUME`.
+				return false;
+			}
+		} break;
+	}
+
+#undef READ
+#undef WRITE
+#undef READ_WRITE
+#undef LAST_OPERAND
+
+	r_instruction.original_length = r_instruction.length;
+	return r_instruction.length > 0 && p_position + r_instruction.length <= code.size();
+}
+
+bool GDScriptByteCodeOptimizer::_decode() {
+	instructions.clear();
+	instruction_at.clear();
+	instruction_at.resize(code.size() + 1);
+	for (int &index : instruction_at) {
+		index = -1;
+	}
+
+	int position = 0;
+	while (position < code.size()) {
+		Instruction instruction;
+		if (!_decode_instruction(position, instruction)) {
+			return false;
+		}
+		instruction_at[position] = instructions.size();
+		position += instruction.length;
+		instructions.push_back(instruction);
+	}
+	instruction_at[code.size()] = instructions.size();
+
+	// Every jump must land on an instruction boundary, otherwise the code can't be safely rewritten.
+	for (const Instruction &instruction : instructions) {
+		if (instruction.jump_offset >= 0) {
+			const int target = code[instruction.position + instruction.jump_offset];
+			if (target < 0 || target > code.size() || instruction_at[target] < 0) {
+				return false;
+			}
+		}
+		for (const Operand &operand : instruction.operands) {
+			const int temporary = _get_temporary(code[instruction.position + operand.offset]);
+			if (temporary >= 0 && instruction.opcode >= GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL && instruction.opcode <= GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY) {
+				adjusted_temporaries[temporary] = true;
+			}
+		}
+	}
+
+	entry_points.clear();
+	if (!instructions.is_empty()) {
+		entry_points.push_back(0);
+	}
+	for (const int &default_argument : codegen->function->default_arguments) {
+		if (default_argument < 0 || default_argument > code.size() || instruction_at[default_argument] < 0) {
+			return false;
+		}
+		if (instruction_at[default_argument] < (int)instructions.size()) {
+			entry_points.push_back(instruction_at[default_argument]);
+		}
+	}
+	return true;
+}
+
+void GDScriptByteCodeOptimizer::_encode() {
+	// Map every old position to the new position of the first kept instruction at or after it.
+	LocalVector<int> new_position;
+	new_position.resize(code.size() + 1);
+
+	int new_size = 0;
+	for (const Instruction &instruction : instructions) {
+		if (!instruction.removed) {
+			new_size += instruction.length;
+		}
+	}
+	new_position[code.size()] = new_size;
+
+	int next_position = new_size;
+	for (int i = (int)instructions.size() - 1; i >= 0; i--) {
+		const Instruction &instruction = instructions[i];
+		if (!instruction.removed) {
+			next_position -= instruction.length;
+		}
+		for (int j = 0; j < instruction.original_length; j++) {
+			new_position[instruction.position + j] = next_position;
+		}
+	}
+
+	Vector<int> new_code;
+	new_code.resize(new_size);
+	int *dst = new_code.ptrw();
+	for (const Instruction &instruction : instructions) {
+		if (instruction.removed) {
+			continue;
+		}
+		for (int j = 0; j < instruction.length; j++) {
+			dst[j] = code[instruction.position + j];
+		}
+		if (instruction.jump_offset >= 0) {
+			dst[instruction.jump_offset] = new_position[code[instruction.position + instruction.jump_offset]];
+		}
+		dst += instruction.length;
+	}
+
+	for (int &default_argument : codegen->function->default_arguments) {
+		default_argument = new_position[default_argument];
+	}
+	for (GDScriptFunction::StackDebug &sd : codegen->stack_debug) {
+		if (sd.pos >= 0 && sd.pos <= code.size()) {
+			sd.pos = new_position[sd.pos];
+		}
+	}
+
+	code = new_code;
+	codegen->opcodes = code;
+}
+
+void GDScriptByteCodeOptimizer::_get_successors(int p_index, LocalVector<int> &r_successors) const {
+	r_successors.clear();
+	const Instruction &instruction = instructions[p_index];
+	const int next = p_index + 1 < (int)instructions.size() ? p_index + 1 : -1;
+
+	if (instruction.removed) {
+		// Removed instructions behave as if they weren't there.
+		if (next >= 0) {
+			r_successors.push_back(next);
+		}
+		return;
+	}
+
+	switch (instruction.opcode) {
+		case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT: {
+			for (const int &entry : entry_points) {
+				if (entry != 0) {
+					r_successors.push_back(entry);
+				}
+			}
+			return;
+		}
+		case GDScriptFunction::OPCODE_RETURN:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_ARRAY:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_DICTIONARY:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_NATIVE:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_SCRIPT:
+		case GDScriptFunction::OPCODE_END: {
+			return;
+		}
+		default: {
+		} break;
+	}
+
+	if (instruction.opcode != GDScriptFunction::OPCODE_JUMP && next >= 0) {
+		r_successors.push_back(next);
+	}
+	if (instruction.jump_offset >= 0) {
+		const int target = instruction_at[code[instruction.position + instruction.jump_offset]];
+		// Jumping to the end of the code exits the function.
+		if (target < (int)instructions.size() && target != next) {
+			r_successors.push_back(target);
+		}
+	}
+}
+
+void GDScriptByteCodeOptimizer::_compute_liveness() {
+	const int count = instructions.size();
+	bitset_words = MAX(1, (temporary_count + 63) / 64);
+
+	LocalVector<uint64_t> uses;
+	LocalVector<uint64_t> defs;
+	uses.resize_initialized(count * bitset_words);
+	defs.resize_initialized(count * bitset_words);
+	live_in.clear();
+	live_in.resize_initialized(count * bitset_words);
+	live_out.clear();
+	live_out.resize_initialized(count * bitset_words);
+
+	for (int i = 0; i < count; i++) {
+		const Instruction &instruction = instructions[i];
+		for (const Operand &operand : instruction.operands) {
+			const int temporary = _get_temporary(code[instruction.position + operand.offset]);
+			if (temporary < 0) {
+				continue;
+			}
+			if (operand.access == ACCESS_WRITE) {
+				bitset_set(&defs[i * bitset_words], temporary);
+			} else {
+				bitset_set(&uses[i * bitset_words], temporary);
+			}
+		}
+	}
+
+	LocalVector<int> successors;
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		for (int i = count - 1; i >= 0; i--) {
+			uint64_t *out = &live_out[i * bitset_words];
+			uint64_t *in = &live_in[i * bitset_words];
+			_get_successors(i, successors);
+			for (const int &successor : successors) {
+				const uint64_t *successor_in = &live_in[successor * bitset_words];
+				for (int w = 0; w < bitset_words; w++) {
+					out[w] |= successor_in[w];
+				}
+			}
+			const uint64_t *use = &uses[i * bitset_words];
+			const uint64_t *def = &defs[i * bitset_words];
+			for (int w = 0; w < bitset_words; w++) {
+				const uint64_t value = use[w] | (out[w] & ~def[w]);
+				if (value != in[w]) {
+					in[w] = value;
+					changed = true;
+				}
+			}
+		}
+	}
+}
+
+// Jump threading, folding of conditional jumps on constants, removal of jumps
+// to the next instruction and of unreachable code.
+bool GDScriptByteCodeOptimizer::_simplify_control_flow() {
+	bool changed = false;
+	const int count = instructions.size();
+
+	for (Instruction &instruction : instructions) {
+		if (instruction.jump_offset < 0) {
+			continue;
+		}
+		int *target = &code.write[instruction.position + instruction.jump_offset];
+		for (int steps = 0; steps < count; steps++) {
+			const int index = instruction_at[*target];
+			if (index >= count || instructions[index].opcode != GDScriptFunction::OPCODE_JUMP) {
+				break;
+			}
+			const int next_target = code[instructions[index].position + 1];
+			if (next_target == *target) {
+				break; // Infinite loop, leave it alone.
+			}
+			*target = next_target;
+			changed = true;
+		}
+	}
+
+	for (Instruction &instruction : instructions) {
+		if (instruction.opcode != GDScriptFunction::OPCODE_JUMP_IF && instruction.opcode != GDScriptFunction::OPCODE_JUMP_IF_NOT) {
+			continue;
+		}
+		Variant condition;
+		if (!_get_constant_value(code[instruction.position + 1], condition) || !is_foldable_type(condition.get_type())) {
+			continue;
+		}
+		if (condition.booleanize() == (instruction.opcode == GDScriptFunction::OPCODE_JUMP_IF)) {
+			code.write[instruction.position] = GDScriptFunction::OPCODE_JUMP;
+			code.write[instruction.position + 1] = code[instruction.position + 2];
+			instruction.opcode = GDScriptFunction::OPCODE_JUMP;
+			instruction.length = 2;
+			instruction.jump_offset = 1;
+			instruction.operands.clear();
+		} else {
+			instruction.removed = true;
+		}
+		changed = true;
+	}
+
+	for (Instruction &instruction : instructions) {
+		if (instruction.removed) {
+			continue;
+		}
+		switch (instruction.opcode) {
+			case GDScriptFunction::OPCODE_JUMP:
+			case GDScriptFunction::OPCODE_JUMP_IF:
+			case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+			case GDScriptFunction::OPCODE_JUMP_IF_SHARED: {
+				if (code[instruction.position + instruction.jump_offset] == instruction.position + instruction.original_length) {
+					instruction.removed = true;
+					changed = true;
+				}
+			} break;
+			default: {
+			} break;
+		}
+	}
+
+	LocalVector<bool> reachable;
+	reachable.resize_initialized(count);
+	LocalVector<int> stack;
+	for (const int &entry : entry_points) {
+		if (!reachable[entry]) {
+			reachable[entry] = true;
+			stack.push_back(entry);
+		}
+	}
+	LocalVector<int> successors;
+	while (!stack.is_empty()) {
+		const int index = stack[stack.size() - 1];
+		stack.resize(stack.size() - 1);
+		_get_successors(index, successors);
+		for (const int &successor : successors) {
+			if (!reachable[successor]) {
+				reachable[successor] = true;
+				stack.push_back(successor);
+			}
+		}
+	}
+	// The final `OPCODE_END` is always kept.
+	for (int i = 0; i < count - 1; i++) {
+		if (!reachable[i] && !instructions[i].removed) {
+			instructions[i].removed = true;
+			changed = true;
+		}
+	}
+
+	return changed;
+}
+
+// Block-local copy propagation of `OPCODE_ASSIGN` into temporaries, combined
+// with folding of operators whose operands both end up being constants.
+bool GDScriptByteCodeOptimizer::_propagate_copies() {
+	bool changed = false;
+	const int count = instructions.size();
+
+	LocalVector<bool> leaders;
+	leaders.resize_initialized(count);
+	for (const int &entry : entry_points) {
+		leaders[entry] = true;
+	}
+	for (int i = 0; i < count; i++) {
+		const Instruction &instruction = instructions[i];
+		const bool ends_block = instruction.jump_offset >= 0 || instruction.opcode == GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT ||
+				(instruction.opcode >= GDScriptFunction::OPCODE_RETURN && instruction.opcode <= GDScriptFunction::OPCODE_RETURN_TYPED_SCRIPT);
+		if (ends_block && i + 1 < count) {
+			leaders[i + 1] = true;
+		}
+		if (instruction.jump_offset >= 0) {
+			const int target = instruction_at[code[instruction.position + instruction.jump_offset]];
+			if (target < count) {
+				leaders[target] = true;
+			}
+		}
+	}
+
+	// Source address currently held by each temporary, or -1.
+	LocalVector<int> copies;
+	copies.resize(temporary_count);
+
+	for (int i = 0; i < count; i++) {
+		Instruction &instruction = instructions[i];
+		if (leaders[i]) {
+			for (int &copy : copies) {
+				copy = -1;
+			}
+		}
+
+		for (const Operand &operand : instruction.operands) {
+			if (operand.access != ACCESS_READ) {
+				continue;
+			}
+			int &address = code.write[instruction.position + operand.offset];
+			const int temporary = _get_temporary(address);
+			if (temporary < 0 || copies[temporary] == -1) {
+				continue;
+			}
+			// Don't make an instruction read from the address it writes to,
+			// not every implementation is safe against aliasing.
+			bool aliased = false;
+			for (const Operand &other : instruction.operands) {
+				if (other.access != ACCESS_READ && code[instruction.position + other.offset] == copies[temporary]) {
+					aliased = true;
+					break;
+				}
+			}
+			if (!aliased) {
+				address = copies[temporary];
+				changed = true;
+			}
+		}
+
+		if (instruction.opcode == GDScriptFunction::OPCODE_OPERATOR || instruction.opcode == GDScriptFunction::OPCODE_OPERATOR_VALIDATED) {
+			Variant left;
+			Variant right;
+			Variant::Operator op;
+			bool foldable = _get_operator(instruction, op) && _get_constant_value(code[instruction.position + 1], left);
+			if (foldable && code[instruction.position + 2] == GDScriptFunction::ADDR_NIL) {
+				// Unary operators take the nil address as right operand.
+				foldable = op == Variant::OP_NEGATE || op == Variant::OP_POSITIVE || op == Variant::OP_NOT || op == Variant::OP_BIT_NEGATE;
+			} else if (foldable) {
+				foldable = _get_constant_value(code[instruction.position + 2], right);
+			}
+			if (foldable && is_foldable_type(left.get_type()) && is_foldable_type(right.get_type())) {
+				Variant result;
+				bool valid = false;
+				Variant::evaluate(op, left, right, result, valid);
+				if (valid && is_foldable_type(result.get_type())) {
+					const int target = code[instruction.position + 3];
+					code.write[instruction.position] = GDScriptFunction::OPCODE_ASSIGN;
+					code.write[instruction.position + 1] = target;
+					code.write[instruction.position + 2] = _add_constant(result);
+					instruction.opcode = GDScriptFunction::OPCODE_ASSIGN;
+					instruction.length = 3;
+					instruction.operands.clear();
+					instruction.operands.push_back({ 1, ACCESS_WRITE });
+					instruction.operands.push_back({ 2, ACCESS_READ });
+					changed = true;
+				}
+			}
+		}
+
+		for (const Operand &operand : instruction.operands) {
+			if (operand.access == ACCESS_READ) {
+				continue;
+			}
+			const int address = code[instruction.position + operand.offset];
+			const int temporary = _get_temporary(address);
+			if (temporary >= 0) {
+				copies[temporary] = -1;
+			}
+			for (int &copy : copies) {
+				if (copy == address) {
+					copy = -1;
+				}
+			}
+		}
+
+		if (instruction.opcode == GDScriptFunction::OPCODE_ASSIGN) {
+			const int target = code[instruction.position + 1];
+			const int source = code[instruction.position + 2];
+			const int temporary = _get_temporary(target);
+			// Members can change behind our back (e.g. from a setter), stack slots and constants can't.
+			const int source_type = (source & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS;
+			if (temporary >= 0 && source != target && (source_type == GDScriptFunction::ADDR_TYPE_STACK || source_type == GDScriptFunction::ADDR_TYPE_CONSTANT)) {
+				copies[temporary] = source;
+			}
+		}
+	}
+
+	return changed;
+}
+
+bool GDScriptByteCodeOptimizer::_eliminate_dead_stores() {
+	_compute_liveness();
+
+	bool changed = false;
+	for (uint32_t i = 0; i < instructions.size(); i++) {
+		Instruction &instruction = instructions[i];
+		int target_offset = 0;
+		switch (instruction.opcode) {
+			case GDScriptFunction::OPCODE_ASSIGN: {
+				if (code[instruction.position + 1] == code[instruction.position + 2]) {
+					instruction.removed = true;
+					changed = true;
+					continue;
+				}
+				target_offset = 1;
+			} break;
+			case GDScriptFunction::OPCODE_ASSIGN_NULL:
+			case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+			case GDScriptFunction::OPCODE_ASSIGN_FALSE: {
+				target_offset = 1;
+			} break;
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED: {
+				// Validated operators can't fail, except for the few that may print errors.
+				Variant::Operator op;
+				if (_get_operator(instruction, op) && op != Variant::OP_DIVIDE && op != Variant::OP_MODULE) {
+					target_offset = 3;
+				}
+			} break;
+			default: {
+			} break;
+		}
+		if (target_offset == 0) {
+			continue;
+		}
+		const int temporary = _get_temporary(code[instruction.position + target_offset]);
+		if (temporary >= 0 && _is_pure_temporary(temporary) && !bitset_get(&live_out[i * bitset_words], temporary)) {
+			instruction.removed = true;
+			changed = true;
+		}
+	}
+	return changed;
+}
+
+// Shares stack slots between temporaries of the same type whose lifetimes
+// don't overlap, and drops the ones no longer referenced at all.
+bool GDScriptByteCodeOptimizer::_coalesce_temporaries() {
+	if (temporary_count == 0) {
+		return false;
+	}
+	_compute_liveness();
+
+	const int count = instructions.size();
+	LocalVector<bool> referenced;
+	referenced.resize_initialized(temporary_count);
+	LocalVector<bool> coalescable;
+	coalescable.resize_initialized(temporary_count);
+	LocalVector<uint64_t> interference;
+	interference.resize_initialized(temporary_count * bitset_words);
+
+	for (int t = 0; t < temporary_count; t++) {
+		coalescable[t] = _is_pure_temporary(t);
+	}
+	// A temporary read before being written relies on its initial value.
+	for (const int &entry : entry_points) {
+		for (int t = 0; t < temporary_count; t++) {
+			if (bitset_get(&live_in[entry * bitset_words], t)) {
+				coalescable[t] = false;
+			}
+		}
+	}
+
+	LocalVector<int> operand_temporaries;
+	for (int i = 0; i < count; i++) {
+		const Instruction &instruction = instructions[i];
+		operand_temporaries.clear();
+		for (const Operand &operand : instruction.operands) {
+			const int temporary = _get_temporary(code[instruction.position + operand.offset]);
+			if (temporary >= 0) {
+				referenced[temporary] = true;
+				operand_temporaries.push_back(temporary);
+			}
+		}
+		for (const Operand &operand : instruction.operands) {
+			const int temporary = _get_temporary(code[instruction.position + operand.offset]);
+			if (temporary < 0 || operand.access == ACCESS_READ) {
+				continue;
+			}
+			// Whatever is defined here can't share a slot with what is live afterwards,
+			// nor with the other operands of the same instruction.
+			uint64_t *row = &interference[temporary * bitset_words];
+			const uint64_t *out = &live_out[i * bitset_words];
+			for (int w = 0; w < bitset_words; w++) {
+				row[w] |= out[w];
+			}
+			for (const int &other : operand_temporaries) {
+				bitset_set(row, other);
+			}
+		}
+	}
+	// Make the relation symmetric.
+	for (int a = 0; a < temporary_count; a++) {
+		for (int b = 0; b < temporary_count; b++) {
+			if (bitset_get(&interference[a * bitset_words], b)) {
+				bitset_set(&interference[b * bitset_words], a);
+			}
+		}
+	}
+
+	LocalVector<int> remap;
+	remap.resize(temporary_count);
+	LocalVector<int> slot_owner; // First temporary assigned to each new slot.
+	LocalVector<uint64_t> slot_members;
+	bool changed = false;
+
+	for (int t = 0; t < temporary_count; t++) {
+		remap[t] = -1;
+		if (!referenced[t]) {
+			changed = true;
+			continue;
+		}
+		if (coalescable[t]) {
+			for (uint32_t s = 0; s < slot_owner.size(); s++) {
+				const int owner = slot_owner[s];
+				if (!coalescable[owner] || codegen->temporaries[owner].type != codegen->temporaries[t].type) {
+					continue;
+				}
+				bool conflict = false;
+				const uint64_t *members = &slot_members[s * bitset_words];
+				const uint64_t *row = &interference[t * bitset_words];
+				for (int w = 0; w < bitset_words; w++) {
+					if (members[w] & row[w]) {
+						conflict = true;
+						break;
+					}
+				}
+				if (!conflict) {
+					remap[t] = s;
+					bitset_set(&slot_members[s * bitset_words], t);
+					break;
+				}
+			}
+		}
+		if (remap[t] == -1) {
+			remap[t] = slot_owner.size();
+			slot_owner.push_back(t);
+			slot_members.resize_initialized(slot_owner.size() * bitset_words);
+			bitset_set(&slot_members[remap[t] * bitset_words], t);
+		}
+		if (remap[t] != t) {
+			changed = true;
+		}
+	}
+
+	if (!changed) {
+		return false;
+	}
+
+	for (const Instruction &instruction : instructions) {
+		for (const Operand &operand : instruction.operands) {
+			int &address = code.write[instruction.position + operand.offset];
+			const int temporary = _get_temporary(address);
+			if (temporary >= 0) {
+				address = (temporaries_base + remap[temporary]) | (GDScriptFunction::ADDR_TYPE_STACK << GDScriptFunction::ADDR_BITS);
+			}
+		}
+	}
+
+	Vector<GDScriptByteCodeGenerator::StackSlot> new_temporaries;
+	for (const int &owner : slot_owner) {
+		const GDScriptByteCodeGenerator::StackSlot &slot = codegen->temporaries[owner];
+		new_temporaries.push_back(GDScriptByteCodeGenerator::StackSlot(slot.type, slot.can_contain_object));
+	}
+	codegen->temporaries = new_temporaries;
+	codegen->opcodes = code;
+	temporary_count = new_temporaries.size();
+	return true;
+}
+
+// Merges instruction pairs into superinstructions, saving one dispatch each time they run.
+// A fused instruction is encoded as the concatenation of the pair, so only its opcode
+// changes and the second instruction is dropped as a separate entry.
+bool GDScriptByteCodeOptimizer::fuse_superinstructions() {
+	if (!_decode()) {
+		return false;
+	}
+
+	const int count = instructions.size();
+	LocalVector<bool> jump_targets;
+	jump_targets.resize_initialized(count + 1);
+	for (const Instruction &instruction : instructions) {
+		if (instruction.jump_offset >= 0) {
+			jump_targets[instruction_at[code[instruction.position + instruction.jump_offset]]] = true;
+		}
+	}
+	for (const int &entry : entry_points) {
+		jump_targets[entry] = true;
+	}
+
+	bool changed = false;
+	for (int i = 0; i + 1 < count; i++) {
+		Instruction &first = instructions[i];
+		Instruction &second = instructions[i + 1];
+		if (jump_targets[i + 1]) {
+			continue; // The second instruction must stay reachable on its own.
+		}
+
+		GDScriptFunction::Opcode fused = GDScriptFunction::OPCODE_END;
+		if (first.opcode == GDScriptFunction::OPCODE_OPERATOR_VALIDATED) {
+			if (second.opcode == GDScriptFunction::OPCODE_JUMP_IF) {
+				fused = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF;
+			} else if (second.opcode == GDScriptFunction::OPCODE_JUMP_IF_NOT) {
+				fused = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT;
+			}
+		}
+		// The jump has to test the result of the operator.
+		if (fused == GDScriptFunction::OPCODE_END || code[second.position + 1] != code[first.position + 3]) {
+			continue;
+		}
+
+		code.write[first.position] = fused;
+		first.opcode = fused;
+		first.jump_offset = first.length + second.jump_offset;
+		first.length += second.length;
+		second.removed = true;
+		changed = true;
+		i++;
+	}
+
+	if (changed) {
+		_encode();
+	}
+	return changed;
+}
+
+bool GDScriptByteCodeOptimizer::optimize() {
+	if (!_decode()) {
+		return false;
+	}
+
+	bool optimized = false;
+	for (int round = 0; round < MAX_ROUNDS; round++) {
+		bool changed = false;
+		// Each successful pass re-encodes the code, so the next one starts from a fresh decode.
+		if (_simplify_control_flow()) {
+			_encode();
+			ERR_FAIL_COND_V(!_decode(), true);
+			changed = true;
+		}
+		if (_propagate_copies()) {
+			_encode();
+			ERR_FAIL_COND_V(!_decode(), true);
+			changed = true;
+		}
+		if (_eliminate_dead_stores()) {
+			_encode();
+			ERR_FAIL_COND_V(!_decode(), true);
+			changed = true;
+		}
+		if (!changed) {
+			break;
+		}
+		optimized = true;
+	}
+
+	return _coalesce_temporaries() || optimized;
+}
+
+GDScriptByteCodeOptimizer::GDScriptByteCodeOptimizer(GDScriptByteCodeGenerator *p_codegen) {
+	codegen = p_codegen;
+	code = codegen->opcodes;
+	temporaries_base = GDScriptFunction::FIXED_ADDRESSES_MAX + codegen->max_locals;
+	temporary_count = codegen->temporaries.size();
+	adjusted_temporaries.resize_initialized(temporary_count);
+
+	constants.resize(codegen->constant_map.size());
+	for (const KeyValue<Variant, int> &E : codegen->constant_map) {
+		constants.write[E.value] = E.key;
+	}
+}
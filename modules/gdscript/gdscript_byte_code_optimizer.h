@@ -0,0 +1,110 @@
+/**************************************************************************/
+/*  gdscript_byte_code_optimizer.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "gdscript_function.h"
+
+#include "core/templates/local_vector.h"
+
+class GDScriptByteCodeGenerator;
+
+// Optional pass pipeline run on the bytecode of a single function after code
+// generation is done, and before it is copied into the `GDScriptFunction`.
+// Superinstruction fusion uses the same decoder, but always runs.
+//
+// Every pass is conservative: only temporaries (which are never visible to the
+// debugger) are rewritten or removed, `OPCODE_LINE` instructions are kept so
+// line information stays correct, and nothing is changed if the function
+// contains an instruction the decoder does not understand.
+class GDScriptByteCodeOptimizer {
+	enum OperandAccess {
+		ACCESS_READ,
+		ACCESS_WRITE,
+		ACCESS_READ_WRITE,
+	};
+
+	struct Operand {
+		int offset = 0;
+		OperandAccess access = ACCESS_READ;
+	};
+
+	struct Instruction {
+		GDScriptFunction::Opcode opcode = GDScriptFunction::OPCODE_END;
+		int position = 0;
+		int length = 0; // May shrink when the instruction is rewritten in place.
+		int original_length = 0;
+		int jump_offset = -1; // Offset of the word holding a jump target, if any.
+		bool removed = false;
+		LocalVector<Operand> operands;
+	};
+
+	GDScriptByteCodeGenerator *codegen = nullptr;
+
+	Vector<int> code;
+	LocalVector<Instruction> instructions;
+	LocalVector<int> instruction_at; // Instruction index for each code position, or -1.
+	LocalVector<int> entry_points; // Instruction indices the function can start at.
+	LocalVector<bool> adjusted_temporaries;
+	Vector<Variant> constants;
+
+	int temporaries_base = 0;
+	int temporary_count = 0;
+	int bitset_words = 0;
+
+	// Per-instruction temporary liveness, as bitsets of `bitset_words` words.
+	LocalVector<uint64_t> live_in;
+	LocalVector<uint64_t> live_out;
+
+	int _get_temporary(int p_address) const;
+	bool _is_pure_temporary(int p_temporary) const;
+	bool _get_constant_value(int p_address, Variant &r_value) const;
+	bool _get_operator(const Instruction &p_instruction, Variant::Operator &r_operator) const;
+	int _add_constant(const Variant &p_value);
+
+	bool _decode_var_args(Instruction &r_instruction, int p_trailing_words) const;
+	bool _decode_instruction(int p_position, Instruction &r_instruction) const;
+	bool _decode();
+	void _encode();
+
+	void _get_successors(int p_index, LocalVector<int> &r_successors) const;
+	void _compute_liveness();
+
+	bool _simplify_control_flow();
+	bool _propagate_copies();
+	bool _eliminate_dead_stores();
+	bool _coalesce_temporaries();
+
+public:
+	bool optimize();
+	bool fuse_superinstructions();
+
+	GDScriptByteCodeOptimizer(GDScriptByteCodeGenerator *p_codegen);
+};
@@ -30,6 +30,8 @@
 
 #include "gdscript_byte_codegen.h"
 
+#include "gdscript_byte_code_optimizer.h"
+
 #include "core/object/class_db.h"
 
 uint32_t GDScriptByteCodeGenerator::add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) {
@@ -188,6 +190,19 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		for (int j = 0; j < temporaries[i].bytecode_indices.size(); j++) {
 			opcodes.write[temporaries[i].bytecode_indices[j]] = stack_index | (GDScriptFunction::ADDR_TYPE_STACK << GDScriptFunction::ADDR_BITS);
 		}
+	}
+
+	{
+		// Runs on resolved addresses, before constants and code are copied into the function.
+		GDScriptByteCodeOptimizer optimizer(this);
+		if (GDScriptLanguage::get_singleton()->should_optimize_bytecode()) {
+			optimizer.optimize();
+		}
+		optimizer.fuse_superinstructions();
+	}
+
+	for (int i = 0; i < temporaries.size(); i++) {
+		int stack_index = i + max_locals + GDScriptFunction::FIXED_ADDRESSES_MAX;
 		if (temporaries[i].type != Variant::NIL) {
 			function->temporary_slots.push_back(Pair(stack_index, temporaries[i].type));
 		}
@@ -395,6 +410,15 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->_lambdas_count = 0;
 	}
 
+	if (inline_cache_count) {
+		function->inline_caches.resize(inline_cache_count);
+		function->_inline_caches_ptr = function->inline_caches.ptr();
+		function->_inline_caches_count = inline_cache_count;
+	} else {
+		function->_inline_caches_ptr = nullptr;
+		function->_inline_caches_count = 0;
+	}
+
 	if (GDScriptLanguage::get_singleton()->should_track_locals()) {
 		function->stack_debug = stack_debug;
 	}
@@ -564,6 +588,7 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 		append(Address());
 		append(p_target);
 		append(op_func);
+		operator_func_operators[get_operation_pos(op_func)] = p_operator;
 #ifdef DEBUG_ENABLED
 		add_debug_name(operator_names, get_operation_pos(op_func), Variant::get_operator_name(p_operator));
 #endif
@@ -621,6 +646,7 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 		append(p_right_operand);
 		append(p_target);
 		append(op_func);
+		operator_func_operators[get_operation_pos(op_func)] = p_operator;
 #ifdef DEBUG_ENABLED
 		add_debug_name(operator_names, get_operation_pos(op_func), Variant::get_operator_name(p_operator));
 #endif
@@ -789,7 +815,103 @@ void GDScriptByteCodeGenerator::write_end_ternary() {
 	ternary_result.pop_back();
 }
 
+// Opcodes reading and writing elements directly, for containers with a known layout.
+// Returns `OPCODE_END` if the container type has none.
+static GDScriptFunction::Opcode _get_indexed_direct_opcode(Variant::Type p_container_type, bool p_set, bool p_in_bounds) {
+	static_assert(GDScriptFunction::OPCODE_GET_INDEXED_ARRAY_IN_BOUNDS - GDScriptFunction::OPCODE_GET_INDEXED_ARRAY == 7);
+	static_assert(GDScriptFunction::OPCODE_SET_INDEXED_TYPED_ARRAY - GDScriptFunction::OPCODE_GET_INDEXED_ARRAY == 14);
+	static_assert(GDScriptFunction::OPCODE_SET_INDEXED_TYPED_ARRAY_IN_BOUNDS - GDScriptFunction::OPCODE_GET_INDEXED_ARRAY == 21);
+
+	int offset = 0;
+	switch (p_container_type) {
+		case Variant::ARRAY:
+			offset = 0;
+			break;
+		case Variant::PACKED_INT32_ARRAY:
+			offset = 1;
+			break;
+		case Variant::PACKED_INT64_ARRAY:
+			offset = 2;
+			break;
+		case Variant::PACKED_FLOAT32_ARRAY:
+			offset = 3;
+			break;
+		case Variant::PACKED_FLOAT64_ARRAY:
+			offset = 4;
+			break;
+		case Variant::PACKED_VECTOR2_ARRAY:
+			offset = 5;
+			break;
+		case Variant::PACKED_VECTOR3_ARRAY:
+			offset = 6;
+			break;
+		default:
+			return GDScriptFunction::OPCODE_END;
+	}
+	if (p_set) {
+		offset += 14;
+	}
+	if (p_in_bounds) {
+		offset += 7;
+	}
+	return GDScriptFunction::Opcode(GDScriptFunction::OPCODE_GET_INDEXED_ARRAY + offset);
+}
+
+bool GDScriptByteCodeGenerator::_write_set_direct(const Address &p_target, const Address &p_index, const Address &p_source, bool p_in_bounds) {
+	if (!HAS_BUILTIN_TYPE(p_target) || !IS_BUILTIN_TYPE(p_index, Variant::INT)) {
+		return false;
+	}
+
+	const Variant::Type container_type = p_target.type.builtin_type;
+	Variant::Type element_type = Variant::NIL;
+	if (container_type == Variant::ARRAY) {
+		// Only typed arrays, so the value can be stored without checking it against the element type.
+		if (!p_target.type.has_container_element_type(0)) {
+			return false;
+		}
+		const GDScriptDataType &array_element_type = p_target.type.get_container_element_type(0);
+		if (array_element_type.kind != GDScriptDataType::BUILTIN || array_element_type.builtin_type == Variant::OBJECT) {
+			return false;
+		}
+		element_type = array_element_type.builtin_type;
+	} else {
+		element_type = Variant::get_indexed_element_type(container_type);
+	}
+
+	const GDScriptFunction::Opcode opcode = _get_indexed_direct_opcode(container_type, true, p_in_bounds);
+	if (opcode == GDScriptFunction::OPCODE_END || !IS_BUILTIN_TYPE(p_source, element_type)) {
+		return false;
+	}
+
+	append_opcode(opcode);
+	append(p_target);
+	append(p_index);
+	append(p_source);
+	return true;
+}
+
+bool GDScriptByteCodeGenerator::_write_get_direct(const Address &p_target, const Address &p_index, const Address &p_source, bool p_in_bounds) {
+	if (!HAS_BUILTIN_TYPE(p_source) || !IS_BUILTIN_TYPE(p_index, Variant::INT)) {
+		return false;
+	}
+
+	const GDScriptFunction::Opcode opcode = _get_indexed_direct_opcode(p_source.type.builtin_type, false, p_in_bounds);
+	if (opcode == GDScriptFunction::OPCODE_END) {
+		return false;
+	}
+
+	append_opcode(opcode);
+	append(p_source);
+	append(p_index);
+	append(p_target);
+	return true;
+}
+
 void GDScriptByteCodeGenerator::write_set(const Address &p_target, const Address &p_index, const Address &p_source) {
+	if (_write_set_direct(p_target, p_index, p_source, false)) {
+		return;
+	}
+
 	if (HAS_BUILTIN_TYPE(p_target)) {
 		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_setter(p_target.type.builtin_type) &&
 				IS_BUILTIN_TYPE(p_source, Variant::get_indexed_element_type(p_target.type.builtin_type))) {
@@ -819,6 +941,10 @@ void GDScriptByteCodeGenerator::write_set(const Address &p_target, const Address
 }
 
 void GDScriptByteCodeGenerator::write_get(const Address &p_target, const Address &p_index, const Address &p_source) {
+	if (_write_get_direct(p_target, p_index, p_source, false)) {
+		return;
+	}
+
 	if (HAS_BUILTIN_TYPE(p_source)) {
 		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_getter(p_source.type.builtin_type)) {
 			// Use indexed getter instead.
@@ -845,6 +971,18 @@ void GDScriptByteCodeGenerator::write_get(const Address &p_target, const Address
 	append(p_target);
 }
 
+void GDScriptByteCodeGenerator::write_set_in_bounds(const Address &p_target, const Address &p_index, const Address &p_source) {
+	if (!_write_set_direct(p_target, p_index, p_source, true)) {
+		write_set(p_target, p_index, p_source);
+	}
+}
+
+void GDScriptByteCodeGenerator::write_get_in_bounds(const Address &p_target, const Address &p_index, const Address &p_source) {
+	if (!_write_get_direct(p_target, p_index, p_source, true)) {
+		write_get(p_target, p_index, p_source);
+	}
+}
+
 void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
 	if (HAS_BUILTIN_TYPE(p_target) && Variant::get_member_validated_setter(p_target.type.builtin_type, p_name) &&
 			IS_BUILTIN_TYPE(p_source, Variant::get_member_type(p_target.type.builtin_type, p_name))) {
@@ -862,6 +1000,7 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 	append(p_target);
 	append(p_source);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
@@ -880,6 +1019,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -1038,6 +1178,12 @@ void GDScriptByteCodeGenerator::write_store_named_global(const Address &p_dst, c
 	append(p_global);
 }
 
+void GDScriptByteCodeGenerator::write_get_node_cached(const Address &p_target, const Address &p_path) {
+	append_opcode(GDScriptFunction::OPCODE_GET_NODE_CACHED);
+	append(p_path);
+	append(p_target);
+}
+
 void GDScriptByteCodeGenerator::write_cast(const Address &p_target, const Address &p_source, const GDScriptDataType &p_type) {
 	int index = 0;
 
@@ -1093,6 +1239,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1118,6 +1265,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1352,6 +1500,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1365,6 +1514,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1378,6 +1528,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
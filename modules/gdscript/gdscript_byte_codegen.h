@@ -38,6 +38,8 @@
 #include "core/templates/rb_map.h"
 
 class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
+	friend class GDScriptByteCodeOptimizer;
+
 	struct StackSlot {
 		Variant::Type type = Variant::NIL;
 		bool can_contain_object = true;
@@ -110,6 +112,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	Vector<StringName> named_globals;
 #endif
 	RBMap<Variant::ValidatedOperatorEvaluator, int> operator_func_map;
+	HashMap<int, Variant::Operator> operator_func_operators; // Used to fold validated operators.
 	RBMap<Variant::ValidatedSetter, int> setters_map;
 	RBMap<Variant::ValidatedGetter, int> getters_map;
 	RBMap<Variant::ValidatedKeyedSetter, int> keyed_setters_map;
@@ -122,6 +125,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	RBMap<GDScriptUtilityFunctions::FunctionPtr, int> gds_utilities_map;
 	RBMap<MethodBind *, int> method_bind_map;
 	RBMap<GDScriptFunction *, int> lambdas_map;
+	int inline_cache_count = 0;
 
 #ifdef DEBUG_ENABLED
 	// Keep method and property names for pointer and validated operations.
@@ -391,6 +395,10 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		opcodes.push_back(p_code);
 	}
 
+	void append_inline_cache() {
+		opcodes.push_back(inline_cache_count++);
+	}
+
 	void append(const Address &p_address) {
 		opcodes.push_back(address_of(p_address));
 	}
@@ -455,6 +463,9 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		opcodes.write[p_address] = opcodes.size();
 	}
 
+	bool _write_set_direct(const Address &p_target, const Address &p_index, const Address &p_source, bool p_in_bounds);
+	bool _write_get_direct(const Address &p_target, const Address &p_index, const Address &p_source, bool p_in_bounds);
+
 public:
 	virtual uint32_t add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local(const StringName &p_name, const GDScriptDataType &p_type) override;
@@ -498,6 +509,8 @@ public:
 	virtual void write_end_ternary() override;
 	virtual void write_set(const Address &p_target, const Address &p_index, const Address &p_source) override;
 	virtual void write_get(const Address &p_target, const Address &p_index, const Address &p_source) override;
+	virtual void write_set_in_bounds(const Address &p_target, const Address &p_index, const Address &p_source) override;
+	virtual void write_get_in_bounds(const Address &p_target, const Address &p_index, const Address &p_source) override;
 	virtual void write_set_named(const Address &p_target, const StringName &p_name, const Address &p_source) override;
 	virtual void write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) override;
 	virtual void write_set_member(const Address &p_value, const StringName &p_name) override;
@@ -512,6 +525,7 @@ public:
 	virtual void write_assign_default_parameter(const Address &p_dst, const Address &p_src, bool p_use_conversion) override;
 	virtual void write_store_global(const Address &p_dst, int p_global_index) override;
 	virtual void write_store_named_global(const Address &p_dst, const StringName &p_global) override;
+	virtual void write_get_node_cached(const Address &p_target, const Address &p_path) override;
 	virtual void write_cast(const Address &p_target, const Address &p_source, const GDScriptDataType &p_type) override;
 	virtual void write_call(const Address &p_target, const Address &p_base, const StringName &p_function_name, const Vector<Address> &p_arguments) override;
 	virtual void write_super_call(const Address &p_target, const StringName &p_function_name, const Vector<Address> &p_arguments) override;
@@ -32,11 +32,15 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_binary_bytecode.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 
+#include "core/config/project_settings.h"
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/vector.h"
 
 GDScriptParserRef::Status GDScriptParserRef::get_status() const {
@@ -66,6 +70,8 @@ GDScriptAnalyzer *GDScriptParserRef::get_analyzer() {
 }
 
 Error GDScriptParserRef::raise_status(Status p_new_status) {
+	MutexLock lock(mutex);
+
 	ERR_FAIL_COND_V(clearing, ERR_BUG);
 	ERR_FAIL_COND_V(parser == nullptr && status != EMPTY, ERR_BUG);
 
@@ -210,6 +216,7 @@ void GDScriptCache::remove_script(const String &p_path) {
 	remove_parser(p_path);
 
 	singleton->dependencies.erase(p_path);
+	singleton->preloaded_parsers.erase(p_path);
 	singleton->shallow_gdscript_cache.erase(p_path);
 	singleton->full_gdscript_cache.erase(p_path);
 }
@@ -286,7 +293,7 @@ String GDScriptCache::get_source_code(const String &p_path) {
 	return source;
 }
 
-Vector<uint8_t> GDScriptCache::get_binary_tokens(const String &p_path) {
+Vector<uint8_t> GDScriptCache::get_binary_tokens(const String &p_path, Vector<uint8_t> *r_compiled_bytecode) {
 	Vector<uint8_t> buffer;
 	Error err = OK;
 	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
@@ -297,6 +304,15 @@ Vector<uint8_t> GDScriptCache::get_binary_tokens(const String &p_path) {
 	uint64_t read = f->get_buffer(buffer.ptrw(), buffer.size());
 	ERR_FAIL_COND_V_MSG(read != len, Vector<uint8_t>(), "Failed to read binary GDScript file '" + p_path + "'.");
 
+	if (GDScriptBinaryBytecode::is_compiled_bytecode(buffer)) {
+		// Compiled bytecode embeds the binary tokens, which are used when the bytecode can't be loaded.
+		if (r_compiled_bytecode) {
+			*r_compiled_bytecode = buffer;
+		}
+		buffer = GDScriptBinaryBytecode::get_binary_tokens(buffer);
+		ERR_FAIL_COND_V_MSG(buffer.is_empty(), Vector<uint8_t>(), "Failed to read compiled GDScript file '" + p_path + "'.");
+	}
+
 	return buffer;
 }
 
@@ -319,12 +335,14 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 	script.instantiate();
 
 	script->set_path_cache(p_path);
+	Vector<uint8_t> compiled_bytecode;
 	if (remapped_path.has_extension("gdc")) {
-		Vector<uint8_t> buffer = get_binary_tokens(remapped_path);
+		Vector<uint8_t> buffer = get_binary_tokens(remapped_path, &compiled_bytecode);
 		if (buffer.is_empty()) {
 			r_error = ERR_FILE_CANT_READ;
 		}
 		script->set_binary_tokens_source(buffer);
+		script->set_compiled_bytecode_source(compiled_bytecode);
 	} else {
 		r_error = script->load_source_code(remapped_path);
 	}
@@ -333,9 +351,12 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
-	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
-	if (r_error == OK) {
-		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+	// The class tree of compiled bytecode replaces the parser here, the parser is only used as fallback.
+	if (compiled_bytecode.is_empty() || GDScriptBinaryBytecode::make_scripts(script.ptr(), compiled_bytecode) != OK) {
+		Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
+		if (r_error == OK) {
+			GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+		}
 	}
 
 	singleton->shallow_gdscript_cache[p_path] = script;
@@ -371,12 +392,14 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 
 	if (p_update_from_disk) {
 		if (remapped_path.has_extension("gdc")) {
-			Vector<uint8_t> buffer = get_binary_tokens(remapped_path);
+			Vector<uint8_t> compiled_bytecode;
+			Vector<uint8_t> buffer = get_binary_tokens(remapped_path, &compiled_bytecode);
 			if (buffer.is_empty()) {
 				r_error = ERR_FILE_CANT_READ;
 				goto finish;
 			}
 			script->set_binary_tokens_source(buffer);
+			script->set_compiled_bytecode_source(compiled_bytecode);
 		} else {
 			r_error = script->load_source_code(remapped_path);
 			if (r_error) {
@@ -456,6 +479,302 @@ void GDScriptCache::remove_static_script(const String &p_fqcn) {
 	singleton->static_gdscript_cache.erase(p_fqcn);
 }
 
+// State shared with the worker threads of `GDScriptCache::preload_scripts()`.
+struct GDScriptPreloadState {
+	struct Script {
+		String path;
+		Ref<GDScriptParserRef> parser_ref;
+		Vector<String> dependency_paths;
+		LocalVector<uint32_t> dependencies; // Indices in `scripts`.
+		uint32_t group = 0;
+	};
+
+	LocalVector<Script> scripts;
+	HashMap<String, uint32_t> script_indices;
+	HashMap<String, Ref<GDScriptParserRef>> parsers; // Preloaded and already resolved parsers, only read by the tasks.
+	LocalVector<uint32_t> order; // Dependencies first.
+	LocalVector<LocalVector<uint32_t>> groups; // Connected scripts, analyzed by the same task in `order`.
+	uint32_t parse_begin = 0;
+
+	static void parse_script(void *p_userdata, uint32_t p_index) {
+		GDScriptPreloadState *state = static_cast<GDScriptPreloadState *>(p_userdata);
+		state->scripts[state->parse_begin + p_index].parser_ref->raise_status(GDScriptParserRef::PARSED);
+	}
+
+	static void analyze_group(void *p_userdata, uint32_t p_index) {
+		GDScriptPreloadState *state = static_cast<GDScriptPreloadState *>(p_userdata);
+		const LocalVector<uint32_t> &group = state->groups[p_index];
+
+		// Scripts of the group resolve each other through these private parsers, never through the cache,
+		// so no other task can touch them. Indirect dependencies are in the same group, and are found
+		// through `GDScriptParser::preload_parsers`. Scripts outside the preload were resolved before
+		// the tasks started.
+		for (uint32_t index : group) {
+			Script &script = state->scripts[index];
+			GDScriptParser *parser = script.parser_ref->get_parser();
+			parser->preload_parsers = &state->parsers;
+			for (uint32_t dependency_index : script.dependencies) {
+				const Script &dependency = state->scripts[dependency_index];
+				parser->depended_parsers[dependency.path] = dependency.parser_ref;
+			}
+		}
+
+		for (uint32_t index : group) {
+			const Ref<GDScriptParserRef> &parser_ref = state->scripts[index].parser_ref;
+			if (parser_ref->raise_status(GDScriptParserRef::FULLY_SOLVED) == OK) {
+				parser_ref->result = parser_ref->get_analyzer()->resolve_dependencies();
+			}
+		}
+
+		for (uint32_t index : group) {
+			state->scripts[index].parser_ref->get_parser()->preload_parsers = nullptr;
+		}
+	}
+
+	// Dependencies outside the preload (e.g. scripts that are already compiled) are shared through `parser_map`.
+	// They are resolved on the calling thread, so the analysis tasks only read them. Refs that are only found
+	// during analysis still go through the cache, their lock keeps tasks from raising them at the same time.
+	void resolve_external_dependencies() {
+		for (const Script &script : scripts) {
+			parsers.insert(script.path, script.parser_ref);
+		}
+		for (Script &script : scripts) {
+			if (script.parser_ref->result != OK) {
+				continue;
+			}
+			for (const String &path : script.dependency_paths) {
+				if (script_indices.has(path)) {
+					continue;
+				}
+				// Also registers the dependency, if the path was already resolved for another script.
+				Error err = OK;
+				Ref<GDScriptParserRef> parser_ref = GDScriptCache::get_parser(path, GDScriptParserRef::FULLY_SOLVED, err, script.path);
+				if (parser_ref.is_valid()) {
+					parsers.insert(path, parser_ref);
+					script.parser_ref->get_parser()->depended_parsers[path] = parser_ref;
+				}
+			}
+		}
+	}
+
+	uint32_t find_group(uint32_t p_index) {
+		while (scripts[p_index].group != p_index) {
+			scripts[p_index].group = scripts[scripts[p_index].group].group;
+			p_index = scripts[p_index].group;
+		}
+		return p_index;
+	}
+};
+
+static bool _has_compiled_bytecode(const String &p_remapped_path) {
+	if (!p_remapped_path.has_extension("gdc")) {
+		return false;
+	}
+	Ref<FileAccess> f = FileAccess::open(p_remapped_path, FileAccess::READ);
+	if (f.is_null()) {
+		return false;
+	}
+	Vector<uint8_t> header;
+	header.resize(GDScriptBinaryBytecode::HEADER_SIZE);
+	if (f->get_buffer(header.ptrw(), header.size()) != (uint64_t)header.size()) {
+		return false;
+	}
+	return GDScriptBinaryBytecode::is_compatible(header);
+}
+
+void GDScriptCache::preload_scripts(const Vector<String> &p_paths) {
+	ERR_FAIL_NULL(singleton);
+
+	GDScriptPreloadState state;
+	LocalVector<String> pending;
+	for (const String &path : p_paths) {
+		pending.push_back(path);
+	}
+
+	// Parsers initialize static tables on first use, do it before any task does.
+	GDScriptParser::get_builtin_type(StringName());
+	{
+		GDScriptParser parser;
+	}
+
+	// Parse in waves: the dependencies found in each wave are parsed in the next one.
+	while (!pending.is_empty()) {
+		state.parse_begin = state.scripts.size();
+		{
+			MutexLock lock(singleton->mutex);
+			for (const String &path : pending) {
+				if (state.script_indices.has(path) || singleton->full_gdscript_cache.has(path)) {
+					continue;
+				}
+				const String remapped_path = ResourceLoader::path_remap(path);
+				if (!FileAccess::exists(remapped_path) || _has_compiled_bytecode(remapped_path)) {
+					continue;
+				}
+
+				GDScriptPreloadState::Script script;
+				script.path = path;
+				script.parser_ref.instantiate();
+				script.parser_ref->path = path;
+				// Not in `parser_map` (yet), so it must not unregister the path when freed.
+				script.parser_ref->abandoned = true;
+				script.group = state.scripts.size();
+				state.script_indices.insert(path, state.scripts.size());
+				state.scripts.push_back(script);
+			}
+		}
+		pending.clear();
+
+		const uint32_t parse_count = state.scripts.size() - state.parse_begin;
+		if (parse_count == 0) {
+			break;
+		}
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&GDScriptPreloadState::parse_script, &state, parse_count, -1, true, SNAME("GDScriptPreloadParse"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (uint32_t i = state.parse_begin; i < state.scripts.size(); i++) {
+			GDScriptPreloadState::Script &script = state.scripts[i];
+			if (script.parser_ref->result != OK) {
+				continue;
+			}
+			const GDScriptParser *parser = script.parser_ref->get_parser();
+			HashSet<String> dependency_paths(parser->get_preload_dependencies());
+			for (const StringName &name : parser->get_referenced_names()) {
+				if (ScriptServer::is_global_class(name)) {
+					dependency_paths.insert(ScriptServer::get_global_class_path(name));
+				} else if (ProjectSettings::get_singleton()->has_autoload(name)) {
+					const ProjectSettings::AutoloadInfo autoload = ProjectSettings::get_singleton()->get_autoload(name);
+					if (autoload.is_singleton) {
+						dependency_paths.insert(autoload.path);
+					}
+				}
+			}
+			for (const String &path : dependency_paths) {
+				if (path != script.path && path.has_extension("gd")) {
+					script.dependency_paths.push_back(path);
+					pending.push_back(path);
+				}
+			}
+		}
+	}
+
+	if (state.scripts.is_empty()) {
+		return;
+	}
+
+	// Scripts that depend on each other, directly or not, form a group.
+	for (uint32_t i = 0; i < state.scripts.size(); i++) {
+		GDScriptPreloadState::Script &script = state.scripts[i];
+		for (const String &path : script.dependency_paths) {
+			HashMap<String, uint32_t>::ConstIterator E = state.script_indices.find(path);
+			if (!E) {
+				continue;
+			}
+			script.dependencies.push_back(E->value);
+			const uint32_t a = state.find_group(i);
+			const uint32_t b = state.find_group(E->value);
+			if (a != b) {
+				state.scripts[MAX(a, b)].group = MIN(a, b);
+			}
+		}
+	}
+
+	// Depth-first post-order, so dependencies come first. Cycles are broken arbitrarily, as the analyzer handles them.
+	{
+		LocalVector<bool> visited;
+		visited.resize(state.scripts.size());
+		for (bool &E : visited) {
+			E = false;
+		}
+		LocalVector<Pair<uint32_t, uint32_t>> stack;
+		for (uint32_t i = 0; i < state.scripts.size(); i++) {
+			if (visited[i]) {
+				continue;
+			}
+			visited[i] = true;
+			stack.push_back(Pair<uint32_t, uint32_t>(i, 0));
+			while (!stack.is_empty()) {
+				Pair<uint32_t, uint32_t> &top = stack[stack.size() - 1];
+				const LocalVector<uint32_t> &dependencies = state.scripts[top.first].dependencies;
+				if (top.second < dependencies.size()) {
+					const uint32_t dependency = dependencies[top.second++];
+					if (!visited[dependency]) {
+						visited[dependency] = true;
+						stack.push_back(Pair<uint32_t, uint32_t>(dependency, 0));
+					}
+				} else {
+					state.order.push_back(top.first);
+					stack.resize(stack.size() - 1);
+				}
+			}
+		}
+	}
+
+	HashMap<uint32_t, uint32_t> group_indices;
+	for (uint32_t index : state.order) {
+		const uint32_t root = state.find_group(index);
+		HashMap<uint32_t, uint32_t>::Iterator E = group_indices.find(root);
+		if (!E) {
+			E = group_indices.insert(root, state.groups.size());
+			state.groups.push_back(LocalVector<uint32_t>());
+		}
+		state.groups[E->value].push_back(index);
+	}
+
+	state.resolve_external_dependencies();
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&GDScriptPreloadState::analyze_group, &state, state.groups.size(), -1, true, SNAME("GDScriptPreloadAnalyze"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Publish the analyzed parsers, so `GDScript::reload()` and other scripts use them instead of parsing again.
+	{
+		MutexLock lock(singleton->mutex);
+		for (const GDScriptPreloadState::Script &script : state.scripts) {
+			const Ref<GDScriptParserRef> &parser_ref = script.parser_ref;
+			if (parser_ref->status != GDScriptParserRef::FULLY_SOLVED || parser_ref->result != OK) {
+				continue;
+			}
+			if (!singleton->parser_map.has(script.path)) {
+				singleton->parser_map[script.path] = parser_ref.ptr();
+				parser_ref->abandoned = false;
+			}
+			for (uint32_t dependency_index : script.dependencies) {
+				const String &dependency_path = state.scripts[dependency_index].path;
+				singleton->dependencies[script.path].insert(dependency_path);
+				singleton->parser_inverse_dependencies[dependency_path].insert(script.path);
+			}
+			singleton->preloaded_parsers[script.path] = parser_ref;
+		}
+	}
+
+	// Compilation creates resources and runs static initializers, so it stays on this thread.
+	for (uint32_t index : state.order) {
+		const GDScriptPreloadState::Script &script = state.scripts[index];
+		if (script.parser_ref->result == OK) {
+			Error err = OK;
+			get_full_script(script.path, err);
+		}
+	}
+
+	MutexLock lock(singleton->mutex);
+	for (const GDScriptPreloadState::Script &script : state.scripts) {
+		singleton->preloaded_parsers.erase(script.path);
+	}
+}
+
+Ref<GDScriptParserRef> GDScriptCache::take_preloaded_parser(const String &p_path, uint32_t p_source_hash) {
+	MutexLock lock(singleton->mutex);
+	HashMap<String, Ref<GDScriptParserRef>>::Iterator E = singleton->preloaded_parsers.find(p_path);
+	if (!E) {
+		return Ref<GDScriptParserRef>();
+	}
+	Ref<GDScriptParserRef> parser_ref = E->value;
+	singleton->preloaded_parsers.remove(E);
+	if (parser_ref->source_hash != p_source_hash || parser_ref->status != GDScriptParserRef::FULLY_SOLVED || parser_ref->result != OK) {
+		return Ref<GDScriptParserRef>();
+	}
+	return parser_ref;
+}
+
 void GDScriptCache::clear() {
 	if (singleton == nullptr) {
 		return;
@@ -469,6 +788,7 @@ void GDScriptCache::clear() {
 	singleton->cleared = true;
 
 	singleton->parser_inverse_dependencies.clear();
+	singleton->preloaded_parsers.clear();
 
 	for (const KeyValue<String, Vector<ObjectID>> &KV : singleton->abandoned_parser_map) {
 		for (ObjectID parser_ref_id : KV.value) {
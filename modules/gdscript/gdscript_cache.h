@@ -33,6 +33,7 @@
 #include "gdscript.h"
 
 #include "core/object/ref_counted.h"
+#include "core/os/mutex.h"
 #include "core/os/safe_binary_mutex.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/hash_set.h"
@@ -61,9 +62,13 @@ private:
 	uint32_t source_hash = 0;
 	bool clearing = false;
 	bool abandoned = false;
+	// Held by `raise_status()`. Refs are shared through the cache, so preload tasks may raise one at the
+	// same time. Recursive, as resolving cyclic dependencies raises the same ref again.
+	Mutex mutex;
 
 	friend class GDScriptCache;
 	friend class GDScript;
+	friend struct GDScriptPreloadState;
 
 public:
 	Status get_status() const;
@@ -91,10 +96,12 @@ class GDScriptCache {
 	HashMap<String, Ref<GDScript>> static_gdscript_cache;
 	HashMap<String, HashSet<String>> dependencies;
 	HashMap<String, HashSet<String>> parser_inverse_dependencies;
+	HashMap<String, Ref<GDScriptParserRef>> preloaded_parsers; // Analyzed by `preload_scripts()`, waiting for `GDScript::reload()`.
 
 	friend class GDScript;
 	friend class GDScriptParserRef;
 	friend class GDScriptInstance;
+	friend class GDScriptBinaryBytecode;
 	friend class GDScriptTests::TestGDScriptCacheAccessor;
 
 	static GDScriptCache *singleton;
@@ -115,7 +122,7 @@ public:
 	static bool has_parser(const String &p_path);
 	static void remove_parser(const String &p_path);
 	static String get_source_code(const String &p_path);
-	static Vector<uint8_t> get_binary_tokens(const String &p_path);
+	static Vector<uint8_t> get_binary_tokens(const String &p_path, Vector<uint8_t> *r_compiled_bytecode = nullptr);
 	static Ref<GDScript> get_shallow_script(const String &p_path, Error &r_error, const String &p_owner = String());
 	/**
 	 * Returns a fully loaded GDScript using an already cached script if one exists.
@@ -128,6 +135,15 @@ public:
 	static void add_static_script(Ref<GDScript> p_script);
 	static void remove_static_script(const String &p_fqcn);
 
+	/**
+	 * Compiles the given scripts and the scripts they depend on.
+	 *
+	 * Scripts are parsed in parallel, then groups of scripts that don't depend on each other
+	 * are analyzed in parallel. Compilation happens on the calling thread, dependencies first.
+	 */
+	static void preload_scripts(const Vector<String> &p_paths);
+	static Ref<GDScriptParserRef> take_preloaded_parser(const String &p_path, uint32_t p_source_hash);
+
 	static void clear();
 
 	GDScriptCache();
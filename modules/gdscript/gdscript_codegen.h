@@ -106,6 +106,9 @@ public:
 	virtual void write_end_ternary() = 0;
 	virtual void write_set(const Address &p_target, const Address &p_index, const Address &p_source) = 0;
 	virtual void write_get(const Address &p_target, const Address &p_index, const Address &p_source) = 0;
+	// Same as `write_set()` and `write_get()`, for an index known to be within the container's size.
+	virtual void write_set_in_bounds(const Address &p_target, const Address &p_index, const Address &p_source) = 0;
+	virtual void write_get_in_bounds(const Address &p_target, const Address &p_index, const Address &p_source) = 0;
 	virtual void write_set_named(const Address &p_target, const StringName &p_name, const Address &p_source) = 0;
 	virtual void write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) = 0;
 	virtual void write_set_member(const Address &p_value, const StringName &p_name) = 0;
@@ -120,6 +123,7 @@ public:
 	virtual void write_assign_default_parameter(const Address &dst, const Address &src, bool p_use_conversion) = 0;
 	virtual void write_store_global(const Address &p_dst, int p_global_index) = 0;
 	virtual void write_store_named_global(const Address &p_dst, const StringName &p_global) = 0;
+	virtual void write_get_node_cached(const Address &p_target, const Address &p_path) = 0;
 	virtual void write_cast(const Address &p_target, const Address &p_source, const GDScriptDataType &p_type) = 0;
 	virtual void write_call(const Address &p_target, const Address &p_base, const StringName &p_function_name, const Vector<Address> &p_arguments) = 0;
 	virtual void write_super_call(const Address &p_target, const StringName &p_function_name, const Vector<Address> &p_arguments) = 0;
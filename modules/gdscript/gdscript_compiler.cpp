@@ -251,6 +251,246 @@ static bool _can_use_validate_call(const MethodBind *p_method, const Vector<GDSc
 	return true;
 }
 
+// Lookups of these paths are cached per instance by `OPCODE_GET_NODE_CACHED`.
+// They can only resolve to nodes in the subtree of `self`, which tracks its own changes.
+static bool _is_cacheable_node_path(const NodePath &p_path) {
+	if (p_path.is_empty() || p_path.is_absolute()) {
+		return false;
+	}
+	for (int i = 0; i < p_path.get_name_count(); i++) {
+		const StringName &name = p_path.get_name(i);
+		if (name == SNAME("..") || name.is_node_unique_name()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool _get_cacheable_node_path(const GDScriptParser::ExpressionNode *p_expression, NodePath &r_path) {
+	if (!p_expression->is_constant) {
+		return false;
+	}
+	switch (p_expression->reduced_value.get_type()) {
+		case Variant::STRING:
+		case Variant::STRING_NAME:
+		case Variant::NODE_PATH:
+			r_path = p_expression->reduced_value;
+			return _is_cacheable_node_path(r_path);
+		default:
+			return false;
+	}
+}
+
+static bool _is_plain_builtin(const GDScriptParser::DataType &p_type) {
+	// Values of these types can't run user code nor hold a reference to an array.
+	return p_type.is_hard_type() && p_type.kind == GDScriptParser::DataType::BUILTIN && p_type.builtin_type != Variant::NIL && p_type.builtin_type < Variant::OBJECT;
+}
+
+static bool _is_direct_indexed_container(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::ARRAY:
+		case Variant::PACKED_INT32_ARRAY:
+		case Variant::PACKED_INT64_ARRAY:
+		case Variant::PACKED_FLOAT32_ARRAY:
+		case Variant::PACKED_FLOAT64_ARRAY:
+		case Variant::PACKED_VECTOR2_ARRAY:
+		case Variant::PACKED_VECTOR3_ARRAY:
+			return true;
+		default:
+			return false;
+	}
+}
+
+// Returns the name of `X` if the loop is `for i in X.size()` or `for i in range(X.size())`, where `X` is a typed local array.
+static StringName _get_counted_loop_container(const GDScriptParser::ForNode *p_for) {
+	const GDScriptParser::ExpressionNode *list = p_for->list;
+	if (list == nullptr || list->type != GDScriptParser::Node::CALL) {
+		return StringName();
+	}
+
+	const GDScriptParser::CallNode *call = static_cast<const GDScriptParser::CallNode *>(list);
+	if (call->get_callee_type() == GDScriptParser::Node::IDENTIFIER && call->function_name == SNAME("range")) {
+		if (call->arguments.size() != 1 || call->arguments[0]->type != GDScriptParser::Node::CALL) {
+			return StringName();
+		}
+		call = static_cast<const GDScriptParser::CallNode *>(call->arguments[0]);
+	}
+
+	if (call->is_super || !call->arguments.is_empty() || call->function_name != SNAME("size") || call->get_callee_type() != GDScriptParser::Node::SUBSCRIPT) {
+		return StringName();
+	}
+	const GDScriptParser::SubscriptNode *callee = static_cast<const GDScriptParser::SubscriptNode *>(call->callee);
+	if (!callee->is_attribute || callee->base->type != GDScriptParser::Node::IDENTIFIER) {
+		return StringName();
+	}
+
+	const GDScriptParser::IdentifierNode *container = static_cast<const GDScriptParser::IdentifierNode *>(callee->base);
+	if (container->source != GDScriptParser::IdentifierNode::LOCAL_VARIABLE && container->source != GDScriptParser::IdentifierNode::FUNCTION_PARAMETER) {
+		return StringName();
+	}
+	const GDScriptParser::DataType container_type = container->get_datatype();
+	if (!container_type.is_hard_type() || container_type.kind != GDScriptParser::DataType::BUILTIN || !_is_direct_indexed_container(container_type.builtin_type)) {
+		return StringName();
+	}
+	return container->name;
+}
+
+// Conservatively checks that a loop body can't resize the container nor reassign it or the loop counter.
+// Anything that may run arbitrary code (calls to scripts and objects, setters, `await`, lambdas) rejects the loop.
+static bool _can_skip_bounds_checks(const GDScriptParser::Node *p_node, const StringName &p_container, const StringName &p_counter) {
+	if (p_node == nullptr) {
+		return true;
+	}
+
+	switch (p_node->type) {
+		case GDScriptParser::Node::PASS:
+		case GDScriptParser::Node::BREAK:
+		case GDScriptParser::Node::CONTINUE:
+		case GDScriptParser::Node::BREAKPOINT:
+		case GDScriptParser::Node::LITERAL:
+		case GDScriptParser::Node::SELF:
+		case GDScriptParser::Node::PRELOAD:
+		case GDScriptParser::Node::CONSTANT:
+			return true;
+		case GDScriptParser::Node::SUITE: {
+			for (const GDScriptParser::Node *statement : static_cast<const GDScriptParser::SuiteNode *>(p_node)->statements) {
+				if (!_can_skip_bounds_checks(statement, p_container, p_counter)) {
+					return false;
+				}
+			}
+			return true;
+		}
+		case GDScriptParser::Node::VARIABLE:
+			return _can_skip_bounds_checks(static_cast<const GDScriptParser::VariableNode *>(p_node)->initializer, p_container, p_counter);
+		case GDScriptParser::Node::IF: {
+			const GDScriptParser::IfNode *if_n = static_cast<const GDScriptParser::IfNode *>(p_node);
+			return _can_skip_bounds_checks(if_n->condition, p_container, p_counter) && _can_skip_bounds_checks(if_n->true_block, p_container, p_counter) && _can_skip_bounds_checks(if_n->false_block, p_container, p_counter);
+		}
+		case GDScriptParser::Node::WHILE: {
+			const GDScriptParser::WhileNode *while_n = static_cast<const GDScriptParser::WhileNode *>(p_node);
+			return _can_skip_bounds_checks(while_n->condition, p_container, p_counter) && _can_skip_bounds_checks(while_n->loop, p_container, p_counter);
+		}
+		case GDScriptParser::Node::FOR: {
+			const GDScriptParser::ForNode *for_n = static_cast<const GDScriptParser::ForNode *>(p_node);
+			return _can_skip_bounds_checks(for_n->list, p_container, p_counter) && _can_skip_bounds_checks(for_n->loop, p_container, p_counter);
+		}
+		case GDScriptParser::Node::RETURN:
+			return _can_skip_bounds_checks(static_cast<const GDScriptParser::ReturnNode *>(p_node)->return_value, p_container, p_counter);
+		case GDScriptParser::Node::ASSERT: {
+			const GDScriptParser::AssertNode *assert_n = static_cast<const GDScriptParser::AssertNode *>(p_node);
+			return _can_skip_bounds_checks(assert_n->condition, p_container, p_counter) && _can_skip_bounds_checks(assert_n->message, p_container, p_counter);
+		}
+		default:
+			break;
+	}
+
+	// Remaining nodes are expressions.
+	const GDScriptParser::ExpressionNode *expression = static_cast<const GDScriptParser::ExpressionNode *>(p_node);
+	if (expression->is_constant) {
+		return true;
+	}
+
+	switch (p_node->type) {
+		case GDScriptParser::Node::IDENTIFIER: {
+			const GDScriptParser::IdentifierNode *identifier = static_cast<const GDScriptParser::IdentifierNode *>(p_node);
+			switch (identifier->source) {
+				case GDScriptParser::IdentifierNode::FUNCTION_PARAMETER:
+				case GDScriptParser::IdentifierNode::LOCAL_VARIABLE:
+				case GDScriptParser::IdentifierNode::LOCAL_CONSTANT:
+				case GDScriptParser::IdentifierNode::LOCAL_ITERATOR:
+				case GDScriptParser::IdentifierNode::LOCAL_BIND:
+				case GDScriptParser::IdentifierNode::MEMBER_CONSTANT:
+				case GDScriptParser::IdentifierNode::MEMBER_CLASS:
+					return true;
+				case GDScriptParser::IdentifierNode::MEMBER_VARIABLE:
+				case GDScriptParser::IdentifierNode::STATIC_VARIABLE:
+					// Getters and setters may run arbitrary code.
+					return identifier->variable_source != nullptr && identifier->variable_source->property == GDScriptParser::VariableNode::PROP_NONE;
+				default:
+					return false;
+			}
+		}
+		case GDScriptParser::Node::ASSIGNMENT: {
+			const GDScriptParser::AssignmentNode *assignment = static_cast<const GDScriptParser::AssignmentNode *>(p_node);
+			if (assignment->assignee->type == GDScriptParser::Node::IDENTIFIER) {
+				const StringName &name = static_cast<const GDScriptParser::IdentifierNode *>(assignment->assignee)->name;
+				if (name == p_container || name == p_counter) {
+					return false;
+				}
+			}
+			if (assignment->operation != GDScriptParser::AssignmentNode::OP_NONE && (!_is_plain_builtin(assignment->assignee->get_datatype()) || !_is_plain_builtin(assignment->assigned_value->get_datatype()))) {
+				// Operators on other types may end up calling script code.
+				return false;
+			}
+			return _can_skip_bounds_checks(assignment->assignee, p_container, p_counter) && _can_skip_bounds_checks(assignment->assigned_value, p_container, p_counter);
+		}
+		case GDScriptParser::Node::BINARY_OPERATOR: {
+			const GDScriptParser::BinaryOpNode *binary = static_cast<const GDScriptParser::BinaryOpNode *>(p_node);
+			return _is_plain_builtin(binary->left_operand->get_datatype()) && _is_plain_builtin(binary->right_operand->get_datatype()) && _can_skip_bounds_checks(binary->left_operand, p_container, p_counter) && _can_skip_bounds_checks(binary->right_operand, p_container, p_counter);
+		}
+		case GDScriptParser::Node::UNARY_OPERATOR: {
+			const GDScriptParser::UnaryOpNode *unary = static_cast<const GDScriptParser::UnaryOpNode *>(p_node);
+			return _is_plain_builtin(unary->operand->get_datatype()) && _can_skip_bounds_checks(unary->operand, p_container, p_counter);
+		}
+		case GDScriptParser::Node::TERNARY_OPERATOR: {
+			const GDScriptParser::TernaryOpNode *ternary = static_cast<const GDScriptParser::TernaryOpNode *>(p_node);
+			return _can_skip_bounds_checks(ternary->condition, p_container, p_counter) && _can_skip_bounds_checks(ternary->true_expr, p_container, p_counter) && _can_skip_bounds_checks(ternary->false_expr, p_container, p_counter);
+		}
+		case GDScriptParser::Node::CAST:
+			return _is_plain_builtin(p_node->get_datatype()) && _can_skip_bounds_checks(static_cast<const GDScriptParser::CastNode *>(p_node)->operand, p_container, p_counter);
+		case GDScriptParser::Node::TYPE_TEST:
+			return _can_skip_bounds_checks(static_cast<const GDScriptParser::TypeTestNode *>(p_node)->operand, p_container, p_counter);
+		case GDScriptParser::Node::ARRAY: {
+			for (const GDScriptParser::ExpressionNode *element : static_cast<const GDScriptParser::ArrayNode *>(p_node)->elements) {
+				if (!_can_skip_bounds_checks(element, p_container, p_counter)) {
+					return false;
+				}
+			}
+			return true;
+		}
+		case GDScriptParser::Node::SUBSCRIPT: {
+			const GDScriptParser::SubscriptNode *subscript = static_cast<const GDScriptParser::SubscriptNode *>(p_node);
+			const GDScriptParser::DataType base_type = subscript->base->get_datatype();
+			if (!base_type.is_hard_type() || base_type.kind != GDScriptParser::DataType::BUILTIN || base_type.builtin_type == Variant::NIL || base_type.builtin_type == Variant::OBJECT) {
+				return false;
+			}
+			return _can_skip_bounds_checks(subscript->base, p_container, p_counter) && (subscript->is_attribute || _can_skip_bounds_checks(subscript->index, p_container, p_counter));
+		}
+		case GDScriptParser::Node::CALL: {
+			const GDScriptParser::CallNode *call = static_cast<const GDScriptParser::CallNode *>(p_node);
+			if (call->is_super) {
+				return false;
+			}
+			for (const GDScriptParser::ExpressionNode *argument : call->arguments) {
+				if (!_is_plain_builtin(argument->get_datatype()) || !_can_skip_bounds_checks(argument, p_container, p_counter)) {
+					return false;
+				}
+			}
+			if (call->get_callee_type() == GDScriptParser::Node::IDENTIFIER) {
+				// Builtin constructors and Variant utility functions.
+				return GDScriptParser::get_builtin_type(call->function_name) < Variant::VARIANT_MAX || Variant::has_utility_function(call->function_name);
+			}
+			if (call->get_callee_type() != GDScriptParser::Node::SUBSCRIPT) {
+				return false;
+			}
+			const GDScriptParser::SubscriptNode *callee = static_cast<const GDScriptParser::SubscriptNode *>(call->callee);
+			if (!callee->is_attribute) {
+				return false;
+			}
+			const GDScriptParser::DataType base_type = callee->base->get_datatype();
+			if (_is_plain_builtin(base_type)) {
+				return _can_skip_bounds_checks(callee->base, p_container, p_counter);
+			}
+			if (base_type.is_hard_type() && base_type.kind == GDScriptParser::DataType::BUILTIN && base_type.builtin_type > Variant::OBJECT && call->arguments.is_empty() && (call->function_name == SNAME("size") || call->function_name == SNAME("is_empty"))) {
+				return _can_skip_bounds_checks(callee->base, p_container, p_counter);
+			}
+			return false;
+		}
+		default:
+			return false;
+	}
+}
+
 GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &codegen, Error &r_error, const GDScriptParser::ExpressionNode *p_expression, bool p_root, bool p_initializer) {
 	if (p_expression->is_constant && !(p_expression->get_datatype().is_meta_type && p_expression->get_datatype().kind == GDScriptParser::DataType::CLASS)) {
 		return codegen.add_constant(p_expression->reduced_value);
@@ -419,8 +659,8 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 					if (GDScriptLanguage::get_singleton()->get_global_map().has(identifier)) {
 						// If it's an autoload singleton, we postpone to load it at runtime.
 						// This is so one autoload doesn't try to load another before it's compiled.
-						HashMap<StringName, ProjectSettings::AutoloadInfo> autoloads(ProjectSettings::get_singleton()->get_autoload_list());
-						if (autoloads.has(identifier) && autoloads[identifier].is_singleton) {
+						const ProjectSettings::AutoloadInfo *autoload = ProjectSettings::get_singleton()->get_autoload_list().getptr(identifier);
+						if (autoload && autoload->is_singleton) {
 							GDScriptCodeGenerator::Address global = codegen.add_temporary(_gdtype_from_datatype(in->get_datatype(), codegen.script));
 							int idx = GDScriptLanguage::get_singleton()->get_global_map()[identifier];
 							gen->write_store_global(global, idx);
@@ -638,7 +878,11 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 				} else {
 					if (callee->type == GDScriptParser::Node::IDENTIFIER) {
 						// Self function call.
-						if (ClassDB::has_method(codegen.script->native->get_name(), call->function_name)) {
+						NodePath node_path;
+						if (!p_root && call->function_name == SNAME("get_node") && call->arguments.size() == 1 && _get_cacheable_node_path(call->arguments[0], node_path) && ClassDB::is_parent_class(codegen.script->native->get_name(), SNAME("Node"))) {
+							// Same as `$Path`.
+							gen->write_get_node_cached(result, codegen.add_constant(node_path));
+						} else if (ClassDB::has_method(codegen.script->native->get_name(), call->function_name)) {
 							// Native method, use faster path.
 							GDScriptCodeGenerator::Address self;
 							self.mode = GDScriptCodeGenerator::Address::SELF;
@@ -743,14 +987,19 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 		} break;
 		case GDScriptParser::Node::GET_NODE: {
 			const GDScriptParser::GetNodeNode *get_node = static_cast<const GDScriptParser::GetNodeNode *>(p_expression);
-
-			Vector<GDScriptCodeGenerator::Address> args;
-			args.push_back(codegen.add_constant(NodePath(get_node->full_path)));
+			const NodePath node_path(get_node->full_path);
 
 			GDScriptCodeGenerator::Address result = codegen.add_temporary(_gdtype_from_datatype(get_node->get_datatype(), codegen.script));
 
-			MethodBind *get_node_method = ClassDB::get_method("Node", "get_node");
-			gen->write_call_method_bind_validated(result, GDScriptCodeGenerator::Address(GDScriptCodeGenerator::Address::SELF), get_node_method, args);
+			if (_is_cacheable_node_path(node_path)) {
+				gen->write_get_node_cached(result, codegen.add_constant(node_path));
+			} else {
+				Vector<GDScriptCodeGenerator::Address> args;
+				args.push_back(codegen.add_constant(node_path));
+
+				MethodBind *get_node_method = ClassDB::get_method("Node", "get_node");
+				gen->write_call_method_bind_validated(result, GDScriptCodeGenerator::Address(GDScriptCodeGenerator::Address::SELF), get_node_method, args);
+			}
 
 			return result;
 		} break;
@@ -834,7 +1083,11 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 			if (named) {
 				gen->write_get_named(result, name, base);
 			} else {
-				gen->write_get(result, index, base);
+				if (codegen.is_in_bounds_index(subscript)) {
+					gen->write_get_in_bounds(result, index, base);
+				} else {
+					gen->write_get(result, index, base);
+				}
 			}
 
 			if (index.mode == GDScriptCodeGenerator::Address::TEMPORARY) {
@@ -1087,6 +1340,7 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 
 				struct ChainInfo {
 					bool is_named = false;
+					bool in_bounds = false;
 					GDScriptCodeGenerator::Address base;
 					GDScriptCodeGenerator::Address key;
 					StringName name;
@@ -1103,6 +1357,7 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 					GDScriptCodeGenerator::Address value = codegen.add_temporary(_gdtype_from_datatype(subscript_elem->get_datatype(), codegen.script));
 					GDScriptCodeGenerator::Address key;
 					StringName name;
+					const bool in_bounds = codegen.is_in_bounds_index(subscript_elem);
 
 					if (subscript_elem->is_attribute) {
 						name = subscript_elem->attribute->name;
@@ -1112,11 +1367,15 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 						if (r_error) {
 							return GDScriptCodeGenerator::Address();
 						}
-						gen->write_get(value, key, prev_base);
+						if (in_bounds) {
+							gen->write_get_in_bounds(value, key, prev_base);
+						} else {
+							gen->write_get(value, key, prev_base);
+						}
 					}
 
 					// Store base and key for setting it back later.
-					set_chain.push_front({ subscript_elem->is_attribute, prev_base, key, name }); // Push to front to invert the list.
+					set_chain.push_front({ subscript_elem->is_attribute, in_bounds, prev_base, key, name }); // Push to front to invert the list.
 					prev_base = value;
 				}
 
@@ -1143,6 +1402,8 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 					GDScriptCodeGenerator::Address value = codegen.add_temporary(_gdtype_from_datatype(subscript->get_datatype(), codegen.script));
 					if (subscript->is_attribute) {
 						gen->write_get_named(value, name, prev_base);
+					} else if (codegen.is_in_bounds_index(subscript)) {
+						gen->write_get_in_bounds(value, key, prev_base);
 					} else {
 						gen->write_get(value, key, prev_base);
 					}
@@ -1157,6 +1418,8 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 				// Perform assignment.
 				if (subscript->is_attribute) {
 					gen->write_set_named(prev_base, name, assigned);
+				} else if (codegen.is_in_bounds_index(subscript)) {
+					gen->write_set_in_bounds(prev_base, key, assigned);
 				} else {
 					gen->write_set(prev_base, key, assigned);
 				}
@@ -1179,7 +1442,9 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 							// Jump shared values since they are already updated in-place.
 							gen->write_jump_if_shared(assigned);
 						}
-						if (!info.is_named) {
+						if (info.in_bounds) {
+							gen->write_set_in_bounds(info.base, info.key, assigned);
+						} else if (!info.is_named) {
 							gen->write_set(info.base, info.key, assigned);
 						} else {
 							gen->write_set_named(info.base, info.name, assigned);
@@ -2105,11 +2370,25 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 
 				//_clear_block_locals(codegen, loop_locals); // Inside loop, before block - for `continue`. // TODO
 
+				// Indexing the container with the counter of a loop over its size can't go out of bounds,
+				// as long as nothing in the body can resize the container or reassign either of them.
+				StringName counted_container = _get_counted_loop_container(for_n);
+				if (counted_container != StringName() && !_can_skip_bounds_checks(for_n->loop, counted_container, for_n->variable->name)) {
+					counted_container = StringName();
+				}
+				if (counted_container != StringName()) {
+					codegen.in_bounds_indices.push_back(Pair<StringName, StringName>(counted_container, for_n->variable->name));
+				}
+
 				err = _parse_block(codegen, for_n->loop, false); // Don't add locals again.
 				if (err) {
 					return err;
 				}
 
+				if (counted_container != StringName()) {
+					codegen.in_bounds_indices.resize(codegen.in_bounds_indices.size() - 1);
+				}
+
 				gen->write_endfor(range_call != nullptr);
 
 				_clear_block_locals(codegen, loop_locals); // Outside loop, after block - for `break` and normal exit.
@@ -3287,6 +3566,9 @@ Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_scri
 	main_script = p_script;
 	const GDScriptParser::ClassNode *root = parser->get_tree();
 
+	// Members and functions are about to change, drop what VM inline caches remember about them.
+	GDScriptFunction::invalidate_inline_caches();
+
 	source = p_script->get_path();
 
 	ScriptLambdaInfo old_lambda_info = _get_script_lambda_replacement_info(p_script);
@@ -3311,6 +3593,9 @@ Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_scri
 	HashMap<GDScriptFunction *, GDScriptFunction *> func_ptr_replacements;
 	_get_function_ptr_replacements(func_ptr_replacements, old_lambda_info, &new_lambda_info);
 	main_script->_recurse_replace_function_ptrs(func_ptr_replacements);
+	GDScriptFunction::invalidate_inline_caches();
+
+	GDScriptAOT::attach(parser, main_script);
 
 	if (has_static_data && !root->annotated_static_unload) {
 		GDScriptCache::add_static_script(p_script);
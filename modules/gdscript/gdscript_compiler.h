@@ -139,6 +139,23 @@ class GDScriptCompiler {
 			locals_stack.pop_back();
 			generator->end_block();
 		}
+
+		// Containers indexed by the counter of a loop over their size, which can't go out of bounds.
+		LocalVector<Pair<StringName, StringName>> in_bounds_indices; // Container and counter names.
+
+		bool is_in_bounds_index(const GDScriptParser::SubscriptNode *p_subscript) const {
+			if (in_bounds_indices.is_empty() || p_subscript->is_attribute || p_subscript->base->type != GDScriptParser::Node::IDENTIFIER || p_subscript->index->type != GDScriptParser::Node::IDENTIFIER) {
+				return false;
+			}
+			const StringName &container = static_cast<const GDScriptParser::IdentifierNode *>(p_subscript->base)->name;
+			const StringName &counter = static_cast<const GDScriptParser::IdentifierNode *>(p_subscript->index)->name;
+			for (const Pair<StringName, StringName> &E : in_bounds_indices) {
+				if (E.first == container && E.second == counter) {
+					return true;
+				}
+			}
+			return false;
+		}
 	};
 
 	bool _is_class_member_property(CodeGen &codegen, const StringName &p_name);
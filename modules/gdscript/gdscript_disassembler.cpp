@@ -142,6 +142,24 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+			case OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT: {
+				text += "validated operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+				text += _code_ptr[ip] == OPCODE_OPERATOR_VALIDATED_JUMP_IF ? ", jump-if " : ", jump-if-not ";
+				text += DADDR(3);
+				text += " to ";
+				text += itos(_code_ptr[ip + 7]);
+
+				incr += 8;
+			} break;
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
@@ -301,6 +319,53 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_GET_INDEXED_ARRAY:
+			case OPCODE_GET_INDEXED_PACKED_INT32_ARRAY:
+			case OPCODE_GET_INDEXED_PACKED_INT64_ARRAY:
+			case OPCODE_GET_INDEXED_PACKED_FLOAT32_ARRAY:
+			case OPCODE_GET_INDEXED_PACKED_FLOAT64_ARRAY:
+			case OPCODE_GET_INDEXED_PACKED_VECTOR2_ARRAY:
+			case OPCODE_GET_INDEXED_PACKED_VECTOR3_ARRAY:
+			case OPCODE_GET_INDEXED_ARRAY_IN_BOUNDS:
+			case OPCODE_GET_INDEXED_PACKED_INT32_ARRAY_IN_BOUNDS:
+			case OPCODE_GET_INDEXED_PACKED_INT64_ARRAY_IN_BOUNDS:
+			case OPCODE_GET_INDEXED_PACKED_FLOAT32_ARRAY_IN_BOUNDS:
+			case OPCODE_GET_INDEXED_PACKED_FLOAT64_ARRAY_IN_BOUNDS:
+			case OPCODE_GET_INDEXED_PACKED_VECTOR2_ARRAY_IN_BOUNDS:
+			case OPCODE_GET_INDEXED_PACKED_VECTOR3_ARRAY_IN_BOUNDS: {
+				text += _code_ptr[ip] >= OPCODE_GET_INDEXED_ARRAY_IN_BOUNDS ? "get indexed in bounds " : "get indexed direct ";
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += "[";
+				text += DADDR(2);
+				text += "]";
+
+				incr += 4;
+			} break;
+			case OPCODE_SET_INDEXED_TYPED_ARRAY:
+			case OPCODE_SET_INDEXED_PACKED_INT32_ARRAY:
+			case OPCODE_SET_INDEXED_PACKED_INT64_ARRAY:
+			case OPCODE_SET_INDEXED_PACKED_FLOAT32_ARRAY:
+			case OPCODE_SET_INDEXED_PACKED_FLOAT64_ARRAY:
+			case OPCODE_SET_INDEXED_PACKED_VECTOR2_ARRAY:
+			case OPCODE_SET_INDEXED_PACKED_VECTOR3_ARRAY:
+			case OPCODE_SET_INDEXED_TYPED_ARRAY_IN_BOUNDS:
+			case OPCODE_SET_INDEXED_PACKED_INT32_ARRAY_IN_BOUNDS:
+			case OPCODE_SET_INDEXED_PACKED_INT64_ARRAY_IN_BOUNDS:
+			case OPCODE_SET_INDEXED_PACKED_FLOAT32_ARRAY_IN_BOUNDS:
+			case OPCODE_SET_INDEXED_PACKED_FLOAT64_ARRAY_IN_BOUNDS:
+			case OPCODE_SET_INDEXED_PACKED_VECTOR2_ARRAY_IN_BOUNDS:
+			case OPCODE_SET_INDEXED_PACKED_VECTOR3_ARRAY_IN_BOUNDS: {
+				text += _code_ptr[ip] >= OPCODE_SET_INDEXED_TYPED_ARRAY_IN_BOUNDS ? "set indexed in bounds " : "set indexed direct ";
+				text += DADDR(1);
+				text += "[";
+				text += DADDR(2);
+				text += "] = ";
+				text += DADDR(3);
+
+				incr += 4;
+			} break;
 			case OPCODE_SET_NAMED: {
 				text += "set_named ";
 				text += DADDR(1);
@@ -309,7 +374,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += "\"] = ";
 				text += DADDR(2);
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_SET_NAMED_VALIDATED: {
 				text += "set_named validated ";
@@ -330,7 +395,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += _global_names_ptr[_code_ptr[ip + 3]];
 				text += "\"]";
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_GET_NAMED_VALIDATED: {
 				text += "get_named validated ";
@@ -709,7 +774,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				}
 				text += ")";
 
-				incr = 5 + argc;
+				incr = 6 + argc;
 			} break;
 			case OPCODE_CALL_METHOD_BIND:
 			case OPCODE_CALL_METHOD_BIND_RET: {
@@ -1241,6 +1306,14 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 3;
 			} break;
+			case OPCODE_GET_NODE_CACHED: {
+				text += "get node cached ";
+				text += DADDR(2);
+				text += " = ";
+				text += DADDR(1);
+
+				incr += 3;
+			} break;
 			case OPCODE_LINE: {
 				int line = _code_ptr[ip + 1] - 1;
 				if (line >= 0 && line < p_code_lines.size()) {
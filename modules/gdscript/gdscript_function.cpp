@@ -33,6 +33,9 @@
 #include "gdscript.h"
 
 #include "core/object/class_db.h"
+#include "core/os/spin_lock.h"
+#include "core/templates/hashfuncs.h"
+#include "core/variant/variant_internal.h"
 
 bool GDScriptDataType::is_type(const Variant &p_variant, bool p_allow_implicit_conversion) const {
 	switch (kind) {
@@ -161,6 +164,64 @@ StringName GDScriptFunction::get_global_name(int p_idx) const {
 	return global_names[p_idx];
 }
 
+bool GDScriptFunction::_call_aot(const Variant **p_args, int p_argcount, Variant &r_ret) const {
+	// Translated functions only take `bool`, `int` and `float`, without default arguments.
+	if (p_argcount != _argument_count) {
+		return false;
+	}
+
+	GDScriptAOTABI::Value args[16];
+	ERR_FAIL_COND_V(p_argcount > (int)std_size(args), false);
+	for (int i = 0; i < p_argcount; i++) {
+		const Variant &arg = *p_args[i];
+		switch (argument_types[i].builtin_type) {
+			case Variant::BOOL:
+				if (arg.get_type() != Variant::BOOL) {
+					return false;
+				}
+				args[i].b = *VariantInternal::get_bool(&arg) ? 1 : 0;
+				break;
+			case Variant::INT:
+				if (arg.get_type() != Variant::INT) {
+					return false;
+				}
+				args[i].i = *VariantInternal::get_int(&arg);
+				break;
+			case Variant::FLOAT:
+				if (arg.get_type() == Variant::FLOAT) {
+					args[i].f = *VariantInternal::get_float(&arg);
+				} else if (arg.get_type() == Variant::INT) {
+					args[i].f = double(*VariantInternal::get_int(&arg));
+				} else {
+					return false;
+				}
+				break;
+			default:
+				return false;
+		}
+	}
+
+	GDScriptAOTABI::Context context = { 0, 0 };
+	GDScriptAOTABI::Value ret;
+	aot_call(args, &ret, &context);
+	if (context.error != 0) {
+		return false;
+	}
+
+	switch (return_type.builtin_type) {
+		case Variant::BOOL:
+			r_ret = ret.b != 0;
+			break;
+		case Variant::INT:
+			r_ret = ret.i;
+			break;
+		default:
+			r_ret = ret.f;
+			break;
+	}
+	return true;
+}
+
 struct _GDFKC {
 	int order = 0;
 	List<int> pos;
@@ -223,6 +284,73 @@ void GDScriptFunction::debug_get_stack_member_state(int p_line, List<Pair<String
 	}
 }
 
+// Frames are rounded up to `FRAME_GRANULARITY` bytes and cached per size class.
+// Bigger frames are rare enough to go straight to the allocator.
+static constexpr uint32_t FRAME_GRANULARITY = 64;
+static constexpr uint32_t FRAME_SIZE_CLASSES = 64;
+static constexpr uint32_t FRAME_CACHE_MAX = 128; // Per size class.
+
+struct GDScriptFramePool {
+	struct FreeFrame {
+		FreeFrame *next = nullptr;
+	};
+
+	SpinLock spin_lock;
+	FreeFrame *free_frames[FRAME_SIZE_CLASSES] = {};
+	uint32_t free_count[FRAME_SIZE_CLASSES] = {};
+};
+
+static GDScriptFramePool frame_pool;
+
+uint8_t *GDScriptFunction::_alloc_frame(uint32_t p_size) {
+	const uint32_t size_class = (MAX(p_size, 1u) - 1) / FRAME_GRANULARITY;
+	if (unlikely(size_class >= FRAME_SIZE_CLASSES)) {
+		return (uint8_t *)memalloc(p_size);
+	}
+
+	frame_pool.spin_lock.lock();
+	GDScriptFramePool::FreeFrame *frame = frame_pool.free_frames[size_class];
+	if (frame) {
+		frame_pool.free_frames[size_class] = frame->next;
+		frame_pool.free_count[size_class]--;
+		frame_pool.spin_lock.unlock();
+		return (uint8_t *)frame;
+	}
+	frame_pool.spin_lock.unlock();
+
+	return (uint8_t *)memalloc((size_class + 1) * FRAME_GRANULARITY);
+}
+
+void GDScriptFunction::_free_frame(uint8_t *p_frame, uint32_t p_size) {
+	const uint32_t size_class = (MAX(p_size, 1u) - 1) / FRAME_GRANULARITY;
+	if (likely(size_class < FRAME_SIZE_CLASSES)) {
+		frame_pool.spin_lock.lock();
+		if (frame_pool.free_count[size_class] < FRAME_CACHE_MAX) {
+			GDScriptFramePool::FreeFrame *frame = (GDScriptFramePool::FreeFrame *)p_frame;
+			frame->next = frame_pool.free_frames[size_class];
+			frame_pool.free_frames[size_class] = frame;
+			frame_pool.free_count[size_class]++;
+			frame_pool.spin_lock.unlock();
+			return;
+		}
+		frame_pool.spin_lock.unlock();
+	}
+
+	memfree(p_frame);
+}
+
+void GDScriptFunction::_clear_frame_pool() {
+	frame_pool.spin_lock.lock();
+	for (uint32_t i = 0; i < FRAME_SIZE_CLASSES; i++) {
+		while (GDScriptFramePool::FreeFrame *frame = frame_pool.free_frames[i]) {
+			frame_pool.free_frames[i] = frame->next;
+			memfree(frame);
+		}
+		frame_pool.free_count[i] = 0;
+	}
+	frame_pool.spin_lock.unlock();
+}
+
 GDScriptFunction::GDScriptFunction() {
 	name = "<anonymous>";
 #ifdef DEBUG_ENABLED
@@ -342,14 +470,19 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 
 void GDScriptFunctionState::_clear_stack() {
 	if (state.stack_size) {
-		Variant *stack = (Variant *)state.stack.ptr();
+		Variant *stack = (Variant *)state.stack;
 		// First `GDScriptFunction::FIXED_ADDRESSES_MAX` stack addresses are special
-		// and not copied to the state, so we skip them here.
+		// and not kept alive in the state, so we skip them here.
 		for (int i = GDScriptFunction::FIXED_ADDRESSES_MAX; i < state.stack_size; i++) {
 			stack[i].~Variant();
 		}
 		state.stack_size = 0;
 	}
+	if (state.stack) {
+		GDScriptFunction::_free_frame(state.stack, state.frame_size);
+		state.stack = nullptr;
+		state.frame_size = 0;
+	}
 }
 
 void GDScriptFunctionState::_clear_connections() {
@@ -361,6 +494,64 @@ void GDScriptFunctionState::_clear_connections() {
 	}
 }
 
+// Resumes the function state directly when the awaited signal is emitted, so the
+// connection doesn't need a method lookup and a bound copy of the state.
+class GDScriptFunctionStateResumeCallable : public CallableCustom {
+	Ref<GDScriptFunctionState> function_state;
+
+	static bool compare_equal(const CallableCustom *p_a, const CallableCustom *p_b) {
+		return p_a == p_b;
+	}
+
+	static bool compare_less(const CallableCustom *p_a, const CallableCustom *p_b) {
+		return p_a < p_b;
+	}
+
+public:
+	uint32_t hash() const override {
+		return hash_murmur3_one_64((uint64_t)function_state->get_instance_id());
+	}
+
+	String get_as_text() const override {
+		return "GDScriptFunctionState::resume";
+	}
+
+	CompareEqualFunc get_compare_equal_func() const override {
+		return compare_equal;
+	}
+
+	CompareLessFunc get_compare_less_func() const override {
+		return compare_less;
+	}
+
+	ObjectID get_object() const override {
+		return function_state->get_instance_id();
+	}
+
+	void call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const override {
+		r_call_error.error = Callable::CallError::CALL_OK;
+
+		if (p_argcount == 0) {
+			r_return_value = function_state->resume();
+		} else if (p_argcount == 1) {
+			r_return_value = function_state->resume(*p_arguments[0]);
+		} else {
+			Array extra_args;
+			for (int i = 0; i < p_argcount; i++) {
+				extra_args.push_back(*p_arguments[i]);
+			}
+			r_return_value = function_state->resume(extra_args);
+		}
+	}
+
+	GDScriptFunctionStateResumeCallable(const Ref<GDScriptFunctionState> &p_function_state) :
+			function_state(p_function_state) {}
+};
+
+Error GDScriptFunctionState::_connect_resume(Signal p_signal) {
+	return p_signal.connect(Callable(memnew(GDScriptFunctionStateResumeCallable(Ref<GDScriptFunctionState>(this)))), Object::CONNECT_ONE_SHOT);
+}
+
 void GDScriptFunctionState::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("resume", "arg"), &GDScriptFunctionState::resume, DEFVAL(Variant()));
 	ClassDB::bind_method(D_METHOD("is_valid", "extended_check"), &GDScriptFunctionState::is_valid, DEFVAL(false));
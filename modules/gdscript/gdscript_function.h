@@ -30,13 +30,16 @@
 
 #pragma once
 
+#include "gdscript_aot.h"
 #include "gdscript_utility_functions.h"
 
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
 
@@ -152,6 +155,8 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_DICTIONARY,
@@ -163,6 +168,34 @@ public:
 		OPCODE_GET_KEYED,
 		OPCODE_GET_KEYED_VALIDATED,
 		OPCODE_GET_INDEXED_VALIDATED,
+		OPCODE_GET_INDEXED_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_INT32_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_INT64_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_FLOAT32_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_FLOAT64_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_VECTOR2_ARRAY,
+		OPCODE_GET_INDEXED_PACKED_VECTOR3_ARRAY,
+		OPCODE_GET_INDEXED_ARRAY_IN_BOUNDS,
+		OPCODE_GET_INDEXED_PACKED_INT32_ARRAY_IN_BOUNDS,
+		OPCODE_GET_INDEXED_PACKED_INT64_ARRAY_IN_BOUNDS,
+		OPCODE_GET_INDEXED_PACKED_FLOAT32_ARRAY_IN_BOUNDS,
+		OPCODE_GET_INDEXED_PACKED_FLOAT64_ARRAY_IN_BOUNDS,
+		OPCODE_GET_INDEXED_PACKED_VECTOR2_ARRAY_IN_BOUNDS,
+		OPCODE_GET_INDEXED_PACKED_VECTOR3_ARRAY_IN_BOUNDS,
+		OPCODE_SET_INDEXED_TYPED_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_INT32_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_INT64_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_FLOAT32_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_FLOAT64_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_VECTOR2_ARRAY,
+		OPCODE_SET_INDEXED_PACKED_VECTOR3_ARRAY,
+		OPCODE_SET_INDEXED_TYPED_ARRAY_IN_BOUNDS,
+		OPCODE_SET_INDEXED_PACKED_INT32_ARRAY_IN_BOUNDS,
+		OPCODE_SET_INDEXED_PACKED_INT64_ARRAY_IN_BOUNDS,
+		OPCODE_SET_INDEXED_PACKED_FLOAT32_ARRAY_IN_BOUNDS,
+		OPCODE_SET_INDEXED_PACKED_FLOAT64_ARRAY_IN_BOUNDS,
+		OPCODE_SET_INDEXED_PACKED_VECTOR2_ARRAY_IN_BOUNDS,
+		OPCODE_SET_INDEXED_PACKED_VECTOR3_ARRAY_IN_BOUNDS,
 		OPCODE_SET_NAMED,
 		OPCODE_SET_NAMED_VALIDATED,
 		OPCODE_GET_NAMED,
@@ -266,6 +299,7 @@ public:
 		OPCODE_ITERATE_RANGE,
 		OPCODE_STORE_GLOBAL,
 		OPCODE_STORE_NAMED_GLOBAL,
+		OPCODE_GET_NODE_CACHED,
 		OPCODE_TYPE_ADJUST_BOOL,
 		OPCODE_TYPE_ADJUST_INT,
 		OPCODE_TYPE_ADJUST_FLOAT,
@@ -337,11 +371,60 @@ public:
 		StringName identifier;
 	};
 
+	// Polymorphic cache attached to each untyped `OPCODE_GET_NAMED`, `OPCODE_SET_NAMED`
+	// and `OPCODE_CALL*` instruction, remembering how the name was resolved for the
+	// last few base types. Entries are tagged with `inline_cache_epoch`, which is bumped
+	// whenever a script is reloaded or freed.
+	struct InlineCache {
+		enum Kind : uint8_t {
+			KIND_NONE,
+			KIND_BUILTIN_GETTER,
+			KIND_BUILTIN_SETTER,
+			KIND_SCRIPT_MEMBER,
+			KIND_SCRIPT_FUNCTION,
+			KIND_NATIVE_GETTER,
+			KIND_NATIVE_SETTER,
+			KIND_NATIVE_METHOD,
+		};
+
+		struct Entry {
+			Kind kind = KIND_NONE;
+			Variant::Type base_type = Variant::NIL;
+			Variant::Type value_type = Variant::NIL; // Required value type for setters, `NIL` if any.
+			uint32_t epoch = 0;
+			const void *class_key = nullptr; // Unique pointer of the native class name.
+			const GDScript *script = nullptr;
+			int member_index = -1;
+			Variant::ValidatedGetter getter = nullptr;
+			Variant::ValidatedSetter setter = nullptr;
+			MethodBind *method = nullptr;
+			GDScriptFunction *function = nullptr;
+		};
+
+		static constexpr int MAX_ENTRIES = 4;
+		// Past this many stores the site is considered megamorphic and no longer updated.
+		static constexpr int MAX_STORES = 16;
+
+		// Odd while an entry is being written, so readers can detect torn entries.
+		std::atomic<uint32_t> version = 0;
+		int count = 0;
+		int stores = 0;
+		Entry entries[MAX_ENTRIES];
+	};
+
+	static SafeNumeric<uint32_t> inline_cache_epoch;
+
+	static void invalidate_inline_caches() { inline_cache_epoch.increment(); }
+
 private:
 	friend class GDScript;
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
+	friend class GDScriptByteCodeOptimizer;
 	friend class GDScriptLanguage;
+	friend class GDScriptBinaryBytecode;
+	friend class GDScriptFunctionState;
+	friend class GDScriptAOT;
 
 	StringName name;
 	StringName source;
@@ -381,6 +464,11 @@ private:
 	Vector<GDScriptUtilityFunctions::FunctionPtr> gds_utilities;
 	Vector<MethodBind *> methods;
 	Vector<GDScriptFunction *> lambdas;
+	LocalVector<InlineCache> inline_caches;
+
+	// Native code from a GDScript AOT library, used instead of the bytecode when set.
+	GDScriptAOTABI::Call aot_call = nullptr;
+	bool _call_aot(const Variant **p_args, int p_argcount, Variant &r_ret) const;
 
 	int _code_size = 0;
 	int _default_arg_count = 0;
@@ -399,6 +487,7 @@ private:
 	int _gds_utilities_count = 0;
 	int _methods_count = 0;
 	int _lambdas_count = 0;
+	int _inline_caches_count = 0;
 
 	int *_code_ptr = nullptr;
 	const int *_default_arg_ptr = nullptr;
@@ -417,6 +506,7 @@ private:
 	const GDScriptUtilityFunctions::FunctionPtr *_gds_utilities_ptr = nullptr;
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
+	InlineCache *_inline_caches_ptr = nullptr;
 
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
@@ -455,6 +545,20 @@ private:
 	String _get_callable_call_error(const String &p_where, const Callable &p_callable, const Variant **p_argptrs, int p_argcount, const Variant &p_ret, const Callable::CallError &p_err) const;
 	Variant _get_default_variant_for_data_type(const GDScriptDataType &p_data_type);
 
+	static bool _inline_cache_get_key(const Variant *p_base, InlineCache::Entry &r_key, Object *&r_object, GDScriptInstance *&r_instance);
+	static bool _inline_cache_find(InlineCache &p_cache, const InlineCache::Entry &p_key, InlineCache::Entry &r_entry);
+	static void _inline_cache_store(InlineCache &p_cache, const InlineCache::Entry &p_entry);
+	static bool _inline_cache_get_named(InlineCache &p_cache, const Variant *p_base, const StringName &p_name, Variant &r_ret);
+	static void _inline_cache_set_named(InlineCache &p_cache, Variant *p_base, const StringName &p_name, const Variant &p_value, bool &r_valid);
+	static void _inline_cache_call(InlineCache &p_cache, Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error);
+	bool _get_node_cached(GDScriptInstance *p_instance, int p_ip, const NodePath &p_path, Variant &r_ret) const;
+
+	// Frames of suspended coroutines are kept in size-classed free lists, so
+	// `await` in a loop doesn't hit the allocator every time.
+	static uint8_t *_alloc_frame(uint32_t p_size);
+	static void _free_frame(uint8_t *p_frame, uint32_t p_size);
+	static void _clear_frame_pool();
+
 public:
 	static constexpr int MAX_CALL_DEPTH = 2048; // Limit to try to avoid crash because of a stack overflow.
 
@@ -466,7 +570,8 @@ public:
 		StringName function_name;
 		String script_path;
 #endif
-		Vector<uint8_t> stack;
+		uint8_t *stack = nullptr; // Frame taken from the frame pool, see `_alloc_frame()`.
+		uint32_t frame_size = 0;
 		int stack_size = 0;
 		int ip = 0;
 		int line = 0;
@@ -483,6 +588,7 @@ public:
 	_FORCE_INLINE_ int get_argument_count() const { return _argument_count; }
 	_FORCE_INLINE_ Variant get_rpc_config() const { return rpc_config; }
 	_FORCE_INLINE_ int get_max_stack_size() const { return _stack_size; }
+	_FORCE_INLINE_ int get_code_size() const { return _code_size; }
 
 	Variant get_constant(int p_idx) const;
 	StringName get_global_name(int p_idx) const;
@@ -525,6 +631,7 @@ public:
 
 	void _clear_stack();
 	void _clear_connections();
+	Error _connect_resume(Signal p_signal);
 
 	GDScriptFunctionState();
 	~GDScriptFunctionState();
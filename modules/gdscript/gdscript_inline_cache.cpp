@@ -0,0 +1,388 @@
+/**************************************************************************/
+/*  gdscript_inline_cache.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+
+#include "gdscript_function.h"
+
+#include "gdscript.h"
+
+#include "core/config/engine.h"
+#include "core/object/class_db.h"
+#include "core/variant/variant_internal.h"
+#include "scene/main/node.h"
+#include "scene/scene_string_names.h"
+
+SafeNumeric<uint32_t> GDScriptFunction::inline_cache_epoch(1);
+
+bool GDScriptFunction::_inline_cache_get_key(const Variant *p_base, InlineCache::Entry &r_key, Object *&r_object, GDScriptInstance *&r_instance) {
+	r_key.base_type = p_base->get_type();
+	r_key.epoch = inline_cache_epoch.get();
+	r_object = nullptr;
+	r_instance = nullptr;
+	if (r_key.base_type != Variant::OBJECT) {
+		return true;
+	}
+
+	r_object = p_base->get_validated_object();
+	if (unlikely(!r_object)) {
+		return false; // Let the regular path report the error.
+	}
+	r_key.class_key = r_object->get_class_name().data_unique_pointer();
+
+	ScriptInstance *script_instance = r_object->get_script_instance();
+	if (script_instance) {
+		// Placeholders and other languages resolve names their own way.
+		if (script_instance->is_placeholder() || script_instance->get_language() != GDScriptLanguage::get_singleton()) {
+			return false;
+		}
+		r_instance = static_cast<GDScriptInstance *>(script_instance);
+		r_key.script = r_instance->script.ptr();
+	}
+	return true;
+}
+
+bool GDScriptFunction::_inline_cache_find(InlineCache &p_cache, const InlineCache::Entry &p_key, InlineCache::Entry &r_entry) {
+	const uint32_t version = p_cache.version.load(std::memory_order_acquire);
+	if (version & 1) {
+		return false; // Being updated by another thread.
+	}
+
+	InlineCache::Entry found;
+	const int count = MIN(p_cache.count, InlineCache::MAX_ENTRIES);
+	for (int i = 0; i < count; i++) {
+		const InlineCache::Entry &entry = p_cache.entries[i];
+		if (entry.epoch == p_key.epoch && entry.base_type == p_key.base_type && entry.class_key == p_key.class_key && entry.script == p_key.script) {
+			found = entry;
+			break;
+		}
+	}
+
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if (found.epoch == 0 || p_cache.version.load(std::memory_order_relaxed) != version) {
+		return false;
+	}
+	r_entry = found;
+	return true;
+}
+
+void GDScriptFunction::_inline_cache_store(InlineCache &p_cache, const InlineCache::Entry &p_entry) {
+	uint32_t version = p_cache.version.load(std::memory_order_relaxed);
+	if ((version & 1) || p_cache.stores >= InlineCache::MAX_STORES) {
+		return;
+	}
+	if (!p_cache.version.compare_exchange_strong(version, version + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+		return; // Another thread is updating it, this result isn't worth waiting for.
+	}
+	std::atomic_thread_fence(std::memory_order_release);
+
+	// Reuse the slot of the same key or of an outdated entry, then append, then evict.
+	int index = -1;
+	for (int i = 0; i < p_cache.count; i++) {
+		const InlineCache::Entry &entry = p_cache.entries[i];
+		if (entry.epoch != p_entry.epoch || (entry.base_type == p_entry.base_type && entry.class_key == p_entry.class_key && entry.script == p_entry.script)) {
+			index = i;
+			break;
+		}
+	}
+	if (index == -1) {
+		index = p_cache.count < InlineCache::MAX_ENTRIES ? p_cache.count++ : p_cache.stores % InlineCache::MAX_ENTRIES;
+	}
+	p_cache.entries[index] = p_entry;
+	p_cache.stores++;
+
+	p_cache.version.store(version + 2, std::memory_order_release);
+}
+
+bool GDScriptFunction::_inline_cache_get_named(InlineCache &p_cache, const Variant *p_base, const StringName &p_name, Variant &r_ret) {
+	InlineCache::Entry entry;
+	Object *object = nullptr;
+	GDScriptInstance *instance = nullptr;
+	const bool cacheable = _inline_cache_get_key(p_base, entry, object, instance);
+	const bool found = cacheable && _inline_cache_find(p_cache, entry, entry);
+
+	if (found) {
+		switch (entry.kind) {
+			case InlineCache::KIND_BUILTIN_GETTER: {
+				// Validated getters expect the target to already hold the member type.
+				if (likely(r_ret.get_type() == entry.value_type && &r_ret != p_base)) {
+					entry.getter(p_base, &r_ret);
+				} else {
+					Variant ret;
+					VariantInternal::initialize(&ret, entry.value_type);
+					entry.getter(p_base, &ret);
+					r_ret = ret;
+				}
+				return true;
+			}
+			case InlineCache::KIND_SCRIPT_MEMBER: {
+				if (likely(entry.member_index < instance->members.size())) {
+					if (unlikely(&r_ret == p_base)) {
+						// The target may hold the only reference to the instance.
+						const Variant value = instance->members[entry.member_index];
+						r_ret = value;
+					} else {
+						r_ret = instance->members[entry.member_index];
+					}
+					return true;
+				}
+			} break;
+			case InlineCache::KIND_NATIVE_GETTER: {
+				Callable::CallError ce;
+				const Variant ret = entry.method->call(object, nullptr, 0, ce);
+				r_ret = (ce.error == Callable::CallError::CALL_OK) ? ret : Variant();
+				return true;
+			}
+			default: {
+			} break;
+		}
+	}
+
+	bool valid;
+	r_ret = p_base->get_named(p_name, valid);
+	if (!valid || !cacheable || found) {
+		return valid;
+	}
+
+	// Resolve the name the same way `Variant::get_named()` just did.
+	entry.kind = InlineCache::KIND_NONE;
+	if (!object) {
+		entry.getter = Variant::get_member_validated_getter(entry.base_type, p_name);
+		if (entry.getter) {
+			entry.kind = InlineCache::KIND_BUILTIN_GETTER;
+			entry.value_type = Variant::get_member_type(entry.base_type, p_name);
+		}
+	} else if (instance) {
+		// Other script-side names (constants, static variables, methods, `_get()`) aren't cached.
+		const GDScript::MemberInfo *member = instance->script->member_indices.getptr(p_name);
+		if (member && !member->getter) {
+			entry.kind = InlineCache::KIND_SCRIPT_MEMBER;
+			entry.member_index = member->index;
+		}
+	} else if (!ClassDB::is_gdextension(object->get_class_name())) {
+		// Only plain properties, a method, constant or signal declared with the same
+		// name in a derived class would take precedence in `ClassDB::get_property()`.
+		const StringName &class_name = object->get_class_name();
+		bool is_property = false;
+		const int index = ClassDB::get_property_index(class_name, p_name, &is_property);
+		if (is_property && index < 0 && !ClassDB::has_method(class_name, p_name) && !ClassDB::has_integer_constant(class_name, p_name) && !ClassDB::has_signal(class_name, p_name)) {
+			const StringName getter = ClassDB::get_property_getter(class_name, p_name);
+			entry.method = getter != StringName() ? ClassDB::get_method(class_name, getter) : nullptr;
+			if (entry.method) {
+				entry.kind = InlineCache::KIND_NATIVE_GETTER;
+			}
+		}
+	}
+	_inline_cache_store(p_cache, entry);
+
+	return valid;
+}
+
+void GDScriptFunction::_inline_cache_set_named(InlineCache &p_cache, Variant *p_base, const StringName &p_name, const Variant &p_value, bool &r_valid) {
+	InlineCache::Entry entry;
+	Object *object = nullptr;
+	GDScriptInstance *instance = nullptr;
+	const bool cacheable = _inline_cache_get_key(p_base, entry, object, instance);
+	const bool found = cacheable && _inline_cache_find(p_cache, entry, entry);
+
+	if (found && (entry.value_type == Variant::NIL || entry.value_type == p_value.get_type())) {
+		switch (entry.kind) {
+			case InlineCache::KIND_BUILTIN_SETTER: {
+				entry.setter(p_base, &p_value);
+				r_valid = true;
+				return;
+			}
+			case InlineCache::KIND_SCRIPT_MEMBER: {
+				if (likely(entry.member_index < instance->members.size())) {
+					instance->members.write[entry.member_index] = p_value;
+					r_valid = true;
+					return;
+				}
+			} break;
+			case InlineCache::KIND_NATIVE_SETTER: {
+				const Variant *args[1] = { &p_value };
+				Callable::CallError ce;
+				entry.method->call(object, args, 1, ce);
+				r_valid = ce.error == Callable::CallError::CALL_OK;
+				return;
+			}
+			default: {
+			} break;
+		}
+	}
+
+	p_base->set_named(p_name, p_value, r_valid);
+	if (!r_valid || !cacheable || found) {
+		return;
+	}
+
+	// Resolve the name the same way `Variant::set_named()` just did.
+	// `Object::set()` also marks objects as edited, which only matters in the editor.
+	bool cache_objects = true;
+#ifdef TOOLS_ENABLED
+	cache_objects = !Engine::get_singleton()->is_editor_hint();
+#endif
+	entry.kind = InlineCache::KIND_NONE;
+	if (!object) {
+		entry.setter = Variant::get_member_validated_setter(entry.base_type, p_name);
+		if (entry.setter) {
+			entry.kind = InlineCache::KIND_BUILTIN_SETTER;
+			entry.value_type = Variant::get_member_type(entry.base_type, p_name);
+		}
+	} else if (instance && cache_objects) {
+		const GDScript::MemberInfo *member = instance->script->member_indices.getptr(p_name);
+		// Typed members are only cached for plain built-in types, anything else needs a conversion or a check.
+		if (member && !member->setter) {
+			if (!member->data_type.has_type()) {
+				entry.kind = InlineCache::KIND_SCRIPT_MEMBER;
+			} else if (member->data_type.kind == GDScriptDataType::BUILTIN && member->data_type.container_element_types.is_empty()) {
+				entry.kind = InlineCache::KIND_SCRIPT_MEMBER;
+				entry.value_type = member->data_type.builtin_type;
+			}
+			entry.member_index = member->index;
+		}
+	} else if (!instance && cache_objects && !ClassDB::is_gdextension(object->get_class_name())) {
+		const StringName &class_name = object->get_class_name();
+		bool is_property = false;
+		const int index = ClassDB::get_property_index(class_name, p_name, &is_property);
+		if (is_property && index < 0) {
+			const StringName setter = ClassDB::get_property_setter(class_name, p_name);
+			entry.method = setter != StringName() ? ClassDB::get_method(class_name, setter) : nullptr;
+			if (entry.method) {
+				entry.kind = InlineCache::KIND_NATIVE_SETTER;
+			}
+		}
+	}
+	_inline_cache_store(p_cache, entry);
+}
+
+void GDScriptFunction::_inline_cache_call(InlineCache &p_cache, Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
+	if (p_base->get_type() != Variant::OBJECT) {
+		// Built-in methods already have validated calls for typed code.
+		p_base->callp(p_method, p_args, p_argcount, r_ret, r_error);
+		return;
+	}
+
+	InlineCache::Entry entry;
+	Object *object = nullptr;
+	GDScriptInstance *instance = nullptr;
+	const bool cacheable = _inline_cache_get_key(p_base, entry, object, instance);
+	const bool found = cacheable && _inline_cache_find(p_cache, entry, entry);
+
+	if (found) {
+		switch (entry.kind) {
+			case InlineCache::KIND_SCRIPT_FUNCTION: {
+				r_ret = entry.function->call(instance, p_args, p_argcount, r_error);
+				return;
+			}
+			case InlineCache::KIND_NATIVE_METHOD: {
+				r_ret = entry.method->call(object, p_args, p_argcount, r_error);
+				return;
+			}
+			default: {
+			} break;
+		}
+	}
+
+	p_base->callp(p_method, p_args, p_argcount, r_ret, r_error);
+	if (r_error.error != Callable::CallError::CALL_OK || !cacheable || found) {
+		return;
+	}
+
+	// Resolve the method the same way `Object::callp()` just did.
+	// `free()` and `_ready()` have special handling there, so they're never cached.
+	entry.kind = InlineCache::KIND_NONE;
+	if (p_method != CoreStringName(free_) && p_method != SceneStringName(_ready)) {
+		if (instance) {
+			for (GDScript *script = instance->script.ptr(); script; script = script->base.ptr()) {
+				GDScriptFunction *const *function = script->valid ? script->member_functions.getptr(p_method) : nullptr;
+				if (function) {
+					entry.kind = InlineCache::KIND_SCRIPT_FUNCTION;
+					entry.function = *function;
+					break;
+				}
+			}
+		}
+		if (entry.kind == InlineCache::KIND_NONE) {
+			entry.method = ClassDB::get_method(object->get_class_name(), p_method);
+			if (entry.method) {
+				entry.kind = InlineCache::KIND_NATIVE_METHOD;
+			}
+		}
+	}
+	_inline_cache_store(p_cache, entry);
+}
+
+bool GDScriptFunction::_get_node_cached(GDScriptInstance *p_instance, int p_ip, const NodePath &p_path, Variant &r_ret) const {
+	Node *base = p_instance ? Object::cast_to<Node>(p_instance->owner) : nullptr;
+	if (unlikely(!base)) {
+		return false;
+	}
+	if (unlikely(!base->is_accessible_from_caller_thread())) {
+		r_ret = base->get_node(p_path); // Let `get_node()` report the error.
+		return true;
+	}
+
+	// The compiler only emits cached lookups for paths that stay inside the base node's
+	// subtree, so any change that could resolve them differently bumps its version.
+	const uint32_t epoch = inline_cache_epoch.get();
+	const uint64_t subtree_version = base->get_subtree_version();
+	GDScriptInstance::NodeCacheEntry *slot = nullptr;
+	for (GDScriptInstance::NodeCacheEntry &entry : p_instance->node_cache) {
+		if (entry.function == this && entry.ip == p_ip && entry.epoch == epoch) {
+			if (entry.subtree_version == subtree_version) {
+				r_ret = entry.node;
+				return true;
+			}
+			slot = &entry;
+			break;
+		}
+		if (!slot && entry.epoch != epoch) {
+			slot = &entry; // Left over from a reloaded script.
+		}
+	}
+
+	Node *node = base->get_node(p_path);
+	r_ret = node;
+	if (!node) {
+		return true; // Not cached, so the error is reported on every access.
+	}
+
+	if (!slot) {
+		if (p_instance->node_cache.size() >= GDScriptInstance::NODE_CACHE_MAX_ENTRIES) {
+			return true;
+		}
+		p_instance->node_cache.push_back(GDScriptInstance::NodeCacheEntry());
+		slot = &p_instance->node_cache[p_instance->node_cache.size() - 1];
+	}
+	slot->function = this;
+	slot->ip = p_ip;
+	slot->epoch = epoch;
+	slot->subtree_version = subtree_version;
+	slot->node = node;
+	return true;
+}
@@ -228,6 +228,18 @@ void GDScriptParser::clear() {
 	*this = GDScriptParser();
 }
 
+void GDScriptParser::add_dependency(const String &p_path) {
+	if (p_path.is_empty()) {
+		return;
+	}
+	// Same resolution as the analyzer does for `preload()`.
+	String path = p_path;
+	if (path.is_relative_path()) {
+		path = script_path.get_base_dir().path_join(path);
+	}
+	dependencies.insert(path.simplify_path());
+}
+
 void GDScriptParser::push_error(const String &p_message, const Node *p_origin) {
 	// TODO: Improve error reporting by pointing at source code.
 	// TODO: Errors might point at more than one place at once (e.g. show previous declaration).
@@ -873,6 +885,10 @@ Ref<GDScriptParserRef> GDScriptParser::get_depended_parser_for(const String &p_p
 	Ref<GDScriptParserRef> ref;
 	if (depended_parsers.has(p_path)) {
 		ref = depended_parsers[p_path];
+	} else if (preload_parsers && preload_parsers->has(p_path)) {
+		// Preloaded parsers aren't in the cache yet, and shared ones must not be raised by several tasks.
+		ref = (*preload_parsers)[p_path];
+		depended_parsers[p_path] = ref;
 	} else {
 		Error err = OK;
 		ref = GDScriptCache::get_parser(p_path, GDScriptParserRef::EMPTY, err, script_path);
@@ -1021,6 +1037,7 @@ void GDScriptParser::parse_extends() {
 			push_error(vformat(R"(Only strings or identifiers can be used after "extends", found "%s" instead.)", Variant::get_type_name(previous.literal.get_type())));
 		}
 		current_class->extends_path = previous.literal;
+		add_dependency(current_class->extends_path);
 
 		if (!match(GDScriptTokenizer::Token::PERIOD)) {
 			return;
@@ -2872,6 +2889,8 @@ GDScriptParser::ExpressionNode *GDScriptParser::parse_identifier(ExpressionNode
 			case SuiteNode::Local::UNDEFINED:
 				ERR_FAIL_V_MSG(nullptr, "Undefined local found.");
 		}
+	} else {
+		referenced_names.insert(identifier->name);
 	}
 
 	return identifier;
@@ -3704,6 +3723,10 @@ GDScriptParser::ExpressionNode *GDScriptParser::parse_preload(ExpressionNode *p_
 		push_error(R"(Expected resource path after "(".)");
 	} else if (preload->path->type == Node::LITERAL) {
 		override_completion_context(preload->path, COMPLETION_RESOURCE_PATH, preload);
+		const Variant &path = static_cast<LiteralNode *>(preload->path)->value;
+		if (path.get_type() == Variant::STRING) {
+			add_dependency(path);
+		}
 	}
 
 	pop_completion_call();
@@ -1344,6 +1344,7 @@ public:
 private:
 	friend class GDScriptAnalyzer;
 	friend class GDScriptParserRef;
+	friend struct GDScriptPreloadState;
 
 	bool _is_tool = false;
 	String script_path;
@@ -1354,6 +1355,9 @@ private:
 	bool can_continue = false;
 	List<bool> multiline_stack;
 	HashMap<String, Ref<GDScriptParserRef>> depended_parsers;
+	const HashMap<String, Ref<GDScriptParserRef>> *preload_parsers = nullptr; // Set while analyzed by `GDScriptCache::preload_scripts()`.
+	HashSet<String> dependencies; // Literal `extends` and `preload()` paths.
+	HashSet<StringName> referenced_names; // Non-local identifiers, which may name global classes or autoloads.
 
 	ClassNode *head = nullptr;
 	Node *list = nullptr;
@@ -1502,6 +1506,7 @@ private:
 
 	void clear();
 
+	void add_dependency(const String &p_path);
 	void push_error(const String &p_message, const Node *p_origin = nullptr);
 	void push_error(const String &p_message, const GDScriptTokenizer::Token &p_origin);
 
@@ -1648,6 +1653,9 @@ public:
 		// TODO: Keep track of deps.
 		return List<String>();
 	}
+	// Only used by the parallel preload, resource dependencies are unchanged.
+	const HashSet<String> &get_preload_dependencies() const { return dependencies; }
+	const HashSet<StringName> &get_referenced_names() const { return referenced_names; }
 
 #ifdef DEBUG_ENABLED
 	static void update_project_settings();
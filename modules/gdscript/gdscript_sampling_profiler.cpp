@@ -0,0 +1,174 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampling_profiler.h"
+
+#include "gdscript.h"
+
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+
+SafeNumeric<uint32_t> GDScriptSamplingProfiler::sample_epoch;
+thread_local uint32_t GDScriptSamplingProfiler::thread_epoch = 0;
+
+Mutex GDScriptSamplingProfiler::mutex;
+HashMap<String, uint64_t> GDScriptSamplingProfiler::samples;
+uint64_t GDScriptSamplingProfiler::sample_count = 0;
+uint64_t GDScriptSamplingProfiler::sampling_usec = 0;
+
+Thread GDScriptSamplingProfiler::timer_thread;
+SafeFlag GDScriptSamplingProfiler::running;
+uint32_t GDScriptSamplingProfiler::interval_usec = GDScriptSamplingProfiler::DEFAULT_INTERVAL_USEC;
+
+void GDScriptSamplingProfiler::_timer_thread_func(void *p_userdata) {
+	Thread::set_name("GDScript Sampling Profiler");
+
+	while (running.is_set()) {
+		OS::get_singleton()->delay_usec(interval_usec);
+		sample_epoch.increment();
+	}
+}
+
+void GDScriptSamplingProfiler::_take_sample(uint32_t p_epoch) {
+	// Wrapping subtraction, the epoch is a free-running counter.
+	const uint32_t ticks = p_epoch - thread_epoch;
+	thread_epoch = p_epoch;
+
+	if (!running.is_set()) {
+		// Stale epoch from a previous session.
+		return;
+	}
+
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+
+	// Build the folded stack, outermost frame first.
+	LocalVector<const GDScriptLanguage::CallLevel *> levels;
+	for (const GDScriptLanguage::CallLevel *cl = GDScriptLanguage::_call_stack; cl; cl = cl->prev) {
+		levels.push_back(cl);
+	}
+	if (levels.is_empty()) {
+		return;
+	}
+
+	String stack;
+	for (int64_t i = int64_t(levels.size()) - 1; i >= 0; i--) {
+		const GDScriptLanguage::CallLevel *cl = levels[i];
+		if (!stack.is_empty()) {
+			stack += ";";
+		}
+		if (cl->function) {
+			stack += String(cl->function->get_name());
+			stack += " (";
+			stack += cl->function->get_script() ? cl->function->get_script()->get_script_path() : String();
+			stack += ":";
+			stack += itos(*cl->line);
+			stack += ")";
+		} else {
+			stack += "<unknown>";
+		}
+	}
+
+	MutexLock lock(mutex);
+	uint64_t *count = samples.getptr(stack);
+	if (count) {
+		*count += ticks;
+	} else {
+		samples.insert(stack, ticks);
+	}
+	sample_count += ticks;
+	sampling_usec += OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+void GDScriptSamplingProfiler::start(uint32_t p_interval_usec) {
+	ERR_FAIL_COND_MSG(running.is_set(), "The GDScript sampling profiler is already running.");
+	ERR_FAIL_COND(p_interval_usec == 0);
+
+	if (!GDScriptLanguage::get_singleton()->should_track_call_stack()) {
+		WARN_PRINT("The GDScript sampling profiler needs call stacks, which are not tracked in this build. Enable \"debug/settings/gdscript/always_track_call_stacks\" to get samples.");
+	}
+
+	interval_usec = p_interval_usec;
+	running.set();
+	timer_thread.start(_timer_thread_func, nullptr);
+}
+
+void GDScriptSamplingProfiler::stop() {
+	if (!running.is_set()) {
+		return;
+	}
+
+	running.clear();
+	timer_thread.wait_to_finish();
+}
+
+void GDScriptSamplingProfiler::clear() {
+	MutexLock lock(mutex);
+	samples.clear();
+	sample_count = 0;
+	sampling_usec = 0;
+}
+
+uint64_t GDScriptSamplingProfiler::get_sample_count() {
+	MutexLock lock(mutex);
+	return sample_count;
+}
+
+uint64_t GDScriptSamplingProfiler::get_sampling_usec() {
+	MutexLock lock(mutex);
+	return sampling_usec;
+}
+
+String GDScriptSamplingProfiler::get_folded_stacks() {
+	MutexLock lock(mutex);
+
+	// Sorted so that files of different runs can be diffed.
+	Vector<String> stacks;
+	stacks.resize(samples.size());
+	int index = 0;
+	for (const KeyValue<String, uint64_t> &E : samples) {
+		stacks.write[index++] = E.key;
+	}
+	stacks.sort();
+
+	String result;
+	for (const String &stack : stacks) {
+		result += stack + " " + itos(samples[stack]) + "\n";
+	}
+	return result;
+}
+
+Error GDScriptSamplingProfiler::save_folded_stacks(const String &p_path) {
+	Error err;
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(file.is_null(), err, vformat(R"(Cannot save GDScript samples to "%s".)", p_path));
+
+	file->store_string(get_folded_stacks());
+	return OK;
+}
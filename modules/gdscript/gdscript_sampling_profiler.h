@@ -0,0 +1,94 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/safe_refcount.h"
+
+// Statistical profiler for GDScript, cheap enough to run on production-like loads.
+//
+// A timer thread bumps a global sample epoch at a fixed interval. Every thread running
+// GDScript polls the epoch at each `OPCODE_LINE` and, when it changed, records its own
+// call stack (so no other thread ever walks it). A sample counts the ticks elapsed since the
+// thread last sampled, so lines following long native calls get their weight. Ticks that
+// happen while the thread runs no script are skipped. Samples are aggregated by stack and
+// saved in the folded format ("frame;frame;frame count" per line) read by flame graph
+// tools such as `flamegraph.pl` and speedscope.
+//
+// Stacks are only available while the language tracks them, which is always the case in
+// debug builds, and requires `debug/settings/gdscript/always_track_call_stacks` otherwise.
+// Time spent in native code called from a script is attributed to the next line that runs.
+class GDScriptSamplingProfiler {
+	static SafeNumeric<uint32_t> sample_epoch;
+	static thread_local uint32_t thread_epoch;
+
+	static Mutex mutex;
+	static HashMap<String, uint64_t> samples;
+	static uint64_t sample_count;
+	static uint64_t sampling_usec;
+
+	static Thread timer_thread;
+	static SafeFlag running;
+	static uint32_t interval_usec;
+
+	static void _timer_thread_func(void *p_userdata);
+	static void _take_sample(uint32_t p_epoch);
+
+public:
+	static constexpr uint32_t DEFAULT_INTERVAL_USEC = 1000;
+
+	// Called by the VM at every line, must stay as cheap as possible.
+	_FORCE_INLINE_ static void poll() {
+		const uint32_t epoch = sample_epoch.get();
+		if (unlikely(epoch != thread_epoch)) {
+			_take_sample(epoch);
+		}
+	}
+
+	// Called when a thread enters its outermost script function, to skip the ticks elapsed while it was idle.
+	_FORCE_INLINE_ static void sync_thread() {
+		thread_epoch = sample_epoch.get();
+	}
+
+	static void start(uint32_t p_interval_usec = DEFAULT_INTERVAL_USEC);
+	static void stop();
+	static bool is_running() { return running.is_set(); }
+
+	static void clear();
+	static uint64_t get_sample_count();
+	// Total time spent recording samples, across all threads.
+	static uint64_t get_sampling_usec();
+
+	static String get_folded_stacks();
+	static Error save_folded_stacks(const String &p_path);
+};
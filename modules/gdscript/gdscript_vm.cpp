@@ -34,6 +34,7 @@
 
 #include "core/object/class_db.h"
 #include "core/os/os.h"
+#include "core/profiling/frame_telemetry.h"
 #include "core/profiling/profiling.h"
 
 #ifdef DEBUG_ENABLED
@@ -256,6 +257,8 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = { \
 		&&OPCODE_OPERATOR, \
 		&&OPCODE_OPERATOR_VALIDATED, \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF, \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT, \
 		&&OPCODE_TYPE_TEST_BUILTIN, \
 		&&OPCODE_TYPE_TEST_ARRAY, \
 		&&OPCODE_TYPE_TEST_DICTIONARY, \
@@ -267,6 +270,34 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_GET_KEYED, \
 		&&OPCODE_GET_KEYED_VALIDATED, \
 		&&OPCODE_GET_INDEXED_VALIDATED, \
+		&&OPCODE_GET_INDEXED_ARRAY, \
+		&&OPCODE_GET_INDEXED_PACKED_INT32_ARRAY, \
+		&&OPCODE_GET_INDEXED_PACKED_INT64_ARRAY, \
+		&&OPCODE_GET_INDEXED_PACKED_FLOAT32_ARRAY, \
+		&&OPCODE_GET_INDEXED_PACKED_FLOAT64_ARRAY, \
+		&&OPCODE_GET_INDEXED_PACKED_VECTOR2_ARRAY, \
+		&&OPCODE_GET_INDEXED_PACKED_VECTOR3_ARRAY, \
+		&&OPCODE_GET_INDEXED_ARRAY_IN_BOUNDS, \
+		&&OPCODE_GET_INDEXED_PACKED_INT32_ARRAY_IN_BOUNDS, \
+		&&OPCODE_GET_INDEXED_PACKED_INT64_ARRAY_IN_BOUNDS, \
+		&&OPCODE_GET_INDEXED_PACKED_FLOAT32_ARRAY_IN_BOUNDS, \
+		&&OPCODE_GET_INDEXED_PACKED_FLOAT64_ARRAY_IN_BOUNDS, \
+		&&OPCODE_GET_INDEXED_PACKED_VECTOR2_ARRAY_IN_BOUNDS, \
+		&&OPCODE_GET_INDEXED_PACKED_VECTOR3_ARRAY_IN_BOUNDS, \
+		&&OPCODE_SET_INDEXED_TYPED_ARRAY, \
+		&&OPCODE_SET_INDEXED_PACKED_INT32_ARRAY, \
+		&&OPCODE_SET_INDEXED_PACKED_INT64_ARRAY, \
+		&&OPCODE_SET_INDEXED_PACKED_FLOAT32_ARRAY, \
+		&&OPCODE_SET_INDEXED_PACKED_FLOAT64_ARRAY, \
+		&&OPCODE_SET_INDEXED_PACKED_VECTOR2_ARRAY, \
+		&&OPCODE_SET_INDEXED_PACKED_VECTOR3_ARRAY, \
+		&&OPCODE_SET_INDEXED_TYPED_ARRAY_IN_BOUNDS, \
+		&&OPCODE_SET_INDEXED_PACKED_INT32_ARRAY_IN_BOUNDS, \
+		&&OPCODE_SET_INDEXED_PACKED_INT64_ARRAY_IN_BOUNDS, \
+		&&OPCODE_SET_INDEXED_PACKED_FLOAT32_ARRAY_IN_BOUNDS, \
+		&&OPCODE_SET_INDEXED_PACKED_FLOAT64_ARRAY_IN_BOUNDS, \
+		&&OPCODE_SET_INDEXED_PACKED_VECTOR2_ARRAY_IN_BOUNDS, \
+		&&OPCODE_SET_INDEXED_PACKED_VECTOR3_ARRAY_IN_BOUNDS, \
 		&&OPCODE_SET_NAMED, \
 		&&OPCODE_SET_NAMED_VALIDATED, \
 		&&OPCODE_GET_NAMED, \
@@ -370,6 +401,7 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_ITERATE_RANGE, \
 		&&OPCODE_STORE_GLOBAL, \
 		&&OPCODE_STORE_NAMED_GLOBAL, \
+		&&OPCODE_GET_NODE_CACHED, \
 		&&OPCODE_TYPE_ADJUST_BOOL, \
 		&&OPCODE_TYPE_ADJUST_INT, \
 		&&OPCODE_TYPE_ADJUST_FLOAT, \
@@ -507,6 +539,14 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	r_err.error = Callable::CallError::CALL_OK;
 
+	if (aot_call != nullptr && p_state == nullptr) {
+		// Falls back to the bytecode on unexpected arguments or errors, which the VM then reports.
+		Variant aot_ret;
+		if (_call_aot(p_args, p_argcount, aot_ret)) {
+			return aot_ret;
+		}
+	}
+
 	static thread_local int call_depth = 0;
 	if (unlikely(++call_depth > MAX_CALL_DEPTH)) {
 		call_depth--;
@@ -532,31 +572,36 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		return _get_default_variant_for_data_type(return_type);
 	}
 
+	// Only the outermost call is timed, calls between script functions are part of it.
+	FrameTelemetry::Scope telemetry_scope(FrameTelemetry::SUBSYSTEM_SCRIPT, call_depth == 1);
+
 	Variant retvalue;
 	Variant *stack = nullptr;
 	Variant **instruction_args = nullptr;
 	int defarg = 0;
 
 	uint32_t alloca_size = 0;
+	uint8_t *frame = nullptr; // Pooled frame owned by this call, `nullptr` while running on the native stack.
 	GDScript *script;
 	int ip = 0;
 	int line = _initial_line;
 
 	if (p_state) {
 		// Use existing (supplied) state (awaited).
-		stack = (Variant *)p_state->stack.ptr();
-		instruction_args = (Variant **)&p_state->stack.ptr()[sizeof(Variant) * p_state->stack_size]; // `ptr()` to avoid bounds check.
+		frame = p_state->stack;
+		stack = (Variant *)frame;
+		instruction_args = (Variant **)&frame[sizeof(Variant) * p_state->stack_size];
 		line = p_state->line;
 		ip = p_state->ip;
-		alloca_size = p_state->stack.size();
+		alloca_size = p_state->frame_size;
 		script = p_state->script;
 		p_instance = p_state->instance;
 		defarg = p_state->defarg;
 
-		// Responsibility for the stack is moved from `GDScriptFunctionState` to this method. So, we reset `p_state->stack_size`
-		// to prevent `GDScriptFunctionState::_clear_stack()` from clearing the stack again.
-		// NOTE: Strictly speaking, ownership doesn't move. However, we can be sure that `p_state->stack` won't be cleared
-		// before the current call completes, and that `p_state` won't be resumed again.
+		// Ownership of the frame moves from `GDScriptFunctionState` to this method, so it's released on exit
+		// or handed over as is if the function awaits again, without copying the locals.
+		p_state->stack = nullptr;
+		p_state->frame_size = 0;
 		p_state->stack_size = 0;
 	} else {
 		if (p_argcount != _argument_count) {
@@ -862,6 +907,54 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			// Superinstructions: `OPCODE_OPERATOR_VALIDATED` followed by a conditional jump on its result.
+			// The layout is the concatenation of both, with the jump target at `ip + 7`.
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF) {
+				CHECK_SPACE(8);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				if (dst->booleanize()) {
+					int to = _code_ptr[ip + 7];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 8;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) {
+				CHECK_SPACE(8);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				if (!dst->booleanize()) {
+					int to = _code_ptr[ip + 7];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 8;
+				}
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1205,8 +1298,154 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			// Direct element access when the container type is known at compile time. The `_IN_BOUNDS` variants
+			// are emitted for indices proven to be in range (counted loops over the container's size), so the
+			// check is only kept in debug builds.
+#ifdef DEBUG_ENABLED
+#define OPCODE_INDEXED_CHECK_HOISTED true
+#define OPCODE_INDEXED_READ_ONLY(m_base) \
+	err_text = "Invalid assignment on read-only value (on base: '" + _get_var_type(m_base) + "')."; \
+	OPCODE_BREAK
+#define OPCODE_INDEXED_OUT_OF_BOUNDS(m_action, m_base, m_index) \
+	err_text = "Out of bounds " m_action " index '" + itos(m_index) + "' (on base: '" + _get_var_type(m_base) + "')"; \
+	OPCODE_BREAK
+#else
+#define OPCODE_INDEXED_CHECK_HOISTED false
+#define OPCODE_INDEXED_READ_ONLY(m_base) \
+	ip += 4; \
+	DISPATCH_OPCODE
+#define OPCODE_INDEXED_OUT_OF_BOUNDS(m_action, m_base, m_index) \
+	ip += 4; \
+	DISPATCH_OPCODE
+#endif
+
+#define OPCODE_GET_INDEXED_DIRECT(m_opcode, m_check_bounds, m_container_type, m_get_func, m_elem_type, m_elem_get_func) \
+	OPCODE(m_opcode) { \
+		CHECK_SPACE(3); \
+		GET_VARIANT_PTR(src, 0); \
+		GET_VARIANT_PTR(index, 1); \
+		GET_VARIANT_PTR(dst, 2); \
+		const m_container_type *container = VariantInternal::m_get_func((const Variant *)src); \
+		int64_t int_index = *VariantInternal::get_int(index); \
+		if (m_check_bounds) { \
+			const int64_t size = container->size(); \
+			if (int_index < 0) { \
+				int_index += size; \
+			} \
+			if (unlikely(int_index < 0 || int_index >= size)) { \
+				OPCODE_INDEXED_OUT_OF_BOUNDS("get", src, *VariantInternal::get_int(index)); \
+			} \
+		} \
+		VariantTypeChanger<m_elem_type>::change(dst); \
+		*VariantInternal::m_elem_get_func(dst) = container->ptr()[int_index]; \
+		ip += 4; \
+	} \
+	DISPATCH_OPCODE
+
+#define OPCODE_SET_INDEXED_DIRECT(m_opcode, m_check_bounds, m_container_type, m_get_func, m_value_get_func) \
+	OPCODE(m_opcode) { \
+		CHECK_SPACE(3); \
+		GET_VARIANT_PTR(dst, 0); \
+		GET_VARIANT_PTR(index, 1); \
+		GET_VARIANT_PTR(value, 2); \
+		m_container_type *container = VariantInternal::m_get_func(dst); \
+		int64_t int_index = *VariantInternal::get_int(index); \
+		if (m_check_bounds) { \
+			const int64_t size = container->size(); \
+			if (int_index < 0) { \
+				int_index += size; \
+			} \
+			if (unlikely(int_index < 0 || int_index >= size)) { \
+				OPCODE_INDEXED_OUT_OF_BOUNDS("set", dst, *VariantInternal::get_int(index)); \
+			} \
+		} \
+		container->ptrw()[int_index] = *VariantInternal::m_value_get_func(value); \
+		ip += 4; \
+	} \
+	DISPATCH_OPCODE
+
+			OPCODE_GET_INDEXED_DIRECT(OPCODE_GET_INDEXED_PACKED_INT32_ARRAY, true, PackedInt32Array, get_int32_array, int64_t, get_int);
+			OPCODE_GET_INDEXED_DIRECT(OPCODE_GET_INDEXED_PACKED_INT64_ARRAY, true, PackedInt64Array, get_int64_array, int64_t, get_int);
+			OPCODE_GET_INDEXED_DIRECT(OPCODE_GET_INDEXED_PACKED_FLOAT32_ARRAY, true, PackedFloat32Array, get_float32_array, double, get_float);
+			OPCODE_GET_INDEXED_DIRECT(OPCODE_GET_INDEXED_PACKED_FLOAT64_ARRAY, true, PackedFloat64Array, get_float64_array, double, get_float);
+			OPCODE_GET_INDEXED_DIRECT(OPCODE_GET_INDEXED_PACKED_VECTOR2_ARRAY, true, PackedVector2Array, get_vector2_array, Vector2, get_vector2);
+			OPCODE_GET_INDEXED_DIRECT(OPCODE_GET_INDEXED_PACKED_VECTOR3_ARRAY, true, PackedVector3Array, get_vector3_array, Vector3, get_vector3);
+			OPCODE_GET_INDEXED_DIRECT(OPCODE_GET_INDEXED_PACKED_INT32_ARRAY_IN_BOUNDS, OPCODE_INDEXED_CHECK_HOISTED, PackedInt32Array, get_int32_array, int64_t, get_int);
+			OPCODE_GET_INDEXED_DIRECT(OPCODE_GET_INDEXED_PACKED_INT64_ARRAY_IN_BOUNDS, OPCODE_INDEXED_CHECK_HOISTED, PackedInt64Array, get_int64_array, int64_t, get_int);
+			OPCODE_GET_INDEXED_DIRECT(OPCODE_GET_INDEXED_PACKED_FLOAT32_ARRAY_IN_BOUNDS, OPCODE_INDEXED_CHECK_HOISTED, PackedFloat32Array, get_float32_array, double, get_float);
+			OPCODE_GET_INDEXED_DIRECT(OPCODE_GET_INDEXED_PACKED_FLOAT64_ARRAY_IN_BOUNDS, OPCODE_INDEXED_CHECK_HOISTED, PackedFloat64Array, get_float64_array, double, get_float);
+			OPCODE_GET_INDEXED_DIRECT(OPCODE_GET_INDEXED_PACKED_VECTOR2_ARRAY_IN_BOUNDS, OPCODE_INDEXED_CHECK_HOISTED, PackedVector2Array, get_vector2_array, Vector2, get_vector2);
+			OPCODE_GET_INDEXED_DIRECT(OPCODE_GET_INDEXED_PACKED_VECTOR3_ARRAY_IN_BOUNDS, OPCODE_INDEXED_CHECK_HOISTED, PackedVector3Array, get_vector3_array, Vector3, get_vector3);
+
+			OPCODE_SET_INDEXED_DIRECT(OPCODE_SET_INDEXED_PACKED_INT32_ARRAY, true, PackedInt32Array, get_int32_array, get_int);
+			OPCODE_SET_INDEXED_DIRECT(OPCODE_SET_INDEXED_PACKED_INT64_ARRAY, true, PackedInt64Array, get_int64_array, get_int);
+			OPCODE_SET_INDEXED_DIRECT(OPCODE_SET_INDEXED_PACKED_FLOAT32_ARRAY, true, PackedFloat32Array, get_float32_array, get_float);
+			OPCODE_SET_INDEXED_DIRECT(OPCODE_SET_INDEXED_PACKED_FLOAT64_ARRAY, true, PackedFloat64Array, get_float64_array, get_float);
+			OPCODE_SET_INDEXED_DIRECT(OPCODE_SET_INDEXED_PACKED_VECTOR2_ARRAY, true, PackedVector2Array, get_vector2_array, get_vector2);
+			OPCODE_SET_INDEXED_DIRECT(OPCODE_SET_INDEXED_PACKED_VECTOR3_ARRAY, true, PackedVector3Array, get_vector3_array, get_vector3);
+			OPCODE_SET_INDEXED_DIRECT(OPCODE_SET_INDEXED_PACKED_INT32_ARRAY_IN_BOUNDS, OPCODE_INDEXED_CHECK_HOISTED, PackedInt32Array, get_int32_array, get_int);
+			OPCODE_SET_INDEXED_DIRECT(OPCODE_SET_INDEXED_PACKED_INT64_ARRAY_IN_BOUNDS, OPCODE_INDEXED_CHECK_HOISTED, PackedInt64Array, get_int64_array, get_int);
+			OPCODE_SET_INDEXED_DIRECT(OPCODE_SET_INDEXED_PACKED_FLOAT32_ARRAY_IN_BOUNDS, OPCODE_INDEXED_CHECK_HOISTED, PackedFloat32Array, get_float32_array, get_float);
+			OPCODE_SET_INDEXED_DIRECT(OPCODE_SET_INDEXED_PACKED_FLOAT64_ARRAY_IN_BOUNDS, OPCODE_INDEXED_CHECK_HOISTED, PackedFloat64Array, get_float64_array, get_float);
+			OPCODE_SET_INDEXED_DIRECT(OPCODE_SET_INDEXED_PACKED_VECTOR2_ARRAY_IN_BOUNDS, OPCODE_INDEXED_CHECK_HOISTED, PackedVector2Array, get_vector2_array, get_vector2);
+			OPCODE_SET_INDEXED_DIRECT(OPCODE_SET_INDEXED_PACKED_VECTOR3_ARRAY_IN_BOUNDS, OPCODE_INDEXED_CHECK_HOISTED, PackedVector3Array, get_vector3_array, get_vector3);
+
+#define OPCODE_GET_INDEXED_ARRAY_DIRECT(m_opcode, m_check_bounds) \
+	OPCODE(m_opcode) { \
+		CHECK_SPACE(3); \
+		GET_VARIANT_PTR(src, 0); \
+		GET_VARIANT_PTR(index, 1); \
+		GET_VARIANT_PTR(dst, 2); \
+		const Array *array = VariantInternal::get_array((const Variant *)src); \
+		int64_t int_index = *VariantInternal::get_int(index); \
+		if (m_check_bounds) { \
+			const int64_t size = array->size(); \
+			if (int_index < 0) { \
+				int_index += size; \
+			} \
+			if (unlikely(int_index < 0 || int_index >= size)) { \
+				OPCODE_INDEXED_OUT_OF_BOUNDS("get", src, *VariantInternal::get_int(index)); \
+			} \
+		} \
+		*dst = (*array)[int_index]; \
+		ip += 4; \
+	} \
+	DISPATCH_OPCODE
+
+			OPCODE_GET_INDEXED_ARRAY_DIRECT(OPCODE_GET_INDEXED_ARRAY, true);
+			OPCODE_GET_INDEXED_ARRAY_DIRECT(OPCODE_GET_INDEXED_ARRAY_IN_BOUNDS, OPCODE_INDEXED_CHECK_HOISTED);
+
+			// The value is statically known to match the element type, so it's stored without validation.
+#define OPCODE_SET_INDEXED_TYPED_ARRAY_DIRECT(m_opcode, m_check_bounds) \
+	OPCODE(m_opcode) { \
+		CHECK_SPACE(3); \
+		GET_VARIANT_PTR(dst, 0); \
+		GET_VARIANT_PTR(index, 1); \
+		GET_VARIANT_PTR(value, 2); \
+		Array *array = VariantInternal::get_array(dst); \
+		if (unlikely(array->is_read_only())) { \
+			OPCODE_INDEXED_READ_ONLY(dst); \
+		} \
+		int64_t int_index = *VariantInternal::get_int(index); \
+		if (m_check_bounds) { \
+			const int64_t size = array->size(); \
+			if (int_index < 0) { \
+				int_index += size; \
+			} \
+			if (unlikely(int_index < 0 || int_index >= size)) { \
+				OPCODE_INDEXED_OUT_OF_BOUNDS("set", dst, *VariantInternal::get_int(index)); \
+			} \
+		} \
+		(*array)[int_index] = *value; \
+		ip += 4; \
+	} \
+	DISPATCH_OPCODE
+
+			OPCODE_SET_INDEXED_TYPED_ARRAY_DIRECT(OPCODE_SET_INDEXED_TYPED_ARRAY, true);
+			OPCODE_SET_INDEXED_TYPED_ARRAY_DIRECT(OPCODE_SET_INDEXED_TYPED_ARRAY_IN_BOUNDS, OPCODE_INDEXED_CHECK_HOISTED);
+
 			OPCODE(OPCODE_SET_NAMED) {
-				CHECK_SPACE(3);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
@@ -1216,8 +1455,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int cache_index = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_index < 0 || cache_index >= _inline_caches_count);
+
 				bool valid;
-				dst->set_named(*index, *value, valid);
+				_inline_cache_set_named(_inline_caches_ptr[cache_index], dst, *index, *value, valid);
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1238,7 +1480,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1258,7 +1500,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
@@ -1268,13 +1510,15 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
-				bool valid;
+				int cache_index = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_index < 0 || cache_index >= _inline_caches_count);
+
 #ifdef DEBUG_ENABLED
 				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, valid);
-
+				Variant ret;
+				bool valid = _inline_cache_get_named(_inline_caches_ptr[cache_index], src, *index, ret);
 #else
-				*dst = src->get_named(*index, valid);
+				_inline_cache_get_named(_inline_caches_ptr[cache_index], src, *index, *dst);
 #endif
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1283,7 +1527,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 				*dst = ret;
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1906,7 +2150,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 
 				ip += instr_arg_count;
 
@@ -1917,6 +2161,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				int cache_index = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cache_index < 0 || cache_index >= _inline_caches_count);
+				InlineCache &cache = _inline_caches_ptr[cache_index];
+
 				GodotProfileZoneScriptSystemCall(methodname, source, name, *methodname, line);
 
 				GET_INSTRUCTION_ARG(base, argc);
@@ -1937,7 +2185,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Callable::CallError err;
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					_inline_cache_call(cache, base, *methodname, (const Variant **)argptrs, argc, temp_ret, err);
 					*ret = temp_ret;
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
@@ -1967,7 +2215,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					}
 #endif
 				} else {
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					_inline_cache_call(cache, base, *methodname, (const Variant **)argptrs, argc, temp_ret, err);
 				}
 #ifdef DEBUG_ENABLED
 
@@ -2022,7 +2270,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif // DEBUG_ENABLED
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -2604,13 +2852,6 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					Ref<GDScriptFunctionState> gdfs = memnew(GDScriptFunctionState);
 					gdfs->function = this;
 
-					gdfs->state.stack.resize(alloca_size);
-
-					// First `FIXED_ADDRESSES_MAX` stack addresses are special, so we just skip them here.
-					for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
-						memnew_placement(&gdfs->state.stack.write[sizeof(Variant) * i], Variant(stack[i]));
-					}
-					gdfs->state.stack_size = _stack_size;
 					gdfs->state.ip = ip + 2;
 					gdfs->state.line = line;
 					gdfs->state.script = _script;
@@ -2640,8 +2881,36 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 					retvalue = gdfs;
 
-					Error err = sig.connect(Callable(gdfs.ptr(), "_signal_callback").bind(retvalue), Object::CONNECT_ONE_SHOT);
+					if (!frame) {
+						// First suspension of this call, move the frame off the native stack.
+						// `Variant` is trivially relocatable, so copying the bytes moves the locals.
+						frame = _alloc_frame(alloca_size);
+						memcpy(frame, (const void *)stack, sizeof(Variant) * _stack_size);
+						stack = (Variant *)frame;
+						call_level.stack = stack;
+					}
+
+					// First `FIXED_ADDRESSES_MAX` stack addresses are special and rebuilt on resume.
+					// Hand over the frame before connecting, since the signal may resume it from another thread right away.
+					stack[ADDR_STACK_SELF].~Variant();
+					stack[ADDR_STACK_NIL].~Variant();
+					gdfs->state.stack = frame;
+					gdfs->state.frame_size = alloca_size;
+					gdfs->state.stack_size = _stack_size;
+
+					Error err = gdfs->_connect_resume(sig);
 					if (err != OK) {
+						// Take the frame back, so it's released on exit.
+						gdfs->state.stack = nullptr;
+						gdfs->state.frame_size = 0;
+						gdfs->state.stack_size = 0;
+						if (p_instance) {
+							memnew_placement(&stack[ADDR_STACK_SELF], Variant(p_instance->owner));
+						} else {
+							memnew_placement(&stack[ADDR_STACK_SELF], Variant);
+						}
+						memnew_placement(&stack[ADDR_STACK_NIL], Variant);
+
 						err_text = "Error connecting to signal: " + sig.get_name() + " during await.";
 						OPCODE_BREAK;
 					}
@@ -3324,7 +3593,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			GET_VARIANT_PTR(iterator, 2); \
 			VariantInternal::initialize(iterator, Variant::m_var_ret_type); \
 			m_ret_type *it = VariantInternal::m_ret_get_func(iterator); \
-			*it = array->get(0); \
+			*it = array->ptr()[0]; \
 			ip += 5; \
 		} else { \
 			int jumpto = _code_ptr[ip + 4]; \
@@ -3695,7 +3964,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			ip = jumpto; \
 		} else { \
 			GET_VARIANT_PTR(iterator, 2); \
-			*VariantInternal::m_ret_get_func(iterator) = array->get(*idx); \
+			*VariantInternal::m_ret_get_func(iterator) = array->ptr()[*idx]; /* Already checked against the size. */ \
 			ip += 5; \
 		} \
 	} \
@@ -3813,13 +4082,30 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				int globalname_idx = _code_ptr[ip + 2];
 				GD_ERR_BREAK(globalname_idx < 0 || globalname_idx >= _global_names_count);
 				const StringName *globalname = &_global_names_ptr[globalname_idx];
-				if (unlikely(!GDScriptLanguage::get_singleton()->get_named_globals_map().has(*globalname))) {
+				const Variant *global = GDScriptLanguage::get_singleton()->get_named_globals_map().getptr(*globalname);
+				if (unlikely(!global)) {
 					err_text = vformat(R"(Trying to access non-existent autoload singleton "%s".)", *globalname);
 					OPCODE_BREAK;
 				}
 
 				GET_VARIANT_PTR(dst, 0);
-				*dst = GDScriptLanguage::get_singleton()->get_named_globals_map()[*globalname];
+				*dst = *global;
+
+				ip += 3;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_GET_NODE_CACHED) {
+				CHECK_SPACE(3);
+
+				GET_VARIANT_PTR(path, 0);
+				GET_VARIANT_PTR(dst, 1);
+				GD_ERR_BREAK(path->get_type() != Variant::NODE_PATH);
+
+				if (unlikely(!_get_node_cached(p_instance, ip, *VariantInternal::get_node_path(path), *dst))) {
+					err_text = "Cannot get a node: the base object is not a Node.";
+					OPCODE_BREAK;
+				}
 
 				ip += 3;
 			}
@@ -3918,6 +4204,8 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				line = _code_ptr[ip + 1];
 				ip += 2;
 
+				GDScriptSamplingProfiler::poll();
+
 				if (EngineDebugger::is_active()) {
 					// line
 					bool do_break = false;
@@ -4022,13 +4310,20 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	GDScriptLanguage::get_singleton()->exit_function();
 
-	// We deliberately avoid calling the destructor for `ADDR_STACK_CLASS`, since we initialized it
-	// without incrementing any reference count that it might have.
-	stack[ADDR_STACK_SELF].~Variant();
-	stack[ADDR_STACK_NIL].~Variant();
+	// When awaited, the frame now belongs to the new function state and must not be touched.
+	if (!awaited) {
+		// We deliberately avoid calling the destructor for `ADDR_STACK_CLASS`, since we initialized it
+		// without incrementing any reference count that it might have.
+		stack[ADDR_STACK_SELF].~Variant();
+		stack[ADDR_STACK_NIL].~Variant();
 
-	for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
-		stack[i].~Variant();
+		for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
+			stack[i].~Variant();
+		}
+
+		if (frame) {
+			_free_frame(frame, alloca_size);
+		}
 	}
 
 	call_depth--;
@@ -31,6 +31,7 @@
 #include "register_types.h"
 
 #include "gdscript.h"
+#include "gdscript_binary_bytecode.h"
 #include "gdscript_cache.h"
 #include "gdscript_parser.h"
 #include "gdscript_resource_format.h"
@@ -94,6 +95,12 @@ protected:
 		if (preset.is_valid()) {
 			script_mode = preset->get_script_export_mode();
 		}
+
+		if (script_mode == EditorExportPreset::MODE_SCRIPT_COMPILED_BYTECODE && !p_debug) {
+			// The editor compiles debug bytecode, which release templates reject.
+			WARN_PRINT("GDScript: Compiled bytecode can only be exported with debug templates, exporting scripts as compressed binary tokens instead.");
+			script_mode = EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED;
+		}
 	}
 
 	virtual void _export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) override {
@@ -107,12 +114,29 @@ protected:
 		}
 
 		String source = String::utf8(reinterpret_cast<const char *>(file.ptr()), file.size());
-		GDScriptTokenizerBuffer::CompressMode compress_mode = script_mode == EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED ? GDScriptTokenizerBuffer::COMPRESS_ZSTD : GDScriptTokenizerBuffer::COMPRESS_NONE;
+		GDScriptTokenizerBuffer::CompressMode compress_mode = script_mode == EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS ? GDScriptTokenizerBuffer::COMPRESS_NONE : GDScriptTokenizerBuffer::COMPRESS_ZSTD;
 		file = GDScriptTokenizerBuffer::parse_code_string(source, compress_mode);
 		if (file.is_empty()) {
 			return;
 		}
 
+		if (script_mode == EditorExportPreset::MODE_SCRIPT_COMPILED_BYTECODE) {
+			Error err = OK;
+			Ref<GDScript> script = GDScriptCache::get_full_script(p_path, err);
+			String error;
+			Vector<uint8_t> bytecode;
+			if (err == OK && script.is_valid()) {
+				bytecode = GDScriptBinaryBytecode::save(script.ptr(), file, error);
+			} else {
+				error = "Script failed to compile.";
+			}
+			if (bytecode.is_empty()) {
+				WARN_PRINT(vformat("GDScript: Exporting \"%s\" as binary tokens, its bytecode can't be exported: %s", p_path, error));
+			} else {
+				file = bytecode;
+			}
+		}
+
 		add_file(p_path.get_basename() + ".gdc", file, true);
 	}
 
@@ -130,6 +154,11 @@ static void _editor_init() {
 	gdscript_syntax_highlighter.instantiate();
 	ScriptEditor::get_singleton()->register_syntax_highlighter(gdscript_syntax_highlighter);
 #endif
+
+	// Autoload constants are registered by now, see `EditorAutoloadSettings`.
+	GDScriptLanguage::get_singleton()->preload_project_scripts();
+
+	GDScriptAOT::handle_cmdline();
 }
 
 #endif // TOOLS_ENABLED
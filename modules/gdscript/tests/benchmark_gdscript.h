@@ -0,0 +1,351 @@
+/**************************************************************************/
+/*  benchmark_gdscript.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../gdscript.h"
+#include "../gdscript_cache.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "tests/benchmark.h"
+#include "tests/test_utils.h"
+
+namespace GDScriptBenchmarks {
+
+static void initialize_language() {
+	static bool language_initialized = false;
+	if (!language_initialized) {
+		GDScriptLanguage::get_singleton()->init();
+		language_initialized = true;
+	}
+}
+
+static Ref<RefCounted> create_benchmark_instance(const String &p_source) {
+	initialize_language();
+
+	Ref<GDScript> script;
+	script.instantiate();
+	script->set_source_code(p_source);
+	ERR_PRINT_OFF; // A spurious error is printed even when the script is valid.
+	const Error err = script->reload();
+	ERR_PRINT_ON;
+	ERR_FAIL_COND_V_MSG(err != OK, Ref<RefCounted>(), "Benchmark script failed to compile.");
+
+	Ref<RefCounted> instance;
+	instance.instantiate();
+	instance->set_script(script);
+	return instance;
+}
+
+static void call_benchmark_function(BenchmarkState &p_state, const String &p_source, const Variant &p_argument) {
+	const Ref<RefCounted> instance = create_benchmark_instance(p_source);
+	const StringName method = "run";
+
+	while (p_state.keep_running()) {
+		Variant result = instance.is_valid() ? instance->call(method, p_argument) : Variant();
+		BenchmarkState::do_not_optimize(result);
+	}
+}
+
+BENCHMARK_CASE("[GDScript] Recursive Fibonacci of 20") {
+	call_benchmark_function(p_state, R"(
+func run(n):
+	if n < 2:
+		return n
+	return run(n - 1) + run(n - 2)
+)",
+			20);
+}
+
+BENCHMARK_CASE("[GDScript] Typed integer loop of 100000 iterations") {
+	call_benchmark_function(p_state, R"(
+func run(count: int) -> int:
+	var sum := 0
+	for i in count:
+		sum += i * 2 - 1
+	return sum
+)",
+			100000);
+	p_state.set_items_per_iteration(100000);
+}
+
+BENCHMARK_CASE("[GDScript] Typed while loop with comparisons of 100000 iterations") {
+	call_benchmark_function(p_state, R"(
+func run(count: int) -> int:
+	var i := 0
+	var odd := 0
+	while i < count:
+		if i % 2 == 1:
+			odd += 1
+		i += 1
+	return odd
+)",
+			100000);
+	p_state.set_items_per_iteration(100000);
+}
+
+BENCHMARK_CASE("[GDScript] Untyped float loop of 100000 iterations") {
+	call_benchmark_function(p_state, R"(
+func run(count):
+	var value = 0.0
+	for i in count:
+		value = value * 0.5 + i
+	return value
+)",
+			100000);
+	p_state.set_items_per_iteration(100000);
+}
+
+BENCHMARK_CASE("[GDScript] Fill and sum a typed array of 10000 integers") {
+	call_benchmark_function(p_state, R"(
+func run(count: int) -> int:
+	var array: Array[int] = []
+	for i in count:
+		array.append(i)
+	var sum := 0
+	for value in array:
+		sum += value
+	return sum
+)",
+			10000);
+	p_state.set_items_per_iteration(10000);
+}
+
+BENCHMARK_CASE("[GDScript] Scale and sum a packed array of 10000 floats by index") {
+	call_benchmark_function(p_state, R"(
+func run(count: int) -> float:
+	var values := PackedFloat64Array()
+	values.resize(count)
+	for i in values.size():
+		values[i] = i * 0.5
+	var sum := 0.0
+	for i in range(values.size()):
+		values[i] *= 2.0
+		sum += values[i]
+	return sum
+)",
+			10000);
+	p_state.set_items_per_iteration(10000);
+}
+
+BENCHMARK_CASE("[GDScript] Fill and read a dictionary of 10000 keys") {
+	call_benchmark_function(p_state, R"(
+func run(count: int) -> int:
+	var dictionary := {}
+	for i in count:
+		dictionary[i] = i
+	var sum := 0
+	for i in count:
+		sum += dictionary[i]
+	return sum
+)",
+			10000);
+	p_state.set_items_per_iteration(10000);
+}
+
+BENCHMARK_CASE("[GDScript] Member access and method calls") {
+	call_benchmark_function(p_state, R"(
+var counter := 0
+
+func increment(amount: int) -> void:
+	counter += amount
+
+func run(count: int) -> int:
+	counter = 0
+	for i in count:
+		increment(i)
+	return counter
+)",
+			10000);
+	p_state.set_items_per_iteration(10000);
+}
+
+// Same work through untyped and typed bases, to compare the inline caches
+// of `OPCODE_GET_NAMED`, `OPCODE_SET_NAMED` and `OPCODE_CALL` with validated code.
+static const char *agent_benchmark_source = R"(
+class Agent:
+	var health := 100
+	var position := Vector2()
+
+	func hit(amount: int) -> void:
+		health -= amount
+
+func run_untyped(count):
+	var agent = Agent.new()
+	var resource = Resource.new()
+	var total = 0
+	for i in count:
+		agent.hit(1)
+		agent.position.x += 1.0
+		total += agent.health
+		agent.health = 100
+		resource.resource_local_to_scene = agent.health > 50
+	return total
+
+func run_typed(count: int) -> int:
+	var agent: Agent = Agent.new()
+	var resource: Resource = Resource.new()
+	var total := 0
+	for i in count:
+		agent.hit(1)
+		agent.position.x += 1.0
+		total += agent.health
+		agent.health = 100
+		resource.resource_local_to_scene = agent.health > 50
+	return total
+)";
+
+static void call_agent_benchmark(BenchmarkState &p_state, const StringName &p_method) {
+	const Ref<RefCounted> instance = create_benchmark_instance(agent_benchmark_source);
+
+	while (p_state.keep_running()) {
+		Variant result = instance.is_valid() ? instance->call(p_method, 10000) : Variant();
+		BenchmarkState::do_not_optimize(result);
+	}
+	p_state.set_items_per_iteration(10000);
+}
+
+BENCHMARK_CASE("[GDScript] Untyped property access and method calls") {
+	call_agent_benchmark(p_state, "run_untyped");
+}
+
+BENCHMARK_CASE("[GDScript] Typed property access and method calls") {
+	call_agent_benchmark(p_state, "run_typed");
+}
+
+BENCHMARK_CASE("[GDScript] Build a string of 1000 numbers") {
+	call_benchmark_function(p_state, R"(
+func run(count: int) -> String:
+	var text := ""
+	for i in count:
+		text += str(i) + ","
+	return text
+)",
+			1000);
+	p_state.set_items_per_iteration(1000);
+}
+
+// Coroutines that are resumed by the same signal over and over, which is how
+// most game logic uses `await`.
+static const char *coroutine_benchmark_source = R"(
+signal tick
+
+func wait_loop() -> void:
+	while true:
+		await tick
+
+func start(count: int) -> void:
+	for i in count:
+		wait_loop()
+)";
+
+BENCHMARK_CASE("[GDScript] Resume 1000 suspended coroutines") {
+	const Ref<RefCounted> instance = create_benchmark_instance(coroutine_benchmark_source);
+	const StringName tick = "tick";
+
+	if (instance.is_valid()) {
+		// Memory usage is only tracked in debug builds.
+		const int64_t memory_before = Memory::get_mem_usage();
+		instance->call("start", 1000);
+		p_state.set_counter("bytes/coroutine", (int64_t(Memory::get_mem_usage()) - memory_before) / 1000.0);
+	}
+
+	while (p_state.keep_running()) {
+		if (instance.is_valid()) {
+			instance->emit_signal(tick);
+		}
+	}
+	p_state.set_items_per_iteration(1000);
+}
+
+// Synthetic project of 5000 scripts: 250 independent chains of 20 scripts, each preloading the previous one.
+static const Vector<String> &get_synthetic_project() {
+	static Vector<String> paths;
+	if (!paths.is_empty()) {
+		return paths;
+	}
+
+	const String dir = TestUtils::get_temp_path("gdscript_synthetic_project");
+	DirAccess::make_dir_recursive_absolute(dir);
+	for (int chain = 0; chain < 250; chain++) {
+		for (int link = 0; link < 20; link++) {
+			String source = "extends RefCounted\n\n";
+			if (link > 0) {
+				source += vformat("const Previous = preload(\"script_%d_%d.gd\")\n\n", chain, link - 1);
+			}
+			source += vformat("var value: int = %d\n\nfunc compute(factor: int) -> int:\n\tvar total := value\n\tfor i in factor:\n\t\ttotal += i * value\n", link);
+			if (link > 0) {
+				source += "\ttotal += Previous.new().compute(factor)\n";
+			}
+			source += "\treturn total\n";
+
+			const String path = dir.path_join(vformat("script_%d_%d.gd", chain, link));
+			Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+			ERR_FAIL_COND_V(file.is_null(), paths);
+			file->store_string(source);
+			paths.push_back(path);
+		}
+	}
+	return paths;
+}
+
+static void compile_synthetic_project(BenchmarkState &p_state, bool p_parallel) {
+	initialize_language();
+	const Vector<String> &paths = get_synthetic_project();
+
+	while (p_state.keep_running()) {
+		p_state.pause_timing();
+		for (const String &path : paths) {
+			GDScriptCache::remove_script(path);
+		}
+		p_state.resume_timing();
+
+		if (p_parallel) {
+			GDScriptCache::preload_scripts(paths);
+		} else {
+			for (const String &path : paths) {
+				Error err = OK;
+				GDScriptCache::get_full_script(path, err);
+			}
+		}
+	}
+	p_state.set_items_per_iteration(paths.size());
+}
+
+BENCHMARK_CASE("[GDScript] Compile a project of 5000 scripts one by one") {
+	compile_synthetic_project(p_state, false);
+}
+
+BENCHMARK_CASE("[GDScript] Compile a project of 5000 scripts with parallel preload") {
+	compile_synthetic_project(p_state, true);
+}
+
+} // namespace GDScriptBenchmarks
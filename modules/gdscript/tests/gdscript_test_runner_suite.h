@@ -30,18 +30,21 @@
 
 #pragma once
 
+#include "../gdscript_analyzer.h"
+#include "../gdscript_aot.h"
+#include "../gdscript_binary_bytecode.h"
 #include "../gdscript_cache.h"
+#include "../gdscript_tokenizer_buffer.h"
 #include "gdscript_test_runner.h"
 
+#include "core/io/dir_access.h"
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
+#include "core/os/os.h"
+#include "core/string/print_string.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
 
-#ifdef TOOLS_ENABLED
-#include "core/os/os.h"
-#endif
-
 namespace GDScriptTests {
 
 class TestGDScriptCacheAccessor {
@@ -66,6 +69,15 @@ TEST_SUITE("[Modules][GDScript]") {
 		INFO("Make sure `*.out` files have expected results.");
 		REQUIRE_MESSAGE(fail_count == 0, "All GDScript tests should pass.");
 	}
+
+	TEST_CASE("Script compilation and runtime with bytecode optimization") {
+		GDScriptLanguage::get_singleton()->set_optimize_bytecode(true);
+		GDScriptTestRunner runner("modules/gdscript/tests/scripts", true, false, false);
+		int fail_count = runner.run_tests();
+		GDScriptLanguage::get_singleton()->set_optimize_bytecode(false);
+		INFO("Optimized bytecode must produce the same `*.out` results.");
+		REQUIRE_MESSAGE(fail_count == 0, "All GDScript tests should pass with bytecode optimization enabled.");
+	}
 }
 #endif // TOOLS_ENABLED
 
@@ -91,6 +103,271 @@ func _init():
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
 
+TEST_CASE("[Modules][GDScript] Bytecode optimization shrinks code and keeps results") {
+	GDScriptLanguage::get_singleton()->init();
+	const String source = R"(
+extends RefCounted
+
+func compute() -> int:
+	var a := 2 * 3 + 4
+	var b: int = a
+	if true:
+		b += 1
+	return b
+)";
+
+	int code_size[2] = {};
+	for (int i = 0; i < 2; i++) {
+		GDScriptLanguage::get_singleton()->set_optimize_bytecode(i == 1);
+		Ref<GDScript> gdscript = memnew(GDScript);
+		gdscript->set_source_code(source);
+		ERR_PRINT_OFF;
+		const Error error = gdscript->reload();
+		ERR_PRINT_ON;
+		REQUIRE_MESSAGE(error == OK, "The script should parse successfully.");
+
+		GDScriptFunction *function = gdscript->get_member_functions()["compute"];
+		REQUIRE(function != nullptr);
+		code_size[i] = function->get_code_size();
+
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(gdscript);
+		CHECK_MESSAGE(int(ref_counted->call("compute")) == 11, "The function should return the same result with and without optimization.");
+	}
+	GDScriptLanguage::get_singleton()->set_optimize_bytecode(false);
+
+	CHECK_MESSAGE(code_size[1] < code_size[0], "Optimized bytecode should be shorter.");
+}
+
+#ifdef DEBUG_ENABLED
+static void _append_printed_line(void *p_userdata, const String &p_string, bool p_error, bool p_rich) {
+	*static_cast<String *>(p_userdata) += p_string + "\n";
+}
+
+static String _disassemble(const Ref<GDScript> &p_script, const StringName &p_function) {
+	String output;
+	PrintHandlerList handler;
+	handler.printfunc = _append_printed_line;
+	handler.userdata = &output;
+
+	OS::get_singleton()->set_stdout_enabled(false);
+	add_print_handler(&handler);
+	p_script->get_member_functions()[p_function]->disassemble(Vector<String>());
+	remove_print_handler(&handler);
+	OS::get_singleton()->set_stdout_enabled(true);
+	return output;
+}
+
+TEST_CASE("[Modules][GDScript] Counted loops only skip bounds checks when the body can't resize the container") {
+	GDScriptLanguage::get_singleton()->init();
+	const String source = R"(
+extends RefCounted
+
+var items: Array[int] = []
+var length: int:
+	set(value):
+		items.resize(value)
+
+func drop_last(array: Array[int]) -> void:
+	array.resize(array.size() - 1)
+
+func sum(values: Array[int]) -> int:
+	var total := 0
+	for i in values.size():
+		values[i] += 1
+		total += values[i]
+	return total
+
+func sum_packed(values: PackedFloat64Array) -> float:
+	var total := 0.0
+	for i in range(values.size()):
+		total += values[i]
+	return total
+
+func sum_calling_method(values: Array[int]) -> int:
+	var total := 0
+	for i in values.size():
+		drop_last(values)
+		total += values[i]
+	return total
+
+func sum_calling_array_method(values: Array[int]) -> int:
+	var total := 0
+	for i in values.size():
+		values.pop_back()
+		total += values[i]
+	return total
+
+func sum_calling_setter() -> int:
+	var values := items
+	var total := 0
+	for i in values.size():
+		length = 1
+		total += values[i]
+	return total
+
+func sum_reassigning(values: Array[int]) -> int:
+	var total := 0
+	for i in values.size():
+		values = []
+		total += values[i]
+	return total
+)";
+
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(source);
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should parse successfully.");
+
+	const String sum = _disassemble(gdscript, "sum");
+	CHECK_MESSAGE(sum.contains("get indexed in bounds"), "Reads in a loop that can't resize the container should skip bounds checks.");
+	CHECK_MESSAGE(sum.contains("set indexed in bounds"), "Writes in a loop that can't resize the container should skip bounds checks.");
+	CHECK_MESSAGE(_disassemble(gdscript, "sum_packed").contains("get indexed in bounds"), "Packed arrays counted with `range()` should skip bounds checks.");
+
+	const char *refused[] = { "sum_calling_method", "sum_calling_array_method", "sum_calling_setter", "sum_reassigning" };
+	for (const char *function : refused) {
+		const String disassembly = _disassemble(gdscript, function);
+		INFO(function);
+		CHECK_MESSAGE(disassembly.contains("get indexed direct"), "Reads should still use the direct opcode.");
+		CHECK_MESSAGE(!disassembly.contains("in bounds"), "Loops that may resize the container should keep bounds checks.");
+	}
+}
+#endif // DEBUG_ENABLED
+
+#ifdef TOOLS_ENABLED
+TEST_CASE("[Modules][GDScript] Compiled bytecode loads and keeps results") {
+	GDScriptLanguage::get_singleton()->init();
+	const String source = R"(
+extends RefCounted
+
+const PRIMES = [2, 3, 5]
+var offset: int = 1
+
+func compute(p_factor := 2) -> int:
+	var total := 0
+	for prime in PRIMES:
+		total += prime * p_factor
+	var add := func(value): return value + offset
+	return add.call(total)
+)";
+
+	Ref<GDScript> compiled = memnew(GDScript);
+	compiled->set_source_code(source);
+	ERR_PRINT_OFF;
+	Error error = compiled->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should parse successfully.");
+
+	const Vector<uint8_t> tokens = GDScriptTokenizerBuffer::parse_code_string(source, GDScriptTokenizerBuffer::COMPRESS_ZSTD);
+	String save_error;
+	const Vector<uint8_t> bytecode = GDScriptBinaryBytecode::save(compiled.ptr(), tokens, save_error);
+	REQUIRE_MESSAGE(!bytecode.is_empty(), save_error);
+	CHECK(GDScriptBinaryBytecode::is_compatible(bytecode));
+	CHECK(GDScriptBinaryBytecode::get_binary_tokens(bytecode) == tokens);
+
+	Ref<GDScript> loaded = memnew(GDScript);
+	loaded->set_binary_tokens_source(tokens);
+	loaded->set_compiled_bytecode_source(bytecode);
+	error = loaded->reload();
+	REQUIRE_MESSAGE(error == OK, "The compiled bytecode should load successfully.");
+	CHECK_MESSAGE(!loaded->get_compiled_bytecode_source().is_empty(), "The script should be loaded from bytecode, not from tokens.");
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(loaded);
+	CHECK(int(ref_counted->call("compute")) == 21);
+	CHECK(int(ref_counted->call("compute", 1)) == 11);
+}
+#endif // TOOLS_ENABLED
+
+#ifdef DEBUG_ENABLED
+TEST_CASE("[Modules][GDScript] Sampling profiler records script call stacks") {
+	GDScriptLanguage::get_singleton()->init();
+	const String source = R"(
+extends RefCounted
+
+func wait_a_bit() -> void:
+	for i in 2:
+		OS.delay_usec(500)
+
+func spin() -> int:
+	var total := 0
+	for i in 20:
+		wait_a_bit()
+		total += i
+	return total
+)";
+
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(source);
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should parse successfully.");
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	GDScriptSamplingProfiler::clear();
+	GDScriptSamplingProfiler::start(200);
+	CHECK(int(ref_counted->call("spin")) == 190);
+	GDScriptSamplingProfiler::stop();
+
+	CHECK_MESSAGE(GDScriptSamplingProfiler::get_sample_count() > 0, "Samples should be recorded while the script runs.");
+	const String folded = GDScriptSamplingProfiler::get_folded_stacks();
+	CHECK_MESSAGE(folded.begins_with("spin ("), "Stacks should start at the outermost function.");
+	CHECK_MESSAGE(folded.contains(";wait_a_bit ("), "Stacks should contain the called functions.");
+	GDScriptSamplingProfiler::clear();
+}
+#endif // DEBUG_ENABLED
+
+TEST_CASE("[Modules][GDScript] AOT translation keeps untranslatable functions on the VM") {
+	GDScriptLanguage::get_singleton()->init();
+	const String source = R"(
+extends RefCounted
+
+var member := 1
+
+static func fib(n: int) -> int:
+	if n < 2:
+		return n
+	return fib(n - 1) + fib(n - 2)
+
+static func integrate(steps: int, dt: float) -> float:
+	var position := 0.0
+	var velocity := 1.0
+	for i in range(steps):
+		velocity -= position * dt
+		position += velocity * dt
+	return sqrt(position * position + velocity * velocity)
+
+func uses_member() -> int:
+	return member + 1
+
+func calls_untranslated() -> int:
+	return uses_member() * 2
+
+static func untyped(value):
+	return value
+)";
+
+	GDScriptParser parser;
+	REQUIRE(parser.parse(source, "res://aot_test.gd", false) == OK);
+	GDScriptAnalyzer analyzer(&parser);
+	REQUIRE(analyzer.analyze() == OK);
+
+	const GDScriptAOT::Translation translation = GDScriptAOT::translate(&parser);
+	CHECK(translation.functions == Vector<StringName>({ "fib", "integrate" }));
+	CHECK(translation.skipped.has("uses_member"));
+	CHECK(translation.skipped.has("calls_untranslated"));
+	CHECK(translation.skipped.has("untyped"));
+	CHECK(translation.code.contains("f_fib(p_context, gdaot_sub(v_n, INT64_C(1)))"));
+
+	// The same script must always produce the same code, it's how libraries are matched with scripts.
+	CHECK(GDScriptAOT::translate(&parser).code == translation.code);
+}
+
 TEST_CASE("[Modules][GDScript] Loading keeps ResourceCache and GDScriptCache in sync") {
 	const String path = TestUtils::get_temp_path("gdscript_load_test.gd");
 
@@ -111,6 +388,76 @@ TEST_CASE("[Modules][GDScript] Loading keeps ResourceCache and GDScriptCache in
 	CHECK(TestGDScriptCacheAccessor::has_full(path));
 }
 
+// Scripts that preload each other in a cycle, a chain using types of its indirect dependencies,
+// and scripts of separate groups sharing a script that is compiled before the preload.
+static Vector<String> write_cross_referencing_scripts(const String &p_dir, String &r_shared_path) {
+	DirAccess::make_dir_recursive_absolute(p_dir);
+	HashMap<String, String> sources;
+	sources["shared.gd"] = "extends RefCounted\n\nfunc base() -> int:\n\treturn 100\n";
+	sources["cycle_a.gd"] = "extends RefCounted\n\nconst B = preload(\"cycle_b.gd\")\n\nvar value := 2\n\nfunc compute() -> int:\n\treturn value * 10 + B.new().partial()\n\nfunc partial() -> int:\n\treturn value\n";
+	sources["cycle_b.gd"] = "extends RefCounted\n\nconst A = preload(\"cycle_a.gd\")\n\nfunc partial() -> int:\n\treturn 3\n\nfunc compute() -> int:\n\treturn A.new().partial() + 1\n";
+	sources["chain_0.gd"] = "extends RefCounted\n\nfunc make() -> RefCounted:\n\treturn self\n\nfunc compute() -> int:\n\treturn 7\n";
+	sources["chain_1.gd"] = "extends RefCounted\n\nconst Chain0 = preload(\"chain_0.gd\")\n\nvar next: Chain0 = Chain0.new()\n\nfunc compute() -> int:\n\treturn next.compute() * 2\n";
+	sources["chain_2.gd"] = "extends RefCounted\n\nconst Chain1 = preload(\"chain_1.gd\")\n\nfunc compute() -> int:\n\treturn Chain1.new().next.compute() + Chain1.new().compute()\n";
+	for (int i = 0; i < 16; i++) {
+		sources[vformat("user_%d.gd", i)] = vformat("extends RefCounted\n\nconst Shared = preload(\"shared.gd\")\n\nfunc compute() -> int:\n\treturn Shared.new().base() + %d\n", i);
+	}
+
+	Vector<String> paths;
+	for (const KeyValue<String, String> &E : sources) {
+		const String path = p_dir.path_join(E.key);
+		Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+		file->store_string(E.value);
+		if (E.key == "shared.gd") {
+			r_shared_path = path;
+		} else {
+			paths.push_back(path);
+		}
+	}
+	return paths;
+}
+
+static Vector<int> compute_scripts(const Vector<String> &p_paths) {
+	Vector<int> results;
+	for (const String &path : p_paths) {
+		Error err = OK;
+		Ref<GDScript> script = GDScriptCache::get_full_script(path, err);
+		if (err != OK || script.is_null() || !script->is_valid()) {
+			results.push_back(-1);
+			continue;
+		}
+		Ref<RefCounted> instance = memnew(RefCounted);
+		instance->set_script(script);
+		results.push_back(int(instance->call("compute")));
+	}
+	return results;
+}
+
+TEST_CASE("[Modules][GDScript] Preloading cross-referencing scripts keeps results") {
+	GDScriptLanguage::get_singleton()->init();
+	String shared_path;
+	const Vector<String> paths = write_cross_referencing_scripts(TestUtils::get_temp_path("gdscript_preload_test"), shared_path);
+
+	Error err = OK;
+	GDScriptCache::get_full_script(shared_path, err);
+	REQUIRE(err == OK);
+	const Vector<int> expected = compute_scripts(paths);
+	for (int result : expected) {
+		REQUIRE_MESSAGE(result >= 0, "Every script should compile without preloading.");
+	}
+
+	for (const String &path : paths) {
+		GDScriptCache::remove_script(path);
+	}
+	GDScriptCache::preload_scripts(paths);
+	CHECK(compute_scripts(paths) == expected);
+
+	for (const String &path : paths) {
+		GDScriptCache::remove_script(path);
+	}
+	GDScriptCache::remove_script(shared_path);
+}
+
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
 	GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
 
@@ -0,0 +1,45 @@
+const CONST_INTS: Array[int] = [1, 2, 3]
+
+func drop_last(array: Array[int]) -> void:
+	array.resize(array.size() - 1)
+
+func subtest_read_only_set():
+	var ints: Array[int] = [0]
+	ints.make_read_only()
+	ints[0] = 1
+	print(ints)
+
+func subtest_read_only_set_negative_index():
+	var ints := CONST_INTS
+	ints[-1] = 1
+	print(ints)
+
+func subtest_negative_index_out_of_bounds():
+	var ints: Array[int] = [1, 2]
+	var index := -3
+	var value := ints[index]
+	print(value)
+
+func subtest_packed_set_out_of_bounds():
+	var floats := PackedFloat64Array([1.0])
+	floats[1] = 2.0
+	print(floats)
+
+func subtest_packed_get_negative_index_out_of_bounds():
+	var vectors := PackedVector3Array([Vector3.ONE])
+	var vector := vectors[-2]
+	print(vector)
+
+func subtest_resized_in_counted_loop():
+	var values: Array[int] = [1, 2, 3]
+	for i in values.size():
+		drop_last(values)
+		print(values[i])
+
+func test():
+	subtest_read_only_set()
+	subtest_read_only_set_negative_index()
+	subtest_negative_index_out_of_bounds()
+	subtest_packed_set_out_of_bounds()
+	subtest_packed_get_negative_index_out_of_bounds()
+	subtest_resized_in_counted_loop()
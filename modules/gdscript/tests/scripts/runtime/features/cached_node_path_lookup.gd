@@ -0,0 +1,47 @@
+# `$Path` and `get_node()` with a constant path are cached per instance, so the
+# cache has to follow renames, additions and removals below the base node.
+extends Node
+
+func get_a():
+	return $A
+
+func get_a_c():
+	return get_node("A/C")
+
+func test():
+	var a := Node.new()
+	a.name = "A"
+	add_child(a)
+	print(get_a().name)
+	print(get_a() == a)
+
+	a.name = "Renamed"
+	var b := Node.new()
+	b.name = "A"
+	add_child(b)
+	print(get_a() == b)
+
+	remove_child(b)
+	b.free()
+	a.name = "A"
+	print(get_a() == a)
+
+	var c := Node.new()
+	c.name = "C"
+	a.add_child(c)
+	print(get_a_c() == c)
+
+	a.remove_child(c)
+	c.free()
+	var d := Node.new()
+	d.name = "C"
+	a.add_child(d)
+	print(get_a_c() == d)
+
+	var other := Node.new()
+	other.add_child(Node.new())
+	other.get_child(0).name = "A"
+	other.set_script(get_script())
+	print(other.get_a() == other.get_child(0))
+	print(get_a() == a)
+	other.free()
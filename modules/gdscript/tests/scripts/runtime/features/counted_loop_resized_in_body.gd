@@ -0,0 +1,36 @@
+# Counted loops whose body may resize the container keep checking every index.
+
+var items: Array[int] = []
+var length: int:
+	set(value):
+		items.resize(value)
+	get:
+		return items.size()
+
+func drop_last(array: Array[int]) -> void:
+	array.resize(array.size() - 1)
+
+func test():
+	var values: Array[int] = [1, 2, 3, 4]
+	var visited := 0
+	for i in values.size():
+		if i >= values.size():
+			break
+		visited += values[i]
+		drop_last(values)
+	print(values, " ", visited)
+
+	values = [1, 2, 3, 4]
+	for i in range(values.size()):
+		if i < values.size():
+			print(values[i])
+		values.pop_back()
+	print(values)
+
+	items = [5, 6, 7]
+	var aliased := items
+	for i in aliased.size():
+		if i < aliased.size():
+			print(aliased[i])
+		length = 1
+	print(aliased, " ", length)
@@ -0,0 +1,22 @@
+# Typed comparisons followed by a conditional jump are fused into a single instruction.
+
+func count_below(limit: int) -> int:
+	var i := 0
+	while i < limit:
+		i += 1
+	return i
+
+func classify(value: float) -> String:
+	if value > 1.5:
+		return "big"
+	elif value >= 0.5 and value <= 1.5:
+		return "medium"
+	elif not value > 0.0:
+		return "negative"
+	return "small"
+
+func test():
+	print(count_below(10))
+	print(count_below(-1))
+	for value: float in [2.0, 1.0, 0.25, -1.0]:
+		print(classify(value))
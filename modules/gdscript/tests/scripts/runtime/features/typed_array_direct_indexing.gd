@@ -0,0 +1,94 @@
+# Typed containers indexed with an `int` read and write their elements directly.
+
+const CONST_INTS: Array[int] = [1, 2, 3]
+
+func test():
+	var ints: Array[int] = [1, 2, 3]
+	var index := 1
+	ints[0] = 10
+	ints[index] = 20
+	ints[-1] = 30
+	print(ints)
+	print(ints[0], " ", ints[index], " ", ints[-1], " ", ints[-3])
+	var value: int = ints[-2]
+	print(value)
+
+	var strings: Array[String] = ["a", "b"]
+	strings[-1] = "c"
+	print(strings[0] + strings[1])
+
+	# A value not known to be of the element type takes the validated path.
+	var untyped_value = 40
+	ints[0] = untyped_value
+	print(ints[0])
+
+	var int32s := PackedInt32Array([1, 2, 3])
+	int32s[index] = -2
+	int32s[-1] = 2147483647
+	print(int32s, " ", int32s[-3], " ", int32s[-1])
+
+	var int64s := PackedInt64Array([1, 2, 3])
+	int64s[0] = 9223372036854775807
+	int64s[-2] = -5
+	print(int64s, " ", int64s[0], " ", int64s[-2])
+
+	var float32s := PackedFloat32Array([1.0, 2.0])
+	float32s[0] = 0.5
+	float32s[-1] = 2.25
+	print(float32s, " ", float32s[0] + float32s[-1])
+
+	var float64s := PackedFloat64Array([1.0, 2.0])
+	float64s[index] = 0.125
+	float64s[-2] = -3.5
+	print(float64s, " ", float64s[index] + float64s[-2])
+
+	var vector2s := PackedVector2Array([Vector2(), Vector2()])
+	vector2s[0] = Vector2(1, 2)
+	vector2s[-1] = Vector2(3, 4)
+	print(vector2s, " ", vector2s[-2] + vector2s[1])
+
+	var vector3s := PackedVector3Array([Vector3(), Vector3()])
+	vector3s[index] = Vector3(1, 2, 3)
+	vector3s[-2] = Vector3(4, 5, 6)
+	print(vector3s, " ", vector3s[0] + vector3s[-1])
+
+	# Packed types without direct opcodes behave the same through the validated path.
+	var bytes := PackedByteArray([1, 2])
+	bytes[-1] = 255
+	print(bytes, " ", bytes[-1])
+	var packed_strings := PackedStringArray(["a", "b"])
+	packed_strings[-2] = "c"
+	print(packed_strings, " ", packed_strings[0])
+	var colors := PackedColorArray([Color.BLACK])
+	colors[-1] = Color.WHITE
+	print(colors[0] == Color.WHITE)
+	var vector4s := PackedVector4Array([Vector4()])
+	vector4s[0] = Vector4(1, 2, 3, 4)
+	print(vector4s[-1])
+
+	# Packed arrays are passed by reference, so writes are seen through every variable.
+	var int32s_alias := int32s
+	int32s_alias[0] = 100
+	print(int32s[0], " ", int32s_alias[0])
+
+	# Reading from read-only arrays.
+	Utils.check(CONST_INTS.is_read_only())
+	print(CONST_INTS[0] + CONST_INTS[-1])
+	var read_only: Array[int] = [4, 5, 6]
+	read_only.make_read_only()
+	Utils.check(read_only.is_read_only())
+	print(read_only[index], " ", read_only[-1])
+
+	# Counted loops over the container.
+	var sum := 0
+	for i in ints.size():
+		ints[i] += 1
+		sum += ints[i]
+	print(ints, " ", sum)
+	var squares := PackedFloat64Array([1.0, 2.0, 3.0])
+	for i in range(squares.size()):
+		squares[i] = squares[i] * squares[i]
+	print(squares)
+	for i in read_only.size():
+		sum += read_only[i]
+	print(sum)
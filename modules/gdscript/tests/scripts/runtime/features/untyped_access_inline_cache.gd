@@ -0,0 +1,44 @@
+# The same untyped access sites are run on different bases, so the inline cache
+# of each instruction has to tell them apart.
+
+class A:
+	var value = 1
+
+	func describe():
+		return "A %s" % value
+
+class B extends A:
+	func describe():
+		return "B %s" % value
+
+class C:
+	var value = 0:
+		get:
+			return value * 2
+
+	func describe():
+		return "C %s" % value
+
+func get_value(base):
+	return base.value
+
+func set_value(base, new_value):
+	base.value = new_value
+
+func test():
+	var bases = [A.new(), B.new(), C.new(), A.new()]
+	for i in 2:
+		for base in bases:
+			set_value(base, i + 1)
+			print(base.describe(), " ", get_value(base))
+
+	var vectors = [Vector2(1, 2), Vector3(3, 4, 5), Vector2i(6, 7), { "x": 8 }]
+	for vector in vectors:
+		var x = vector.x
+		vector.x = 10
+		print(x, " ", vector.x)
+
+	var resource = Resource.new()
+	for text in ["first", "second"]:
+		resource.resource_name = text
+		print(resource.resource_name)
@@ -606,7 +606,8 @@ void GodotBody2D::integrate_forces(real_t p_step) {
 	biased_linear_velocity = Vector2();
 
 	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
+		_update_shapes_with_motion(motion, false);
+		deferred_broadphase_update = true;
 	}
 
 	contact_count = 0;
@@ -620,14 +621,14 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 	ERR_FAIL_NULL(get_space());
 
 	if (fi_callback_data || body_state_callback.is_valid()) {
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+		deferred_state_query = true;
 	}
 
 	if (mode == PhysicsServer2D::BODY_MODE_KINEMATIC) {
 		_set_transform(new_transform, false);
 		_set_inv_transform(new_transform.affine_inverse());
 		if (contacts.is_empty() && linear_velocity == Vector2() && angular_velocity == 0) {
-			set_active(false); //stopped moving, deactivate
+			deferred_deactivate = true; //stopped moving, deactivate
 		}
 		return;
 	}
@@ -644,7 +645,12 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 		pos += center_of_mass - center_of_mass.rotated(angle_delta);
 	}
 
-	_set_transform(Transform2D(angle, pos), continuous_cd_mode == PhysicsServer2D::CCD_MODE_DISABLED);
+	if (continuous_cd_mode == PhysicsServer2D::CCD_MODE_DISABLED) {
+		_set_transform(Transform2D(angle, pos), true, false);
+		deferred_broadphase_update = true;
+	} else {
+		_set_transform(Transform2D(angle, pos), false);
+	}
 	_set_inv_transform(get_transform().inverse());
 
 	if (continuous_cd_mode != PhysicsServer2D::CCD_MODE_DISABLED) {
@@ -654,6 +660,23 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 	_update_transform_dependent();
 }
 
+void GodotBody2D::apply_deferred_updates() {
+	if (deferred_state_query) {
+		deferred_state_query = false;
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+
+	if (deferred_broadphase_update) {
+		deferred_broadphase_update = false;
+		_update_broadphase();
+	}
+
+	if (deferred_deactivate) {
+		deferred_deactivate = false;
+		set_active(false);
+	}
+}
+
 void GodotBody2D::wakeup_neighbours() {
 	for (const Pair<GodotConstraint2D *, int> &E : constraint_list) {
 		const GodotConstraint2D *c = E.first;
@@ -101,6 +101,12 @@ class GodotBody2D : public GodotCollisionObject2D {
 	bool active = true;
 	bool can_sleep = true;
 	bool first_time_kinematic = false;
+
+	// Changes to the space left by integrate_forces() and integrate_velocities(), see apply_deferred_updates().
+	bool deferred_broadphase_update = false;
+	bool deferred_state_query = false;
+	bool deferred_deactivate = false;
+
 	void _mass_properties_changed();
 	virtual void _shapes_changed() override;
 	Transform2D new_transform;
@@ -315,8 +321,11 @@ public:
 	_FORCE_INLINE_ real_t get_friction() const { return friction; }
 	_FORCE_INLINE_ real_t get_bounce() const { return bounce; }
 
+	// These only modify the body itself, so different bodies can be integrated in parallel.
+	// apply_deferred_updates() must be called afterwards, one body at a time.
 	void integrate_forces(real_t p_step);
 	void integrate_velocities(real_t p_step);
+	void apply_deferred_updates();
 
 	_FORCE_INLINE_ Vector2 get_velocity_in_local_point(const Vector2 &rel_pos) const {
 		return linear_velocity + Vector2(-angular_velocity * rel_pos.y, angular_velocity * rel_pos.x);
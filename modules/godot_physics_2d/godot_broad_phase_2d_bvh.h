@@ -93,6 +93,9 @@ public:
 
 	virtual void update() override;
 
+	// Enabled by default, disabling it is only useful to compare results.
+	void set_parallel_pair_checks(bool p_enable) { bvh.params_set_parallel_pair_checks(p_enable); }
+
 	static GodotBroadPhase2D *_create();
 	GodotBroadPhase2DBVH();
 };
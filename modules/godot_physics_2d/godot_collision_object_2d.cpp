@@ -159,7 +159,7 @@ void GodotCollisionObject2D::_unregister_shapes() {
 	}
 }
 
-void GodotCollisionObject2D::_update_shapes() {
+void GodotCollisionObject2D::_update_shapes(bool p_update_broadphase) {
 	if (!space) {
 		return;
 	}
@@ -176,17 +176,14 @@ void GodotCollisionObject2D::_update_shapes() {
 		shape_aabb = xform.xform(shape_aabb);
 		shape_aabb.grow_by((s.aabb_cache.size.x + s.aabb_cache.size.y) * 0.5 * 0.05);
 		s.aabb_cache = shape_aabb;
+	}
 
-		if (s.bpid == 0) {
-			s.bpid = space->get_broadphase()->create(this, i, shape_aabb, _static);
-			space->get_broadphase()->set_static(s.bpid, _static);
-		}
-
-		space->get_broadphase()->move(s.bpid, shape_aabb);
+	if (p_update_broadphase) {
+		_update_broadphase();
 	}
 }
 
-void GodotCollisionObject2D::_update_shapes_with_motion(const Vector2 &p_motion) {
+void GodotCollisionObject2D::_update_shapes_with_motion(const Vector2 &p_motion, bool p_update_broadphase) {
 	if (!space) {
 		return;
 	}
@@ -203,13 +200,30 @@ void GodotCollisionObject2D::_update_shapes_with_motion(const Vector2 &p_motion)
 		shape_aabb = xform.xform(shape_aabb);
 		shape_aabb = shape_aabb.merge(Rect2(shape_aabb.position + p_motion, shape_aabb.size)); //use motion
 		s.aabb_cache = shape_aabb;
+	}
+
+	if (p_update_broadphase) {
+		_update_broadphase();
+	}
+}
+
+void GodotCollisionObject2D::_update_broadphase() {
+	if (!space) {
+		return;
+	}
+
+	for (int i = 0; i < shapes.size(); i++) {
+		Shape &s = shapes.write[i];
+		if (s.disabled) {
+			continue;
+		}
 
 		if (s.bpid == 0) {
-			s.bpid = space->get_broadphase()->create(this, i, shape_aabb, _static);
+			s.bpid = space->get_broadphase()->create(this, i, s.aabb_cache, _static);
 			space->get_broadphase()->set_static(s.bpid, _static);
 		}
 
-		space->get_broadphase()->move(s.bpid, shape_aabb);
+		space->get_broadphase()->move(s.bpid, s.aabb_cache);
 	}
 }
 
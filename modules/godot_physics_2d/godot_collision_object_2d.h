@@ -74,16 +74,19 @@ private:
 
 	SelfList<GodotCollisionObject2D> pending_shape_update_list;
 
-	void _update_shapes();
+	// Without p_update_broadphase, only the shape caches are updated, which is safe to do
+	// for several objects in parallel. _update_broadphase() must then be called afterwards.
+	void _update_shapes(bool p_update_broadphase = true);
 
 protected:
-	void _update_shapes_with_motion(const Vector2 &p_motion);
+	void _update_shapes_with_motion(const Vector2 &p_motion, bool p_update_broadphase = true);
+	void _update_broadphase();
 	void _unregister_shapes();
 
-	_FORCE_INLINE_ void _set_transform(const Transform2D &p_transform, bool p_update_shapes = true) {
+	_FORCE_INLINE_ void _set_transform(const Transform2D &p_transform, bool p_update_shapes = true, bool p_update_broadphase = true) {
 		transform = p_transform;
 		if (p_update_shapes) {
-			_update_shapes();
+			_update_shapes(p_update_broadphase);
 		}
 	}
 	_FORCE_INLINE_ void _set_inv_transform(const Transform2D &p_transform) { inv_transform = p_transform; }
@@ -40,6 +40,9 @@
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
+#define ACTIVE_BODY_COUNT_RESERVE 1024
+// Below this, integrating on the calling thread is faster than dispatching tasks.
+#define PARALLEL_INTEGRATION_MIN_BODIES 64
 
 void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
@@ -127,6 +130,35 @@ void GodotStep2D::_check_suspend(LocalVector<GodotBody2D *> &p_body_island) cons
 	}
 }
 
+void GodotStep2D::_gather_active_bodies(const SelfList<GodotBody2D>::List &p_body_list) {
+	active_bodies.clear();
+	const SelfList<GodotBody2D> *b = p_body_list.first();
+	while (b) {
+		active_bodies.push_back(b->self());
+		b = b->next();
+	}
+}
+
+void GodotStep2D::_integrate_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta);
+}
+
+void GodotStep2D::_integrate_velocities(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities(delta);
+}
+
+void GodotStep2D::_run_body_tasks(void (GodotStep2D::*p_method)(uint32_t, void *), uint32_t p_count, const StringName &p_description) {
+	if (p_count < PARALLEL_INTEGRATION_MIN_BODIES) {
+		for (uint32_t i = 0; i < p_count; i++) {
+			(this->*p_method)(i, nullptr);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, p_method, nullptr, p_count, -1, true, p_description);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	p_space->lock(); // can't access space during this
 
@@ -144,16 +176,15 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
-
-	const SelfList<GodotBody2D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	// Bodies are integrated in parallel, but anything touching the space or the broadphase
+	// is deferred and applied afterwards in list order, so results don't depend on threading.
+	_gather_active_bodies(*body_list);
+	_run_body_tasks(&GodotStep2D::_integrate_forces, active_bodies.size(), SNAME("Physics2DIntegrateForces"));
+	for (GodotBody2D *body : active_bodies) {
+		body->apply_deferred_updates();
 	}
 
-	p_space->set_active_objects(active_count);
+	p_space->set_active_objects((int)active_bodies.size());
 
 	// Update the broadphase to register collision pairs.
 	p_space->update();
@@ -194,7 +225,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
-	b = body_list->first();
+	const SelfList<GodotBody2D> *b = body_list->first();
 
 	uint32_t body_island_count = 0;
 
@@ -273,11 +304,12 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody2D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n; // in case it shuts itself down
+	// Solving may have woken up bodies, so the list is gathered again.
+	// Deactivating a body removes it from the list, which is why that is deferred as well.
+	_gather_active_bodies(*body_list);
+	_run_body_tasks(&GodotStep2D::_integrate_velocities, active_bodies.size(), SNAME("Physics2DIntegrateVelocities"));
+	for (GodotBody2D *body : active_bodies) {
+		body->apply_deferred_updates();
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
@@ -302,6 +334,7 @@ GodotStep2D::GodotStep2D() {
 	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
+	active_bodies.reserve(ACTIVE_BODY_COUNT_RESERVE);
 }
 
 GodotStep2D::~GodotStep2D() {
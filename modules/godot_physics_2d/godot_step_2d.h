@@ -44,12 +44,20 @@ class GodotStep2D {
 	LocalVector<LocalVector<GodotConstraint2D *>> constraint_islands;
 	LocalVector<GodotConstraint2D *> all_constraints;
 
+	// Copied from the active list of the space, so it can be split into tasks.
+	LocalVector<GodotBody2D *> active_bodies;
+
 	void _populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint2D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr) const;
 	void _check_suspend(LocalVector<GodotBody2D *> &p_body_island) const;
 
+	void _gather_active_bodies(const SelfList<GodotBody2D>::List &p_body_list);
+	void _integrate_forces(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _integrate_velocities(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _run_body_tasks(void (GodotStep2D::*p_method)(uint32_t, void *), uint32_t p_count, const StringName &p_description);
+
 public:
 	void step(GodotSpace2D *p_space, real_t p_delta);
 	GodotStep2D();
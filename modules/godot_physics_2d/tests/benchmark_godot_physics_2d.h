@@ -0,0 +1,153 @@
+/**************************************************************************/
+/*  benchmark_godot_physics_2d.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_physics_server_2d.h"
+
+#include "core/math/random_pcg.h"
+#include "tests/benchmark.h"
+
+namespace GodotPhysics2DBenchmarks {
+
+static constexpr real_t STEP = 1.0 / 60.0;
+static constexpr int SETTLE_STEPS = 10;
+
+// Circles moving in random directions inside a closed box, without gravity, damping or
+// sleeping. The amount of work per step stays about the same however long it runs.
+class BouncingCirclesScene {
+	static constexpr real_t RADIUS = 4.0;
+	static constexpr real_t SPACING = 10.0;
+	static constexpr real_t SPEED = 100.0;
+	static constexpr real_t WALL_HALF_THICKNESS = 16.0;
+
+	GodotPhysicsServer2D *server = nullptr;
+	RID space;
+	RID circle_shape;
+	RID horizontal_wall_shape;
+	RID vertical_wall_shape;
+	LocalVector<RID> bodies;
+
+	void _add_wall(RID p_shape, const Vector2 &p_position) {
+		RID wall = server->body_create();
+		server->body_set_mode(wall, PhysicsServer2D::BODY_MODE_STATIC);
+		server->body_add_shape(wall, p_shape);
+		server->body_set_space(wall, space);
+		server->body_set_state(wall, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0.0, p_position));
+		bodies.push_back(wall);
+	}
+
+public:
+	void step() {
+		server->step(STEP);
+	}
+
+	int get_collision_pairs() const {
+		return server->get_process_info(PhysicsServer2D::INFO_COLLISION_PAIRS);
+	}
+
+	BouncingCirclesScene(int p_body_count) {
+		server = memnew(GodotPhysicsServer2D);
+		server->init();
+
+		space = server->space_create();
+		server->space_set_active(space, true);
+		server->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY, 0.0);
+		server->area_set_param(space, PhysicsServer2D::AREA_PARAM_LINEAR_DAMP, 0.0);
+		server->area_set_param(space, PhysicsServer2D::AREA_PARAM_ANGULAR_DAMP, 0.0);
+
+		const int side = (int)Math::ceil(Math::sqrt((double)p_body_count));
+		const real_t extent = side * SPACING;
+
+		circle_shape = server->circle_shape_create();
+		server->shape_set_data(circle_shape, RADIUS);
+		horizontal_wall_shape = server->rectangle_shape_create();
+		server->shape_set_data(horizontal_wall_shape, Vector2(extent * 0.5 + WALL_HALF_THICKNESS * 2.0, WALL_HALF_THICKNESS));
+		vertical_wall_shape = server->rectangle_shape_create();
+		server->shape_set_data(vertical_wall_shape, Vector2(WALL_HALF_THICKNESS, extent * 0.5 + WALL_HALF_THICKNESS * 2.0));
+
+		_add_wall(horizontal_wall_shape, Vector2(extent * 0.5, -WALL_HALF_THICKNESS));
+		_add_wall(horizontal_wall_shape, Vector2(extent * 0.5, extent + WALL_HALF_THICKNESS));
+		_add_wall(vertical_wall_shape, Vector2(-WALL_HALF_THICKNESS, extent * 0.5));
+		_add_wall(vertical_wall_shape, Vector2(extent + WALL_HALF_THICKNESS, extent * 0.5));
+
+		// Fixed seed, so every run simulates the same scene.
+		RandomPCG rng(1234);
+		for (int i = 0; i < p_body_count; i++) {
+			const Vector2 position = (Vector2(i % side, i / side) + Vector2(0.5, 0.5)) * SPACING;
+			const Vector2 velocity = Vector2(rng.randf() * 2.0 - 1.0, rng.randf() * 2.0 - 1.0) * SPEED;
+
+			RID body = server->body_create();
+			server->body_set_mode(body, PhysicsServer2D::BODY_MODE_RIGID);
+			server->body_add_shape(body, circle_shape);
+			server->body_set_space(body, space);
+			server->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0.0, position));
+			server->body_set_state(body, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY, velocity);
+			server->body_set_state(body, PhysicsServer2D::BODY_STATE_CAN_SLEEP, false);
+			bodies.push_back(body);
+		}
+	}
+
+	~BouncingCirclesScene() {
+		for (const RID &body : bodies) {
+			server->free_rid(body);
+		}
+		server->free_rid(circle_shape);
+		server->free_rid(horizontal_wall_shape);
+		server->free_rid(vertical_wall_shape);
+		server->free_rid(space);
+
+		server->finish();
+		memdelete(server);
+	}
+};
+
+static void step_bouncing_circles(BenchmarkState &p_state, int p_body_count) {
+	BouncingCirclesScene scene(p_body_count);
+	for (int i = 0; i < SETTLE_STEPS; i++) {
+		scene.step();
+	}
+
+	while (p_state.keep_running()) {
+		scene.step();
+	}
+	p_state.set_items_per_iteration(p_body_count);
+	p_state.set_counter("collision_pairs", scene.get_collision_pairs());
+}
+
+BENCHMARK_CASE("[Physics2D] Step 10000 bouncing circles") {
+	step_bouncing_circles(p_state, 10000);
+}
+
+BENCHMARK_CASE("[Physics2D] Step 100000 bouncing circles") {
+	step_bouncing_circles(p_state, 100000);
+}
+
+} // namespace GodotPhysics2DBenchmarks
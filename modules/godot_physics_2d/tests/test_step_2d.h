@@ -0,0 +1,161 @@
+/**************************************************************************/
+/*  test_step_2d.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_broad_phase_2d_bvh.h"
+#include "../godot_physics_server_2d.h"
+#include "../godot_space_2d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStep2D {
+
+static constexpr real_t STEP = 1.0 / 60.0;
+static constexpr int STEP_COUNT = 60;
+static constexpr int GRID_SIZE = 12;
+
+// Circles thrown at each other above a static floor. With 144 bodies, integration runs on the
+// WorkerThreadPool and every body is a changed broadphase item on the first steps.
+class CircleScene {
+	GodotPhysicsServer2D *server = nullptr;
+	RID space;
+	RID floor_shape;
+	RID circle_shape;
+	RID floor;
+	LocalVector<RID> circles;
+
+public:
+	LocalVector<int> collision_pairs;
+
+	void simulate() {
+		for (int i = 0; i < STEP_COUNT; i++) {
+			server->step(STEP);
+			collision_pairs.push_back(server->get_process_info(PhysicsServer2D::INFO_COLLISION_PAIRS));
+		}
+	}
+
+	uint32_t get_circle_count() const {
+		return circles.size();
+	}
+
+	Transform2D get_circle_transform(uint32_t p_index) const {
+		return server->body_get_state(circles[p_index], PhysicsServer2D::BODY_STATE_TRANSFORM);
+	}
+
+	Vector2 get_circle_linear_velocity(uint32_t p_index) const {
+		return server->body_get_state(circles[p_index], PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY);
+	}
+
+	real_t get_circle_angular_velocity(uint32_t p_index) const {
+		return server->body_get_state(circles[p_index], PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY);
+	}
+
+	explicit CircleScene(bool p_parallel_pair_checks) {
+		server = memnew(GodotPhysicsServer2D);
+		server->init();
+
+		space = server->space_create();
+		server->space_set_active(space, true);
+		GodotPhysicsDirectSpaceState2D *direct_state = static_cast<GodotPhysicsDirectSpaceState2D *>(server->space_get_direct_state(space));
+		static_cast<GodotBroadPhase2DBVH *>(direct_state->space->get_broadphase())->set_parallel_pair_checks(p_parallel_pair_checks);
+
+		floor_shape = server->rectangle_shape_create();
+		server->shape_set_data(floor_shape, Vector2(1000, 10));
+		circle_shape = server->circle_shape_create();
+		server->shape_set_data(circle_shape, 8.0);
+
+		// The top of the floor is at y = 0, and the circles are above it (negative y).
+		floor = server->body_create();
+		server->body_set_mode(floor, PhysicsServer2D::BODY_MODE_STATIC);
+		server->body_add_shape(floor, floor_shape);
+		server->body_set_space(floor, space);
+		server->body_set_state(floor, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0.0, Vector2(0, 10)));
+
+		const Vector2 center = Vector2(GRID_SIZE - 1, -(GRID_SIZE - 1)) * 10.0 - Vector2(0, 8);
+		for (int x = 0; x < GRID_SIZE; x++) {
+			for (int y = 0; y < GRID_SIZE; y++) {
+				const Vector2 position = Vector2(x * 20.0, -y * 20.0 - 8.0);
+				RID circle = server->body_create();
+				server->body_set_mode(circle, PhysicsServer2D::BODY_MODE_RIGID);
+				server->body_add_shape(circle, circle_shape);
+				server->body_set_space(circle, space);
+				server->body_set_state(circle, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0.0, position));
+				server->body_set_state(circle, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY, (center - position) * 2.0);
+				server->body_set_state(circle, PhysicsServer2D::BODY_STATE_CAN_SLEEP, false);
+				circles.push_back(circle);
+			}
+		}
+	}
+
+	~CircleScene() {
+		for (const RID &circle : circles) {
+			server->free_rid(circle);
+		}
+		server->free_rid(floor);
+		server->free_rid(circle_shape);
+		server->free_rid(floor_shape);
+		server->free_rid(space);
+
+		server->finish();
+		memdelete(server);
+	}
+};
+
+TEST_CASE("[Physics2D][GodotPhysics2D] Parallel pair checks don't change simulation results") {
+	CircleScene serial(false);
+	CircleScene parallel(true);
+
+	serial.simulate();
+	parallel.simulate();
+
+	int max_collision_pairs = 0;
+	for (int i = 0; i < STEP_COUNT; i++) {
+		CHECK_MESSAGE(parallel.collision_pairs[i] == serial.collision_pairs[i], vformat("Step %d should have %d collision pairs, not %d.", i, serial.collision_pairs[i], parallel.collision_pairs[i]));
+		max_collision_pairs = MAX(max_collision_pairs, serial.collision_pairs[i]);
+	}
+	CHECK_MESSAGE(max_collision_pairs > 0, "The circles should collide with each other.");
+
+	for (uint32_t i = 0; i < serial.get_circle_count(); i++) {
+		const Transform2D expected_transform = serial.get_circle_transform(i);
+		const Transform2D transform = parallel.get_circle_transform(i);
+		CHECK_MESSAGE(transform == expected_transform, vformat("Circle %d should end at %s, not %s.", i, expected_transform, transform));
+
+		const Vector2 expected_linear_velocity = serial.get_circle_linear_velocity(i);
+		const Vector2 linear_velocity = parallel.get_circle_linear_velocity(i);
+		CHECK_MESSAGE(linear_velocity == expected_linear_velocity, vformat("Circle %d should end with a linear velocity of %s, not %s.", i, expected_linear_velocity, linear_velocity));
+
+		const real_t expected_angular_velocity = serial.get_circle_angular_velocity(i);
+		const real_t angular_velocity = parallel.get_circle_angular_velocity(i);
+		CHECK_MESSAGE(angular_velocity == expected_angular_velocity, vformat("Circle %d should end with an angular velocity of %s, not %s.", i, expected_angular_velocity, angular_velocity));
+	}
+}
+
+} // namespace TestStep2D
@@ -665,7 +665,8 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 	biased_linear_velocity = Vector3();
 
 	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
+		_update_shapes_with_motion(motion, false);
+		deferred_broadphase_update = true;
 	}
 
 	contact_count = 0;
@@ -679,7 +680,7 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 	ERR_FAIL_NULL(get_space());
 
 	if (fi_callback_data || body_state_callback.is_valid()) {
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+		deferred_state_query = true;
 	}
 
 	//apply axis lock linear
@@ -702,7 +703,7 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 		_set_transform(new_transform, false);
 		_set_inv_transform(new_transform.affine_inverse());
 		if (contacts.is_empty() && linear_velocity == Vector3() && angular_velocity == Vector3()) {
-			set_active(false); //stopped moving, deactivate
+			deferred_deactivate = true; //stopped moving, deactivate
 		}
 
 		return;
@@ -731,12 +732,30 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 
 	transform_new.origin += total_linear_velocity * p_step;
 
-	_set_transform(transform_new);
+	_set_transform(transform_new, true, false);
+	deferred_broadphase_update = true;
 	_set_inv_transform(get_transform().inverse());
 
 	_update_transform_dependent();
 }
 
+void GodotBody3D::apply_deferred_updates() {
+	if (deferred_state_query) {
+		deferred_state_query = false;
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+
+	if (deferred_broadphase_update) {
+		deferred_broadphase_update = false;
+		_update_broadphase();
+	}
+
+	if (deferred_deactivate) {
+		deferred_deactivate = false;
+		set_active(false);
+	}
+}
+
 void GodotBody3D::wakeup_neighbours() {
 	for (const KeyValue<GodotConstraint3D *, int> &E : constraint_map) {
 		const GodotConstraint3D *c = E.key;
@@ -107,6 +107,11 @@ class GodotBody3D : public GodotCollisionObject3D {
 	bool can_sleep = true;
 	bool first_time_kinematic = false;
 
+	// Changes to the space left by integrate_forces() and integrate_velocities(), see apply_deferred_updates().
+	bool deferred_broadphase_update = false;
+	bool deferred_state_query = false;
+	bool deferred_deactivate = false;
+
 	void _mass_properties_changed();
 	virtual void _shapes_changed() override;
 	Transform3D new_transform;
@@ -145,6 +150,10 @@ class GodotBody3D : public GodotCollisionObject3D {
 
 	uint64_t island_step = 0;
 
+	// Slot in the GodotSolverBodies3D of the island being solved, only valid during solver_step.
+	uint64_t solver_step = 0;
+	uint32_t solver_index = 0;
+
 	void _update_transform_dependent();
 
 	friend class GodotPhysicsDirectBodyState3D; // i give up, too many functions to expose
@@ -195,6 +204,13 @@ public:
 	_FORCE_INLINE_ uint64_t get_island_step() const { return island_step; }
 	_FORCE_INLINE_ void set_island_step(uint64_t p_step) { island_step = p_step; }
 
+	_FORCE_INLINE_ bool has_solver_index(uint64_t p_step) const { return solver_step == p_step; }
+	_FORCE_INLINE_ uint32_t get_solver_index() const { return solver_index; }
+	_FORCE_INLINE_ void set_solver_index(uint64_t p_step, uint32_t p_index) {
+		solver_step = p_step;
+		solver_index = p_index;
+	}
+
 	_FORCE_INLINE_ void add_constraint(GodotConstraint3D *p_constraint, int p_pos) { constraint_map[p_constraint] = p_pos; }
 	_FORCE_INLINE_ void remove_constraint(GodotConstraint3D *p_constraint) { constraint_map.erase(p_constraint); }
 	const HashMap<GodotConstraint3D *, int> &get_constraint_map() const { return constraint_map; }
@@ -217,7 +233,10 @@ public:
 	_FORCE_INLINE_ Vector3 get_prev_linear_velocity() const { return prev_linear_velocity; }
 	_FORCE_INLINE_ Vector3 get_prev_angular_velocity() const { return prev_angular_velocity; }
 
+	_FORCE_INLINE_ void set_biased_linear_velocity(const Vector3 &p_velocity) { biased_linear_velocity = p_velocity; }
 	_FORCE_INLINE_ const Vector3 &get_biased_linear_velocity() const { return biased_linear_velocity; }
+
+	_FORCE_INLINE_ void set_biased_angular_velocity(const Vector3 &p_velocity) { biased_angular_velocity = p_velocity; }
 	_FORCE_INLINE_ const Vector3 &get_biased_angular_velocity() const { return biased_angular_velocity; }
 
 	_FORCE_INLINE_ void apply_central_impulse(const Vector3 &p_impulse) {
@@ -316,8 +335,11 @@ public:
 	void set_axis_lock(PhysicsServer3D::BodyAxis p_axis, bool lock);
 	bool is_axis_locked(PhysicsServer3D::BodyAxis p_axis) const;
 
+	// These only modify the body itself, so different bodies can be integrated in parallel.
+	// apply_deferred_updates() must be called afterwards, one body at a time.
 	void integrate_forces(real_t p_step);
 	void integrate_velocities(real_t p_step);
+	void apply_deferred_updates();
 
 	_FORCE_INLINE_ Vector3 get_velocity_in_local_point(const Vector3 &rel_pos) const {
 		return linear_velocity + angular_velocity.cross(rel_pos - center_of_mass);
@@ -35,9 +35,6 @@
 
 #include <cfloat> // FLT_MAX
 
-#define MIN_VELOCITY 0.0001
-#define MAX_BIAS_ROTATION (Math::PI / 8)
-
 void GodotBodyPair3D::_contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata) {
 	GodotBodyPair3D *pair = static_cast<GodotBodyPair3D *>(p_userdata);
 	pair->contact_added_callback(p_point_A, p_index_A, p_point_B, p_index_B, normal);
@@ -453,21 +450,39 @@ bool GodotBodyPair3D::pre_solve(real_t p_step) {
 	return do_process;
 }
 
+void GodotBodyPair3D::bind_solver_bodies(GodotSolverBodies3D *p_solver_bodies) {
+	solver_bodies = p_solver_bodies;
+	solver_index_A = p_solver_bodies->add_body(A);
+	solver_index_B = p_solver_bodies->add_body(B);
+}
+
 void GodotBodyPair3D::solve(real_t p_step) {
 	if (!collided) {
 		return;
 	}
 
+	DEV_ASSERT(solver_bodies);
+	GodotSolverBodies3D &bodies = *solver_bodies;
+
 	const real_t max_bias_av = MAX_BIAS_ROTATION / p_step;
 
 	Basis zero_basis;
 	zero_basis.set_zero();
 
-	const Basis &inv_inertia_tensor_A = collide_A ? A->get_inv_inertia_tensor() : zero_basis;
-	const Basis &inv_inertia_tensor_B = collide_B ? B->get_inv_inertia_tensor() : zero_basis;
+	const Basis &inv_inertia_tensor_A = collide_A ? bodies.inv_inertia_tensor[solver_index_A] : zero_basis;
+	const Basis &inv_inertia_tensor_B = collide_B ? bodies.inv_inertia_tensor[solver_index_B] : zero_basis;
 
-	real_t inv_mass_A = collide_A ? A->get_inv_mass() : 0.0;
-	real_t inv_mass_B = collide_B ? B->get_inv_mass() : 0.0;
+	real_t inv_mass_A = collide_A ? bodies.inv_mass[solver_index_A] : 0.0;
+	real_t inv_mass_B = collide_B ? bodies.inv_mass[solver_index_B] : 0.0;
+
+	const Vector3 &linear_velocity_A = bodies.linear_velocity[solver_index_A];
+	const Vector3 &linear_velocity_B = bodies.linear_velocity[solver_index_B];
+	const Vector3 &angular_velocity_A = bodies.angular_velocity[solver_index_A];
+	const Vector3 &angular_velocity_B = bodies.angular_velocity[solver_index_B];
+	const Vector3 &biased_linear_velocity_A = bodies.biased_linear_velocity[solver_index_A];
+	const Vector3 &biased_linear_velocity_B = bodies.biased_linear_velocity[solver_index_B];
+	const Vector3 &biased_angular_velocity_A = bodies.biased_angular_velocity[solver_index_A];
+	const Vector3 &biased_angular_velocity_B = bodies.biased_angular_velocity[solver_index_B];
 
 	for (int i = 0; i < contact_count; i++) {
 		Contact &c = contacts[i];
@@ -479,9 +494,9 @@ void GodotBodyPair3D::solve(real_t p_step) {
 
 		//bias impulse
 
-		Vector3 crbA = A->get_biased_angular_velocity().cross(c.rA);
-		Vector3 crbB = B->get_biased_angular_velocity().cross(c.rB);
-		Vector3 dbv = B->get_biased_linear_velocity() + crbB - A->get_biased_linear_velocity() - crbA;
+		Vector3 crbA = biased_angular_velocity_A.cross(c.rA);
+		Vector3 crbB = biased_angular_velocity_B.cross(c.rB);
+		Vector3 dbv = biased_linear_velocity_B + crbB - biased_linear_velocity_A - crbA;
 
 		real_t vbn = dbv.dot(c.normal);
 
@@ -493,15 +508,15 @@ void GodotBodyPair3D::solve(real_t p_step) {
 			Vector3 jb = c.normal * (c.acc_bias_impulse - jbnOld);
 
 			if (collide_A) {
-				A->apply_bias_impulse(-jb, c.rA + A->get_center_of_mass(), max_bias_av);
+				bodies.apply_bias_impulse(solver_index_A, -jb, c.rA, max_bias_av);
 			}
 			if (collide_B) {
-				B->apply_bias_impulse(jb, c.rB + B->get_center_of_mass(), max_bias_av);
+				bodies.apply_bias_impulse(solver_index_B, jb, c.rB, max_bias_av);
 			}
 
-			crbA = A->get_biased_angular_velocity().cross(c.rA);
-			crbB = B->get_biased_angular_velocity().cross(c.rB);
-			dbv = B->get_biased_linear_velocity() + crbB - A->get_biased_linear_velocity() - crbA;
+			crbA = biased_angular_velocity_A.cross(c.rA);
+			crbB = biased_angular_velocity_B.cross(c.rB);
+			dbv = biased_linear_velocity_B + crbB - biased_linear_velocity_A - crbA;
 
 			vbn = dbv.dot(c.normal);
 
@@ -513,19 +528,19 @@ void GodotBodyPair3D::solve(real_t p_step) {
 				Vector3 jb_com = c.normal * (c.acc_bias_impulse_center_of_mass - jbnOld_com);
 
 				if (collide_A) {
-					A->apply_bias_impulse(-jb_com, A->get_center_of_mass(), 0.0f);
+					bodies.apply_bias_impulse(solver_index_A, -jb_com, Vector3(), 0.0f);
 				}
 				if (collide_B) {
-					B->apply_bias_impulse(jb_com, B->get_center_of_mass(), 0.0f);
+					bodies.apply_bias_impulse(solver_index_B, jb_com, Vector3(), 0.0f);
 				}
 			}
 
 			c.active = true;
 		}
 
-		Vector3 crA = A->get_angular_velocity().cross(c.rA);
-		Vector3 crB = B->get_angular_velocity().cross(c.rB);
-		Vector3 dv = B->get_linear_velocity() + crB - A->get_linear_velocity() - crA;
+		Vector3 crA = angular_velocity_A.cross(c.rA);
+		Vector3 crB = angular_velocity_B.cross(c.rB);
+		Vector3 dv = linear_velocity_B + crB - linear_velocity_A - crA;
 
 		//normal impulse
 		real_t vn = dv.dot(c.normal);
@@ -538,10 +553,10 @@ void GodotBodyPair3D::solve(real_t p_step) {
 			Vector3 j = c.normal * (c.acc_normal_impulse - jnOld);
 
 			if (collide_A) {
-				A->apply_impulse(-j, c.rA + A->get_center_of_mass());
+				bodies.apply_impulse(solver_index_A, -j, c.rA);
 			}
 			if (collide_B) {
-				B->apply_impulse(j, c.rB + B->get_center_of_mass());
+				bodies.apply_impulse(solver_index_B, j, c.rB);
 			}
 			c.acc_impulse -= j;
 
@@ -552,8 +567,8 @@ void GodotBodyPair3D::solve(real_t p_step) {
 
 		real_t friction = combine_friction(A, B);
 
-		Vector3 lvA = A->get_linear_velocity() + A->get_angular_velocity().cross(c.rA);
-		Vector3 lvB = B->get_linear_velocity() + B->get_angular_velocity().cross(c.rB);
+		Vector3 lvA = linear_velocity_A + angular_velocity_A.cross(c.rA);
+		Vector3 lvB = linear_velocity_B + angular_velocity_B.cross(c.rB);
 
 		Vector3 dtv = lvB - lvA;
 		real_t tn = c.normal.dot(dtv);
@@ -585,10 +600,10 @@ void GodotBodyPair3D::solve(real_t p_step) {
 			jt = c.acc_tangent_impulse - jtOld;
 
 			if (collide_A) {
-				A->apply_impulse(-jt, c.rA + A->get_center_of_mass());
+				bodies.apply_impulse(solver_index_A, -jt, c.rA);
 			}
 			if (collide_B) {
-				B->apply_impulse(jt, c.rB + B->get_center_of_mass());
+				bodies.apply_impulse(solver_index_B, jt, c.rB);
 			}
 			c.acc_impulse -= jt;
 
@@ -606,6 +621,7 @@ GodotBodyPair3D::GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p
 	space = A->get_space();
 	A->add_constraint(this, 0);
 	B->add_constraint(this, 1);
+	set_using_solver_bodies(true);
 }
 
 GodotBodyPair3D::~GodotBodyPair3D() {
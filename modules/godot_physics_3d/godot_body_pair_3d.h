@@ -33,10 +33,15 @@
 #include "godot_body_3d.h"
 #include "godot_constraint_3d.h"
 #include "godot_soft_body_3d.h"
+#include "godot_solver_bodies_3d.h"
 
 #include "core/templates/local_vector.h"
 
 class GodotBodyContact3D : public GodotConstraint3D {
+public:
+	static constexpr real_t MIN_VELOCITY = 0.0001;
+	static constexpr real_t MAX_BIAS_ROTATION = Math::PI / 8;
+
 protected:
 	struct Contact {
 		Vector3 position;
@@ -69,7 +74,12 @@ protected:
 	}
 };
 
+real_t combine_bounce(GodotBody3D *A, GodotBody3D *B);
+real_t combine_friction(GodotBody3D *A, GodotBody3D *B);
+
 class GodotBodyPair3D : public GodotBodyContact3D {
+	friend class GodotContactBatchSolver3D;
+
 	enum {
 		MAX_CONTACTS = 4
 	};
@@ -96,6 +106,10 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	Contact contacts[MAX_CONTACTS];
 	int contact_count = 0;
 
+	GodotSolverBodies3D *solver_bodies = nullptr;
+	uint32_t solver_index_A = 0;
+	uint32_t solver_index_B = 0;
+
 	static void _contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata);
 
 	void contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal);
@@ -104,6 +118,9 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	bool _test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B);
 
 public:
+	virtual void bind_solver_bodies(GodotSolverBodies3D *p_solver_bodies) override;
+	virtual GodotBodyPair3D *get_body_pair() override { return this; }
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
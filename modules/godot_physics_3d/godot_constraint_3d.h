@@ -34,7 +34,9 @@
 #include "core/typedefs.h"
 
 class GodotBody3D;
+class GodotBodyPair3D;
 class GodotSoftBody3D;
+class GodotSolverBodies3D;
 
 class GodotConstraint3D {
 	GodotBody3D **_body_ptr;
@@ -42,6 +44,7 @@ class GodotConstraint3D {
 	uint64_t island_step;
 	int priority;
 	bool disabled_collisions_between_bodies;
+	bool using_solver_bodies;
 
 	RID self;
 
@@ -52,8 +55,11 @@ protected:
 		island_step = 0;
 		priority = 1;
 		disabled_collisions_between_bodies = true;
+		using_solver_bodies = false;
 	}
 
+	_FORCE_INLINE_ void set_using_solver_bodies(bool p_enable) { using_solver_bodies = p_enable; }
+
 public:
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
 	_FORCE_INLINE_ RID get_self() const { return self; }
@@ -73,6 +79,15 @@ public:
 	_FORCE_INLINE_ void disable_collisions_between_bodies(const bool p_disabled) { disabled_collisions_between_bodies = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled_collisions_between_bodies() const { return disabled_collisions_between_bodies; }
 
+	// Constraints using solver bodies read and write the velocities gathered for their island in
+	// solve(), instead of the bodies themselves. Others are solved on the bodies, which are kept
+	// in sync with the solver bodies around each call (see GodotStep3D::_solve_island()).
+	_FORCE_INLINE_ bool is_using_solver_bodies() const { return using_solver_bodies; }
+	virtual void bind_solver_bodies(GodotSolverBodies3D *p_solver_bodies) {}
+
+	// Contacts between two bodies, which can be solved in batches (see GodotContactBatchSolver3D).
+	virtual GodotBodyPair3D *get_body_pair() { return nullptr; }
+
 	virtual bool setup(real_t p_step) = 0;
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
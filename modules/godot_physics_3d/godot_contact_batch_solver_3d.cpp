@@ -0,0 +1,543 @@
+/**************************************************************************/
+/*  godot_contact_batch_solver_3d.cpp                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "godot_contact_batch_solver_3d.h"
+
+#include "core/object/worker_thread_pool.h"
+
+#if !defined(REAL_T_IS_DOUBLE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define CONTACT_BATCH_SSE2
+#include <emmintrin.h>
+#elif !defined(REAL_T_IS_DOUBLE) && (defined(__aarch64__) || defined(_M_ARM64))
+#define CONTACT_BATCH_NEON
+#include <arm_neon.h>
+#endif
+
+// Below this, solving the batches of a color on the calling thread is faster than dispatching tasks.
+#define PARALLEL_BATCH_MIN_COUNT 32
+
+namespace ContactBatchSIMD {
+
+static_assert(GodotContactBatchSolver3D::LANE_COUNT == 4);
+
+// One value per lane. Masked lanes can hold anything (including NaN), so every result
+// written back to the contacts or bodies goes through select() first.
+#if defined(CONTACT_BATCH_SSE2)
+
+struct Real4 {
+	__m128 v;
+};
+
+struct Mask4 {
+	__m128 v;
+};
+
+_FORCE_INLINE_ Real4 load(const real_t *p_values) { return { _mm_loadu_ps(p_values) }; }
+_FORCE_INLINE_ void store(real_t *r_values, const Real4 &p_a) { _mm_storeu_ps(r_values, p_a.v); }
+_FORCE_INLINE_ Real4 splat(real_t p_value) { return { _mm_set1_ps(p_value) }; }
+
+_FORCE_INLINE_ Real4 operator+(const Real4 &p_a, const Real4 &p_b) { return { _mm_add_ps(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Real4 operator-(const Real4 &p_a, const Real4 &p_b) { return { _mm_sub_ps(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Real4 operator*(const Real4 &p_a, const Real4 &p_b) { return { _mm_mul_ps(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Real4 operator/(const Real4 &p_a, const Real4 &p_b) { return { _mm_div_ps(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Real4 operator-(const Real4 &p_a) { return { _mm_xor_ps(p_a.v, _mm_set1_ps(-0.0f)) }; }
+
+// Same as MAX(p_a, p_b).
+_FORCE_INLINE_ Real4 lanes_max(const Real4 &p_a, const Real4 &p_b) { return { _mm_max_ps(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Real4 lanes_abs(const Real4 &p_a) { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), p_a.v) }; }
+_FORCE_INLINE_ Real4 lanes_sqrt(const Real4 &p_a) { return { _mm_sqrt_ps(p_a.v) }; }
+
+_FORCE_INLINE_ Mask4 operator>(const Real4 &p_a, const Real4 &p_b) { return { _mm_cmpgt_ps(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Mask4 operator&(const Mask4 &p_a, const Mask4 &p_b) { return { _mm_and_ps(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Mask4 operator|(const Mask4 &p_a, const Mask4 &p_b) { return { _mm_or_ps(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ bool any(const Mask4 &p_mask) { return _mm_movemask_ps(p_mask.v) != 0; }
+
+_FORCE_INLINE_ Real4 select(const Mask4 &p_mask, const Real4 &p_a, const Real4 &p_b) {
+	return { _mm_or_ps(_mm_and_ps(p_mask.v, p_a.v), _mm_andnot_ps(p_mask.v, p_b.v)) };
+}
+
+#elif defined(CONTACT_BATCH_NEON)
+
+struct Real4 {
+	float32x4_t v;
+};
+
+struct Mask4 {
+	uint32x4_t v;
+};
+
+_FORCE_INLINE_ Real4 load(const real_t *p_values) { return { vld1q_f32(p_values) }; }
+_FORCE_INLINE_ void store(real_t *r_values, const Real4 &p_a) { vst1q_f32(r_values, p_a.v); }
+_FORCE_INLINE_ Real4 splat(real_t p_value) { return { vdupq_n_f32(p_value) }; }
+
+_FORCE_INLINE_ Real4 operator+(const Real4 &p_a, const Real4 &p_b) { return { vaddq_f32(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Real4 operator-(const Real4 &p_a, const Real4 &p_b) { return { vsubq_f32(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Real4 operator*(const Real4 &p_a, const Real4 &p_b) { return { vmulq_f32(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Real4 operator/(const Real4 &p_a, const Real4 &p_b) { return { vdivq_f32(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Real4 operator-(const Real4 &p_a) { return { vnegq_f32(p_a.v) }; }
+
+// Same as MAX(p_a, p_b), vmaxq_f32() differs for signed zeros and NaN.
+_FORCE_INLINE_ Real4 lanes_max(const Real4 &p_a, const Real4 &p_b) { return { vbslq_f32(vcgtq_f32(p_a.v, p_b.v), p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Real4 lanes_abs(const Real4 &p_a) { return { vabsq_f32(p_a.v) }; }
+_FORCE_INLINE_ Real4 lanes_sqrt(const Real4 &p_a) { return { vsqrtq_f32(p_a.v) }; }
+
+_FORCE_INLINE_ Mask4 operator>(const Real4 &p_a, const Real4 &p_b) { return { vcgtq_f32(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Mask4 operator&(const Mask4 &p_a, const Mask4 &p_b) { return { vandq_u32(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ Mask4 operator|(const Mask4 &p_a, const Mask4 &p_b) { return { vorrq_u32(p_a.v, p_b.v) }; }
+_FORCE_INLINE_ bool any(const Mask4 &p_mask) { return vmaxvq_u32(p_mask.v) != 0; }
+
+_FORCE_INLINE_ Real4 select(const Mask4 &p_mask, const Real4 &p_a, const Real4 &p_b) { return { vbslq_f32(p_mask.v, p_a.v, p_b.v) }; }
+
+#else
+
+// Portable fallback, also used with double precision.
+struct Real4 {
+	real_t v[4];
+};
+
+struct Mask4 {
+	bool v[4];
+};
+
+#define CONTACT_BATCH_LANE_OP(m_type, m_expression) \
+	m_type result;                                  \
+	for (int i = 0; i < 4; i++) {                   \
+		result.v[i] = m_expression;                 \
+	}                                               \
+	return result;
+
+_FORCE_INLINE_ Real4 load(const real_t *p_values) { return { { p_values[0], p_values[1], p_values[2], p_values[3] } }; }
+_FORCE_INLINE_ void store(real_t *r_values, const Real4 &p_a) {
+	for (int i = 0; i < 4; i++) {
+		r_values[i] = p_a.v[i];
+	}
+}
+_FORCE_INLINE_ Real4 splat(real_t p_value) { return { { p_value, p_value, p_value, p_value } }; }
+
+_FORCE_INLINE_ Real4 operator+(const Real4 &p_a, const Real4 &p_b) { CONTACT_BATCH_LANE_OP(Real4, p_a.v[i] + p_b.v[i]) }
+_FORCE_INLINE_ Real4 operator-(const Real4 &p_a, const Real4 &p_b) { CONTACT_BATCH_LANE_OP(Real4, p_a.v[i] - p_b.v[i]) }
+_FORCE_INLINE_ Real4 operator*(const Real4 &p_a, const Real4 &p_b) { CONTACT_BATCH_LANE_OP(Real4, p_a.v[i] * p_b.v[i]) }
+_FORCE_INLINE_ Real4 operator/(const Real4 &p_a, const Real4 &p_b) { CONTACT_BATCH_LANE_OP(Real4, p_a.v[i] / p_b.v[i]) }
+_FORCE_INLINE_ Real4 operator-(const Real4 &p_a) { CONTACT_BATCH_LANE_OP(Real4, -p_a.v[i]) }
+
+_FORCE_INLINE_ Real4 lanes_max(const Real4 &p_a, const Real4 &p_b) { CONTACT_BATCH_LANE_OP(Real4, MAX(p_a.v[i], p_b.v[i])) }
+_FORCE_INLINE_ Real4 lanes_abs(const Real4 &p_a) { CONTACT_BATCH_LANE_OP(Real4, Math::abs(p_a.v[i])) }
+_FORCE_INLINE_ Real4 lanes_sqrt(const Real4 &p_a) { CONTACT_BATCH_LANE_OP(Real4, Math::sqrt(p_a.v[i])) }
+
+_FORCE_INLINE_ Mask4 operator>(const Real4 &p_a, const Real4 &p_b) { CONTACT_BATCH_LANE_OP(Mask4, p_a.v[i] > p_b.v[i]) }
+_FORCE_INLINE_ Mask4 operator&(const Mask4 &p_a, const Mask4 &p_b) { CONTACT_BATCH_LANE_OP(Mask4, p_a.v[i] && p_b.v[i]) }
+_FORCE_INLINE_ Mask4 operator|(const Mask4 &p_a, const Mask4 &p_b) { CONTACT_BATCH_LANE_OP(Mask4, p_a.v[i] || p_b.v[i]) }
+_FORCE_INLINE_ bool any(const Mask4 &p_mask) { return p_mask.v[0] || p_mask.v[1] || p_mask.v[2] || p_mask.v[3]; }
+
+_FORCE_INLINE_ Real4 select(const Mask4 &p_mask, const Real4 &p_a, const Real4 &p_b) { CONTACT_BATCH_LANE_OP(Real4, p_mask.v[i] ? p_a.v[i] : p_b.v[i]) }
+
+#undef CONTACT_BATCH_LANE_OP
+
+#endif
+
+// Same operations as Vector3 and Basis, in the same order so that each lane gets the same result as the scalar solver.
+struct Vector3x4 {
+	Real4 x, y, z;
+
+	_FORCE_INLINE_ Vector3x4 operator+(const Vector3x4 &p_v) const { return { x + p_v.x, y + p_v.y, z + p_v.z }; }
+	_FORCE_INLINE_ Vector3x4 operator-(const Vector3x4 &p_v) const { return { x - p_v.x, y - p_v.y, z - p_v.z }; }
+	_FORCE_INLINE_ Vector3x4 operator*(const Real4 &p_scalar) const { return { x * p_scalar, y * p_scalar, z * p_scalar }; }
+	_FORCE_INLINE_ Vector3x4 operator/(const Real4 &p_scalar) const { return { x / p_scalar, y / p_scalar, z / p_scalar }; }
+	_FORCE_INLINE_ Vector3x4 operator-() const { return { -x, -y, -z }; }
+
+	_FORCE_INLINE_ Real4 dot(const Vector3x4 &p_with) const { return x * p_with.x + y * p_with.y + z * p_with.z; }
+	_FORCE_INLINE_ Vector3x4 cross(const Vector3x4 &p_with) const {
+		return {
+			(y * p_with.z) - (z * p_with.y),
+			(z * p_with.x) - (x * p_with.z),
+			(x * p_with.y) - (y * p_with.x)
+		};
+	}
+	_FORCE_INLINE_ Real4 length() const { return lanes_sqrt(x * x + y * y + z * z); }
+};
+
+struct Basis3x4 {
+	Vector3x4 rows[3];
+
+	_FORCE_INLINE_ Vector3x4 xform(const Vector3x4 &p_vector) const { return { rows[0].dot(p_vector), rows[1].dot(p_vector), rows[2].dot(p_vector) }; }
+};
+
+_FORCE_INLINE_ Vector3x4 select(const Mask4 &p_mask, const Vector3x4 &p_a, const Vector3x4 &p_b) {
+	return { select(p_mask, p_a.x, p_b.x), select(p_mask, p_a.y, p_b.y), select(p_mask, p_a.z, p_b.z) };
+}
+
+_FORCE_INLINE_ Vector3x4 load(const GodotContactBatchSolver3D::Vector3Lanes &p_lanes) { return { load(p_lanes.x), load(p_lanes.y), load(p_lanes.z) }; }
+
+_FORCE_INLINE_ void store(GodotContactBatchSolver3D::Vector3Lanes &r_lanes, const Vector3x4 &p_value) {
+	store(r_lanes.x, p_value.x);
+	store(r_lanes.y, p_value.y);
+	store(r_lanes.z, p_value.z);
+}
+
+_FORCE_INLINE_ Basis3x4 load(const GodotContactBatchSolver3D::Vector3Lanes *p_rows) { return { { load(p_rows[0]), load(p_rows[1]), load(p_rows[2]) } }; }
+
+_FORCE_INLINE_ Vector3x4 gather(const LocalVector<Vector3> &p_vectors, const uint32_t *p_indices) {
+	GodotContactBatchSolver3D::Vector3Lanes lanes;
+	for (uint32_t i = 0; i < 4; i++) {
+		lanes.set(i, p_vectors[p_indices[i]]);
+	}
+	return load(lanes);
+}
+
+_FORCE_INLINE_ void scatter(LocalVector<Vector3> &r_vectors, const uint32_t *p_indices, uint32_t p_count, const Vector3x4 &p_value) {
+	GodotContactBatchSolver3D::Vector3Lanes lanes;
+	store(lanes, p_value);
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_vectors[p_indices[i]] = lanes.get(i);
+	}
+}
+
+// Same as GodotSolverBodies3D::apply_impulse() and apply_bias_impulse(), for bodies with
+// a zero inverse mass and inertia when the pair doesn't apply impulses to them.
+_FORCE_INLINE_ void apply_impulse(Vector3x4 &r_linear_velocity, Vector3x4 &r_angular_velocity, const Vector3x4 &p_impulse, const Vector3x4 &p_offset, const Real4 &p_inv_mass, const Basis3x4 &p_inv_inertia_tensor) {
+	r_linear_velocity = r_linear_velocity + p_impulse * p_inv_mass;
+	r_angular_velocity = r_angular_velocity + p_inv_inertia_tensor.xform(p_offset.cross(p_impulse));
+}
+
+_FORCE_INLINE_ void apply_bias_impulse(Vector3x4 &r_linear_velocity, Vector3x4 &r_angular_velocity, const Vector3x4 &p_impulse, const Vector3x4 &p_offset, const Real4 &p_inv_mass, const Basis3x4 &p_inv_inertia_tensor, const Real4 &p_max_delta_av) {
+	r_linear_velocity = r_linear_velocity + p_impulse * p_inv_mass;
+	Vector3x4 delta_av = p_inv_inertia_tensor.xform(p_offset.cross(p_impulse));
+	const Real4 delta_av_length = delta_av.length();
+	delta_av = select(delta_av_length > p_max_delta_av, (delta_av / delta_av_length) * p_max_delta_av, delta_av);
+	r_angular_velocity = r_angular_velocity + delta_av;
+}
+
+} // namespace ContactBatchSIMD
+
+void GodotContactBatchSolver3D::_fill_batch(Batch &r_batch, GodotBodyPair3D *const *p_pairs, uint32_t p_pair_count, const GodotSolverBodies3D &p_bodies) const {
+	r_batch.lane_count = p_pair_count;
+
+	for (uint32_t lane = 0; lane < LANE_COUNT; lane++) {
+		if (lane >= p_pair_count) {
+			// Padding lanes read the bodies of the first pair, but have no active contacts and aren't written back.
+			r_batch.index_A[lane] = r_batch.index_A[0];
+			r_batch.index_B[lane] = r_batch.index_B[0];
+			continue;
+		}
+
+		GodotBodyPair3D *pair = p_pairs[lane];
+		r_batch.pairs[lane] = pair;
+		r_batch.index_A[lane] = pair->solver_index_A;
+		r_batch.index_B[lane] = pair->solver_index_B;
+
+		if (pair->collide_A) {
+			r_batch.inv_mass_A[lane] = p_bodies.inv_mass[pair->solver_index_A];
+			const Basis &inv_inertia_tensor = p_bodies.inv_inertia_tensor[pair->solver_index_A];
+			for (int row = 0; row < 3; row++) {
+				r_batch.inv_inertia_tensor_A[row].set(lane, inv_inertia_tensor.rows[row]);
+			}
+		}
+		if (pair->collide_B) {
+			r_batch.inv_mass_B[lane] = p_bodies.inv_mass[pair->solver_index_B];
+			const Basis &inv_inertia_tensor = p_bodies.inv_inertia_tensor[pair->solver_index_B];
+			for (int row = 0; row < 3; row++) {
+				r_batch.inv_inertia_tensor_B[row].set(lane, inv_inertia_tensor.rows[row]);
+			}
+		}
+		r_batch.friction[lane] = combine_friction(pair->A, pair->B);
+
+		r_batch.contact_count = MAX(r_batch.contact_count, pair->contact_count);
+		for (int i = 0; i < pair->contact_count; i++) {
+			const GodotBodyPair3D::Contact &c = pair->contacts[i];
+			ContactLanes &lanes = r_batch.contacts[i];
+			lanes.rA.set(lane, c.rA);
+			lanes.rB.set(lane, c.rB);
+			lanes.normal.set(lane, c.normal);
+			lanes.acc_impulse.set(lane, c.acc_impulse);
+			lanes.acc_tangent_impulse.set(lane, c.acc_tangent_impulse);
+			lanes.acc_normal_impulse[lane] = c.acc_normal_impulse;
+			lanes.acc_bias_impulse[lane] = c.acc_bias_impulse;
+			lanes.acc_bias_impulse_center_of_mass[lane] = c.acc_bias_impulse_center_of_mass;
+			lanes.mass_normal[lane] = c.mass_normal;
+			lanes.bias[lane] = c.bias;
+			lanes.bounce[lane] = c.bounce;
+			lanes.active[lane] = c.active ? 1.0 : 0.0;
+		}
+	}
+}
+
+void GodotContactBatchSolver3D::_solve_batch(Batch &r_batch, GodotSolverBodies3D &p_bodies, real_t p_step) {
+	using namespace ContactBatchSIMD;
+
+	const Real4 zero = splat(0.0);
+	const Real4 one = splat(1.0);
+	const Real4 half = splat(0.5);
+	const Real4 min_velocity = splat(GodotBodyContact3D::MIN_VELOCITY);
+	const Real4 max_bias_av = splat(GodotBodyContact3D::MAX_BIAS_ROTATION / p_step);
+	const Real4 cmp_epsilon = splat(CMP_EPSILON);
+
+	const Real4 inv_mass_A = load(r_batch.inv_mass_A);
+	const Real4 inv_mass_B = load(r_batch.inv_mass_B);
+	const Basis3x4 inv_inertia_tensor_A = load(r_batch.inv_inertia_tensor_A);
+	const Basis3x4 inv_inertia_tensor_B = load(r_batch.inv_inertia_tensor_B);
+	const Real4 friction = load(r_batch.friction);
+
+	Vector3x4 linear_velocity_A = gather(p_bodies.linear_velocity, r_batch.index_A);
+	Vector3x4 linear_velocity_B = gather(p_bodies.linear_velocity, r_batch.index_B);
+	Vector3x4 angular_velocity_A = gather(p_bodies.angular_velocity, r_batch.index_A);
+	Vector3x4 angular_velocity_B = gather(p_bodies.angular_velocity, r_batch.index_B);
+	Vector3x4 biased_linear_velocity_A = gather(p_bodies.biased_linear_velocity, r_batch.index_A);
+	Vector3x4 biased_linear_velocity_B = gather(p_bodies.biased_linear_velocity, r_batch.index_B);
+	Vector3x4 biased_angular_velocity_A = gather(p_bodies.biased_angular_velocity, r_batch.index_A);
+	Vector3x4 biased_angular_velocity_B = gather(p_bodies.biased_angular_velocity, r_batch.index_B);
+
+	for (int i = 0; i < r_batch.contact_count; i++) {
+		ContactLanes &c = r_batch.contacts[i];
+
+		const Real4 was_active = load(c.active);
+		const Mask4 active = was_active > half;
+		if (!any(active)) {
+			continue;
+		}
+
+		const Vector3x4 rA = load(c.rA);
+		const Vector3x4 rB = load(c.rB);
+		const Vector3x4 normal = load(c.normal);
+		const Real4 mass_normal = load(c.mass_normal);
+		Vector3x4 acc_impulse = load(c.acc_impulse);
+
+		// Bias impulse.
+
+		Vector3x4 crbA = biased_angular_velocity_A.cross(rA);
+		Vector3x4 crbB = biased_angular_velocity_B.cross(rB);
+		Vector3x4 dbv = biased_linear_velocity_B + crbB - biased_linear_velocity_A - crbA;
+
+		const Real4 bias = load(c.bias);
+		Real4 vbn = dbv.dot(normal);
+
+		const Mask4 apply_bias = active & (lanes_abs(-vbn + bias) > min_velocity);
+		if (any(apply_bias)) {
+			const Real4 jbn = (-vbn + bias) * mass_normal;
+			const Real4 jbn_old = load(c.acc_bias_impulse);
+			const Real4 acc_bias_impulse = select(apply_bias, lanes_max(jbn_old + jbn, zero), jbn_old);
+			store(c.acc_bias_impulse, acc_bias_impulse);
+
+			const Vector3x4 jb = normal * (acc_bias_impulse - jbn_old);
+
+			apply_bias_impulse(biased_linear_velocity_A, biased_angular_velocity_A, -jb, rA, inv_mass_A, inv_inertia_tensor_A, max_bias_av);
+			apply_bias_impulse(biased_linear_velocity_B, biased_angular_velocity_B, jb, rB, inv_mass_B, inv_inertia_tensor_B, max_bias_av);
+
+			crbA = biased_angular_velocity_A.cross(rA);
+			crbB = biased_angular_velocity_B.cross(rB);
+			dbv = biased_linear_velocity_B + crbB - biased_linear_velocity_A - crbA;
+
+			vbn = dbv.dot(normal);
+
+			const Mask4 apply_bias_center_of_mass = apply_bias & (lanes_abs(-vbn + bias) > min_velocity);
+			const Real4 jbn_com = (-vbn + bias) / (inv_mass_A + inv_mass_B);
+			const Real4 jbn_old_com = load(c.acc_bias_impulse_center_of_mass);
+			const Real4 acc_bias_impulse_center_of_mass = select(apply_bias_center_of_mass, lanes_max(jbn_old_com + jbn_com, zero), jbn_old_com);
+			store(c.acc_bias_impulse_center_of_mass, acc_bias_impulse_center_of_mass);
+
+			const Vector3x4 jb_com = normal * (acc_bias_impulse_center_of_mass - jbn_old_com);
+
+			biased_linear_velocity_A = biased_linear_velocity_A + (-jb_com) * inv_mass_A;
+			biased_linear_velocity_B = biased_linear_velocity_B + jb_com * inv_mass_B;
+		}
+
+		// Normal impulse.
+
+		const Vector3x4 crA = angular_velocity_A.cross(rA);
+		const Vector3x4 crB = angular_velocity_B.cross(rB);
+		const Vector3x4 dv = linear_velocity_B + crB - linear_velocity_A - crA;
+
+		const Real4 vn = dv.dot(normal);
+
+		const Mask4 apply_normal = active & (lanes_abs(vn) > min_velocity);
+		const Real4 jn = -(load(c.bounce) + vn) * mass_normal;
+		const Real4 jn_old = load(c.acc_normal_impulse);
+		const Real4 acc_normal_impulse = select(apply_normal, lanes_max(jn_old + jn, zero), jn_old);
+		store(c.acc_normal_impulse, acc_normal_impulse);
+
+		const Vector3x4 j = normal * (acc_normal_impulse - jn_old);
+
+		apply_impulse(linear_velocity_A, angular_velocity_A, -j, rA, inv_mass_A, inv_inertia_tensor_A);
+		apply_impulse(linear_velocity_B, angular_velocity_B, j, rB, inv_mass_B, inv_inertia_tensor_B);
+		acc_impulse = acc_impulse - j;
+
+		// Friction impulse.
+
+		const Vector3x4 lvA = linear_velocity_A + angular_velocity_A.cross(rA);
+		const Vector3x4 lvB = linear_velocity_B + angular_velocity_B.cross(rB);
+
+		const Vector3x4 dtv = lvB - lvA;
+		const Real4 tn = normal.dot(dtv);
+
+		// Tangential velocity.
+		Vector3x4 tv = dtv - normal * tn;
+		const Real4 tvl = tv.length();
+
+		const Mask4 apply_friction = active & (tvl > min_velocity);
+		if (any(apply_friction)) {
+			tv = tv / tvl;
+
+			const Vector3x4 temp1 = inv_inertia_tensor_A.xform(rA.cross(tv));
+			const Vector3x4 temp2 = inv_inertia_tensor_B.xform(rB.cross(tv));
+
+			const Real4 t = -tvl / (inv_mass_A + inv_mass_B + tv.dot(temp1.cross(rA) + temp2.cross(rB)));
+
+			const Vector3x4 jt_old = load(c.acc_tangent_impulse);
+			Vector3x4 acc_tangent_impulse = jt_old + tv * t;
+
+			const Real4 fi_len = acc_tangent_impulse.length();
+			const Real4 jt_max = acc_normal_impulse * friction;
+
+			acc_tangent_impulse = select((fi_len > cmp_epsilon) & (fi_len > jt_max), acc_tangent_impulse * (jt_max / fi_len), acc_tangent_impulse);
+			acc_tangent_impulse = select(apply_friction, acc_tangent_impulse, jt_old);
+			store(c.acc_tangent_impulse, acc_tangent_impulse);
+
+			const Vector3x4 jt = acc_tangent_impulse - jt_old;
+
+			apply_impulse(linear_velocity_A, angular_velocity_A, -jt, rA, inv_mass_A, inv_inertia_tensor_A);
+			apply_impulse(linear_velocity_B, angular_velocity_B, jt, rB, inv_mass_B, inv_inertia_tensor_B);
+			acc_impulse = acc_impulse - jt;
+		}
+
+		store(c.acc_impulse, acc_impulse);
+
+		// Contacts stay active only if they applied an impulse, like in GodotBodyPair3D::solve().
+		const Mask4 applied = apply_bias | apply_normal | apply_friction;
+		store(c.active, select(active, select(applied, one, zero), was_active));
+	}
+
+	const uint32_t lane_count = r_batch.lane_count;
+	scatter(p_bodies.linear_velocity, r_batch.index_A, lane_count, linear_velocity_A);
+	scatter(p_bodies.linear_velocity, r_batch.index_B, lane_count, linear_velocity_B);
+	scatter(p_bodies.angular_velocity, r_batch.index_A, lane_count, angular_velocity_A);
+	scatter(p_bodies.angular_velocity, r_batch.index_B, lane_count, angular_velocity_B);
+	scatter(p_bodies.biased_linear_velocity, r_batch.index_A, lane_count, biased_linear_velocity_A);
+	scatter(p_bodies.biased_linear_velocity, r_batch.index_B, lane_count, biased_linear_velocity_B);
+	scatter(p_bodies.biased_angular_velocity, r_batch.index_A, lane_count, biased_angular_velocity_A);
+	scatter(p_bodies.biased_angular_velocity, r_batch.index_B, lane_count, biased_angular_velocity_B);
+}
+
+void GodotContactBatchSolver3D::_solve_batch_task(uint32_t p_batch_index, void *p_userdata) {
+	_solve_batch(batches[task_batch_offset + p_batch_index], *task_bodies, task_step);
+}
+
+void GodotContactBatchSolver3D::setup(LocalVector<GodotConstraint3D *> &p_constraint_island, const GodotSolverBodies3D &p_bodies) {
+	batches.clear();
+	color_batch_ends.clear();
+	for (LocalVector<GodotBodyPair3D *> &pairs : color_pairs) {
+		pairs.clear();
+	}
+
+	body_colors.resize(p_bodies.linear_velocity.size());
+	for (uint64_t &colors : body_colors) {
+		colors = 0;
+	}
+
+	// Greedy coloring: each pair gets the first color none of its bodies uses yet.
+	uint32_t color_count = 0;
+	uint32_t remaining_count = 0;
+	for (GodotConstraint3D *constraint : p_constraint_island) {
+		GodotBodyPair3D *pair = constraint->get_body_pair();
+		if (pair && pair->collided && pair->contact_count > 0) {
+			uint64_t &colors_A = body_colors[pair->solver_index_A];
+			uint64_t &colors_B = body_colors[pair->solver_index_B];
+			const uint64_t used_colors = colors_A | colors_B;
+
+			uint32_t color = 0;
+			while (color < MAX_COLORS && (used_colors & (uint64_t(1) << color))) {
+				color++;
+			}
+
+			if (color < MAX_COLORS) {
+				colors_A |= uint64_t(1) << color;
+				colors_B |= uint64_t(1) << color;
+				color_pairs[color].push_back(pair);
+				color_count = MAX(color_count, color + 1);
+				continue;
+			}
+		}
+
+		// Keep this constraint for the scalar solver.
+		p_constraint_island[remaining_count++] = constraint;
+	}
+	p_constraint_island.resize(remaining_count);
+
+	uint32_t batch_count = 0;
+	for (uint32_t color = 0; color < color_count; color++) {
+		batch_count += (color_pairs[color].size() + LANE_COUNT - 1) / LANE_COUNT;
+	}
+	batches.resize(batch_count);
+
+	uint32_t batch_index = 0;
+	for (uint32_t color = 0; color < color_count; color++) {
+		const LocalVector<GodotBodyPair3D *> &pairs = color_pairs[color];
+		for (uint32_t pair_index = 0; pair_index < pairs.size(); pair_index += LANE_COUNT) {
+			_fill_batch(batches[batch_index++], pairs.ptr() + pair_index, MIN(LANE_COUNT, pairs.size() - pair_index), p_bodies);
+		}
+		color_batch_ends.push_back(batch_index);
+	}
+}
+
+void GodotContactBatchSolver3D::solve(GodotSolverBodies3D &p_bodies, real_t p_step, bool p_parallel) {
+	// Colors are solved one after the other, the batches of a color don't share any body.
+	uint32_t batch_begin = 0;
+	for (uint32_t batch_end : color_batch_ends) {
+		const uint32_t batch_count = batch_end - batch_begin;
+		if (p_parallel && batch_count >= PARALLEL_BATCH_MIN_COUNT) {
+			task_bodies = &p_bodies;
+			task_batch_offset = batch_begin;
+			task_step = p_step;
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotContactBatchSolver3D::_solve_batch_task, nullptr, batch_count, -1, true, SNAME("Physics3DSolveContactBatches"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			for (uint32_t batch_index = batch_begin; batch_index < batch_end; batch_index++) {
+				_solve_batch(batches[batch_index], p_bodies, p_step);
+			}
+		}
+		batch_begin = batch_end;
+	}
+}
+
+void GodotContactBatchSolver3D::finish() {
+	for (const Batch &batch : batches) {
+		for (uint32_t lane = 0; lane < batch.lane_count; lane++) {
+			GodotBodyPair3D *pair = batch.pairs[lane];
+			for (int i = 0; i < pair->contact_count; i++) {
+				GodotBodyPair3D::Contact &c = pair->contacts[i];
+				const ContactLanes &lanes = batch.contacts[i];
+				c.acc_impulse = lanes.acc_impulse.get(lane);
+				c.acc_normal_impulse = lanes.acc_normal_impulse[lane];
+				c.acc_tangent_impulse = lanes.acc_tangent_impulse.get(lane);
+				c.acc_bias_impulse = lanes.acc_bias_impulse[lane];
+				c.acc_bias_impulse_center_of_mass = lanes.acc_bias_impulse_center_of_mass[lane];
+				c.active = lanes.active[lane] != 0.0;
+			}
+		}
+	}
+}
@@ -0,0 +1,124 @@
+/**************************************************************************/
+/*  godot_contact_batch_solver_3d.h                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "godot_body_pair_3d.h"
+#include "godot_solver_bodies_3d.h"
+
+#include "core/templates/local_vector.h"
+
+// Solves the contacts of body pairs in an island several pairs at a time, using SIMD instructions.
+//
+// Pairs are colored so that no two pairs of the same color share a body, then the pairs of each
+// color are split into batches of LANE_COUNT pairs, one per SIMD lane. Batches of the same color
+// are independent from each other, so large colors can also be solved on multiple threads.
+//
+// The math is the same as GodotBodyPair3D::solve(), which stays the reference implementation;
+// only the order in which pairs are solved differs.
+class GodotContactBatchSolver3D {
+public:
+	static constexpr uint32_t LANE_COUNT = 4;
+
+	struct Vector3Lanes {
+		real_t x[LANE_COUNT] = {};
+		real_t y[LANE_COUNT] = {};
+		real_t z[LANE_COUNT] = {};
+
+		_FORCE_INLINE_ Vector3 get(uint32_t p_lane) const { return Vector3(x[p_lane], y[p_lane], z[p_lane]); }
+		_FORCE_INLINE_ void set(uint32_t p_lane, const Vector3 &p_value) {
+			x[p_lane] = p_value.x;
+			y[p_lane] = p_value.y;
+			z[p_lane] = p_value.z;
+		}
+	};
+
+private:
+	// Bodies only get 64 colors, pairs which don't fit are solved one by one instead.
+	static constexpr uint32_t MAX_COLORS = 64;
+	static constexpr int MAX_CONTACTS = GodotBodyPair3D::MAX_CONTACTS;
+
+	struct ContactLanes {
+		Vector3Lanes rA;
+		Vector3Lanes rB;
+		Vector3Lanes normal;
+		Vector3Lanes acc_impulse;
+		Vector3Lanes acc_tangent_impulse;
+		real_t acc_normal_impulse[LANE_COUNT] = {};
+		real_t acc_bias_impulse[LANE_COUNT] = {};
+		real_t acc_bias_impulse_center_of_mass[LANE_COUNT] = {};
+		real_t mass_normal[LANE_COUNT] = {};
+		real_t bias[LANE_COUNT] = {};
+		real_t bounce[LANE_COUNT] = {};
+		real_t active[LANE_COUNT] = {}; // 1 if active, 0 otherwise (including missing contacts).
+	};
+
+	struct Batch {
+		GodotBodyPair3D *pairs[LANE_COUNT] = {};
+		uint32_t index_A[LANE_COUNT] = {};
+		uint32_t index_B[LANE_COUNT] = {};
+		uint32_t lane_count = 0;
+		int contact_count = 0; // Highest contact count of the pairs.
+
+		// Zero for bodies the pair doesn't apply impulses to.
+		real_t inv_mass_A[LANE_COUNT] = {};
+		real_t inv_mass_B[LANE_COUNT] = {};
+		Vector3Lanes inv_inertia_tensor_A[3]; // Rows.
+		Vector3Lanes inv_inertia_tensor_B[3];
+		real_t friction[LANE_COUNT] = {};
+
+		ContactLanes contacts[MAX_CONTACTS];
+	};
+
+	LocalVector<Batch> batches;
+	LocalVector<uint32_t> color_batch_ends;
+
+	LocalVector<uint64_t> body_colors;
+	LocalVector<GodotBodyPair3D *> color_pairs[MAX_COLORS];
+
+	// State of the batches solved in parallel.
+	GodotSolverBodies3D *task_bodies = nullptr;
+	uint32_t task_batch_offset = 0;
+	real_t task_step = 0.0;
+
+	void _fill_batch(Batch &r_batch, GodotBodyPair3D *const *p_pairs, uint32_t p_pair_count, const GodotSolverBodies3D &p_bodies) const;
+	static void _solve_batch(Batch &r_batch, GodotSolverBodies3D &p_bodies, real_t p_step);
+	void _solve_batch_task(uint32_t p_batch_index, void *p_userdata = nullptr);
+
+public:
+	// Moves the body pairs out of the island into batches. The pairs must be bound to p_bodies.
+	void setup(LocalVector<GodotConstraint3D *> &p_constraint_island, const GodotSolverBodies3D &p_bodies);
+	// Solves all batches once, which is one iteration of the solver.
+	void solve(GodotSolverBodies3D &p_bodies, real_t p_step, bool p_parallel);
+	// Writes the accumulated impulses back to the pairs, for contact reporting and warm starting.
+	void finish();
+
+	_FORCE_INLINE_ bool has_batches() const { return !batches.is_empty(); }
+};
@@ -33,6 +33,7 @@
 #include "godot_space_3d.h"
 
 #include "core/math/geometry_3d.h"
+#include "core/templates/frame_arena.h"
 #include "servers/rendering/rendering_server.h"
 
 // Based on Bullet soft body.
@@ -194,7 +195,7 @@ void GodotSoftBody3D::update_normals_and_centroids() {
 	}
 }
 
-void GodotSoftBody3D::update_bounds() {
+void GodotSoftBody3D::update_bounds(bool p_update_shape) {
 	AABB prev_bounds = bounds;
 	prev_bounds.grow_by(collision_margin);
 
@@ -202,7 +203,11 @@ void GodotSoftBody3D::update_bounds() {
 
 	const uint32_t nodes_count = nodes.size();
 	if (nodes_count == 0) {
-		deinitialize_shape();
+		if (p_update_shape) {
+			deinitialize_shape();
+		} else {
+			deferred_shape_update = true;
+		}
 		return;
 	}
 
@@ -221,11 +226,27 @@ void GodotSoftBody3D::update_bounds() {
 		}
 	}
 
-	if (get_space()) {
+	if (!p_update_shape) {
+		deferred_shape_update = true;
+		deferred_shape_moved = moved;
+	} else if (get_space()) {
 		initialize_shape(moved);
 	}
 }
 
+void GodotSoftBody3D::apply_deferred_updates() {
+	if (!deferred_shape_update) {
+		return;
+	}
+	deferred_shape_update = false;
+
+	if (nodes.is_empty()) {
+		deinitialize_shape();
+	} else if (get_space()) {
+		initialize_shape(deferred_shape_moved);
+	}
+}
+
 void GodotSoftBody3D::update_constants() {
 	reset_link_rest_lengths();
 	update_link_constants();
@@ -949,7 +970,7 @@ void GodotSoftBody3D::add_velocity(const Vector3 &p_velocity) {
 	}
 }
 
-void GodotSoftBody3D::apply_forces(const LocalVector<GodotArea3D *> &p_wind_areas) {
+void GodotSoftBody3D::apply_forces(Span<GodotArea3D *> p_wind_areas) {
 	if (nodes.is_empty()) {
 		return;
 	}
@@ -1011,7 +1032,7 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 	bool gravity_done = false;
 	Vector3 gravity;
 
-	LocalVector<GodotArea3D *> wind_areas;
+	FrameLocalVector<GodotArea3D *> wind_areas;
 
 	int ac = areas.size();
 	if (ac) {
@@ -1080,7 +1101,7 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 	}
 
 	// Bounds and tree update.
-	update_bounds();
+	update_bounds(false);
 
 	// Node tree update.
 	for (const Node &node : nodes) {
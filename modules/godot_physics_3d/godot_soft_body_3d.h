@@ -88,6 +88,10 @@ class GodotSoftBody3D : public GodotCollisionObject3D {
 
 	AABB bounds;
 
+	// Shape update left by predict_motion(), see apply_deferred_updates().
+	bool deferred_shape_update = false;
+	bool deferred_shape_moved = false;
+
 	real_t collision_margin = 0.05;
 
 	real_t total_mass = 1.0;
@@ -207,7 +211,9 @@ public:
 	void set_drag_coefficient(real_t p_val);
 	_FORCE_INLINE_ real_t get_drag_coefficient() const { return drag_coefficient; }
 
+	// Only modifies the soft body itself, call apply_deferred_updates() afterwards.
 	void predict_motion(real_t p_delta);
+	void apply_deferred_updates();
 	void solve_constraints(real_t p_delta);
 
 	_FORCE_INLINE_ uint32_t get_node_index(void *p_node) const { return static_cast<Node *>(p_node)->index; }
@@ -225,7 +231,7 @@ protected:
 
 private:
 	void update_normals_and_centroids();
-	void update_bounds();
+	void update_bounds(bool p_update_shape = true);
 	void update_constants();
 	void update_area();
 	void reset_link_rest_lengths();
@@ -235,7 +241,7 @@ private:
 
 	void add_velocity(const Vector3 &p_velocity);
 
-	void apply_forces(const LocalVector<GodotArea3D *> &p_wind_areas);
+	void apply_forces(Span<GodotArea3D *> p_wind_areas);
 
 	bool create_from_trimesh(const Vector<int> &p_indices, const Vector<Vector3> &p_vertices);
 	void generate_bending_constraints(int p_distance);
@@ -0,0 +1,107 @@
+/**************************************************************************/
+/*  godot_solver_bodies_3d.cpp                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "godot_solver_bodies_3d.h"
+
+#include "godot_body_3d.h"
+#include "godot_constraint_3d.h"
+
+void GodotSolverBodies3D::begin(uint64_t p_step) {
+	step = p_step;
+	rigid_bodies.clear();
+	linear_velocity.clear();
+	angular_velocity.clear();
+	biased_linear_velocity.clear();
+	biased_angular_velocity.clear();
+	inv_mass.clear();
+	inv_inertia_tensor.clear();
+}
+
+uint32_t GodotSolverBodies3D::add_body(GodotBody3D *p_body) {
+	const bool rigid = p_body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC;
+	if (rigid && p_body->has_solver_index(step)) {
+		return p_body->get_solver_index();
+	}
+
+	const uint32_t index = linear_velocity.size();
+	linear_velocity.push_back(p_body->get_linear_velocity());
+	angular_velocity.push_back(p_body->get_angular_velocity());
+	biased_linear_velocity.push_back(p_body->get_biased_linear_velocity());
+	biased_angular_velocity.push_back(p_body->get_biased_angular_velocity());
+	inv_mass.push_back(p_body->get_inv_mass());
+	inv_inertia_tensor.push_back(p_body->get_inv_inertia_tensor());
+
+	if (rigid) {
+		p_body->set_solver_index(step, index);
+		rigid_bodies.push_back(p_body);
+	}
+
+	return index;
+}
+
+void GodotSolverBodies3D::write_back() {
+	for (GodotBody3D *body : rigid_bodies) {
+		const uint32_t index = body->get_solver_index();
+		body->set_linear_velocity(linear_velocity[index]);
+		body->set_angular_velocity(angular_velocity[index]);
+		body->set_biased_linear_velocity(biased_linear_velocity[index]);
+		body->set_biased_angular_velocity(biased_angular_velocity[index]);
+	}
+}
+
+void GodotSolverBodies3D::store_bodies(const GodotConstraint3D *p_constraint) {
+	GodotBody3D **bodies = p_constraint->get_body_ptr();
+	for (int i = 0; i < p_constraint->get_body_count(); i++) {
+		GodotBody3D *body = bodies[i];
+		if (body->get_mode() <= PhysicsServer3D::BODY_MODE_KINEMATIC || !body->has_solver_index(step)) {
+			continue;
+		}
+		const uint32_t index = body->get_solver_index();
+		body->set_linear_velocity(linear_velocity[index]);
+		body->set_angular_velocity(angular_velocity[index]);
+		body->set_biased_linear_velocity(biased_linear_velocity[index]);
+		body->set_biased_angular_velocity(biased_angular_velocity[index]);
+	}
+}
+
+void GodotSolverBodies3D::load_bodies(const GodotConstraint3D *p_constraint) {
+	GodotBody3D **bodies = p_constraint->get_body_ptr();
+	for (int i = 0; i < p_constraint->get_body_count(); i++) {
+		GodotBody3D *body = bodies[i];
+		if (body->get_mode() <= PhysicsServer3D::BODY_MODE_KINEMATIC || !body->has_solver_index(step)) {
+			continue;
+		}
+		const uint32_t index = body->get_solver_index();
+		linear_velocity[index] = body->get_linear_velocity();
+		angular_velocity[index] = body->get_angular_velocity();
+		biased_linear_velocity[index] = body->get_biased_linear_velocity();
+		biased_angular_velocity[index] = body->get_biased_angular_velocity();
+	}
+}
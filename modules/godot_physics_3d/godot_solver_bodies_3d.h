@@ -0,0 +1,82 @@
+/**************************************************************************/
+/*  godot_solver_bodies_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/basis.h"
+#include "core/math/vector3.h"
+#include "core/templates/local_vector.h"
+
+class GodotBody3D;
+class GodotConstraint3D;
+
+// Velocities and mass properties of the bodies in an island, gathered into contiguous arrays
+// while the island is solved, and written back to the bodies once solving is done.
+//
+// Rigid bodies belong to a single island, so each one gets a single slot, which is recorded in
+// the body. Static and kinematic bodies aren't affected by the solver and may be referenced by
+// islands solved in parallel, so they get a read-only slot for every reference instead.
+class GodotSolverBodies3D {
+	uint64_t step = 0;
+	LocalVector<GodotBody3D *> rigid_bodies;
+
+public:
+	LocalVector<Vector3> linear_velocity;
+	LocalVector<Vector3> angular_velocity;
+	LocalVector<Vector3> biased_linear_velocity;
+	LocalVector<Vector3> biased_angular_velocity;
+	LocalVector<real_t> inv_mass;
+	LocalVector<Basis> inv_inertia_tensor;
+
+	void begin(uint64_t p_step);
+	uint32_t add_body(GodotBody3D *p_body);
+	void write_back();
+
+	// Synchronize the bodies of a constraint that doesn't use solver bodies before and after solving it.
+	void store_bodies(const GodotConstraint3D *p_constraint);
+	void load_bodies(const GodotConstraint3D *p_constraint);
+
+	// Same as the GodotBody3D methods, with offsets relative to the center of mass.
+	_FORCE_INLINE_ void apply_impulse(uint32_t p_index, const Vector3 &p_impulse, const Vector3 &p_offset) {
+		linear_velocity[p_index] += p_impulse * inv_mass[p_index];
+		angular_velocity[p_index] += inv_inertia_tensor[p_index].xform(p_offset.cross(p_impulse));
+	}
+
+	_FORCE_INLINE_ void apply_bias_impulse(uint32_t p_index, const Vector3 &p_impulse, const Vector3 &p_offset = Vector3(), real_t p_max_delta_av = -1.0) {
+		biased_linear_velocity[p_index] += p_impulse * inv_mass[p_index];
+		if (p_max_delta_av != 0.0) {
+			Vector3 delta_av = inv_inertia_tensor[p_index].xform(p_offset.cross(p_impulse));
+			if (p_max_delta_av > 0 && delta_av.length() > p_max_delta_av) {
+				delta_av = delta_av.normalized() * p_max_delta_av;
+			}
+			biased_angular_velocity[p_index] += delta_av;
+		}
+	}
+};
@@ -36,9 +36,14 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/frame_arena.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
+// Below this, batched queries run on the calling thread.
+#define PARALLEL_QUERY_MIN_COUNT 64
+#define QUERY_BATCH_CHUNK_SIZE 32
 
 _FORCE_INLINE_ static bool _can_collide_with(GodotCollisionObject3D *p_object, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 	if (!(p_object->get_collision_layer() & p_collision_mask)) {
@@ -107,16 +112,14 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V(space->locked, false);
-
+bool GodotPhysicsDirectSpaceState3D::_intersect_ray(const RayParameters &p_parameters, RayResult &r_result, GodotCollisionObject3D **r_cull_results, int *r_cull_subindex_results) {
 	Vector3 begin, end;
 	Vector3 normal;
 	begin = p_parameters.from;
 	end = p_parameters.to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_segment(begin, end, r_cull_results, GodotSpace3D::INTERSECTION_QUERY_MAX, r_cull_subindex_results);
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -128,21 +131,21 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	real_t min_d = 1e10;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_cull_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
+		if (p_parameters.pick_ray && !(r_cull_results[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_cull_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject3D *col_obj = r_cull_results[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = r_cull_subindex_results[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -207,17 +210,16 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
-int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
-	if (p_result_max <= 0) {
-		return 0;
-	}
+bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V(space->locked, false);
 
-	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
-	ERR_FAIL_NULL_V(shape, 0);
+	return _intersect_ray(p_parameters, r_result, space->intersection_query_results, space->intersection_query_subindex_results);
+}
 
-	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
+int GodotPhysicsDirectSpaceState3D::_intersect_shape(const ShapeParameters &p_parameters, const GodotShape3D *p_shape, ShapeResult *r_results, int p_result_max, GodotCollisionObject3D **r_cull_results, int *r_cull_subindex_results) {
+	AABB aabb = p_parameters.transform.xform(p_shape->get_aabb());
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_aabb(aabb, r_cull_results, GodotSpace3D::INTERSECTION_QUERY_MAX, r_cull_subindex_results);
 
 	int cc = 0;
 
@@ -228,20 +230,20 @@ int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_par
 			break;
 		}
 
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_cull_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
 		//area can't be picked by ray (default)
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_cull_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject3D *col_obj = r_cull_results[i];
+		int shape_idx = r_cull_subindex_results[i];
 
-		if (!GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
+		if (!GodotCollisionSolver3D::solve_static(p_shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
 			continue;
 		}
 
@@ -262,6 +264,104 @@ int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_par
 	return cc;
 }
 
+int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
+	if (p_result_max <= 0) {
+		return 0;
+	}
+
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, 0);
+
+	return _intersect_shape(p_parameters, shape, r_results, p_result_max, space->intersection_query_results, space->intersection_query_subindex_results);
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_ray_chunk(uint32_t p_chunk_index, RayBatch *p_batch) {
+	FrameArena::Scope frame_arena_scope;
+	FrameLocalVector<GodotCollisionObject3D *> cull_results;
+	cull_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	FrameLocalVector<int> cull_subindex_results;
+	cull_subindex_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+
+	RayParameters parameters = *p_batch->parameters;
+	const int begin = p_chunk_index * QUERY_BATCH_CHUNK_SIZE;
+	const int end = MIN(begin + QUERY_BATCH_CHUNK_SIZE, p_batch->count);
+	for (int i = begin; i < end; i++) {
+		parameters.from = p_batch->from[i];
+		parameters.to = p_batch->to[i];
+		p_batch->hits[i] = _intersect_ray(parameters, p_batch->results[i], cull_results.ptr(), cull_subindex_results.ptr());
+	}
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_shape_chunk(uint32_t p_chunk_index, ShapeBatch *p_batch) {
+	FrameArena::Scope frame_arena_scope;
+	FrameLocalVector<GodotCollisionObject3D *> cull_results;
+	cull_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	FrameLocalVector<int> cull_subindex_results;
+	cull_subindex_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+
+	ShapeParameters parameters = *p_batch->parameters;
+	const int begin = p_chunk_index * QUERY_BATCH_CHUNK_SIZE;
+	const int end = MIN(begin + QUERY_BATCH_CHUNK_SIZE, p_batch->count);
+	for (int i = begin; i < end; i++) {
+		parameters.transform = p_batch->transforms[i];
+		p_batch->result_counts[i] = _intersect_shape(parameters, p_batch->shape, p_batch->results + i * p_batch->result_max, p_batch->result_max, cull_results.ptr(), cull_subindex_results.ptr());
+	}
+}
+
+void GodotPhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND(space->locked);
+
+	if (p_count < PARALLEL_QUERY_MIN_COUNT) {
+		PhysicsDirectSpaceState3D::intersect_rays(p_parameters, p_from, p_to, p_count, r_results, r_hits);
+		return;
+	}
+
+	RayBatch batch;
+	batch.parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.results = r_results;
+	batch.hits = r_hits;
+	batch.count = p_count;
+
+	// The broadphase is locked while culling, so queries only run in parallel past it.
+	const uint32_t chunk_count = (p_count + QUERY_BATCH_CHUNK_SIZE - 1) / QUERY_BATCH_CHUNK_SIZE;
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_ray_chunk, &batch, chunk_count, -1, true, SNAME("Physics3DIntersectRays"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void GodotPhysicsDirectSpaceState3D::intersect_shapes(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) {
+	ERR_FAIL_COND(space->locked);
+
+	if (p_result_max <= 0) {
+		for (int i = 0; i < p_count; i++) {
+			r_result_counts[i] = 0;
+		}
+		return;
+	}
+
+	if (p_count < PARALLEL_QUERY_MIN_COUNT) {
+		PhysicsDirectSpaceState3D::intersect_shapes(p_parameters, p_transforms, p_count, r_results, p_result_max, r_result_counts);
+		return;
+	}
+
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL(shape);
+
+	ShapeBatch batch;
+	batch.parameters = &p_parameters;
+	batch.shape = shape;
+	batch.transforms = p_transforms;
+	batch.results = r_results;
+	batch.result_max = p_result_max;
+	batch.result_counts = r_result_counts;
+	batch.count = p_count;
+
+	const uint32_t chunk_count = (p_count + QUERY_BATCH_CHUNK_SIZE - 1) / QUERY_BATCH_CHUNK_SIZE;
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_shape_chunk, &batch, chunk_count, -1, true, SNAME("Physics3DIntersectShapes"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info) {
 	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
 	ERR_FAIL_NULL_V(shape, false);
@@ -1215,6 +1315,9 @@ void GodotSpace3D::set_param(PhysicsServer3D::SpaceParameter p_param, real_t p_v
 		case PhysicsServer3D::SPACE_PARAM_SOLVER_ITERATIONS:
 			solver_iterations = p_value;
 			break;
+		case PhysicsServer3D::SPACE_PARAM_SOLVER_BATCHED_CONTACTS:
+			batched_contacts = p_value != 0.0;
+			break;
 	}
 }
 
@@ -1236,6 +1339,8 @@ real_t GodotSpace3D::get_param(PhysicsServer3D::SpaceParameter p_param) const {
 			return body_time_to_sleep;
 		case PhysicsServer3D::SPACE_PARAM_SOLVER_ITERATIONS:
 			return solver_iterations;
+		case PhysicsServer3D::SPACE_PARAM_SOLVER_BATCHED_CONTACTS:
+			return batched_contacts;
 	}
 	return 0;
 }
@@ -1261,6 +1366,7 @@ GodotSpace3D::GodotSpace3D() {
 	body_angular_velocity_sleep_threshold = GLOBAL_GET("physics/3d/sleep_threshold_angular");
 	body_time_to_sleep = GLOBAL_GET("physics/3d/time_before_sleep");
 	solver_iterations = GLOBAL_GET("physics/3d/solver/solver_iterations");
+	batched_contacts = GLOBAL_GET("physics/3d/solver/batched_contacts");
 	contact_recycle_radius = GLOBAL_GET("physics/3d/solver/contact_recycle_radius");
 	contact_max_separation = GLOBAL_GET("physics/3d/solver/contact_max_separation");
 	contact_max_allowed_penetration = GLOBAL_GET("physics/3d/solver/contact_max_allowed_penetration");
@@ -41,6 +41,34 @@
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	struct RayBatch {
+		const RayParameters *parameters = nullptr;
+		const Vector3 *from = nullptr;
+		const Vector3 *to = nullptr;
+		RayResult *results = nullptr;
+		bool *hits = nullptr;
+		int count = 0;
+	};
+
+	struct ShapeBatch {
+		const ShapeParameters *parameters = nullptr;
+		const GodotShape3D *shape = nullptr;
+		const Transform3D *transforms = nullptr;
+		ShapeResult *results = nullptr;
+		int result_max = 0;
+		int *result_counts = nullptr;
+		int count = 0;
+	};
+
+	// The broadphase results are written to r_cull_results and r_cull_subindex_results, which hold
+	// GodotSpace3D::INTERSECTION_QUERY_MAX elements. The space has its own for queries made directly,
+	// batched queries running on several threads use one per task instead.
+	bool _intersect_ray(const RayParameters &p_parameters, RayResult &r_result, GodotCollisionObject3D **r_cull_results, int *r_cull_subindex_results);
+	int _intersect_shape(const ShapeParameters &p_parameters, const GodotShape3D *p_shape, ShapeResult *r_results, int p_result_max, GodotCollisionObject3D **r_cull_results, int *r_cull_subindex_results);
+
+	void _intersect_ray_chunk(uint32_t p_chunk_index, RayBatch *p_batch);
+	void _intersect_shape_chunk(uint32_t p_chunk_index, ShapeBatch *p_batch);
+
 public:
 	GodotSpace3D *space = nullptr;
 
@@ -52,6 +80,9 @@ public:
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) override;
 	virtual Vector3 get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const override;
 
+	virtual void intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) override;
+	virtual void intersect_shapes(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) override;
+
 	GodotPhysicsDirectSpaceState3D();
 };
 
@@ -89,6 +120,7 @@ private:
 	GodotArea3D *area = nullptr;
 
 	int solver_iterations = 0;
+	bool batched_contacts = false;
 
 	real_t contact_recycle_radius = 0.0;
 	real_t contact_max_separation = 0.0;
@@ -156,6 +188,7 @@ public:
 	const HashSet<GodotCollisionObject3D *> &get_objects() const;
 
 	_FORCE_INLINE_ int get_solver_iterations() const { return solver_iterations; }
+	_FORCE_INLINE_ bool is_using_batched_contacts() const { return batched_contacts; }
 	_FORCE_INLINE_ real_t get_contact_recycle_radius() const { return contact_recycle_radius; }
 	_FORCE_INLINE_ real_t get_contact_max_separation() const { return contact_max_separation; }
 	_FORCE_INLINE_ real_t get_contact_max_allowed_penetration() const { return contact_max_allowed_penetration; }
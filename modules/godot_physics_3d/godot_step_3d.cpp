@@ -34,12 +34,18 @@
 
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "core/templates/frame_arena.h"
 
 #define BODY_ISLAND_COUNT_RESERVE 128
 #define BODY_ISLAND_SIZE_RESERVE 512
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
+#define ACTIVE_BODY_COUNT_RESERVE 1024
+// Below this, integrating on the calling thread is faster than dispatching tasks.
+#define PARALLEL_INTEGRATION_MIN_BODIES 64
+// From this, islands are solved one at a time with their contact batches split across threads.
+#define PARALLEL_BATCH_MIN_ISLAND_SIZE 512
 
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
@@ -130,21 +136,50 @@ void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constrai
 	p_constraint_island.resize(valid_constraint_count);
 }
 
-void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
+void GodotStep3D::_solve_island(uint32_t p_island_index, bool p_parallel_batches) {
 	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_island_index];
 
+	// Gather the velocities of the bodies, so contacts don't need to access them during iterations.
+	GodotSolverBodies3D &solver_bodies = island_solver_bodies[p_island_index];
+	solver_bodies.begin(_step);
+	for (GodotConstraint3D *constraint : constraint_island) {
+		if (constraint->is_using_solver_bodies()) {
+			constraint->bind_solver_bodies(&solver_bodies);
+		}
+	}
+
+	// Body pairs are moved out of the island into batches.
+	GodotContactBatchSolver3D *batch_solver = nullptr;
+	if (batched_contacts) {
+		batch_solver = &island_batch_solvers[p_island_index];
+		batch_solver->setup(constraint_island, solver_bodies);
+	}
+	bool solve_batches = batch_solver && batch_solver->has_batches();
+
 	int current_priority = 1;
 
 	uint32_t constraint_count = constraint_island.size();
-	while (constraint_count > 0) {
+	while (constraint_count > 0 || solve_batches) {
 		for (int i = 0; i < iterations; i++) {
 			// Go through all iterations.
+			if (solve_batches) {
+				batch_solver->solve(solver_bodies, delta, p_parallel_batches);
+			}
 			for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
-				constraint_island[constraint_index]->solve(delta);
+				GodotConstraint3D *constraint = constraint_island[constraint_index];
+				if (likely(constraint->is_using_solver_bodies())) {
+					constraint->solve(delta);
+				} else {
+					solver_bodies.store_bodies(constraint);
+					constraint->solve(delta);
+					solver_bodies.load_bodies(constraint);
+				}
 			}
 		}
 
 		// Check priority to keep only higher priority constraints.
+		// Body pairs have the lowest priority, so batches are only solved in the first pass.
+		solve_batches = false;
 		uint32_t priority_constraint_count = 0;
 		++current_priority;
 		for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
@@ -156,6 +191,15 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 		}
 		constraint_count = priority_constraint_count;
 	}
+
+	if (batch_solver) {
+		batch_solver->finish();
+	}
+	solver_bodies.write_back();
+}
+
+void GodotStep3D::_solve_island_task(uint32_t p_task_index, void *p_userdata) {
+	_solve_island(task_islands[p_task_index], false);
 }
 
 void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
@@ -182,7 +226,43 @@ void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island
 	}
 }
 
+void GodotStep3D::_gather_active_bodies(const SelfList<GodotBody3D>::List &p_body_list) {
+	active_bodies.clear();
+	const SelfList<GodotBody3D> *b = p_body_list.first();
+	while (b) {
+		active_bodies.push_back(b->self());
+		b = b->next();
+	}
+}
+
+void GodotStep3D::_integrate_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta);
+}
+
+void GodotStep3D::_predict_soft_body_motion(uint32_t p_soft_body_index, void *p_userdata) {
+	active_soft_bodies[p_soft_body_index]->predict_motion(delta);
+}
+
+void GodotStep3D::_integrate_velocities(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities(delta);
+}
+
+void GodotStep3D::_run_body_tasks(void (GodotStep3D::*p_method)(uint32_t, void *), uint32_t p_count, const StringName &p_description) {
+	if (p_count < PARALLEL_INTEGRATION_MIN_BODIES) {
+		for (uint32_t i = 0; i < p_count; i++) {
+			(this->*p_method)(i, nullptr);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, p_method, nullptr, p_count, -1, true, p_description);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
+	// Physics may run on its own thread, out of sync with frames.
+	FrameArena::Scope frame_arena_scope;
+
 	p_space->lock(); // can't access space during this
 
 	p_space->setup(); //update inertias, etc
@@ -190,6 +270,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	p_space->set_last_step(p_delta);
 
 	iterations = p_space->get_solver_iterations();
+	batched_contacts = p_space->is_using_batched_contacts();
 	delta = p_delta;
 
 	const SelfList<GodotBody3D>::List *body_list = &p_space->get_active_body_list();
@@ -201,25 +282,29 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
-
-	const SelfList<GodotBody3D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	// Bodies are integrated in parallel, but anything touching the space or the broadphase
+	// is deferred and applied afterwards in list order, so results don't depend on threading.
+	_gather_active_bodies(*body_list);
+	_run_body_tasks(&GodotStep3D::_integrate_forces, active_bodies.size(), SNAME("Physics3DIntegrateForces"));
+	for (GodotBody3D *body : active_bodies) {
+		body->apply_deferred_updates();
 	}
 
 	/* UPDATE SOFT BODY MOTION */
 
+	active_soft_bodies.clear();
 	const SelfList<GodotSoftBody3D> *sb = soft_body_list->first();
 	while (sb) {
-		sb->self()->predict_motion(p_delta);
+		active_soft_bodies.push_back(sb->self());
 		sb = sb->next();
-		active_count++;
 	}
 
-	p_space->set_active_objects(active_count);
+	_run_body_tasks(&GodotStep3D::_predict_soft_body_motion, active_soft_bodies.size(), SNAME("Physics3DPredictSoftBodyMotion"));
+	for (GodotSoftBody3D *soft_body : active_soft_bodies) {
+		soft_body->apply_deferred_updates();
+	}
+
+	p_space->set_active_objects((int)(active_bodies.size() + active_soft_bodies.size()));
 
 	// Update the broadphase to register collision pairs.
 	p_space->update();
@@ -260,7 +345,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
-	b = body_list->first();
+	const SelfList<GodotBody3D> *b = body_list->first();
 
 	uint32_t body_island_count = 0;
 
@@ -362,9 +447,31 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
+	if (island_solver_bodies.size() < island_count) {
+		island_solver_bodies.resize(island_count);
+	}
+	if (batched_contacts && island_batch_solvers.size() < island_count) {
+		island_batch_solvers.resize(island_count);
+	}
+
+	// Waiting for a group task from another one could deadlock, so islands large enough to split
+	// their batches across threads are solved here, while the others are solved in the group task.
+	task_islands.clear();
+	large_islands.clear();
+	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+		if (batched_contacts && constraint_islands[island_index].size() >= PARALLEL_BATCH_MIN_ISLAND_SIZE) {
+			large_islands.push_back(island_index);
+		} else {
+			task_islands.push_back(island_index);
+		}
+	}
+
 	// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island_task, nullptr, task_islands.size(), -1, true, SNAME("Physics3DConstraintSolveIslands"));
+	for (uint32_t island_index : large_islands) {
+		_solve_island(island_index, true);
+	}
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
@@ -375,11 +482,12 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody3D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n;
+	// Solving may have woken up bodies, so the list is gathered again.
+	// Deactivating a body removes it from the list, which is why that is deferred as well.
+	_gather_active_bodies(*body_list);
+	_run_body_tasks(&GodotStep3D::_integrate_velocities, active_bodies.size(), SNAME("Physics3DIntegrateVelocities"));
+	for (GodotBody3D *body : active_bodies) {
+		body->apply_deferred_updates();
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
@@ -412,6 +520,9 @@ GodotStep3D::GodotStep3D() {
 	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
+	island_solver_bodies.reserve(ISLAND_COUNT_RESERVE);
+	task_islands.reserve(ISLAND_COUNT_RESERVE);
+	active_bodies.reserve(ACTIVE_BODY_COUNT_RESERVE);
 }
 
 GodotStep3D::~GodotStep3D() {
@@ -30,6 +30,8 @@
 
 #pragma once
 
+#include "godot_contact_batch_solver_3d.h"
+#include "godot_solver_bodies_3d.h"
 #include "godot_space_3d.h"
 
 #include "core/templates/local_vector.h"
@@ -39,18 +41,37 @@ class GodotStep3D {
 
 	int iterations = 0;
 	real_t delta = 0.0;
+	bool batched_contacts = false;
 
 	LocalVector<LocalVector<GodotBody3D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
+	LocalVector<GodotSolverBodies3D> island_solver_bodies;
+	LocalVector<GodotContactBatchSolver3D> island_batch_solvers;
+
+	// Islands solved in a group task, the others are solved on the calling thread with
+	// their contact batches split across threads instead.
+	LocalVector<uint32_t> task_islands;
+	LocalVector<uint32_t> large_islands;
+
+	// Copied from the active lists of the space, so they can be split into tasks.
+	LocalVector<GodotBody3D *> active_bodies;
+	LocalVector<GodotSoftBody3D *> active_soft_bodies;
 
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
-	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
+	void _solve_island(uint32_t p_island_index, bool p_parallel_batches);
+	void _solve_island_task(uint32_t p_task_index, void *p_userdata = nullptr);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
 
+	void _gather_active_bodies(const SelfList<GodotBody3D>::List &p_body_list);
+	void _integrate_forces(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _predict_soft_body_motion(uint32_t p_soft_body_index, void *p_userdata = nullptr);
+	void _integrate_velocities(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _run_body_tasks(void (GodotStep3D::*p_method)(uint32_t, void *), uint32_t p_count, const StringName &p_description);
+
 public:
 	void step(GodotSpace3D *p_space, real_t p_delta);
 	GodotStep3D();
@@ -0,0 +1,213 @@
+/**************************************************************************/
+/*  test_contact_batch_solver_3d.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestContactBatchSolver3D {
+
+static constexpr real_t STEP = 1.0 / 60.0;
+static constexpr int STEP_COUNT = 120;
+static constexpr real_t BOX_HALF_SIZE = 0.5;
+
+// Boxes on a static floor, simulated either with the reference (scalar) contact solver or the batched one.
+class BoxScene {
+	GodotPhysicsServer3D *server = nullptr;
+	RID space;
+	RID floor_shape;
+	RID box_shape;
+	RID floor;
+	LocalVector<RID> boxes;
+
+public:
+	void add_box(const Vector3 &p_position, const Vector3 &p_linear_velocity = Vector3(), const Vector3 &p_angular_velocity = Vector3()) {
+		RID box = server->body_create();
+		server->body_set_mode(box, PhysicsServer3D::BODY_MODE_RIGID);
+		server->body_add_shape(box, box_shape);
+		server->body_set_space(box, space);
+		server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), p_position));
+		server->body_set_state(box, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, p_linear_velocity);
+		server->body_set_state(box, PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY, p_angular_velocity);
+		server->body_set_state(box, PhysicsServer3D::BODY_STATE_CAN_SLEEP, false);
+		boxes.push_back(box);
+	}
+
+	void simulate() {
+		for (int i = 0; i < STEP_COUNT; i++) {
+			server->step(STEP);
+		}
+	}
+
+	// Of the last step.
+	int get_island_count() const {
+		return server->get_process_info(PhysicsServer3D::INFO_ISLAND_COUNT);
+	}
+
+	int get_collision_pair_count() const {
+		return server->get_process_info(PhysicsServer3D::INFO_COLLISION_PAIRS);
+	}
+
+	uint32_t get_box_count() const {
+		return boxes.size();
+	}
+
+	Vector3 get_box_position(uint32_t p_index) const {
+		Transform3D transform = server->body_get_state(boxes[p_index], PhysicsServer3D::BODY_STATE_TRANSFORM);
+		return transform.origin;
+	}
+
+	explicit BoxScene(bool p_batched_contacts) {
+		server = memnew(GodotPhysicsServer3D);
+		server->init();
+
+		space = server->space_create();
+		server->space_set_active(space, true);
+		server->space_set_param(space, PhysicsServer3D::SPACE_PARAM_SOLVER_BATCHED_CONTACTS, p_batched_contacts ? 1.0 : 0.0);
+
+		floor_shape = server->box_shape_create();
+		server->shape_set_data(floor_shape, Vector3(100, 1, 100));
+		box_shape = server->box_shape_create();
+		server->shape_set_data(box_shape, Vector3(BOX_HALF_SIZE, BOX_HALF_SIZE, BOX_HALF_SIZE));
+
+		// The top of the floor is at y = 0.
+		floor = server->body_create();
+		server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+		server->body_add_shape(floor, floor_shape);
+		server->body_set_space(floor, space);
+		server->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -1, 0)));
+	}
+
+	~BoxScene() {
+		for (const RID &box : boxes) {
+			server->free_rid(box);
+		}
+		server->free_rid(floor);
+		server->free_rid(box_shape);
+		server->free_rid(floor_shape);
+		server->free_rid(space);
+
+		server->finish();
+		memdelete(server);
+	}
+};
+
+static void add_separate_boxes(BoxScene &r_scene) {
+	// Boxes that don't touch each other, dropped and sliding on the floor, so friction is involved.
+	for (int x = 0; x < 8; x++) {
+		for (int z = 0; z < 8; z++) {
+			const Vector3 position = Vector3(x * 3.0, BOX_HALF_SIZE + 0.1 * (x % 3), z * 3.0);
+			const Vector3 linear_velocity = Vector3(0.2 * (z % 4), 0, -0.2 * (x % 4));
+			const Vector3 angular_velocity = Vector3(0, 0.5 * ((x + z) % 3), 0);
+			r_scene.add_box(position, linear_velocity, angular_velocity);
+		}
+	}
+}
+
+static void add_stacked_boxes(BoxScene &r_scene) {
+	// Touching boxes forming a single island, with many pairs sharing bodies.
+	for (int y = 0; y < 4; y++) {
+		for (int x = 0; x < 4; x++) {
+			for (int z = 0; z < 4; z++) {
+				r_scene.add_box(Vector3(x, y + BOX_HALF_SIZE, z) * (BOX_HALF_SIZE * 2.0));
+			}
+		}
+	}
+}
+
+static void add_box_layer(BoxScene &r_scene) {
+	// A layer of slightly overlapping boxes forming a single island. Its 576 floor pairs and 1104 side
+	// pairs are enough to solve the island's batches on several threads.
+	for (int x = 0; x < 24; x++) {
+		for (int z = 0; z < 24; z++) {
+			r_scene.add_box(Vector3(x * 0.99, 0, z * 0.99) * (BOX_HALF_SIZE * 2.0) + Vector3(0, BOX_HALF_SIZE, 0));
+		}
+	}
+}
+
+TEST_CASE("[Physics3D][GodotPhysics3D] Batched contacts match the reference solver for independent pairs") {
+	// Every pair is in its own island, so both solvers handle contacts in the same order.
+	BoxScene reference(false);
+	BoxScene batched(true);
+	add_separate_boxes(reference);
+	add_separate_boxes(batched);
+
+	reference.simulate();
+	batched.simulate();
+
+	for (uint32_t i = 0; i < reference.get_box_count(); i++) {
+		const Vector3 expected = reference.get_box_position(i);
+		const Vector3 position = batched.get_box_position(i);
+		CHECK_MESSAGE(position.distance_to(expected) < 1e-4, vformat("Box %d should end at %s, not %s.", i, expected, position));
+	}
+}
+
+TEST_CASE("[Physics3D][GodotPhysics3D] Batched contacts keep a stack of boxes at rest") {
+	// Pairs are solved in a different order, so results only need to be close to the reference.
+	BoxScene reference(false);
+	BoxScene batched(true);
+	add_stacked_boxes(reference);
+	add_stacked_boxes(batched);
+
+	reference.simulate();
+	batched.simulate();
+
+	for (uint32_t i = 0; i < reference.get_box_count(); i++) {
+		const Vector3 expected = reference.get_box_position(i);
+		const Vector3 position = batched.get_box_position(i);
+		CHECK_MESSAGE(position.y > BOX_HALF_SIZE - 0.05, vformat("Box %d shouldn't sink into the floor.", i));
+		CHECK_MESSAGE(position.distance_to(expected) < 0.1, vformat("Box %d should end close to %s, not %s.", i, expected, position));
+	}
+}
+
+TEST_CASE("[Physics3D][GodotPhysics3D] Batched contacts solved on several threads stay close to the reference solver") {
+	BoxScene reference(false);
+	BoxScene batched(true);
+	add_box_layer(reference);
+	add_box_layer(batched);
+
+	reference.simulate();
+	batched.simulate();
+
+	// Large enough for the island to be solved with `GodotStep3D::_solve_island(..., true)`.
+	REQUIRE(batched.get_island_count() == 1);
+	REQUIRE(batched.get_collision_pair_count() >= 512);
+
+	for (uint32_t i = 0; i < reference.get_box_count(); i++) {
+		const Vector3 expected = reference.get_box_position(i);
+		const Vector3 position = batched.get_box_position(i);
+		CHECK_MESSAGE(position.y > BOX_HALF_SIZE - 0.05, vformat("Box %d shouldn't sink into the floor.", i));
+		CHECK_MESSAGE(position.distance_to(expected) < 0.1, vformat("Box %d should end close to %s, not %s.", i, expected, position));
+	}
+}
+
+} // namespace TestContactBatchSolver3D
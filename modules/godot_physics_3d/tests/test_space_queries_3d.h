@@ -0,0 +1,244 @@
+/**************************************************************************/
+/*  test_space_queries_3d.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_physics_server_3d.h"
+
+#include "core/variant/typed_array.h"
+#include "tests/test_macros.h"
+
+namespace TestSpaceQueries3D {
+
+static constexpr int MAX_RESULTS = 3;
+
+// Static spheres on every even point of a grid, queried from above and around.
+class SphereGrid {
+	GodotPhysicsServer3D *server = nullptr;
+	RID space;
+	RID sphere_shape;
+	LocalVector<RID> spheres;
+
+public:
+	RID query_shape;
+
+	PhysicsDirectSpaceState3D *get_direct_state() const {
+		return server->space_get_direct_state(space);
+	}
+
+	SphereGrid() {
+		server = memnew(GodotPhysicsServer3D);
+		server->init();
+
+		space = server->space_create();
+		server->space_set_active(space, true);
+
+		sphere_shape = server->sphere_shape_create();
+		server->shape_set_data(sphere_shape, 0.5);
+		query_shape = server->sphere_shape_create();
+		server->shape_set_data(query_shape, 1.5);
+
+		for (int x = 0; x < 20; x += 2) {
+			for (int z = 0; z < 10; z += 2) {
+				RID sphere = server->body_create();
+				server->body_set_mode(sphere, PhysicsServer3D::BODY_MODE_STATIC);
+				server->body_add_shape(sphere, sphere_shape);
+				server->body_set_space(sphere, space);
+				server->body_set_state(sphere, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(x, 0, z)));
+				spheres.push_back(sphere);
+			}
+		}
+
+		// Adds the shapes to the broadphase.
+		server->step(1.0 / 60.0);
+	}
+
+	~SphereGrid() {
+		for (const RID &sphere : spheres) {
+			server->free_rid(sphere);
+		}
+		server->free_rid(query_shape);
+		server->free_rid(sphere_shape);
+		server->free_rid(space);
+
+		server->finish();
+		memdelete(server);
+	}
+};
+
+static Vector3 get_grid_point(int p_index) {
+	return Vector3(p_index % 20, 0, (p_index / 20) % 10);
+}
+
+static void check_ray_batch(int p_count) {
+	SphereGrid grid;
+	PhysicsDirectSpaceState3D *direct_state = grid.get_direct_state();
+
+	PackedVector3Array from;
+	PackedVector3Array to;
+	for (int i = 0; i < p_count; i++) {
+		from.push_back(get_grid_point(i) + Vector3(0.1, 5, 0));
+		to.push_back(get_grid_point(i) + Vector3(0.1, -5, 0));
+	}
+	Ref<PhysicsRayQueryParameters3D> query;
+	query.instantiate();
+
+	const Dictionary batch = direct_state->call("intersect_rays_batch", query, from, to);
+	const PackedByteArray hit = batch["hit"];
+	const PackedVector3Array position = batch["position"];
+	const PackedVector3Array normal = batch["normal"];
+	const PackedInt32Array face_index = batch["face_index"];
+	const PackedInt64Array collider_id = batch["collider_id"];
+	const PackedInt32Array shape = batch["shape"];
+	const TypedArray<RID> rid = batch["rid"];
+	REQUIRE(hit.size() == p_count);
+	REQUIRE(position.size() == p_count);
+	REQUIRE(normal.size() == p_count);
+	REQUIRE(face_index.size() == p_count);
+	REQUIRE(collider_id.size() == p_count);
+	REQUIRE(shape.size() == p_count);
+	REQUIRE(rid.size() == p_count);
+
+	int hit_count = 0;
+	PhysicsDirectSpaceState3D::RayParameters parameters = query->get_parameters();
+	for (int i = 0; i < p_count; i++) {
+		parameters.from = from[i];
+		parameters.to = to[i];
+		PhysicsDirectSpaceState3D::RayResult expected;
+		const bool expected_hit = direct_state->intersect_ray(parameters, expected);
+
+		INFO("Ray ", i);
+		CHECK(hit[i] == (expected_hit ? 1 : 0));
+		if (!expected_hit) {
+			CHECK(collider_id[i] == 0);
+			CHECK(shape[i] == -1);
+			CHECK(RID(rid[i]) == RID());
+			continue;
+		}
+		hit_count++;
+		CHECK(position[i] == expected.position);
+		CHECK(normal[i] == expected.normal);
+		CHECK(face_index[i] == expected.face_index);
+		CHECK(collider_id[i] == (int64_t)expected.collider_id);
+		CHECK(shape[i] == expected.shape);
+		CHECK(RID(rid[i]) == expected.rid);
+	}
+	CHECK_MESSAGE(hit_count > 0, "Some rays should hit a sphere.");
+	CHECK_MESSAGE(hit_count < p_count, "Some rays should miss every sphere.");
+}
+
+static void check_shape_batch(int p_count) {
+	SphereGrid grid;
+	PhysicsDirectSpaceState3D *direct_state = grid.get_direct_state();
+
+	PackedVector3Array positions;
+	for (int i = 0; i < p_count; i++) {
+		positions.push_back(get_grid_point(i) + Vector3(0, 0, 0.5));
+	}
+	Ref<PhysicsShapeQueryParameters3D> query;
+	query.instantiate();
+	query->set_shape_rid(grid.query_shape);
+	// Only the position of the transform is replaced.
+	query->set_transform(Transform3D(Basis(Vector3(0, 1, 0), Math::PI / 4.0), Vector3(100, 100, 100)));
+
+	const Dictionary batch = direct_state->call("intersect_shapes_batch", query, positions, MAX_RESULTS);
+	const PackedInt32Array count = batch["count"];
+	const PackedInt64Array collider_id = batch["collider_id"];
+	const PackedInt32Array shape = batch["shape"];
+	const TypedArray<RID> rid = batch["rid"];
+	REQUIRE(count.size() == p_count);
+
+	// Results are packed one query after the other.
+	int offset = 0;
+	int max_count = 0;
+	PhysicsDirectSpaceState3D::ShapeParameters parameters = query->get_parameters();
+	for (int i = 0; i < p_count; i++) {
+		parameters.transform.origin = positions[i];
+		PhysicsDirectSpaceState3D::ShapeResult expected[MAX_RESULTS];
+		const int expected_count = direct_state->intersect_shape(parameters, expected, MAX_RESULTS);
+
+		INFO("Query ", i);
+		REQUIRE(count[i] == expected_count);
+		REQUIRE(offset + expected_count <= collider_id.size());
+		for (int j = 0; j < expected_count; j++) {
+			CHECK(collider_id[offset + j] == (int64_t)expected[j].collider_id);
+			CHECK(shape[offset + j] == expected[j].shape);
+			CHECK(RID(rid[offset + j]) == expected[j].rid);
+		}
+		offset += expected_count;
+		max_count = MAX(max_count, expected_count);
+	}
+	CHECK(offset == collider_id.size());
+	CHECK(offset == shape.size());
+	CHECK(offset == rid.size());
+	CHECK_MESSAGE(max_count == MAX_RESULTS, "Some queries should be limited to the maximum number of results.");
+}
+
+TEST_CASE("[Physics3D][GodotPhysics3D] Batched ray queries match single ray queries") {
+	SUBCASE("Batch run on the calling thread") {
+		check_ray_batch(40);
+	}
+	SUBCASE("Batch split into tasks") {
+		check_ray_batch(200);
+	}
+}
+
+TEST_CASE("[Physics3D][GodotPhysics3D] Batched shape queries match single shape queries") {
+	SUBCASE("Batch run on the calling thread") {
+		check_shape_batch(40);
+	}
+	SUBCASE("Batch split into tasks") {
+		check_shape_batch(200);
+	}
+}
+
+TEST_CASE("[Physics3D][GodotPhysics3D] Batched queries reject invalid arguments") {
+	SphereGrid grid;
+	PhysicsDirectSpaceState3D *direct_state = grid.get_direct_state();
+
+	Ref<PhysicsRayQueryParameters3D> ray_query;
+	ray_query.instantiate();
+	Ref<PhysicsShapeQueryParameters3D> shape_query;
+	shape_query.instantiate();
+	shape_query->set_shape_rid(grid.query_shape);
+	const PackedVector3Array points = { Vector3(0, 5, 0), Vector3(2, 5, 0) };
+
+	ERR_PRINT_OFF;
+	const Dictionary mismatched = direct_state->call("intersect_rays_batch", ray_query, points, PackedVector3Array{ Vector3(0, -5, 0) });
+	const Dictionary too_many_results = direct_state->call("intersect_shapes_batch", shape_query, points, INT32_MAX);
+	const Dictionary no_results = direct_state->call("intersect_shapes_batch", shape_query, points, 0);
+	ERR_PRINT_ON;
+
+	CHECK_MESSAGE(mismatched.is_empty(), "The from and to arrays should be required to have the same size.");
+	CHECK_MESSAGE(too_many_results.is_empty(), "Result counts overflowing the result buffer should be rejected.");
+	CHECK_MESSAGE(no_results.is_empty(), "The maximum number of results should be positive.");
+}
+
+} // namespace TestSpaceQueries3D
@@ -0,0 +1,147 @@
+/**************************************************************************/
+/*  test_step_3d.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_broad_phase_3d_bvh.h"
+#include "../godot_physics_server_3d.h"
+#include "../godot_space_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStep3D {
+
+static constexpr real_t STEP = 1.0 / 60.0;
+static constexpr int STEP_COUNT = 60;
+static constexpr int GRID_SIZE = 7;
+
+// Spheres thrown at each other above a static floor. With 343 bodies, integration runs on the
+// WorkerThreadPool and every body is a changed broadphase item on the first steps.
+class SphereScene {
+	GodotPhysicsServer3D *server = nullptr;
+	RID space;
+	RID floor_shape;
+	RID sphere_shape;
+	RID floor;
+	LocalVector<RID> spheres;
+
+public:
+	LocalVector<int> collision_pairs;
+
+	void simulate() {
+		for (int i = 0; i < STEP_COUNT; i++) {
+			server->step(STEP);
+			collision_pairs.push_back(server->get_process_info(PhysicsServer3D::INFO_COLLISION_PAIRS));
+		}
+	}
+
+	uint32_t get_sphere_count() const {
+		return spheres.size();
+	}
+
+	Transform3D get_sphere_transform(uint32_t p_index) const {
+		return server->body_get_state(spheres[p_index], PhysicsServer3D::BODY_STATE_TRANSFORM);
+	}
+
+	explicit SphereScene(bool p_parallel_pair_checks) {
+		server = memnew(GodotPhysicsServer3D);
+		server->init();
+
+		space = server->space_create();
+		server->space_set_active(space, true);
+		GodotPhysicsDirectSpaceState3D *direct_state = static_cast<GodotPhysicsDirectSpaceState3D *>(server->space_get_direct_state(space));
+		static_cast<GodotBroadPhase3DBVH *>(direct_state->space->get_broadphase())->set_parallel_pair_checks(p_parallel_pair_checks);
+
+		floor_shape = server->box_shape_create();
+		server->shape_set_data(floor_shape, Vector3(100, 1, 100));
+		sphere_shape = server->sphere_shape_create();
+		server->shape_set_data(sphere_shape, 0.5);
+
+		// The top of the floor is at y = 0.
+		floor = server->body_create();
+		server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+		server->body_add_shape(floor, floor_shape);
+		server->body_set_space(floor, space);
+		server->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -1, 0)));
+
+		const Vector3 center = Vector3(GRID_SIZE - 1, GRID_SIZE - 1, GRID_SIZE - 1) * 0.6 + Vector3(0, 0.5, 0);
+		for (int x = 0; x < GRID_SIZE; x++) {
+			for (int y = 0; y < GRID_SIZE; y++) {
+				for (int z = 0; z < GRID_SIZE; z++) {
+					const Vector3 position = Vector3(x * 1.2, y * 1.2 + 0.5, z * 1.2);
+					RID sphere = server->body_create();
+					server->body_set_mode(sphere, PhysicsServer3D::BODY_MODE_RIGID);
+					server->body_add_shape(sphere, sphere_shape);
+					server->body_set_space(sphere, space);
+					server->body_set_state(sphere, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), position));
+					server->body_set_state(sphere, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, (center - position) * 2.0);
+					server->body_set_state(sphere, PhysicsServer3D::BODY_STATE_CAN_SLEEP, false);
+					spheres.push_back(sphere);
+				}
+			}
+		}
+	}
+
+	~SphereScene() {
+		for (const RID &sphere : spheres) {
+			server->free_rid(sphere);
+		}
+		server->free_rid(floor);
+		server->free_rid(sphere_shape);
+		server->free_rid(floor_shape);
+		server->free_rid(space);
+
+		server->finish();
+		memdelete(server);
+	}
+};
+
+TEST_CASE("[Physics3D][GodotPhysics3D] Parallel pair checks don't change simulation results") {
+	SphereScene serial(false);
+	SphereScene parallel(true);
+
+	serial.simulate();
+	parallel.simulate();
+
+	int max_collision_pairs = 0;
+	for (int i = 0; i < STEP_COUNT; i++) {
+		CHECK_MESSAGE(parallel.collision_pairs[i] == serial.collision_pairs[i], vformat("Step %d should have %d collision pairs, not %d.", i, serial.collision_pairs[i], parallel.collision_pairs[i]));
+		max_collision_pairs = MAX(max_collision_pairs, serial.collision_pairs[i]);
+	}
+	CHECK_MESSAGE(max_collision_pairs > 0, "The spheres should collide with each other.");
+
+	for (uint32_t i = 0; i < serial.get_sphere_count(); i++) {
+		const Transform3D expected = serial.get_sphere_transform(i);
+		const Transform3D transform = parallel.get_sphere_transform(i);
+		CHECK_MESSAGE(transform == expected, vformat("Sphere %d should end at %s, not %s.", i, expected, transform));
+	}
+}
+
+} // namespace TestStep3D
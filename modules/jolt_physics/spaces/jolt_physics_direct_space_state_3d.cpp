@@ -44,6 +44,8 @@
 #include "jolt_query_filter_3d.h"
 #include "jolt_space_3d.h"
 
+#include "core/object/worker_thread_pool.h"
+
 #include <Jolt/Geometry/GJKClosestPoint.h>
 #include <Jolt/Physics/Body/Body.h>
 #include <Jolt/Physics/Body/BodyFilter.h>
@@ -55,6 +57,14 @@
 #include <Jolt/Physics/Collision/Shape/MeshShape.h>
 #include <Jolt/Physics/PhysicsSystem.h>
 
+namespace {
+
+// Batches smaller than this are queried on the calling thread.
+constexpr int PARALLEL_QUERY_MIN_COUNT = 64;
+constexpr int QUERY_BATCH_CHUNK_SIZE = 32;
+
+} // namespace
+
 bool JoltPhysicsDirectSpaceState3D::_cast_motion_impl(const JPH::Shape &p_jolt_shape, const Transform3D &p_transform_com, const Vector3 &p_scale, const Vector3 &p_motion, bool p_use_edge_removal, bool p_ignore_overlaps, const JPH::CollideShapeSettings &p_settings, const JPH::BroadPhaseLayerFilter &p_broad_phase_layer_filter, const JPH::ObjectLayerFilter &p_object_layer_filter, const JPH::BodyFilter &p_body_filter, const JPH::ShapeFilter &p_shape_filter, real_t &r_closest_safe, real_t &r_closest_unsafe) const {
 	r_closest_safe = 1.0f;
 	r_closest_unsafe = 1.0f;
@@ -444,15 +454,34 @@ void JoltPhysicsDirectSpaceState3D::_collide_shape_motion(
 	}
 }
 
-JoltPhysicsDirectSpaceState3D::JoltPhysicsDirectSpaceState3D(JoltSpace3D *p_space) :
-		space(p_space) {
+void JoltPhysicsDirectSpaceState3D::_intersect_ray_chunk(uint32_t p_chunk_index, RayBatch *p_batch) {
+	RayParameters parameters = *p_batch->parameters;
+	const int begin = (int)p_chunk_index * QUERY_BATCH_CHUNK_SIZE;
+	const int end = MIN(begin + QUERY_BATCH_CHUNK_SIZE, p_batch->count);
+
+	for (int i = begin; i < end; ++i) {
+		parameters.from = p_batch->from[i];
+		parameters.to = p_batch->to[i];
+		p_batch->hits[i] = _intersect_ray_impl(parameters, p_batch->results[i]);
+	}
 }
 
-bool JoltPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_ray must not be called while the physics space is being stepped.");
+void JoltPhysicsDirectSpaceState3D::_intersect_shape_chunk(uint32_t p_chunk_index, ShapeBatch *p_batch) {
+	ShapeParameters parameters = *p_batch->parameters;
+	const int begin = (int)p_chunk_index * QUERY_BATCH_CHUNK_SIZE;
+	const int end = MIN(begin + QUERY_BATCH_CHUNK_SIZE, p_batch->count);
 
-	space->flush_pending_objects();
+	for (int i = begin; i < end; ++i) {
+		parameters.transform = p_batch->transforms[i];
+		p_batch->result_counts[i] = _intersect_shape_impl(parameters, p_batch->jolt_shape, p_batch->results + i * p_batch->result_max, p_batch->result_max);
+	}
+}
+
+JoltPhysicsDirectSpaceState3D::JoltPhysicsDirectSpaceState3D(JoltSpace3D *p_space) :
+		space(p_space) {
+}
 
+bool JoltPhysicsDirectSpaceState3D::_intersect_ray_impl(const RayParameters &p_parameters, RayResult &r_result) {
 	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude, p_parameters.pick_ray);
 
 	const JPH::RVec3 from = to_jolt_r(p_parameters.from);
@@ -511,6 +540,40 @@ bool JoltPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_paramet
 	return true;
 }
 
+bool JoltPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_ray must not be called while the physics space is being stepped.");
+
+	space->flush_pending_objects();
+
+	return _intersect_ray_impl(p_parameters, r_result);
+}
+
+void JoltPhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND_MSG(space->is_stepping(), "intersect_rays must not be called while the physics space is being stepped.");
+
+	space->flush_pending_objects();
+
+	RayBatch batch;
+	batch.parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.results = r_results;
+	batch.hits = r_hits;
+	batch.count = p_count;
+
+	const uint32_t chunk_count = (p_count + QUERY_BATCH_CHUNK_SIZE - 1) / QUERY_BATCH_CHUNK_SIZE;
+
+	if (p_count < PARALLEL_QUERY_MIN_COUNT) {
+		for (uint32_t i = 0; i < chunk_count; ++i) {
+			_intersect_ray_chunk(i, &batch);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &JoltPhysicsDirectSpaceState3D::_intersect_ray_chunk, &batch, chunk_count, -1, true, SNAME("JoltIntersectRays"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 int JoltPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_point must not be called while the physics space is being stepped.");
 
@@ -549,29 +612,15 @@ int JoltPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_para
 	return hit_count;
 }
 
-int JoltPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
-	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_shape must not be called while the physics space is being stepped.");
-
-	if (p_result_max == 0) {
-		return 0;
-	}
-
-	space->flush_pending_objects();
-
-	JoltShape3D *shape = JoltPhysicsServer3D::get_singleton()->get_shape(p_parameters.shape_rid);
-	ERR_FAIL_NULL_V(shape, 0);
-
-	const JPH::ShapeRefC jolt_shape = shape->try_build();
-	ERR_FAIL_NULL_V(jolt_shape, 0);
-
+int JoltPhysicsDirectSpaceState3D::_intersect_shape_impl(const ShapeParameters &p_parameters, const JPH::Shape *p_jolt_shape, ShapeResult *r_results, int p_result_max) {
 	Transform3D transform = p_parameters.transform;
 	JOLT_ENSURE_SCALE_NOT_ZERO(transform, "intersect_shape was passed an invalid transform.");
 
 	Vector3 scale;
 	JoltMath::decompose(transform, scale);
-	JOLT_ENSURE_SCALE_VALID(jolt_shape, scale, "intersect_shape was passed an invalid transform.");
+	JOLT_ENSURE_SCALE_VALID(p_jolt_shape, scale, "intersect_shape was passed an invalid transform.");
 
-	const Vector3 com_scaled = to_godot(jolt_shape->GetCenterOfMass());
+	const Vector3 com_scaled = to_godot(p_jolt_shape->GetCenterOfMass());
 	const Transform3D transform_com = transform.translated_local(com_scaled);
 
 	JPH::CollideShapeSettings settings;
@@ -579,7 +628,7 @@ int JoltPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_para
 
 	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude);
 	JoltQueryCollectorAnyMulti<JPH::CollideShapeCollector, 32> collector(p_result_max);
-	_collide_shape_queries(jolt_shape, to_jolt(scale), to_jolt_r(transform_com), settings, to_jolt_r(transform_com.origin), collector, query_filter, query_filter, query_filter);
+	_collide_shape_queries(p_jolt_shape, to_jolt(scale), to_jolt_r(transform_com), settings, to_jolt_r(transform_com.origin), collector, query_filter, query_filter, query_filter);
 
 	const int hit_count = collector.get_hit_count();
 
@@ -606,6 +655,65 @@ int JoltPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_para
 	return hit_count;
 }
 
+int JoltPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
+	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_shape must not be called while the physics space is being stepped.");
+
+	if (p_result_max == 0) {
+		return 0;
+	}
+
+	space->flush_pending_objects();
+
+	JoltShape3D *shape = JoltPhysicsServer3D::get_singleton()->get_shape(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, 0);
+
+	const JPH::ShapeRefC jolt_shape = shape->try_build();
+	ERR_FAIL_NULL_V(jolt_shape, 0);
+
+	return _intersect_shape_impl(p_parameters, jolt_shape, r_results, p_result_max);
+}
+
+void JoltPhysicsDirectSpaceState3D::intersect_shapes(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) {
+	ERR_FAIL_COND_MSG(space->is_stepping(), "intersect_shapes must not be called while the physics space is being stepped.");
+
+	if (p_result_max <= 0) {
+		for (int i = 0; i < p_count; ++i) {
+			r_result_counts[i] = 0;
+		}
+		return;
+	}
+
+	space->flush_pending_objects();
+
+	JoltShape3D *shape = JoltPhysicsServer3D::get_singleton()->get_shape(p_parameters.shape_rid);
+	ERR_FAIL_NULL(shape);
+
+	// Building the shape isn't thread-safe, so it's done once here for the whole batch.
+	const JPH::ShapeRefC jolt_shape = shape->try_build();
+	ERR_FAIL_NULL(jolt_shape);
+
+	ShapeBatch batch;
+	batch.parameters = &p_parameters;
+	batch.jolt_shape = jolt_shape;
+	batch.transforms = p_transforms;
+	batch.results = r_results;
+	batch.result_max = p_result_max;
+	batch.result_counts = r_result_counts;
+	batch.count = p_count;
+
+	const uint32_t chunk_count = (p_count + QUERY_BATCH_CHUNK_SIZE - 1) / QUERY_BATCH_CHUNK_SIZE;
+
+	if (p_count < PARALLEL_QUERY_MIN_COUNT) {
+		for (uint32_t i = 0; i < chunk_count; ++i) {
+			_intersect_shape_chunk(i, &batch);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &JoltPhysicsDirectSpaceState3D::_intersect_shape_chunk, &batch, chunk_count, -1, true, SNAME("JoltIntersectShapes"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 bool JoltPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &r_closest_safe, real_t &r_closest_unsafe, ShapeRestInfo *r_info) {
 	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "cast_motion must not be called while the physics space is being stepped.");
 	ERR_FAIL_COND_V_MSG(r_info != nullptr, false, "Providing rest info as part of cast_motion is not supported when using Jolt Physics.");
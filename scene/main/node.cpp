@@ -1459,6 +1459,7 @@ void Node::set_name(const StringName &p_name) {
 		data.parent->_validate_child_name(this, true);
 		bool success = data.parent->data.children.replace_key(old_name, data.name);
 		ERR_FAIL_COND_MSG(!success, "Renaming child in hashtable failed, this is a bug.");
+		data.parent->_bump_subtree_version();
 	}
 
 	if (data.unique_name_in_owner && data.owner) {
@@ -1524,6 +1525,12 @@ String Node::adjust_name_casing(const String &p_name) {
 	return p_name;
 }
 
+void Node::_bump_subtree_version() {
+	for (Node *node = this; node; node = node->data.parent) {
+		node->data.subtree_version++;
+	}
+}
+
 void Node::_validate_child_name(Node *p_child, bool p_force_human_readable) {
 	/* Make sure the name is unique */
 
@@ -1666,6 +1673,7 @@ void Node::_add_child_nocheck(Node *p_child, const StringName &p_name, InternalM
 
 	p_child->data.name = p_name;
 	data.children.insert(p_name, p_child);
+	_bump_subtree_version();
 
 	p_child->data.internal_mode = p_internal_mode;
 
@@ -1771,6 +1779,7 @@ void Node::remove_child(RequiredParam<Node> rp_child) {
 	data.children_cache_dirty = true;
 	bool success = data.children.erase(p_child->data.name);
 	ERR_FAIL_COND_MSG(!success, "Children name does not match parent name in hashtable, this is a bug.");
+	_bump_subtree_version();
 
 	p_child->data.parent = nullptr;
 	p_child->data.index = -1;
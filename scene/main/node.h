@@ -204,6 +204,8 @@ private:
 		Node *parent = nullptr;
 		Node *owner = nullptr;
 		HashMap<StringName, Node *> children;
+		// Bumped whenever a child is added, removed or renamed anywhere below this node.
+		uint64_t subtree_version = 0;
 		mutable bool children_cache_dirty = false;
 		mutable LocalVector<Node *> children_cache;
 		HashMap<StringName, Node *> owned_unique_nodes;
@@ -306,6 +308,7 @@ private:
 	void _replace_connections_target(Node *p_new_target);
 
 	void _validate_child_name(Node *p_child, bool p_force_human_readable = false);
+	void _bump_subtree_version();
 	void _generate_serial_child_name(const Node *p_child, StringName &name) const;
 
 	void _propagate_enter_tree();
@@ -539,6 +542,8 @@ public:
 	bool has_node(const NodePath &p_path) const;
 	Node *get_node(const NodePath &p_path) const;
 	Node *get_node_or_null(const NodePath &p_path) const;
+	// Relative paths without `..` or unique names resolve the same while this is unchanged.
+	_FORCE_INLINE_ uint64_t get_subtree_version() const { return data.subtree_version; }
 	Node *find_child(const String &p_pattern, bool p_recursive = true, bool p_owned = true) const;
 	TypedArray<Node> find_children(const String &p_pattern, const String &p_type = "", bool p_recursive = true, bool p_owned = true) const;
 	bool has_node_and_resource(const NodePath &p_path) const;
@@ -482,6 +482,152 @@ Dictionary PhysicsDirectSpaceState3D::_get_rest_info(RequiredParam<PhysicsShapeQ
 	return r;
 }
 
+Dictionary PhysicsDirectSpaceState3D::_intersect_rays_batch(RequiredParam<PhysicsRayQueryParameters3D> rp_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to) {
+	EXTRACT_PARAM_OR_FAIL_V(p_ray_query, rp_ray_query, Dictionary());
+	ERR_FAIL_COND_V_MSG(p_from.size() != p_to.size(), Dictionary(), "The from and to arrays must have the same size.");
+
+	const int count = p_from.size();
+
+	Vector<RayResult> results;
+	ERR_FAIL_COND_V(results.resize(count) != OK, Dictionary());
+	Vector<bool> hits;
+	ERR_FAIL_COND_V(hits.resize_initialized(count) != OK, Dictionary());
+	intersect_rays(p_ray_query->get_parameters(), p_from.ptr(), p_to.ptr(), count, results.ptrw(), hits.ptrw());
+
+	PackedByteArray hit;
+	hit.resize(count);
+	PackedVector3Array position;
+	position.resize(count);
+	PackedVector3Array normal;
+	normal.resize(count);
+	PackedInt32Array face_index;
+	face_index.resize(count);
+	PackedInt64Array collider_id;
+	collider_id.resize(count);
+	PackedInt32Array shape;
+	shape.resize(count);
+	TypedArray<RID> rid;
+	rid.resize(count);
+
+	uint8_t *hit_ptr = hit.ptrw();
+	Vector3 *position_ptr = position.ptrw();
+	Vector3 *normal_ptr = normal.ptrw();
+	int32_t *face_index_ptr = face_index.ptrw();
+	int64_t *collider_id_ptr = collider_id.ptrw();
+	int32_t *shape_ptr = shape.ptrw();
+
+	for (int i = 0; i < count; i++) {
+		const RayResult &result = results[i];
+		if (!hits[i]) {
+			hit_ptr[i] = 0;
+			position_ptr[i] = Vector3();
+			normal_ptr[i] = Vector3();
+			face_index_ptr[i] = -1;
+			collider_id_ptr[i] = 0;
+			shape_ptr[i] = -1;
+			rid[i] = RID();
+			continue;
+		}
+
+		hit_ptr[i] = 1;
+		position_ptr[i] = result.position;
+		normal_ptr[i] = result.normal;
+		face_index_ptr[i] = result.face_index;
+		collider_id_ptr[i] = (int64_t)result.collider_id;
+		shape_ptr[i] = result.shape;
+		rid[i] = result.rid;
+	}
+
+	Dictionary d;
+	d["hit"] = hit;
+	d["position"] = position;
+	d["normal"] = normal;
+	d["face_index"] = face_index;
+	d["collider_id"] = collider_id;
+	d["shape"] = shape;
+	d["rid"] = rid;
+
+	return d;
+}
+
+Dictionary PhysicsDirectSpaceState3D::_intersect_shapes_batch(RequiredParam<PhysicsShapeQueryParameters3D> rp_shape_query, const PackedVector3Array &p_positions, int p_max_results) {
+	EXTRACT_PARAM_OR_FAIL_V(p_shape_query, rp_shape_query, Dictionary());
+	ERR_FAIL_COND_V(p_max_results <= 0, Dictionary());
+
+	const ShapeParameters &parameters = p_shape_query->get_parameters();
+	const int count = p_positions.size();
+
+	// Every query has room for p_max_results, the results are indexed with int.
+	const int64_t result_capacity = int64_t(count) * int64_t(p_max_results);
+	ERR_FAIL_COND_V_MSG(result_capacity > INT32_MAX, Dictionary(), vformat("Too many results for %d queries of at most %d results.", count, p_max_results));
+
+	// The shape keeps the orientation of the query, only its position changes.
+	Vector<Transform3D> transforms;
+	ERR_FAIL_COND_V(transforms.resize(count) != OK, Dictionary());
+	Transform3D *transforms_ptr = transforms.ptrw();
+	for (int i = 0; i < count; i++) {
+		transforms_ptr[i] = Transform3D(parameters.transform.basis, p_positions[i]);
+	}
+
+	Vector<ShapeResult> results;
+	ERR_FAIL_COND_V(results.resize(result_capacity) != OK, Dictionary());
+	PackedInt32Array result_count;
+	ERR_FAIL_COND_V(result_count.resize_initialized(count) != OK, Dictionary());
+	intersect_shapes(parameters, transforms.ptr(), count, results.ptrw(), p_max_results, result_count.ptrw());
+
+	int total_count = 0;
+	for (int i = 0; i < count; i++) {
+		total_count += result_count[i];
+	}
+
+	PackedInt64Array collider_id;
+	collider_id.resize(total_count);
+	PackedInt32Array shape;
+	shape.resize(total_count);
+	TypedArray<RID> rid;
+	rid.resize(total_count);
+
+	int64_t *collider_id_ptr = collider_id.ptrw();
+	int32_t *shape_ptr = shape.ptrw();
+
+	// Results are packed one query after the other.
+	int index = 0;
+	for (int i = 0; i < count; i++) {
+		const ShapeResult *query_results = results.ptr() + i * p_max_results;
+		for (int j = 0; j < result_count[i]; j++) {
+			collider_id_ptr[index] = (int64_t)query_results[j].collider_id;
+			shape_ptr[index] = query_results[j].shape;
+			rid[index] = query_results[j].rid;
+			index++;
+		}
+	}
+
+	Dictionary d;
+	d["count"] = result_count;
+	d["collider_id"] = collider_id;
+	d["shape"] = shape;
+	d["rid"] = rid;
+
+	return d;
+}
+
+void PhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	RayParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.from = p_from[i];
+		parameters.to = p_to[i];
+		r_hits[i] = intersect_ray(parameters, r_results[i]);
+	}
+}
+
+void PhysicsDirectSpaceState3D::intersect_shapes(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) {
+	ShapeParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.transform = p_transforms[i];
+		r_result_counts[i] = intersect_shape(parameters, r_results + i * p_result_max, p_result_max);
+	}
+}
+
 PhysicsDirectSpaceState3D::PhysicsDirectSpaceState3D() {
 }
 
@@ -492,6 +638,8 @@ void PhysicsDirectSpaceState3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState3D::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_collide_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("get_rest_info", "parameters"), &PhysicsDirectSpaceState3D::_get_rest_info);
+	ClassDB::bind_method(D_METHOD("intersect_rays_batch", "parameters", "from", "to"), &PhysicsDirectSpaceState3D::_intersect_rays_batch);
+	ClassDB::bind_method(D_METHOD("intersect_shapes_batch", "parameters", "positions", "max_results"), &PhysicsDirectSpaceState3D::_intersect_shapes_batch, DEFVAL(32));
 }
 
 ///////////////////////////////
@@ -1124,6 +1272,7 @@ void PhysicsServer3D::_bind_methods() {
 	BIND_ENUM_CONSTANT(SPACE_PARAM_BODY_ANGULAR_VELOCITY_SLEEP_THRESHOLD);
 	BIND_ENUM_CONSTANT(SPACE_PARAM_BODY_TIME_TO_SLEEP);
 	BIND_ENUM_CONSTANT(SPACE_PARAM_SOLVER_ITERATIONS);
+	BIND_ENUM_CONSTANT(SPACE_PARAM_SOLVER_BATCHED_CONTACTS);
 
 	BIND_ENUM_CONSTANT(BODY_AXIS_LINEAR_X);
 	BIND_ENUM_CONSTANT(BODY_AXIS_LINEAR_Y);
@@ -1149,6 +1298,7 @@ PhysicsServer3D::PhysicsServer3D() {
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/sleep_threshold_angular", PROPERTY_HINT_RANGE, "0,90,0.1,radians_as_degrees"), Math::deg_to_rad(8.0));
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/time_before_sleep", PROPERTY_HINT_RANGE, "0,5,0.01,or_greater"), 0.5);
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "physics/3d/solver/solver_iterations", PROPERTY_HINT_RANGE, "1,32,1,or_greater"), 16);
+	GLOBAL_DEF("physics/3d/solver/batched_contacts", false);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_recycle_radius", PROPERTY_HINT_RANGE, "0,0.1,0.001,or_greater"), 0.01);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_separation", PROPERTY_HINT_RANGE, "0,0.1,0.001,or_greater"), 0.05);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_allowed_penetration", PROPERTY_HINT_RANGE, "0.001,0.1,0.001,or_greater"), 0.01);
@@ -35,6 +35,7 @@
 #include "core/math/geometry_3d.h"
 #include "core/object/callable_mp.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/templates/frame_arena.h"
 #include "servers/rendering/rendering_light_culler.h"
 #include "servers/rendering/rendering_server.h"
 #include "servers/rendering/rendering_server_default.h"
@@ -2365,6 +2366,9 @@ void RendererSceneCull::_light_instance_setup_directional_shadow(int p_shadow_in
 }
 
 bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, const Transform3D p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario, float p_screen_mesh_lod_threshold, uint32_t p_visible_layers) {
+	// Gives back the cull temporaries of each light, as many lights are updated per frame.
+	FrameArena::Scope frame_arena_scope;
+
 	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
 
 	Transform3D light_transform = p_instance->transform;
@@ -2389,18 +2393,19 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 					real_t radius = RSG::light_storage->light_get_param(p_instance->base, RSE::LIGHT_PARAM_RANGE);
 
 					real_t z = i == 0 ? -1 : 1;
-					Vector<Plane> planes;
+					FrameLocalVector<Plane> planes;
 					planes.resize(6);
-					planes.write[0] = light_transform.xform(Plane(Vector3(0, 0, z), radius));
-					planes.write[1] = light_transform.xform(Plane(Vector3(1, 0, z).normalized(), radius));
-					planes.write[2] = light_transform.xform(Plane(Vector3(-1, 0, z).normalized(), radius));
-					planes.write[3] = light_transform.xform(Plane(Vector3(0, 1, z).normalized(), radius));
-					planes.write[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
-					planes.write[5] = light_transform.xform(Plane(Vector3(0, 0, -z), 0));
+					planes[0] = light_transform.xform(Plane(Vector3(0, 0, z), radius));
+					planes[1] = light_transform.xform(Plane(Vector3(1, 0, z).normalized(), radius));
+					planes[2] = light_transform.xform(Plane(Vector3(-1, 0, z).normalized(), radius));
+					planes[3] = light_transform.xform(Plane(Vector3(0, 1, z).normalized(), radius));
+					planes[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
+					planes[5] = light_transform.xform(Plane(Vector3(0, 0, -z), 0));
 
 					instance_shadow_cull_result.clear();
 
-					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
+					FrameLocalVector<Vector3> points;
+					Geometry3D::compute_convex_mesh_points(planes.ptr(), planes.size(), points);
 
 					struct CullConvex {
 						PagedArray<Instance *> *result;
@@ -2483,7 +2488,8 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 					instance_shadow_cull_result.clear();
 
-					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
+					FrameLocalVector<Vector3> points;
+					Geometry3D::compute_convex_mesh_points(planes.ptr(), planes.size(), points);
 
 					struct CullConvex {
 						PagedArray<Instance *> *result;
@@ -2551,7 +2557,8 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 			instance_shadow_cull_result.clear();
 
-			Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
+			FrameLocalVector<Vector3> points;
+			Geometry3D::compute_convex_mesh_points(planes.ptr(), planes.size(), points);
 
 			struct CullConvex {
 				PagedArray<Instance *> *result;
@@ -2606,18 +2613,19 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 			Vector2 half_size = RSG::light_storage->light_area_get_size(p_instance->base) / 2.0;
 
 			real_t z = -1;
-			Vector<Plane> planes;
+			FrameLocalVector<Plane> planes;
 			planes.resize(6);
-			planes.write[0] = light_transform.xform(Plane(Vector3(0, 0, z), radius));
-			planes.write[1] = light_transform.xform(Plane(Vector3(1, 0, 0).normalized(), radius + half_size.x));
-			planes.write[2] = light_transform.xform(Plane(Vector3(-1, 0, 0).normalized(), radius + half_size.x));
-			planes.write[3] = light_transform.xform(Plane(Vector3(0, 1, 0).normalized(), radius + half_size.y));
-			planes.write[4] = light_transform.xform(Plane(Vector3(0, -1, 0).normalized(), radius + half_size.y));
-			planes.write[5] = light_transform.xform(Plane(Vector3(0, 0, -z), 0));
+			planes[0] = light_transform.xform(Plane(Vector3(0, 0, z), radius));
+			planes[1] = light_transform.xform(Plane(Vector3(1, 0, 0).normalized(), radius + half_size.x));
+			planes[2] = light_transform.xform(Plane(Vector3(-1, 0, 0).normalized(), radius + half_size.x));
+			planes[3] = light_transform.xform(Plane(Vector3(0, 1, 0).normalized(), radius + half_size.y));
+			planes[4] = light_transform.xform(Plane(Vector3(0, -1, 0).normalized(), radius + half_size.y));
+			planes[5] = light_transform.xform(Plane(Vector3(0, 0, -z), 0));
 
 			instance_shadow_cull_result.clear();
 
-			Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
+			FrameLocalVector<Vector3> points;
+			Geometry3D::compute_convex_mesh_points(planes.ptr(), planes.size(), points);
 
 			struct CullConvex {
 				PagedArray<Instance *> *result;
@@ -3295,6 +3303,9 @@ void RendererSceneCull::_scene_particles_set_view_axis(RID p_particles, const Ve
 }
 
 void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_camera_data, const Ref<RenderSceneBuffers> &p_render_buffers, RID p_environment, RID p_force_camera_attributes, RID p_compositor, uint32_t p_visible_layers, RID p_scenario, RID p_viewport, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass, float p_screen_mesh_lod_threshold, float p_window_output_max_value, bool p_using_shadows, RenderingServerTypes::RenderInfo *r_render_info) {
+	// Rendering may happen on its own thread, out of sync with frames.
+	FrameArena::Scope frame_arena_scope;
+
 	Instance *render_reflection_probe = instance_owner.get_or_null(p_reflection_probe); //if null, not rendering to it
 
 	// Prepare the light - camera volume culling system.
@@ -3357,7 +3368,7 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 	{
 		cull.shadow_count = 0;
 
-		Vector<Instance *> lights_with_shadow;
+		FrameLocalVector<Instance *> lights_with_shadow;
 
 		for (Instance *E : scenario->directional_lights) {
 			if (!E->visible || !(E->layer_mask & p_visible_layers)) {
@@ -3383,7 +3394,7 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 
 		RSG::light_storage->set_directional_shadow_count(lights_with_shadow.size());
 
-		for (int i = 0; i < lights_with_shadow.size(); i++) {
+		for (uint32_t i = 0; i < lights_with_shadow.size(); i++) {
 			_light_instance_setup_directional_shadow(i, lights_with_shadow[i], p_camera_data->main_transform, p_camera_data->main_projection, p_camera_data->is_orthogonal, p_camera_data->vaspect);
 		}
 	}
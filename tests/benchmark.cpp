@@ -0,0 +1,345 @@
+/**************************************************************************/
+/*  benchmark.cpp                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "benchmark.h"
+
+#include "core/config/engine.h"
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/string/print_string.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/sort_array.h"
+
+struct BenchmarkCase {
+	String name;
+	BenchmarkFunc function = nullptr;
+};
+
+// Allocated on first use, benchmarks register themselves during static initialization.
+// Freed once the cases to run are picked, so it isn't reported as leaked.
+static LocalVector<BenchmarkCase> *benchmark_cases = nullptr;
+
+int register_benchmark(const char *p_name, BenchmarkFunc p_function) {
+	if (!benchmark_cases) {
+		benchmark_cases = memnew(LocalVector<BenchmarkCase>);
+	}
+	benchmark_cases->push_back({ String::utf8(p_name), p_function });
+	return 0;
+}
+
+class BenchmarkRunner {
+public:
+	struct Options {
+		String filter;
+		bool list = false;
+		int warmup = 2;
+		int repetitions = 10;
+		uint64_t min_time_usec = 20000;
+		String json_path;
+		String baseline_path;
+		double threshold = 10.0;
+	};
+
+	struct Result {
+		String name;
+		uint64_t iterations = 0;
+		uint64_t items_per_iteration = 0;
+		LocalVector<Pair<String, double>> counters;
+		int repetitions = 0;
+		double median_ns = 0.0;
+		double mean_ns = 0.0;
+		double min_ns = 0.0;
+		double max_ns = 0.0;
+		double stddev_ns = 0.0;
+	};
+
+private:
+	static constexpr uint64_t MAX_ITERATIONS = 1000000000;
+
+	static void _run_once(const BenchmarkCase &p_case, BenchmarkState &r_state, uint64_t p_iterations) {
+		r_state = BenchmarkState();
+		r_state.iterations = p_iterations;
+		p_case.function(r_state);
+		ERR_FAIL_COND_MSG(r_state.iteration != p_iterations, vformat("Benchmark \"%s\" stopped calling keep_running() early.", p_case.name));
+	}
+
+	static uint64_t _calibrate(const BenchmarkCase &p_case, const Options &p_options) {
+		uint64_t iterations = 1;
+		while (true) {
+			BenchmarkState state;
+			_run_once(p_case, state, iterations);
+			if (state.elapsed_usec >= p_options.min_time_usec || iterations >= MAX_ITERATIONS) {
+				return iterations;
+			}
+
+			// Aim a bit over the minimum time, but don't trust very short measurements too much.
+			double multiplier = 100.0;
+			if (state.elapsed_usec > 0) {
+				multiplier = MIN(multiplier, 1.4 * p_options.min_time_usec / state.elapsed_usec);
+			}
+			iterations = MIN(MAX(iterations + 1, (uint64_t)(iterations * multiplier)), MAX_ITERATIONS);
+		}
+	}
+
+	static String _format_time(double p_ns) {
+		if (p_ns < 1000.0) {
+			return vformat("%.2f ns", p_ns);
+		} else if (p_ns < 1000000.0) {
+			return vformat("%.2f us", p_ns / 1000.0);
+		} else if (p_ns < 1000000000.0) {
+			return vformat("%.2f ms", p_ns / 1000000.0);
+		}
+		return vformat("%.2f s", p_ns / 1000000000.0);
+	}
+
+public:
+	static Result run(const BenchmarkCase &p_case, const Options &p_options) {
+		Result result;
+		result.name = p_case.name;
+		result.iterations = _calibrate(p_case, p_options);
+		result.repetitions = p_options.repetitions;
+
+		for (int i = 0; i < p_options.warmup; i++) {
+			BenchmarkState state;
+			_run_once(p_case, state, result.iterations);
+		}
+
+		LocalVector<double> samples;
+		samples.resize(p_options.repetitions);
+		for (int i = 0; i < p_options.repetitions; i++) {
+			BenchmarkState state;
+			_run_once(p_case, state, result.iterations);
+			samples[i] = state.elapsed_usec * 1000.0 / result.iterations;
+			result.items_per_iteration = state.items_per_iteration;
+			result.counters = state.counters;
+		}
+
+		samples.sort();
+		const uint32_t count = samples.size();
+		result.min_ns = samples[0];
+		result.max_ns = samples[count - 1];
+		result.median_ns = count % 2 ? samples[count / 2] : (samples[count / 2 - 1] + samples[count / 2]) * 0.5;
+
+		for (double sample : samples) {
+			result.mean_ns += sample;
+		}
+		result.mean_ns /= count;
+
+		if (count > 1) {
+			double variance = 0.0;
+			for (double sample : samples) {
+				variance += (sample - result.mean_ns) * (sample - result.mean_ns);
+			}
+			result.stddev_ns = Math::sqrt(variance / (count - 1));
+		}
+
+		return result;
+	}
+
+	static void print_result(const Result &p_result) {
+		String line = vformat("%s: %s/iteration (mean %s, min %s, max %s, stddev %.1f%%), %d iterations x %d",
+				p_result.name, _format_time(p_result.median_ns), _format_time(p_result.mean_ns), _format_time(p_result.min_ns), _format_time(p_result.max_ns),
+				p_result.mean_ns > 0.0 ? p_result.stddev_ns / p_result.mean_ns * 100.0 : 0.0, p_result.iterations, p_result.repetitions);
+		if (p_result.items_per_iteration > 0 && p_result.median_ns > 0.0) {
+			line += vformat(", %.2f M items/s", p_result.items_per_iteration * 1000.0 / p_result.median_ns);
+		}
+		for (const Pair<String, double> &counter : p_result.counters) {
+			line += vformat(", %s %.2f", counter.first, counter.second);
+		}
+		print_line(line);
+	}
+
+	static Error save_json(const LocalVector<Result> &p_results, const String &p_path) {
+		Array benchmarks;
+		for (const Result &result : p_results) {
+			Dictionary benchmark;
+			benchmark["name"] = result.name;
+			benchmark["iterations"] = result.iterations;
+			benchmark["repetitions"] = result.repetitions;
+			benchmark["median_ns"] = result.median_ns;
+			benchmark["mean_ns"] = result.mean_ns;
+			benchmark["min_ns"] = result.min_ns;
+			benchmark["max_ns"] = result.max_ns;
+			benchmark["stddev_ns"] = result.stddev_ns;
+			if (result.items_per_iteration > 0 && result.median_ns > 0.0) {
+				benchmark["items_per_second"] = result.items_per_iteration * 1000000000.0 / result.median_ns;
+			}
+			if (!result.counters.is_empty()) {
+				Dictionary counters;
+				for (const Pair<String, double> &counter : result.counters) {
+					counters[counter.first] = counter.second;
+				}
+				benchmark["counters"] = counters;
+			}
+			benchmarks.push_back(benchmark);
+		}
+
+		Dictionary root;
+		root["engine_version"] = Engine::get_singleton()->get_version_info()["string"];
+#ifdef DEBUG_ENABLED
+		root["debug"] = true;
+#else
+		root["debug"] = false;
+#endif
+		root["benchmarks"] = benchmarks;
+
+		Error err;
+		Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+		ERR_FAIL_COND_V_MSG(f.is_null(), err, vformat("Cannot save benchmark results to \"%s\".", p_path));
+		f->store_string(JSON::stringify(root, "\t", false, true));
+		return OK;
+	}
+
+	// Returns the number of benchmarks that got slower than the threshold.
+	static int compare_with_baseline(const LocalVector<Result> &p_results, const String &p_path, double p_threshold) {
+		Error err;
+		const String json = FileAccess::get_file_as_string(p_path, &err);
+		ERR_FAIL_COND_V_MSG(err != OK, 0, vformat("Cannot open the benchmark baseline \"%s\".", p_path));
+		const Variant root = JSON::parse_string(json);
+		ERR_FAIL_COND_V_MSG(root.get_type() != Variant::DICTIONARY, 0, vformat("The benchmark baseline \"%s\" is invalid.", p_path));
+
+		HashMap<String, double> baseline;
+		const Array benchmarks = Dictionary(root).get("benchmarks", Array());
+		for (const Variant &benchmark : benchmarks) {
+			const Dictionary d = benchmark;
+			baseline[d.get("name", String())] = d.get("median_ns", 0.0);
+		}
+
+		print_line(vformat("\nComparison with \"%s\":", p_path));
+		int regressions = 0;
+		for (const Result &result : p_results) {
+			const double *base_ns = baseline.getptr(result.name);
+			if (!base_ns || *base_ns <= 0.0) {
+				print_line(vformat("%s: new", result.name));
+				continue;
+			}
+
+			const double change = (result.median_ns - *base_ns) / *base_ns * 100.0;
+			String status;
+			if (change > p_threshold) {
+				status = " REGRESSION";
+				regressions++;
+			} else if (change < -p_threshold) {
+				status = " improvement";
+			}
+			print_line(vformat("%s: %s -> %s (%+.1f%%)%s", result.name, _format_time(*base_ns), _format_time(result.median_ns), change, status));
+		}
+		return regressions;
+	}
+};
+
+static void print_benchmark_help() {
+	print_line("Usage: godot --test --benchmark [options]\n");
+	print_line("Options:");
+	print_line("  --benchmark-filter <wildcard>    Only run benchmarks with a matching name (case-insensitive).");
+	print_line("  --benchmark-list                 List benchmarks without running them.");
+	print_line("  --benchmark-warmup <count>       Untimed repetitions before measuring (default: 2).");
+	print_line("  --benchmark-repetitions <count>  Timed repetitions (default: 10).");
+	print_line("  --benchmark-min-time <msec>      Minimum duration of a repetition (default: 20).");
+	print_line("  --benchmark-json <path>          Save the results in JSON format.");
+	print_line("  --benchmark-baseline <path>      Compare with results saved by --benchmark-json, and exit with an");
+	print_line("                                   error if a benchmark got slower than the threshold.");
+	print_line("  --benchmark-threshold <percent>  Allowed slowdown against the baseline (default: 10).");
+}
+
+int run_benchmarks(const List<String> &p_args) {
+	BenchmarkRunner::Options options;
+
+	for (const List<String>::Element *E = p_args.front(); E; E = E->next()) {
+		const String &arg = E->get();
+		const String value = E->next() ? E->next()->get() : String();
+
+		if (arg == "--help" || arg == "-h") {
+			print_benchmark_help();
+			return EXIT_SUCCESS;
+		} else if (arg == "--benchmark-list") {
+			options.list = true;
+		} else if (arg == "--benchmark-filter") {
+			options.filter = value;
+		} else if (arg == "--benchmark-warmup") {
+			options.warmup = MAX(0, value.to_int());
+		} else if (arg == "--benchmark-repetitions") {
+			options.repetitions = MAX(1, value.to_int());
+		} else if (arg == "--benchmark-min-time") {
+			options.min_time_usec = MAX(1, value.to_int()) * 1000;
+		} else if (arg == "--benchmark-json") {
+			options.json_path = value;
+		} else if (arg == "--benchmark-baseline") {
+			options.baseline_path = value;
+		} else if (arg == "--benchmark-threshold") {
+			options.threshold = MAX(0.0, value.to_float());
+		}
+	}
+
+	LocalVector<BenchmarkCase> cases;
+	if (benchmark_cases) {
+		for (const BenchmarkCase &benchmark_case : *benchmark_cases) {
+			if (options.filter.is_empty() || benchmark_case.name.matchn(options.filter)) {
+				cases.push_back(benchmark_case);
+			}
+		}
+		memdelete(benchmark_cases);
+		benchmark_cases = nullptr;
+	}
+
+	struct NameSort {
+		bool operator()(const BenchmarkCase &p_a, const BenchmarkCase &p_b) const { return p_a.name < p_b.name; }
+	};
+	cases.sort_custom<NameSort>();
+
+	if (options.list) {
+		for (const BenchmarkCase &benchmark_case : cases) {
+			print_line(benchmark_case.name);
+		}
+		return EXIT_SUCCESS;
+	}
+
+	ERR_FAIL_COND_V_MSG(cases.is_empty(), EXIT_FAILURE, "No benchmarks to run.");
+
+	LocalVector<BenchmarkRunner::Result> results;
+	for (const BenchmarkCase &benchmark_case : cases) {
+		results.push_back(BenchmarkRunner::run(benchmark_case, options));
+		BenchmarkRunner::print_result(results[results.size() - 1]);
+	}
+
+	if (!options.json_path.is_empty()) {
+		BenchmarkRunner::save_json(results, options.json_path);
+	}
+
+	if (!options.baseline_path.is_empty()) {
+		const int regressions = BenchmarkRunner::compare_with_baseline(results, options.baseline_path, options.threshold);
+		if (regressions > 0) {
+			print_line(vformat("%d benchmarks got more than %.1f%% slower.", regressions, options.threshold));
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
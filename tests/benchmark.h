@@ -0,0 +1,147 @@
+/**************************************************************************/
+/*  benchmark.h                                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/os.h"
+#include "core/string/ustring.h"
+#include "core/templates/list.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
+
+// Benchmarks measure how long a piece of code takes to run. They live in
+// `tests/benchmarks/` (and `modules/*/tests/benchmark_*.h`), are registered
+// like test cases, and run with `godot --test --benchmark`, which accepts
+// these options:
+//
+//   --benchmark-filter <wildcard>   Only run benchmarks with a matching name.
+//   --benchmark-list                List benchmarks without running them.
+//   --benchmark-warmup <count>      Untimed repetitions before measuring (default: 2).
+//   --benchmark-repetitions <count> Timed repetitions (default: 10).
+//   --benchmark-min-time <msec>     Minimum duration of a repetition (default: 20).
+//   --benchmark-json <path>         Save the results in JSON format.
+//   --benchmark-baseline <path>     Compare with results saved by `--benchmark-json`, and exit
+//                                   with an error if a benchmark got slower than the threshold.
+//   --benchmark-threshold <percent> Allowed slowdown against the baseline (default: 10).
+//
+// The loop around `keep_running()` is the timed part, anything before it
+// is setup. The iteration count is calibrated so a repetition takes at
+// least the minimum time:
+//
+//   BENCHMARK_CASE("[HashMap] Insert 1000 integers") {
+//       while (p_state.keep_running()) {
+//           HashMap<int, int> map;
+//           for (int i = 0; i < 1000; i++) {
+//               map.insert(i, i);
+//           }
+//           BenchmarkState::do_not_optimize(map);
+//       }
+//       p_state.set_items_per_iteration(1000);
+//   }
+
+class BenchmarkState {
+	friend class BenchmarkRunner;
+
+	uint64_t iterations = 1;
+	uint64_t iteration = 0;
+	uint64_t items_per_iteration = 0;
+	LocalVector<Pair<String, double>> counters;
+
+	uint64_t begin_usec = 0;
+	uint64_t pause_begin_usec = 0;
+	uint64_t paused_usec = 0;
+	uint64_t elapsed_usec = 0;
+
+	static inline volatile const void *sink = nullptr;
+
+public:
+	_FORCE_INLINE_ bool keep_running() {
+		if (unlikely(iteration == 0)) {
+			begin_usec = OS::get_singleton()->get_ticks_usec();
+		}
+		if (likely(iteration < iterations)) {
+			iteration++;
+			return true;
+		}
+		elapsed_usec = OS::get_singleton()->get_ticks_usec() - begin_usec - paused_usec;
+		return false;
+	}
+
+	// Excludes per-iteration setup from the measurement.
+	void pause_timing() {
+		pause_begin_usec = OS::get_singleton()->get_ticks_usec();
+	}
+	void resume_timing() {
+		paused_usec += OS::get_singleton()->get_ticks_usec() - pause_begin_usec;
+	}
+
+	// Reports throughput as well, e.g. the number of elements processed by an iteration.
+	void set_items_per_iteration(uint64_t p_items) {
+		items_per_iteration = p_items;
+	}
+
+	// Reports an extra measurement along with the timings, e.g. memory used per item.
+	void set_counter(const String &p_name, double p_value) {
+		for (Pair<String, double> &counter : counters) {
+			if (counter.first == p_name) {
+				counter.second = p_value;
+				return;
+			}
+		}
+		counters.push_back(Pair<String, double>(p_name, p_value));
+	}
+
+	uint64_t get_iterations() const { return iterations; }
+
+	// Keeps the compiler from optimizing away a result that is never used.
+	template <typename T>
+	static _FORCE_INLINE_ void do_not_optimize(const T &p_value) {
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(p_value) : "memory");
+#else
+		sink = &p_value;
+#endif
+	}
+};
+
+typedef void (*BenchmarkFunc)(BenchmarkState &p_state);
+
+int register_benchmark(const char *p_name, BenchmarkFunc p_function);
+int run_benchmarks(const List<String> &p_args);
+
+#define _BENCHMARK_CAT_IMPL(m_a, m_b) m_a##m_b
+#define _BENCHMARK_CAT(m_a, m_b) _BENCHMARK_CAT_IMPL(m_a, m_b)
+
+#define _BENCHMARK_CASE_IMPL(m_name, m_function) \
+	static void m_function(BenchmarkState &p_state); \
+	[[maybe_unused]] static const int _BENCHMARK_CAT(m_function, _registered) = register_benchmark(m_name, &m_function); \
+	static void m_function(BenchmarkState &p_state)
+
+#define BENCHMARK_CASE(m_name) _BENCHMARK_CASE_IMPL(m_name, _BENCHMARK_CAT(_benchmark_function_, __COUNTER__))
@@ -0,0 +1,127 @@
+/**************************************************************************/
+/*  benchmark_image.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/benchmark.h"
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(benchmark_image)
+
+#include "core/io/image.h"
+
+namespace BenchmarkImage {
+
+static Ref<Image> make_gradient(int p_size, Image::Format p_format) {
+	Ref<Image> image = Image::create_empty(p_size, p_size, false, Image::FORMAT_RGBA8);
+	for (int y = 0; y < p_size; y++) {
+		for (int x = 0; x < p_size; x++) {
+			image->set_pixel(x, y, Color(float(x) / p_size, float(y) / p_size, 0.5, 1.0 - float(x) / p_size));
+		}
+	}
+	image->convert(p_format);
+	return image;
+}
+
+static void resize(BenchmarkState &p_state, Image::Interpolation p_interpolation) {
+	const Ref<Image> source = make_gradient(256, Image::FORMAT_RGBA8);
+
+	while (p_state.keep_running()) {
+		p_state.pause_timing();
+		Ref<Image> image = source->duplicate();
+		p_state.resume_timing();
+
+		image->resize(512, 512, p_interpolation);
+		BenchmarkState::do_not_optimize(image);
+	}
+	p_state.set_items_per_iteration(512 * 512);
+}
+
+BENCHMARK_CASE("[Image] Resize 256x256 to 512x512 (nearest)") {
+	resize(p_state, Image::INTERPOLATE_NEAREST);
+}
+
+BENCHMARK_CASE("[Image] Resize 256x256 to 512x512 (bilinear)") {
+	resize(p_state, Image::INTERPOLATE_BILINEAR);
+}
+
+BENCHMARK_CASE("[Image] Resize 256x256 to 512x512 (Lanczos)") {
+	resize(p_state, Image::INTERPOLATE_LANCZOS);
+}
+
+BENCHMARK_CASE("[Image] Convert 512x512 RGBA8 to RGBAF") {
+	const Ref<Image> source = make_gradient(512, Image::FORMAT_RGBA8);
+
+	while (p_state.keep_running()) {
+		p_state.pause_timing();
+		Ref<Image> image = source->duplicate();
+		p_state.resume_timing();
+
+		image->convert(Image::FORMAT_RGBAF);
+		BenchmarkState::do_not_optimize(image);
+	}
+	p_state.set_items_per_iteration(512 * 512);
+}
+
+BENCHMARK_CASE("[Image] Generate mipmaps for 512x512 RGBA8") {
+	const Ref<Image> source = make_gradient(512, Image::FORMAT_RGBA8);
+
+	while (p_state.keep_running()) {
+		p_state.pause_timing();
+		Ref<Image> image = source->duplicate();
+		p_state.resume_timing();
+
+		image->generate_mipmaps();
+		BenchmarkState::do_not_optimize(image);
+	}
+}
+
+BENCHMARK_CASE("[Image] Blend 256x256 onto 512x512 RGBA8") {
+	const Ref<Image> source = make_gradient(256, Image::FORMAT_RGBA8);
+	Ref<Image> destination = make_gradient(512, Image::FORMAT_RGBA8);
+
+	while (p_state.keep_running()) {
+		destination->blend_rect(source, Rect2i(0, 0, 256, 256), Point2i(128, 128));
+	}
+	p_state.set_items_per_iteration(256 * 256);
+}
+
+BENCHMARK_CASE("[Image] Get and set 256x256 pixels") {
+	Ref<Image> image = make_gradient(256, Image::FORMAT_RGBA8);
+
+	while (p_state.keep_running()) {
+		for (int y = 0; y < 256; y++) {
+			for (int x = 0; x < 256; x++) {
+				image->set_pixel(x, y, image->get_pixel(255 - x, y));
+			}
+		}
+	}
+	p_state.set_items_per_iteration(256 * 256);
+}
+
+} // namespace BenchmarkImage
@@ -0,0 +1,112 @@
+/**************************************************************************/
+/*  benchmark_message_queue.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/benchmark.h"
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(benchmark_message_queue)
+
+#include "core/object/callable_mp.h"
+#include "core/object/message_queue.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+
+namespace BenchmarkMessageQueue {
+
+static constexpr int TOTAL_MESSAGES = 1 << 16;
+
+static void receive(int p_producer, int p_sequence) {
+	BenchmarkState::do_not_optimize(p_sequence);
+}
+
+struct ProducerData {
+	CallQueue *queue = nullptr;
+	int index = 0;
+	int count = 0;
+};
+
+static void produce(void *p_userdata) {
+	ProducerData *data = (ProducerData *)p_userdata;
+	const Callable callable = callable_mp_static(&receive);
+	for (int i = 0; i < data->count; i++) {
+		data->queue->push_callable(callable, data->index, i);
+	}
+}
+
+// Pushes TOTAL_MESSAGES split across `p_producers` threads, then flushes them.
+static void push_and_flush(BenchmarkState &p_state, int p_producers, bool p_multi_producer) {
+	CallQueue queue(nullptr, 8192, String(), p_multi_producer);
+	LocalVector<Thread> threads;
+	LocalVector<ProducerData> data;
+	threads.resize(p_producers);
+	data.resize(p_producers);
+	for (int i = 0; i < p_producers; i++) {
+		data[i].queue = &queue;
+		data[i].index = i;
+		data[i].count = TOTAL_MESSAGES / p_producers;
+	}
+
+	while (p_state.keep_running()) {
+		for (int i = 0; i < p_producers; i++) {
+			threads[i].start(produce, &data[i]);
+		}
+		for (Thread &thread : threads) {
+			thread.wait_to_finish();
+		}
+		queue.flush();
+	}
+	p_state.set_items_per_iteration(TOTAL_MESSAGES);
+}
+
+BENCHMARK_CASE("[CallQueue] Shared buffer, 1 producer") {
+	push_and_flush(p_state, 1, false);
+}
+
+BENCHMARK_CASE("[CallQueue] Shared buffer, 8 producers") {
+	push_and_flush(p_state, 8, false);
+}
+
+BENCHMARK_CASE("[CallQueue] Shared buffer, 64 producers") {
+	push_and_flush(p_state, 64, false);
+}
+
+BENCHMARK_CASE("[CallQueue] Per-thread buffers, 1 producer") {
+	push_and_flush(p_state, 1, true);
+}
+
+BENCHMARK_CASE("[CallQueue] Per-thread buffers, 8 producers") {
+	push_and_flush(p_state, 8, true);
+}
+
+BENCHMARK_CASE("[CallQueue] Per-thread buffers, 64 producers") {
+	push_and_flush(p_state, 64, true);
+}
+
+} // namespace BenchmarkMessageQueue
@@ -0,0 +1,152 @@
+/**************************************************************************/
+/*  benchmark_object_db.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/benchmark.h"
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(benchmark_object_db)
+
+#include "core/object/object.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+
+namespace BenchmarkObjectDB {
+
+static constexpr int OBJECT_COUNT = 1000;
+
+BENCHMARK_CASE("[ObjectDB] Resolve 1000 IDs") {
+	LocalVector<Object *> objects;
+	LocalVector<ObjectID> ids;
+	for (int i = 0; i < OBJECT_COUNT; i++) {
+		objects.push_back(memnew(Object));
+		ids.push_back(objects[i]->get_instance_id());
+	}
+
+	while (p_state.keep_running()) {
+		for (const ObjectID &id : ids) {
+			BenchmarkState::do_not_optimize(ObjectDB::get_instance(id));
+		}
+	}
+	p_state.set_items_per_iteration(OBJECT_COUNT);
+
+	for (Object *object : objects) {
+		memdelete(object);
+	}
+}
+
+BENCHMARK_CASE("[ObjectDB] Create and free 1000 objects") {
+	LocalVector<Object *> objects;
+	objects.resize(OBJECT_COUNT);
+
+	while (p_state.keep_running()) {
+		for (int i = 0; i < OBJECT_COUNT; i++) {
+			objects[i] = memnew(Object);
+		}
+		for (int i = 0; i < OBJECT_COUNT; i++) {
+			memdelete(objects[i]);
+		}
+	}
+	p_state.set_items_per_iteration(OBJECT_COUNT);
+}
+
+struct ContentionData {
+	std::atomic<uint64_t> *published = nullptr;
+	int published_count = 0;
+	int iterations = 0;
+	SafeFlag *done = nullptr;
+};
+
+static void create_and_free(void *p_userdata) {
+	ContentionData *data = static_cast<ContentionData *>(p_userdata);
+	for (int i = 0; i < data->iterations; i++) {
+		Object *object = memnew(Object);
+		data->published[i % data->published_count].store(object->get_instance_id(), std::memory_order_relaxed);
+		memdelete(object);
+	}
+}
+
+static void resolve(void *p_userdata) {
+	ContentionData *data = static_cast<ContentionData *>(p_userdata);
+	while (!data->done->is_set()) {
+		for (int i = 0; i < data->published_count; i++) {
+			BenchmarkState::do_not_optimize(ObjectDB::get_instance(ObjectID(data->published[i].load(std::memory_order_relaxed))));
+		}
+	}
+}
+
+// Creates and frees objects on `p_creators` threads while `p_resolvers` threads resolve IDs.
+// Throughput is the number of objects created and freed.
+static void contention(BenchmarkState &p_state, int p_creators, int p_resolvers) {
+	static constexpr int ITERATIONS = 10000;
+	static constexpr int PUBLISHED_COUNT = 64;
+
+	while (p_state.keep_running()) {
+		std::atomic<uint64_t> published[PUBLISHED_COUNT] = {};
+		SafeFlag done;
+		LocalVector<Thread> threads;
+		LocalVector<ContentionData> data;
+		threads.resize(p_creators + p_resolvers);
+		data.resize(p_creators + p_resolvers);
+
+		for (int i = 0; i < p_creators + p_resolvers; i++) {
+			data[i].published = published;
+			data[i].published_count = PUBLISHED_COUNT;
+			data[i].iterations = ITERATIONS;
+			data[i].done = &done;
+			threads[i].start(i < p_creators ? create_and_free : resolve, &data[i]);
+		}
+		for (int i = 0; i < p_creators; i++) {
+			threads[i].wait_to_finish();
+		}
+		done.set();
+		for (int i = p_creators; i < p_creators + p_resolvers; i++) {
+			threads[i].wait_to_finish();
+		}
+	}
+	p_state.set_items_per_iteration(uint64_t(p_creators) * ITERATIONS);
+}
+
+BENCHMARK_CASE("[ObjectDB] Contention, 1 creator thread, 1 resolver thread") {
+	contention(p_state, 1, 1);
+}
+
+BENCHMARK_CASE("[ObjectDB] Contention, 4 creator threads, 0 resolver threads") {
+	contention(p_state, 4, 0);
+}
+
+BENCHMARK_CASE("[ObjectDB] Contention, 4 creator threads, 4 resolver threads") {
+	contention(p_state, 4, 4);
+}
+
+BENCHMARK_CASE("[ObjectDB] Contention, 8 creator threads, 8 resolver threads") {
+	contention(p_state, 8, 8);
+}
+
+} // namespace BenchmarkObjectDB
@@ -0,0 +1,88 @@
+/**************************************************************************/
+/*  benchmark_worker_thread_pool.cpp                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/benchmark.h"
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(benchmark_worker_thread_pool)
+
+#include "core/object/worker_thread_pool.h"
+
+namespace BenchmarkWorkerThreadPool {
+
+static SafeNumeric<uint32_t> nested_counter;
+
+static void nested_leaf(void *p_arg) {
+	nested_counter.increment();
+}
+
+static void nested_spawner(void *p_arg, uint32_t p_index) {
+	// Posted from a pool thread, so these go to its work queue and are stolen by the others.
+	const uint32_t leaves = (uint32_t)(uintptr_t)p_arg;
+	WorkerThreadPool::TaskID *ids = (WorkerThreadPool::TaskID *)alloca(sizeof(WorkerThreadPool::TaskID) * leaves);
+	for (uint32_t i = 0; i < leaves; i++) {
+		ids[i] = WorkerThreadPool::get_singleton()->add_native_task(nested_leaf, nullptr, true);
+	}
+	for (uint32_t i = 0; i < leaves; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(ids[i]);
+	}
+}
+
+// Every pool thread keeps posting and awaiting tiny tasks at once.
+BENCHMARK_CASE("[WorkerThreadPool] Nested tasks posted from pool threads") {
+	const uint32_t spawners = WorkerThreadPool::get_singleton()->get_thread_count() * 8;
+	const uint32_t leaves = 64;
+
+	while (p_state.keep_running()) {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(nested_spawner, (void *)(uintptr_t)leaves, spawners, -1, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	}
+	p_state.set_items_per_iteration(uint64_t(spawners) * leaves);
+	BenchmarkState::do_not_optimize(nested_counter.get());
+}
+
+static void empty_task(void *p_arg) {
+}
+
+BENCHMARK_CASE("[WorkerThreadPool] Post and wait for 1000 tasks from the main thread") {
+	WorkerThreadPool::TaskID ids[1000];
+
+	while (p_state.keep_running()) {
+		for (WorkerThreadPool::TaskID &id : ids) {
+			id = WorkerThreadPool::get_singleton()->add_native_task(empty_task, nullptr, true);
+		}
+		for (WorkerThreadPool::TaskID id : ids) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(id);
+		}
+	}
+	p_state.set_items_per_iteration(1000);
+}
+
+} // namespace BenchmarkWorkerThreadPool
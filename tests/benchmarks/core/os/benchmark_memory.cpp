@@ -0,0 +1,120 @@
+/**************************************************************************/
+/*  benchmark_memory.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/benchmark.h"
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(benchmark_memory)
+
+#include "core/os/memory.h"
+#include "core/os/small_object_allocator.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+
+namespace BenchmarkMemory {
+
+static constexpr int CHURN_ITERATIONS = 100000;
+
+struct ChurnData {
+	int iterations = 0;
+	uint32_t seed = 0;
+};
+
+// Mimics the churn of short-lived strings, arrays and callables.
+static void churn(void *p_userdata) {
+	ChurnData *data = (ChurnData *)p_userdata;
+	const int live_count = 256;
+	void *live[live_count] = {};
+	uint32_t state = data->seed;
+	for (int i = 0; i < data->iterations; i++) {
+		state = state * 1664525u + 1013904223u;
+		const int slot = (state >> 8) % live_count;
+		if (live[slot]) {
+			memfree(live[slot]);
+		}
+		live[slot] = memalloc(8 + (state >> 24) * 2); // Between 8 and 518 bytes.
+	}
+	for (void *mem : live) {
+		if (mem) {
+			memfree(mem);
+		}
+	}
+}
+
+// Runs the churn on `p_threads` threads at once. Throughput is the number of alloc/free pairs.
+static void churn_threads(BenchmarkState &p_state, int p_threads, bool p_small_object_allocator) {
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+	const bool was_enabled = SmallObjectAllocator::is_enabled();
+	SmallObjectAllocator::set_enabled(p_small_object_allocator);
+#endif
+
+	LocalVector<Thread> threads;
+	LocalVector<ChurnData> data;
+	threads.resize(p_threads);
+	data.resize(p_threads);
+	for (int i = 0; i < p_threads; i++) {
+		data[i].iterations = CHURN_ITERATIONS;
+		data[i].seed = i + 1;
+	}
+
+	while (p_state.keep_running()) {
+		for (int i = 0; i < p_threads; i++) {
+			threads[i].start(churn, &data[i]);
+		}
+		for (Thread &thread : threads) {
+			thread.wait_to_finish();
+		}
+	}
+	p_state.set_items_per_iteration(uint64_t(p_threads) * CHURN_ITERATIONS);
+
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+	SmallObjectAllocator::set_enabled(was_enabled);
+#endif
+}
+
+BENCHMARK_CASE("[Memory] Small allocation churn, system allocator, 1 thread") {
+	churn_threads(p_state, 1, false);
+}
+
+BENCHMARK_CASE("[Memory] Small allocation churn, system allocator, 8 threads") {
+	churn_threads(p_state, 8, false);
+}
+
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+BENCHMARK_CASE("[Memory] Small allocation churn, small object allocator, 1 thread") {
+	churn_threads(p_state, 1, true);
+}
+
+BENCHMARK_CASE("[Memory] Small allocation churn, small object allocator, 8 threads") {
+	churn_threads(p_state, 8, true);
+}
+#endif // SMALL_OBJECT_ALLOCATOR_ENABLED
+
+} // namespace BenchmarkMemory
@@ -0,0 +1,197 @@
+/**************************************************************************/
+/*  benchmark_string.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/benchmark.h"
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(benchmark_string)
+
+#include "core/os/thread.h"
+#include "core/string/string_builder.h"
+#include "core/string/string_name.h"
+#include "core/string/ustring.h"
+
+namespace BenchmarkString {
+
+static String make_text(int p_words) {
+	String text;
+	for (int i = 0; i < p_words; i++) {
+		text += "word" + itos(i) + " ";
+	}
+	return text;
+}
+
+BENCHMARK_CASE("[String] Append 1000 short strings") {
+	while (p_state.keep_running()) {
+		String text;
+		for (int i = 0; i < 1000; i++) {
+			text += "word ";
+		}
+		BenchmarkState::do_not_optimize(text);
+	}
+	p_state.set_items_per_iteration(1000);
+}
+
+BENCHMARK_CASE("[StringBuilder] Append 1000 short strings") {
+	while (p_state.keep_running()) {
+		StringBuilder builder;
+		for (int i = 0; i < 1000; i++) {
+			builder.append("word ");
+		}
+		String text = builder.as_string();
+		BenchmarkState::do_not_optimize(text);
+	}
+	p_state.set_items_per_iteration(1000);
+}
+
+BENCHMARK_CASE("[String] Find in a 1000 word text") {
+	const String text = make_text(1000);
+
+	while (p_state.keep_running()) {
+		int position = text.find("word999");
+		BenchmarkState::do_not_optimize(position);
+	}
+}
+
+BENCHMARK_CASE("[String] Split a 1000 word text") {
+	const String text = make_text(1000);
+
+	while (p_state.keep_running()) {
+		Vector<String> words = text.split(" ");
+		BenchmarkState::do_not_optimize(words);
+	}
+	p_state.set_items_per_iteration(1000);
+}
+
+BENCHMARK_CASE("[String] Format with vformat()") {
+	while (p_state.keep_running()) {
+		String text = vformat("%s: %d items at %.2f each", "benchmark", 42, 1.5);
+		BenchmarkState::do_not_optimize(text);
+	}
+}
+
+BENCHMARK_CASE("[String] UTF-8 round trip of a 1000 word text") {
+	const String text = make_text(1000) + U"ünïcödé テキスト";
+
+	while (p_state.keep_running()) {
+		CharString utf8 = text.utf8();
+		String decoded = String::utf8(utf8.get_data(), utf8.length());
+		BenchmarkState::do_not_optimize(decoded);
+	}
+}
+
+BENCHMARK_CASE("[String] Hash 1000 strings") {
+	LocalVector<String> strings;
+	for (int i = 0; i < 1000; i++) {
+		strings.push_back("string_benchmark_" + itos(i));
+	}
+
+	while (p_state.keep_running()) {
+		uint32_t hash = 0;
+		for (const String &string : strings) {
+			hash ^= string.hash();
+		}
+		BenchmarkState::do_not_optimize(hash);
+	}
+	p_state.set_items_per_iteration(strings.size());
+}
+
+BENCHMARK_CASE("[StringName] Create 1000 existing names") {
+	LocalVector<String> strings;
+	LocalVector<StringName> names;
+	for (int i = 0; i < 1000; i++) {
+		strings.push_back("string_name_benchmark_" + itos(i));
+		names.push_back(strings[i]);
+	}
+
+	while (p_state.keep_running()) {
+		for (const String &string : strings) {
+			StringName name = string;
+			BenchmarkState::do_not_optimize(name);
+		}
+	}
+	p_state.set_items_per_iteration(strings.size());
+}
+
+static constexpr int THREAD_NAME_COUNT = 1000;
+static constexpr int THREAD_NAME_ITERATIONS = 100000;
+
+struct InternData {
+	LocalVector<String> strings;
+	uint32_t seed = 0;
+};
+
+static void intern_names(void *p_data) {
+	InternData *data = static_cast<InternData *>(p_data);
+	uint32_t index = data->seed;
+	for (int i = 0; i < THREAD_NAME_ITERATIONS; i++) {
+		index = (index * 1103515245 + 12345) % THREAD_NAME_COUNT;
+		// Even names are kept alive, odd ones are created and released right away.
+		const StringName name = data->strings[index];
+		BenchmarkState::do_not_optimize(name);
+	}
+}
+
+static void intern_from_threads(BenchmarkState &p_state, int p_threads) {
+	LocalVector<StringName> kept;
+	LocalVector<Thread> threads;
+	LocalVector<InternData> data;
+	threads.resize(p_threads);
+	data.resize(p_threads);
+	for (int i = 0; i < p_threads; i++) {
+		for (int j = 0; j < THREAD_NAME_COUNT; j++) {
+			data[i].strings.push_back("string_name_thread_benchmark_" + itos(j));
+		}
+		data[i].seed = i + 1;
+	}
+	for (int j = 0; j < THREAD_NAME_COUNT; j += 2) {
+		kept.push_back(data[0].strings[j]);
+	}
+
+	while (p_state.keep_running()) {
+		for (int i = 0; i < p_threads; i++) {
+			threads[i].start(intern_names, &data[i]);
+		}
+		for (Thread &thread : threads) {
+			thread.wait_to_finish();
+		}
+	}
+	p_state.set_items_per_iteration(uint64_t(p_threads) * THREAD_NAME_ITERATIONS);
+}
+
+BENCHMARK_CASE("[StringName] Create names from 1 thread") {
+	intern_from_threads(p_state, 1);
+}
+
+BENCHMARK_CASE("[StringName] Create names from 8 threads") {
+	intern_from_threads(p_state, 8);
+}
+
+} // namespace BenchmarkString
@@ -0,0 +1,124 @@
+/**************************************************************************/
+/*  benchmark_frame_arena.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/benchmark.h"
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(benchmark_frame_arena)
+
+#include "core/math/geometry_3d.h"
+#include "core/os/memory.h"
+#include "core/templates/frame_arena.h"
+
+namespace BenchmarkFrameArena {
+
+static constexpr int LISTS = 64;
+static constexpr int ELEMENTS = 200;
+
+// Builds a few transient lists, like a frame of culling does.
+template <typename TVector>
+static void simulate_frame() {
+	for (int i = 0; i < LISTS; i++) {
+		TVector list;
+		for (int j = 0; j < ELEMENTS; j++) {
+			list.push_back(i * j);
+		}
+		BenchmarkState::do_not_optimize(list[list.size() - 1]);
+	}
+}
+
+BENCHMARK_CASE("[FrameArena] Transient lists, LocalVector") {
+	const uint64_t allocations_before = Memory::get_thread_alloc_count();
+	uint64_t iterations = 0;
+	while (p_state.keep_running()) {
+		simulate_frame<LocalVector<int>>();
+		iterations++;
+	}
+	p_state.set_items_per_iteration(LISTS * ELEMENTS);
+	p_state.set_counter("heap allocations per frame", double(Memory::get_thread_alloc_count() - allocations_before) / MAX(iterations, 1u));
+}
+
+BENCHMARK_CASE("[FrameArena] Transient lists, FrameLocalVector") {
+	FrameArena::advance_frame();
+	simulate_frame<FrameLocalVector<int>>(); // Warm up.
+
+	const uint64_t allocations_before = Memory::get_thread_alloc_count();
+	uint64_t iterations = 0;
+	while (p_state.keep_running()) {
+		FrameArena::advance_frame();
+		simulate_frame<FrameLocalVector<int>>();
+		iterations++;
+	}
+	p_state.set_items_per_iteration(LISTS * ELEMENTS);
+	p_state.set_counter("heap allocations per frame", double(Memory::get_thread_alloc_count() - allocations_before) / MAX(iterations, 1u));
+}
+
+// The planes RendererSceneCull builds to cull the shadow casters of one half of an omni light.
+static void build_omni_shadow_planes(Plane *r_planes) {
+	const real_t radius = 10;
+	r_planes[0] = Plane(Vector3(0, 0, -1), radius);
+	r_planes[1] = Plane(Vector3(1, 0, -1).normalized(), radius);
+	r_planes[2] = Plane(Vector3(-1, 0, -1).normalized(), radius);
+	r_planes[3] = Plane(Vector3(0, 1, -1).normalized(), radius);
+	r_planes[4] = Plane(Vector3(0, -1, -1).normalized(), radius);
+	r_planes[5] = Plane(Vector3(0, 0, 1), 0);
+}
+
+BENCHMARK_CASE("[FrameArena] Shadow cull convex points, Vector") {
+	const uint64_t allocations_before = Memory::get_thread_alloc_count();
+	uint64_t iterations = 0;
+	while (p_state.keep_running()) {
+		Vector<Plane> planes;
+		planes.resize(6);
+		build_omni_shadow_planes(planes.ptrw());
+		Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(planes.ptr(), planes.size());
+		BenchmarkState::do_not_optimize(points);
+		iterations++;
+	}
+	p_state.set_counter("heap allocations per light", double(Memory::get_thread_alloc_count() - allocations_before) / MAX(iterations, 1u));
+}
+
+BENCHMARK_CASE("[FrameArena] Shadow cull convex points, FrameLocalVector") {
+	const uint64_t allocations_before = Memory::get_thread_alloc_count();
+	uint64_t iterations = 0;
+	while (p_state.keep_running()) {
+		FrameArena::Scope scope;
+		FrameLocalVector<Plane> planes;
+		planes.resize(6);
+		build_omni_shadow_planes(planes.ptr());
+		FrameLocalVector<Vector3> points;
+		Geometry3D::compute_convex_mesh_points(planes.ptr(), planes.size(), points);
+		BenchmarkState::do_not_optimize(points);
+		iterations++;
+	}
+	p_state.set_counter("heap allocations per light", double(Memory::get_thread_alloc_count() - allocations_before) / MAX(iterations, 1u));
+}
+
+} // namespace BenchmarkFrameArena
@@ -0,0 +1,249 @@
+/**************************************************************************/
+/*  benchmark_templates.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/benchmark.h"
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(benchmark_templates)
+
+#include "core/templates/a_hash_map.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/rb_map.h"
+#include "core/templates/swiss_hash_map.h"
+#include "core/templates/vector.h"
+
+namespace BenchmarkTemplates {
+
+static constexpr int MAP_SIZE = 10000;
+
+template <typename TMap>
+static void insert_integers(BenchmarkState &p_state) {
+	while (p_state.keep_running()) {
+		TMap map;
+		for (int i = 0; i < MAP_SIZE; i++) {
+			map.insert(i, i);
+		}
+		BenchmarkState::do_not_optimize(map);
+	}
+	p_state.set_items_per_iteration(MAP_SIZE);
+}
+
+template <typename TMap>
+static void lookup_integers(BenchmarkState &p_state) {
+	TMap map;
+	for (int i = 0; i < MAP_SIZE; i++) {
+		map.insert(i * 2, i);
+	}
+
+	while (p_state.keep_running()) {
+		// Half hits, half misses.
+		int found = 0;
+		for (int i = 0; i < MAP_SIZE; i++) {
+			found += map.has(i);
+		}
+		BenchmarkState::do_not_optimize(found);
+	}
+	p_state.set_items_per_iteration(MAP_SIZE);
+}
+
+BENCHMARK_CASE("[HashMap] Insert 10000 integers") {
+	insert_integers<HashMap<int, int>>(p_state);
+}
+
+BENCHMARK_CASE("[HashMap] Look up 10000 integers") {
+	lookup_integers<HashMap<int, int>>(p_state);
+}
+
+BENCHMARK_CASE("[AHashMap] Insert 10000 integers") {
+	insert_integers<AHashMap<int, int>>(p_state);
+}
+
+BENCHMARK_CASE("[AHashMap] Look up 10000 integers") {
+	lookup_integers<AHashMap<int, int>>(p_state);
+}
+
+BENCHMARK_CASE("[SwissHashMap] Insert 10000 integers") {
+	insert_integers<SwissHashMap<int, int>>(p_state);
+}
+
+BENCHMARK_CASE("[SwissHashMap] Look up 10000 integers") {
+	lookup_integers<SwissHashMap<int, int>>(p_state);
+}
+
+static constexpr uint32_t SHUFFLED_MAP_SIZE = 100000;
+
+// Shuffled odd keys, so lookups don't follow insertion order. Even keys are used for misses.
+static LocalVector<uint32_t> shuffled_keys() {
+	LocalVector<uint32_t> keys;
+	keys.resize(SHUFFLED_MAP_SIZE);
+	for (uint32_t i = 0; i < SHUFFLED_MAP_SIZE; i++) {
+		keys[i] = hash_fmix32(i) | 1;
+	}
+	return keys;
+}
+
+template <typename TMap>
+static void lookup_shuffled_integers(BenchmarkState &p_state, bool p_hits) {
+	const LocalVector<uint32_t> keys = shuffled_keys();
+	TMap map;
+	for (uint32_t key : keys) {
+		map.insert(key, key);
+	}
+
+	const uint32_t mask = p_hits ? ~0u : ~1u;
+	while (p_state.keep_running()) {
+		uint32_t found = 0;
+		for (uint32_t key : keys) {
+			found += map.has(key & mask);
+		}
+		BenchmarkState::do_not_optimize(found);
+	}
+	p_state.set_items_per_iteration(SHUFFLED_MAP_SIZE);
+}
+
+template <typename TMap>
+static void erase_shuffled_integers(BenchmarkState &p_state) {
+	const LocalVector<uint32_t> keys = shuffled_keys();
+	while (p_state.keep_running()) {
+		p_state.pause_timing();
+		TMap map;
+		for (uint32_t key : keys) {
+			map.insert(key, key);
+		}
+		p_state.resume_timing();
+
+		for (uint32_t key : keys) {
+			map.erase(key);
+		}
+		BenchmarkState::do_not_optimize(map);
+	}
+	p_state.set_items_per_iteration(SHUFFLED_MAP_SIZE);
+}
+
+BENCHMARK_CASE("[HashMap] Hits with 100000 shuffled integers") {
+	lookup_shuffled_integers<HashMap<uint32_t, uint32_t>>(p_state, true);
+}
+
+BENCHMARK_CASE("[HashMap] Misses with 100000 shuffled integers") {
+	lookup_shuffled_integers<HashMap<uint32_t, uint32_t>>(p_state, false);
+}
+
+BENCHMARK_CASE("[HashMap] Erase 100000 shuffled integers") {
+	erase_shuffled_integers<HashMap<uint32_t, uint32_t>>(p_state);
+}
+
+BENCHMARK_CASE("[AHashMap] Hits with 100000 shuffled integers") {
+	lookup_shuffled_integers<AHashMap<uint32_t, uint32_t>>(p_state, true);
+}
+
+BENCHMARK_CASE("[AHashMap] Misses with 100000 shuffled integers") {
+	lookup_shuffled_integers<AHashMap<uint32_t, uint32_t>>(p_state, false);
+}
+
+BENCHMARK_CASE("[AHashMap] Erase 100000 shuffled integers") {
+	erase_shuffled_integers<AHashMap<uint32_t, uint32_t>>(p_state);
+}
+
+BENCHMARK_CASE("[SwissHashMap] Hits with 100000 shuffled integers") {
+	lookup_shuffled_integers<SwissHashMap<uint32_t, uint32_t>>(p_state, true);
+}
+
+BENCHMARK_CASE("[SwissHashMap] Misses with 100000 shuffled integers") {
+	lookup_shuffled_integers<SwissHashMap<uint32_t, uint32_t>>(p_state, false);
+}
+
+BENCHMARK_CASE("[SwissHashMap] Erase 100000 shuffled integers") {
+	erase_shuffled_integers<SwissHashMap<uint32_t, uint32_t>>(p_state);
+}
+
+BENCHMARK_CASE("[RBMap] Insert 10000 integers") {
+	insert_integers<RBMap<int, int>>(p_state);
+}
+
+BENCHMARK_CASE("[HashMap] Look up 1000 strings") {
+	HashMap<String, int> map;
+	LocalVector<String> keys;
+	for (int i = 0; i < 1000; i++) {
+		keys.push_back("key_" + itos(i));
+		map.insert(keys[i], i);
+	}
+
+	while (p_state.keep_running()) {
+		int sum = 0;
+		for (const String &key : keys) {
+			sum += map[key];
+		}
+		BenchmarkState::do_not_optimize(sum);
+	}
+	p_state.set_items_per_iteration(keys.size());
+}
+
+BENCHMARK_CASE("[Vector] Push back 10000 integers") {
+	while (p_state.keep_running()) {
+		Vector<int> vector;
+		for (int i = 0; i < 10000; i++) {
+			vector.push_back(i);
+		}
+		BenchmarkState::do_not_optimize(vector);
+	}
+	p_state.set_items_per_iteration(10000);
+}
+
+BENCHMARK_CASE("[LocalVector] Push back 10000 integers") {
+	while (p_state.keep_running()) {
+		LocalVector<int> vector;
+		for (int i = 0; i < 10000; i++) {
+			vector.push_back(i);
+		}
+		BenchmarkState::do_not_optimize(vector);
+	}
+	p_state.set_items_per_iteration(10000);
+}
+
+BENCHMARK_CASE("[Vector] Sort 10000 integers") {
+	Vector<int> unsorted;
+	for (int i = 0; i < 10000; i++) {
+		unsorted.push_back((int)hash_fmix32(i));
+	}
+
+	while (p_state.keep_running()) {
+		p_state.pause_timing();
+		Vector<int> vector = unsorted;
+		vector.ptrw(); // Copy on write outside of the measurement.
+		p_state.resume_timing();
+
+		vector.sort();
+		BenchmarkState::do_not_optimize(vector);
+	}
+	p_state.set_items_per_iteration(10000);
+}
+
+} // namespace BenchmarkTemplates
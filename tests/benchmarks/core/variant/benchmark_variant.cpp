@@ -0,0 +1,144 @@
+/**************************************************************************/
+/*  benchmark_variant.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/benchmark.h"
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(benchmark_variant)
+
+#include "core/variant/array.h"
+#include "core/variant/dictionary.h"
+#include "core/variant/variant.h"
+
+namespace BenchmarkVariant {
+
+static constexpr int OPERATIONS = 10000;
+
+static void evaluate_operator(BenchmarkState &p_state, Variant::Operator p_op, const Variant &p_a, const Variant &p_b) {
+	while (p_state.keep_running()) {
+		Variant result;
+		bool valid = false;
+		for (int i = 0; i < OPERATIONS; i++) {
+			Variant::evaluate(p_op, p_a, p_b, result, valid);
+		}
+		BenchmarkState::do_not_optimize(result);
+	}
+	p_state.set_items_per_iteration(OPERATIONS);
+}
+
+BENCHMARK_CASE("[Variant] Add integers") {
+	evaluate_operator(p_state, Variant::OP_ADD, 40, 2);
+}
+
+BENCHMARK_CASE("[Variant] Multiply floats") {
+	evaluate_operator(p_state, Variant::OP_MULTIPLY, 4.5, 2.25);
+}
+
+BENCHMARK_CASE("[Variant] Add Vector3s") {
+	evaluate_operator(p_state, Variant::OP_ADD, Vector3(1, 2, 3), Vector3(4, 5, 6));
+}
+
+BENCHMARK_CASE("[Variant] Compare strings") {
+	evaluate_operator(p_state, Variant::OP_EQUAL, String("variant_benchmark"), String("variant_benchmark"));
+}
+
+BENCHMARK_CASE("[Variant] Validated integer addition") {
+	const Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(Variant::OP_ADD, Variant::INT, Variant::INT);
+	const Variant a = 40;
+	const Variant b = 2;
+
+	while (p_state.keep_running()) {
+		Variant result = 0;
+		for (int i = 0; i < OPERATIONS; i++) {
+			evaluator(&a, &b, &result);
+		}
+		BenchmarkState::do_not_optimize(result);
+	}
+	p_state.set_items_per_iteration(OPERATIONS);
+}
+
+BENCHMARK_CASE("[Variant] Call a String method") {
+	Variant string = String("variant_benchmark");
+	const StringName method = "length";
+
+	while (p_state.keep_running()) {
+		Variant result;
+		Callable::CallError ce;
+		for (int i = 0; i < OPERATIONS; i++) {
+			string.callp(method, nullptr, 0, result, ce);
+		}
+		BenchmarkState::do_not_optimize(result);
+	}
+	p_state.set_items_per_iteration(OPERATIONS);
+}
+
+BENCHMARK_CASE("[Variant] Copy Variants holding strings") {
+	const Variant source = String("variant_benchmark");
+
+	while (p_state.keep_running()) {
+		for (int i = 0; i < OPERATIONS; i++) {
+			Variant copy = source;
+			BenchmarkState::do_not_optimize(copy);
+		}
+	}
+	p_state.set_items_per_iteration(OPERATIONS);
+}
+
+BENCHMARK_CASE("[Array] Append and iterate 10000 Variants") {
+	while (p_state.keep_running()) {
+		Array array;
+		for (int i = 0; i < OPERATIONS; i++) {
+			array.push_back(i);
+		}
+		int64_t sum = 0;
+		for (const Variant &value : array) {
+			sum += (int64_t)value;
+		}
+		BenchmarkState::do_not_optimize(sum);
+	}
+	p_state.set_items_per_iteration(OPERATIONS);
+}
+
+BENCHMARK_CASE("[Dictionary] Set and get 10000 integer keys") {
+	while (p_state.keep_running()) {
+		Dictionary dictionary;
+		for (int i = 0; i < OPERATIONS; i++) {
+			dictionary[i] = i;
+		}
+		int64_t sum = 0;
+		for (int i = 0; i < OPERATIONS; i++) {
+			sum += (int64_t)dictionary[i];
+		}
+		BenchmarkState::do_not_optimize(sum);
+	}
+	p_state.set_items_per_iteration(OPERATIONS);
+}
+
+} // namespace BenchmarkVariant
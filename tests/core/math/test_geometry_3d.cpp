@@ -33,6 +33,7 @@
 TEST_FORCE_LINK(test_geometry_3d)
 
 #include "core/math/geometry_3d.h"
+#include "core/templates/frame_arena.h"
 
 namespace TestGeometry3D {
 
@@ -130,6 +131,31 @@ TEST_CASE("[Geometry3D] Compute Convex Mesh Points") {
 	CHECK(Geometry3D::compute_convex_mesh_points(&box_planes[0], box_planes.size()) == cube);
 }
 
+TEST_CASE("[Geometry3D] Compute Convex Mesh Points into a frame arena") {
+	Vector<Plane> box_planes = Geometry3D::build_box_planes(Vector3(5, 5, 5));
+	Vector<Vector3> expected = Geometry3D::compute_convex_mesh_points(&box_planes[0], box_planes.size());
+
+	FrameArena::Scope scope;
+	{
+		// Warm up the arena.
+		FrameArena::Scope warm_up_scope;
+		FrameLocalVector<Vector3> points;
+		Geometry3D::compute_convex_mesh_points(box_planes.ptr(), box_planes.size(), points);
+	}
+
+	const uint64_t allocations_before = Memory::get_thread_alloc_count();
+	FrameLocalVector<Vector3> points;
+	Geometry3D::compute_convex_mesh_points(box_planes.ptr(), box_planes.size(), points);
+	const uint64_t allocations = Memory::get_thread_alloc_count() - allocations_before;
+
+	REQUIRE(points.size() == uint32_t(expected.size()));
+	for (uint32_t i = 0; i < points.size(); i++) {
+		CHECK(points[i] == expected[i]);
+	}
+	// Shadow culling computes these points for every shadowed light, each frame.
+	CHECK_MESSAGE(allocations == 0, "A warmed up arena shouldn't allocate from the heap.");
+}
+
 TEST_CASE("[Geometry3D] Get Closest Point To Segment") {
 	constexpr Vector3 a = Vector3(1, 1, 1);
 	constexpr Vector3 b = Vector3(5, 5, 5);
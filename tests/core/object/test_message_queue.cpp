@@ -0,0 +1,197 @@
+/**************************************************************************/
+/*  test_message_queue.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_message_queue)
+
+#include "core/object/callable_mp.h"
+#include "core/object/message_queue.h"
+#include "core/os/thread.h"
+
+namespace TestMessageQueue {
+
+static LocalVector<int> last_sequence;
+static int executed = 0;
+static bool out_of_order = false;
+
+static void record(int p_producer, int p_sequence) {
+	if (last_sequence[p_producer] + 1 != p_sequence) {
+		out_of_order = true;
+	}
+	last_sequence[p_producer] = p_sequence;
+	executed++;
+}
+
+struct ProducerData {
+	CallQueue *queue = nullptr;
+	int index = 0;
+	int count = 0;
+};
+
+static void producer_function(void *p_userdata) {
+	ProducerData *data = (ProducerData *)p_userdata;
+	const Callable callable = callable_mp_static(&record);
+	for (int i = 0; i < data->count; i++) {
+		data->queue->push_callable(callable, data->index, i);
+	}
+}
+
+static void run_producers(CallQueue &p_queue, int p_producers, int p_messages_per_producer) {
+	LocalVector<Thread> threads;
+	LocalVector<ProducerData> data;
+	threads.resize(p_producers);
+	data.resize(p_producers);
+	for (int i = 0; i < p_producers; i++) {
+		data[i].queue = &p_queue;
+		data[i].index = i;
+		data[i].count = p_messages_per_producer;
+		threads[i].start(producer_function, &data[i]);
+	}
+	for (Thread &thread : threads) {
+		thread.wait_to_finish();
+	}
+}
+
+static void reset_record(int p_producers) {
+	last_sequence.clear();
+	last_sequence.resize(p_producers);
+	for (int &sequence : last_sequence) {
+		sequence = -1;
+	}
+	executed = 0;
+	out_of_order = false;
+}
+
+static void test_order(bool p_multi_producer) {
+	const int producers = 8;
+	const int messages = 2000;
+
+	CallQueue queue(nullptr, 8192, String(), p_multi_producer);
+	reset_record(producers);
+	run_producers(queue, producers, messages);
+
+	CHECK(queue.has_messages());
+	CHECK_EQ(queue.flush(), OK);
+	CHECK_FALSE(queue.has_messages());
+	CHECK_EQ(executed, producers * messages);
+	CHECK_FALSE(out_of_order);
+
+	// The queue must be reusable after flushing, including from new threads.
+	reset_record(producers);
+	run_producers(queue, producers, messages);
+	CHECK_EQ(queue.flush(), OK);
+	CHECK_EQ(executed, producers * messages);
+	CHECK_FALSE(out_of_order);
+}
+
+TEST_CASE("[CallQueue] Messages from several threads keep their order per producer") {
+	SUBCASE("Shared buffer") {
+		test_order(false);
+	}
+	SUBCASE("Per-thread buffers") {
+		test_order(true);
+	}
+}
+
+static CallQueue *reentrant_queue = nullptr;
+static int reentrant_remaining = 0;
+
+static void reentrant_push() {
+	if (reentrant_remaining > 0) {
+		reentrant_remaining--;
+		reentrant_queue->push_callable(callable_mp_static(&reentrant_push));
+	}
+}
+
+static void test_reentrant(bool p_multi_producer) {
+	CallQueue queue(nullptr, 8192, String(), p_multi_producer);
+	reentrant_queue = &queue;
+	reentrant_remaining = 1000;
+	queue.push_callable(callable_mp_static(&reentrant_push));
+
+	CHECK_EQ(queue.flush(), OK);
+	CHECK_EQ(reentrant_remaining, 0);
+	CHECK_FALSE(queue.has_messages());
+	reentrant_queue = nullptr;
+}
+
+TEST_CASE("[CallQueue] Messages pushed while flushing are run in the same flush") {
+	SUBCASE("Shared buffer") {
+		test_reentrant(false);
+	}
+	SUBCASE("Per-thread buffers") {
+		test_reentrant(true);
+	}
+}
+
+static void test_clear(bool p_multi_producer) {
+	const int producers = 4;
+	const int messages = 1000;
+
+	CallQueue queue(nullptr, 8192, String(), p_multi_producer);
+	reset_record(producers);
+	run_producers(queue, producers, messages);
+
+	queue.clear();
+	CHECK_FALSE(queue.has_messages());
+	CHECK_EQ(queue.flush(), OK);
+	CHECK_EQ(executed, 0);
+}
+
+TEST_CASE("[CallQueue] Clearing releases messages from all producers") {
+	SUBCASE("Shared buffer") {
+		test_clear(false);
+	}
+	SUBCASE("Per-thread buffers") {
+		test_clear(true);
+	}
+}
+
+TEST_CASE("[CallQueue] Producers of exited threads are reused") {
+	// Far fewer pages than the threads pushing over time, so producers that kept theirs would run out.
+	const int producers = 2;
+	const int messages = 20;
+	CallQueue queue(nullptr, 8, String(), true);
+
+	for (int round = 0; round < 32; round++) {
+		reset_record(producers);
+		run_producers(queue, producers, messages);
+		CHECK_EQ(queue.flush(), OK);
+		CHECK_EQ(executed, producers * messages);
+		CHECK_FALSE(out_of_order);
+		CHECK_FALSE(queue.has_messages());
+	}
+
+	// All pages of the producers were released once their threads exited and they were flushed.
+	CHECK_EQ(queue.get_max_buffer_usage(), 0);
+}
+
+} // namespace TestMessageQueue
@@ -36,6 +36,8 @@ TEST_FORCE_LINK(test_object)
 #include "core/object/class_db.h"
 #include "core/object/object.h"
 #include "core/object/script_language.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
 #include "tests/signal_watcher.h"
 
 namespace TestObject {
@@ -691,4 +693,85 @@ TEST_CASE("[Object] RequiredResult") {
 	CHECK_EQ(ref, var);
 }
 
+struct ObjectDBThreadData {
+	std::atomic<uint64_t> *published = nullptr;
+	int published_count = 0;
+	int iterations = 0;
+	int offset = 0;
+	SafeFlag *done = nullptr;
+	bool matched = true;
+};
+
+static void object_db_create_and_free(void *p_userdata) {
+	ObjectDBThreadData *data = static_cast<ObjectDBThreadData *>(p_userdata);
+	LocalVector<Object *> alive;
+	for (int i = 0; i < data->iterations; i++) {
+		Object *object = memnew(Object);
+		const ObjectID id = object->get_instance_id();
+		data->matched = data->matched && ObjectDB::get_instance(id) == object;
+		data->published[(data->offset + i) % data->published_count].store(id, std::memory_order_relaxed);
+		alive.push_back(object);
+
+		if (i % 3 == 0) {
+			// Free objects in a different order than they were created in.
+			Object *freed = alive[alive.size() / 2];
+			const ObjectID freed_id = freed->get_instance_id();
+			alive.remove_at_unordered(alive.size() / 2);
+			memdelete(freed);
+			data->matched = data->matched && ObjectDB::get_instance(freed_id) == nullptr;
+		}
+	}
+	for (Object *object : alive) {
+		memdelete(object);
+	}
+}
+
+static void object_db_resolve(void *p_userdata) {
+	ObjectDBThreadData *data = static_cast<ObjectDBThreadData *>(p_userdata);
+	while (!data->done->is_set()) {
+		for (int i = 0; i < data->published_count; i++) {
+			// The object may be freed right after, so it's only looked up.
+			ObjectDB::get_instance(ObjectID(data->published[i].load(std::memory_order_relaxed)));
+		}
+		data->matched = data->matched && ObjectDB::get_instance(ObjectID()) == nullptr;
+	}
+}
+
+TEST_CASE("[Object] ObjectDB lookups while objects are created and freed on other threads") {
+	const int creators = 4;
+	const int resolvers = 4;
+	const int published_count = 256;
+	std::atomic<uint64_t> published[published_count] = {};
+	SafeFlag done;
+	const int initial_count = ObjectDB::get_object_count();
+
+	LocalVector<Thread> threads;
+	LocalVector<ObjectDBThreadData> data;
+	threads.resize(creators + resolvers);
+	data.resize(creators + resolvers);
+	for (int i = 0; i < creators + resolvers; i++) {
+		data[i].published = published;
+		data[i].published_count = published_count;
+		data[i].iterations = 20000;
+		data[i].offset = i * 64;
+		data[i].done = &done;
+		threads[i].start(i < creators ? object_db_create_and_free : object_db_resolve, &data[i]);
+	}
+	for (int i = 0; i < creators; i++) {
+		threads[i].wait_to_finish();
+	}
+	done.set();
+	for (int i = creators; i < creators + resolvers; i++) {
+		threads[i].wait_to_finish();
+	}
+
+	for (const ObjectDBThreadData &E : data) {
+		CHECK(E.matched);
+	}
+	CHECK(ObjectDB::get_object_count() == initial_count);
+	for (int i = 0; i < published_count; i++) {
+		CHECK(ObjectDB::get_instance(ObjectID(published[i].load())) == nullptr);
+	}
+}
+
 } // namespace TestObject
@@ -0,0 +1,150 @@
+/**************************************************************************/
+/*  test_memory.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_memory)
+
+#include "core/os/memory.h"
+#include "core/os/small_object_allocator.h"
+
+namespace TestMemory {
+
+static bool check_pattern(const uint8_t *p_mem, size_t p_bytes, uint8_t p_seed) {
+	for (size_t i = 0; i < p_bytes; i++) {
+		if (p_mem[i] != uint8_t(p_seed + i)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static void fill_pattern(uint8_t *p_mem, size_t p_bytes, uint8_t p_seed) {
+	for (size_t i = 0; i < p_bytes; i++) {
+		p_mem[i] = uint8_t(p_seed + i);
+	}
+}
+
+TEST_CASE("[Memory] Allocating, reallocating and freeing") {
+	const uint64_t usage_before = Memory::get_mem_usage();
+
+	SUBCASE("Sizes around the small allocation limit") {
+		const size_t sizes[] = { 1, 15, 16, 17, 100, 256, 257, 900, 1000, 1024, 4096, 100000 };
+		uint8_t *blocks[std_size(sizes)];
+		for (uint32_t i = 0; i < std_size(sizes); i++) {
+			blocks[i] = (uint8_t *)memalloc(sizes[i]);
+			REQUIRE(blocks[i]);
+			CHECK_MESSAGE((uintptr_t)blocks[i] % Memory::MAX_ALIGN == 0, "Allocations should be aligned to Memory::MAX_ALIGN.");
+			fill_pattern(blocks[i], sizes[i], i);
+		}
+		for (uint32_t i = 0; i < std_size(sizes); i++) {
+			CHECK(check_pattern(blocks[i], sizes[i], i));
+			memfree(blocks[i]);
+		}
+	}
+
+	SUBCASE("Zeroed allocations") {
+		for (size_t size = 8; size <= 2048; size *= 2) {
+			// Dirty a block of the same size first, so it may be reused.
+			memfree(memalloc(size));
+			uint8_t *mem = (uint8_t *)memalloc_zeroed(size);
+			bool zeroed = true;
+			for (size_t i = 0; i < size; i++) {
+				zeroed = zeroed && mem[i] == 0;
+			}
+			CHECK_MESSAGE(zeroed, vformat("%d bytes should be zeroed.", (int64_t)size));
+			memfree(mem);
+		}
+	}
+
+	SUBCASE("Growing and shrinking keeps the contents") {
+		size_t size = 8;
+		uint8_t *mem = (uint8_t *)memalloc(size);
+		fill_pattern(mem, size, 7);
+		while (size < 8192) {
+			const size_t new_size = size * 3 / 2;
+			mem = (uint8_t *)memrealloc(mem, new_size);
+			CHECK(check_pattern(mem, size, 7));
+			fill_pattern(mem, new_size, 7);
+			size = new_size;
+		}
+		while (size > 8) {
+			size = size * 2 / 3;
+			mem = (uint8_t *)memrealloc(mem, size);
+			CHECK(check_pattern(mem, size, 7));
+		}
+		memfree(mem);
+	}
+
+	SUBCASE("Padded allocations keep the element count") {
+		uint8_t *mem = (uint8_t *)Memory::alloc_static(24, true);
+		uint64_t *element_count = (uint64_t *)(mem - Memory::DATA_OFFSET + Memory::ELEMENT_OFFSET);
+		*element_count = 3;
+		for (size_t size = 48; size <= 4096; size *= 2) {
+			mem = (uint8_t *)Memory::realloc_static(mem, size, true);
+			element_count = (uint64_t *)(mem - Memory::DATA_OFFSET + Memory::ELEMENT_OFFSET);
+			CHECK_EQ(*element_count, 3u);
+		}
+		Memory::free_static(mem, true);
+	}
+
+#ifdef DEBUG_ENABLED
+	CHECK_MESSAGE(Memory::get_mem_usage() == usage_before, "Memory usage should be back to where it was.");
+#else
+	(void)usage_before;
+#endif
+}
+
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+TEST_CASE("[Memory] Blocks outlive switching the small object allocator") {
+	const bool was_enabled = SmallObjectAllocator::is_enabled();
+
+	SmallObjectAllocator::set_enabled(true);
+	uint8_t *small = (uint8_t *)memalloc(64);
+	fill_pattern(small, 64, 1);
+	SmallObjectAllocator::set_enabled(false);
+	uint8_t *system = (uint8_t *)memalloc(64);
+	fill_pattern(system, 64, 2);
+
+	// Either kind of block must be reallocated and freed with the allocator it came from.
+	SmallObjectAllocator::set_enabled(true);
+	system = (uint8_t *)memrealloc(system, 128);
+	CHECK(check_pattern(system, 64, 2));
+	memfree(system);
+	SmallObjectAllocator::set_enabled(false);
+	small = (uint8_t *)memrealloc(small, 2000);
+	CHECK(check_pattern(small, 64, 1));
+	memfree(small);
+
+	SmallObjectAllocator::set_enabled(was_enabled);
+}
+#endif // SMALL_OBJECT_ALLOCATOR_ENABLED
+
+} // namespace TestMemory
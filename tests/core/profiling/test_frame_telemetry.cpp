@@ -0,0 +1,137 @@
+/**************************************************************************/
+/*  test_frame_telemetry.cpp                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_frame_telemetry)
+
+#include "core/io/file_access.h"
+#include "core/io/marshalls.h"
+#include "core/profiling/frame_telemetry.h"
+#include "tests/test_utils.h"
+
+namespace TestFrameTelemetry {
+
+TEST_CASE("[FrameTelemetry] Binary encoding") {
+	LocalVector<uint8_t> buffer;
+	FrameTelemetry::encode_binary_header(buffer);
+	REQUIRE(buffer.size() > 12);
+	CHECK(memcmp(buffer.ptr(), "GDTM", 4) == 0);
+	CHECK(decode_uint32(buffer.ptr() + 4) == FrameTelemetry::BINARY_VERSION);
+	CHECK(decode_uint32(buffer.ptr() + 8) == FrameTelemetry::SUBSYSTEM_MAX);
+
+	// Names follow in enum order.
+	uint32_t ofs = 12;
+	for (int i = 0; i < FrameTelemetry::SUBSYSTEM_MAX; i++) {
+		const uint32_t len = decode_uint32(buffer.ptr() + ofs);
+		ofs += 4;
+		CHECK(String::utf8((const char *)buffer.ptr() + ofs, len) == FrameTelemetry::get_subsystem_name(FrameTelemetry::Subsystem(i)));
+		ofs += len;
+	}
+	CHECK(ofs == buffer.size());
+
+	uint32_t usec[FrameTelemetry::SUBSYSTEM_MAX];
+	for (int i = 0; i < FrameTelemetry::SUBSYSTEM_MAX; i++) {
+		usec[i] = i * 100;
+	}
+	buffer.clear();
+	FrameTelemetry::encode_binary_record(buffer, 7, 123456789, usec);
+	REQUIRE(buffer.size() == 16 + FrameTelemetry::SUBSYSTEM_MAX * 4);
+	CHECK(decode_uint64(buffer.ptr()) == 7);
+	CHECK(decode_uint64(buffer.ptr() + 8) == 123456789);
+	for (int i = 0; i < FrameTelemetry::SUBSYSTEM_MAX; i++) {
+		CHECK(decode_uint32(buffer.ptr() + 16 + i * 4) == usec[i]);
+	}
+}
+
+TEST_CASE("[FrameTelemetry] OpenMetrics encoding") {
+	uint64_t totals[FrameTelemetry::SUBSYSTEM_MAX] = {};
+	uint32_t maximums[FrameTelemetry::SUBSYSTEM_MAX] = {};
+	totals[FrameTelemetry::SUBSYSTEM_PHYSICS] = 1500000;
+	maximums[FrameTelemetry::SUBSYSTEM_SCRIPT] = 2500;
+
+	const String text = FrameTelemetry::encode_openmetrics(42, totals, maximums);
+	CHECK(text.contains("godot_frames_total 42\n"));
+	CHECK(text.contains("godot_subsystem_seconds_total{subsystem=\"physics\"} 1.5\n"));
+	CHECK(text.contains("godot_subsystem_max_seconds{subsystem=\"script\"} 0.0025\n"));
+	CHECK(text.ends_with("# EOF\n"));
+}
+
+TEST_CASE("[FrameTelemetry] Binary file output") {
+	const String path = TestUtils::get_temp_path("frame_telemetry.bin");
+	REQUIRE(FrameTelemetry::start(path, FrameTelemetry::FORMAT_BINARY) == OK);
+	CHECK(FrameTelemetry::is_enabled());
+
+	for (int i = 0; i < 3; i++) {
+		FrameTelemetry::add_time(FrameTelemetry::SUBSYSTEM_PHYSICS, 10 * (i + 1));
+		FrameTelemetry::add_time(FrameTelemetry::SUBSYSTEM_PHYSICS, 5);
+		{
+			FrameTelemetry::Scope scope(FrameTelemetry::SUBSYSTEM_SCRIPT);
+		}
+		FrameTelemetry::end_frame(1000);
+	}
+	FrameTelemetry::stop();
+	CHECK_FALSE(FrameTelemetry::is_enabled());
+
+	const Vector<uint8_t> data = FileAccess::get_file_as_bytes(path);
+	LocalVector<uint8_t> header;
+	FrameTelemetry::encode_binary_header(header);
+	const uint32_t record_size = 16 + FrameTelemetry::SUBSYSTEM_MAX * 4;
+	REQUIRE(data.size() == int64_t(header.size() + 3 * record_size));
+	CHECK(memcmp(data.ptr(), header.ptr(), header.size()) == 0);
+
+	for (int i = 0; i < 3; i++) {
+		const uint8_t *record = data.ptr() + header.size() + i * record_size;
+		CHECK(decode_uint64(record) == uint64_t(i));
+		CHECK(decode_uint32(record + 16 + FrameTelemetry::SUBSYSTEM_FRAME * 4) == 1000);
+		CHECK(decode_uint32(record + 16 + FrameTelemetry::SUBSYSTEM_PHYSICS * 4) == uint32_t(10 * (i + 1) + 5));
+		CHECK(decode_uint32(record + 16 + FrameTelemetry::SUBSYSTEM_NAVIGATION * 4) == 0);
+	}
+
+	// Counters are ignored while telemetry is stopped.
+	CHECK(FrameTelemetry::begin() == 0);
+}
+
+TEST_CASE("[FrameTelemetry] OpenMetrics file output") {
+	const String path = TestUtils::get_temp_path("frame_telemetry.prom");
+	REQUIRE(FrameTelemetry::start(path, FrameTelemetry::FORMAT_OPENMETRICS) == OK);
+	FrameTelemetry::add_time(FrameTelemetry::SUBSYSTEM_MESSAGE_QUEUE, 250);
+	FrameTelemetry::end_frame(2000);
+	FrameTelemetry::end_frame(1000);
+	FrameTelemetry::stop();
+
+	const String text = FileAccess::get_file_as_string(path);
+	CHECK(text.contains("godot_frames_total 2\n"));
+	CHECK(text.contains("godot_subsystem_seconds_total{subsystem=\"frame\"} 0.003\n"));
+	CHECK(text.contains("godot_subsystem_max_seconds{subsystem=\"message_queue\"} 0.00025\n"));
+	CHECK(text.ends_with("# EOF\n"));
+}
+
+} // namespace TestFrameTelemetry
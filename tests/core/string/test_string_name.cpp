@@ -0,0 +1,153 @@
+/**************************************************************************/
+/*  test_string_name.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_string_name)
+
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	const StringName a = "test_string_name_interning";
+	const StringName b = String("test_string_name_interning");
+	const StringName c = "test_string_name_other";
+
+	CHECK(a == b);
+	CHECK(a.data_unique_pointer() == b.data_unique_pointer());
+	CHECK(a != c);
+	CHECK(a.hash() == String("test_string_name_interning").hash());
+	CHECK(a == "test_string_name_interning");
+	CHECK(StringName().is_empty());
+	CHECK(StringName("").is_empty());
+	CHECK(StringName(String()).is_empty());
+}
+
+TEST_CASE("[StringName] Names are released and created again") {
+	const String name = "test_string_name_released";
+	{
+		const StringName a = name;
+		CHECK(a == name);
+	}
+	const StringName b = name;
+	CHECK(b == name);
+	CHECK(String(b) == name);
+}
+
+TEST_CASE("[StringName] Many names") {
+	// Enough names to make the table grow.
+	const int count = 200000;
+	LocalVector<StringName> names;
+	names.resize(count);
+	for (int i = 0; i < count; i++) {
+		names[i] = StringName("test_string_name_many_" + itos(i));
+	}
+
+	bool all_match = true;
+	for (int i = 0; i < count; i++) {
+		const StringName again = "test_string_name_many_" + itos(i);
+		if (again.data_unique_pointer() != names[i].data_unique_pointer()) {
+			all_match = false;
+		}
+	}
+	CHECK_MESSAGE(all_match, "Creating a name again should give the same data.");
+}
+
+struct InternData {
+	int names = 0;
+	int iterations = 0;
+	int seed = 0;
+	const StringName *expected = nullptr;
+	bool matched = true;
+};
+
+static void intern_names(void *p_data) {
+	InternData *data = static_cast<InternData *>(p_data);
+	LocalVector<String> strings;
+	strings.resize(data->names);
+	for (int i = 0; i < data->names; i++) {
+		strings[i] = "test_string_name_threads_" + itos(i);
+	}
+
+	uint32_t index = data->seed;
+	for (int i = 0; i < data->iterations; i++) {
+		index = (index * 1103515245 + 12345) % data->names;
+		// Alternate between names that are kept alive and transient ones that get released right away.
+		const StringName name = strings[index];
+		if (data->expected && index % 2 == 0 && name.data_unique_pointer() != data->expected[index].data_unique_pointer()) {
+			data->matched = false;
+		}
+	}
+}
+
+static bool intern_from_threads(int p_threads, int p_names, int p_iterations, const StringName *p_expected) {
+	LocalVector<Thread> threads;
+	LocalVector<InternData> data;
+	threads.resize(p_threads);
+	data.resize(p_threads);
+
+	for (int i = 0; i < p_threads; i++) {
+		data[i].names = p_names;
+		data[i].iterations = p_iterations;
+		data[i].seed = i + 1;
+		data[i].expected = p_expected;
+		threads[i].start(intern_names, &data[i]);
+	}
+	for (Thread &thread : threads) {
+		thread.wait_to_finish();
+	}
+
+	bool matched = true;
+	for (const InternData &E : data) {
+		matched = matched && E.matched;
+	}
+	return matched;
+}
+
+TEST_CASE("[StringName] Creating names from several threads") {
+	const int names = 1000;
+	LocalVector<StringName> expected;
+	expected.resize(names);
+	for (int i = 0; i < names; i += 2) {
+		expected[i] = StringName("test_string_name_threads_" + itos(i));
+	}
+
+	for (int threads = 1; threads <= 8; threads *= 2) {
+		CHECK_MESSAGE(intern_from_threads(threads, names, 20000, expected.ptr()), "Threads should always get the same data for a name.");
+	}
+
+	// Names released while other threads were looking them up are reclaimed later, they must still be created again.
+	const StringName again = "test_string_name_threads_1";
+	CHECK(again == "test_string_name_threads_1");
+}
+
+} // namespace TestStringName
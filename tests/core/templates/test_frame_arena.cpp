@@ -0,0 +1,169 @@
+/**************************************************************************/
+/*  test_frame_arena.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_frame_arena)
+
+#include "core/templates/frame_arena.h"
+
+namespace TestFrameArena {
+
+TEST_CASE("[FrameArena] Allocations are aligned and grow in place") {
+	FrameArena::Scope scope;
+	FrameArena &arena = FrameArena::get_thread_arena();
+
+	uint8_t *a = (uint8_t *)arena.alloc(3);
+	uint8_t *b = (uint8_t *)arena.alloc(5);
+	CHECK((uintptr_t)a % Memory::MAX_ALIGN == 0);
+	CHECK((uintptr_t)b % Memory::MAX_ALIGN == 0);
+	CHECK(b > a);
+
+	memset(b, 7, 5);
+	uint8_t *grown = (uint8_t *)arena.realloc(b, 5, 100);
+	CHECK_MESSAGE(grown == b, "The last allocation should grow in place.");
+
+	uint8_t *moved = (uint8_t *)arena.realloc(a, 3, 100);
+	CHECK_MESSAGE(moved != a, "Allocations that aren't the last one should be moved.");
+	CHECK(grown[4] == 7);
+}
+
+TEST_CASE("[FrameArena] Scopes give back their memory") {
+	FrameArena &arena = FrameArena::get_thread_arena();
+	FrameArena::Scope outer_scope;
+
+	arena.alloc(64);
+	const size_t used_before = arena.get_used_bytes();
+	{
+		FrameArena::Scope scope;
+		for (int i = 0; i < 100; i++) {
+			arena.alloc(1024);
+		}
+		CHECK(arena.get_used_bytes() > used_before);
+	}
+	CHECK(arena.get_used_bytes() == used_before);
+}
+
+TEST_CASE("[FrameArena] Arenas are reset when a new frame starts") {
+	FrameArena &arena = FrameArena::get_thread_arena();
+
+	FrameArena::advance_frame();
+	arena.alloc(FrameArena::CHUNK_SIZE * 2);
+	arena.alloc(1024);
+	CHECK(arena.get_used_bytes() > FrameArena::CHUNK_SIZE * 2);
+
+	FrameArena::advance_frame();
+	arena.alloc(16);
+	CHECK(arena.get_used_bytes() <= FrameArena::CHUNK_SIZE * 2 + 16);
+
+	{
+		// Held arenas keep their memory.
+		FrameArena::Hold hold;
+		const size_t used = arena.get_used_bytes();
+		FrameArena::advance_frame();
+		arena.alloc(16);
+		CHECK(arena.get_used_bytes() > used);
+	}
+}
+
+TEST_CASE("[FrameArena] Containers") {
+	FrameArena::Scope scope;
+
+	FrameLocalVector<int> vector;
+	for (int i = 0; i < 1000; i++) {
+		vector.push_back(i);
+	}
+	CHECK(vector.size() == 1000);
+	CHECK(vector[0] == 0);
+	CHECK(vector[999] == 999);
+	vector.remove_at(0);
+	CHECK(vector[0] == 1);
+
+	FrameHashMap<int, String> map;
+	for (int i = 0; i < 100; i++) {
+		map.insert(i, itos(i));
+	}
+	CHECK(map.size() == 100);
+	CHECK(map[42] == "42");
+	map.erase(42);
+	CHECK_FALSE(map.has(42));
+}
+
+static uint64_t heap_allocations = 0;
+
+// Counts the reallocations of a LocalVector using the default allocator.
+class CountingAllocator {
+public:
+	static void *realloc(void *p_memory, size_t p_prev_bytes, size_t p_bytes) {
+		heap_allocations++;
+		return DefaultLocalVectorAllocator::realloc(p_memory, p_prev_bytes, p_bytes);
+	}
+	static void free(void *p_memory) { DefaultLocalVectorAllocator::free(p_memory); }
+};
+
+// Builds a few transient lists, like a frame of culling does.
+template <typename TVector>
+static uint64_t simulate_frame(int p_lists, int p_elements) {
+	uint64_t sum = 0;
+	for (int i = 0; i < p_lists; i++) {
+		TVector list;
+		for (int j = 0; j < p_elements; j++) {
+			list.push_back(i * j);
+		}
+		sum += list[list.size() - 1];
+	}
+	return sum;
+}
+
+TEST_CASE("[FrameArena] Transient lists don't allocate once the arena is warmed up") {
+	const int frames = 100;
+	const int lists = 64;
+	const int elements = 200;
+
+	heap_allocations = 0;
+	for (int i = 0; i < frames; i++) {
+		simulate_frame<LocalVector<int, uint32_t, false, false, CountingAllocator>>(lists, elements);
+	}
+	CHECK_MESSAGE(heap_allocations > 0, "LocalVector should allocate from the heap.");
+
+	FrameArena &arena = FrameArena::get_thread_arena();
+	FrameArena::advance_frame();
+	simulate_frame<FrameLocalVector<int>>(lists, elements); // Warm up.
+	const uint64_t chunks_before = arena.get_chunk_allocation_count();
+	for (int i = 0; i < frames; i++) {
+		FrameArena::advance_frame();
+		simulate_frame<FrameLocalVector<int>>(lists, elements);
+	}
+	const uint64_t arena_allocations = arena.get_chunk_allocation_count() - chunks_before;
+
+	CHECK_MESSAGE(arena_allocations == 0, "A warmed up arena shouldn't allocate from the heap.");
+}
+
+} // namespace TestFrameArena
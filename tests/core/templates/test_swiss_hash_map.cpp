@@ -0,0 +1,209 @@
+/**************************************************************************/
+/*  test_swiss_hash_map.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_swiss_hash_map)
+
+#include "core/templates/local_vector.h"
+#include "core/templates/swiss_hash_map.h"
+
+namespace TestSwissHashMap {
+
+TEST_CASE("[SwissHashMap] List initialization") {
+	SwissHashMap<int, String> map{ { 0, "A" }, { 1, "B" }, { 2, "C" }, { 3, "D" }, { 4, "E" } };
+
+	CHECK(map.size() == 5);
+	CHECK(map[0] == "A");
+	CHECK(map[1] == "B");
+	CHECK(map[2] == "C");
+	CHECK(map[3] == "D");
+	CHECK(map[4] == "E");
+}
+
+TEST_CASE("[SwissHashMap] Insert, get and erase") {
+	SwissHashMap<int, int> map;
+	SwissHashMap<int, int>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map[42] == 84);
+	CHECK(map.has(42));
+	CHECK(map.find(42));
+	CHECK_FALSE(map.has(24));
+	CHECK_FALSE(map.find(24));
+	CHECK(map.getptr(24) == nullptr);
+
+	map.insert(42, 21);
+	CHECK(map.size() == 1);
+	CHECK(map.get(42) == 21);
+
+	CHECK(map.erase(42));
+	CHECK_FALSE(map.erase(42));
+	CHECK_FALSE(map.has(42));
+	CHECK(map.is_empty());
+}
+
+TEST_CASE("[SwissHashMap] Many elements with erasures") {
+	SwissHashMap<int, int> map;
+	const int count = 10000;
+
+	for (int i = 0; i < count; i++) {
+		map[i] = i * 2;
+	}
+	CHECK(map.size() == count);
+
+	for (int i = 0; i < count; i += 2) {
+		CHECK(map.erase(i));
+	}
+	CHECK(map.size() == count / 2);
+
+	bool all_found = true;
+	for (int i = 0; i < count; i++) {
+		const int *value = map.getptr(i);
+		if ((i % 2 == 0) != (value == nullptr) || (value && *value != i * 2)) {
+			all_found = false;
+		}
+	}
+	CHECK_MESSAGE(all_found, "Only odd keys should remain, with their values.");
+
+	// Churn through keys so the table has to clean up DELETED slots without growing.
+	const uint32_t capacity = map.get_capacity();
+	for (int i = count; i < count * 10; i++) {
+		map.insert(i, i);
+		map.erase(i);
+	}
+	CHECK(map.size() == count / 2);
+	CHECK(map.get_capacity() == capacity);
+	CHECK(map.has(count - 1));
+}
+
+TEST_CASE("[SwissHashMap] Iteration") {
+	SwissHashMap<int, int> map;
+	const int count = 1000;
+
+	for (int i = 0; i < count; i++) {
+		map.insert(i, i + 1);
+	}
+
+	int visited = 0;
+	int64_t key_sum = 0;
+	for (const KeyValue<int, int> &E : map) {
+		CHECK(E.value == E.key + 1);
+		key_sum += E.key;
+		visited++;
+	}
+	CHECK(visited == count);
+	CHECK(key_sum == (int64_t)count * (count - 1) / 2);
+
+	// Removing the current element doesn't move the others.
+	SwissHashMap<int, int>::Iterator it = map.begin();
+	while (it) {
+		SwissHashMap<int, int>::Iterator current = it;
+		++it;
+		if (current->key % 3 == 0) {
+			map.remove(current);
+		}
+	}
+	visited = 0;
+	for (const KeyValue<int, int> &E : map) {
+		CHECK(E.key % 3 != 0);
+		visited++;
+	}
+	CHECK(visited == map.size());
+
+	SwissHashMap<int, int> empty;
+	CHECK(empty.begin() == empty.end());
+	CHECK_FALSE(empty.begin());
+}
+
+TEST_CASE("[SwissHashMap] Copy, move and clear") {
+	SwissHashMap<String, int> map;
+	for (int i = 0; i < 100; i++) {
+		map.insert(itos(i), i);
+	}
+
+	SwissHashMap<String, int> copy(map);
+	CHECK(copy.size() == 100);
+	CHECK(copy["42"] == 42);
+	copy.erase("42");
+	CHECK(map.has("42"));
+
+	SwissHashMap<String, int> moved(std::move(copy));
+	CHECK(moved.size() == 99);
+	CHECK(copy.is_empty());
+
+	map.clear();
+	CHECK(map.is_empty());
+	CHECK_FALSE(map.has("1"));
+	map.insert("1", 1);
+	CHECK(map["1"] == 1);
+
+	SwissHashMap<String, int> reserved;
+	reserved.reserve(1000);
+	const uint32_t capacity = reserved.get_capacity();
+	for (int i = 0; i < 1000; i++) {
+		reserved.insert(itos(i), i);
+	}
+	CHECK_MESSAGE(reserved.get_capacity() == capacity, "Reserved maps shouldn't grow.");
+}
+
+TEST_CASE("[SwissHashMap] Hits, misses and erasures with shuffled keys") {
+	const uint32_t count = 100000;
+
+	// Shuffle the keys so lookups don't follow insertion order.
+	LocalVector<uint32_t> keys;
+	keys.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		keys[i] = hash_fmix32(i) | 1; // Odd keys, even ones are used for misses.
+	}
+
+	SwissHashMap<uint32_t, uint32_t> map;
+	for (uint32_t key : keys) {
+		map.insert(key, key);
+	}
+
+	uint32_t hits = 0;
+	uint32_t misses = 0;
+	for (uint32_t key : keys) {
+		hits += map.has(key);
+		misses += !map.has(key & ~1u);
+	}
+	CHECK(hits == count);
+	CHECK(misses == count);
+
+	for (uint32_t key : keys) {
+		map.erase(key);
+	}
+	CHECK(map.is_empty());
+}
+
+} // namespace TestSwissHashMap
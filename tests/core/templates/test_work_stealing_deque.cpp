@@ -0,0 +1,141 @@
+/**************************************************************************/
+/*  test_work_stealing_deque.cpp                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_work_stealing_deque)
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_deque.h"
+
+namespace TestWorkStealingDeque {
+
+TEST_CASE("[WorkStealingDeque] Owner pops newest, thieves steal oldest") {
+	WorkStealingDeque<uintptr_t, 16> deque;
+	CHECK(deque.is_empty());
+
+	for (uintptr_t i = 1; i <= 4; i++) {
+		CHECK(deque.push(i));
+	}
+	CHECK_EQ(deque.size(), 4u);
+
+	uintptr_t value = 0;
+	CHECK(deque.pop(value));
+	CHECK_EQ(value, 4u);
+	CHECK(deque.steal(value));
+	CHECK_EQ(value, 1u);
+	CHECK(deque.pop(value));
+	CHECK_EQ(value, 3u);
+	CHECK(deque.steal(value));
+	CHECK_EQ(value, 2u);
+
+	CHECK(deque.is_empty());
+	CHECK_FALSE(deque.pop(value));
+	CHECK_FALSE(deque.steal(value));
+}
+
+TEST_CASE("[WorkStealingDeque] Push fails when full") {
+	WorkStealingDeque<uintptr_t, 4> deque;
+	for (uintptr_t i = 0; i < 4; i++) {
+		CHECK(deque.push(i));
+	}
+	CHECK_FALSE(deque.push(4));
+
+	uintptr_t value = 0;
+	CHECK(deque.steal(value));
+	CHECK_EQ(value, 0u);
+	CHECK_MESSAGE(deque.push(4), "Stealing should have made room for one more element.");
+	CHECK_EQ(deque.size(), 4u);
+}
+
+// Every pushed value must be consumed exactly once, no matter whether the owner or a thief got it.
+TEST_CASE("[WorkStealingDeque] Concurrent pop and steal") {
+	static const uint32_t VALUE_COUNT = 100000;
+
+	struct Tester {
+		WorkStealingDeque<uintptr_t, 256> deque;
+		LocalVector<SafeNumeric<uint32_t>> consumed;
+		SafeFlag done;
+
+		static void thief(void *p_data) {
+			Tester *tester = (Tester *)p_data;
+			uintptr_t value = 0;
+			while (!tester->done.is_set() || !tester->deque.is_empty()) {
+				if (tester->deque.steal(value)) {
+					tester->consumed[value].increment();
+				} else {
+					Thread::yield();
+				}
+			}
+		}
+	};
+
+	Tester tester;
+	tester.consumed.resize(VALUE_COUNT);
+
+	const uint32_t thief_count = MAX(2, OS::get_singleton()->get_processor_count() - 1);
+	TightLocalVector<Thread> thieves;
+	thieves.resize(thief_count);
+	for (Thread &thief : thieves) {
+		thief.start(&Tester::thief, &tester);
+	}
+
+	// The owner keeps pushing and, every few values, takes some back itself.
+	uintptr_t value = 0;
+	for (uintptr_t i = 0; i < VALUE_COUNT; i++) {
+		while (!tester.deque.push(i)) {
+			if (tester.deque.pop(value)) {
+				tester.consumed[value].increment();
+			}
+		}
+		if (i % 3 == 0 && tester.deque.pop(value)) {
+			tester.consumed[value].increment();
+		}
+	}
+	while (tester.deque.pop(value)) {
+		tester.consumed[value].increment();
+	}
+	tester.done.set();
+
+	for (Thread &thief : thieves) {
+		thief.wait_to_finish();
+	}
+
+	uint32_t consumed_once = 0;
+	for (uint32_t i = 0; i < VALUE_COUNT; i++) {
+		consumed_once += tester.consumed[i].get() == 1 ? 1 : 0;
+	}
+	CHECK_EQ(consumed_once, VALUE_COUNT);
+}
+
+} // namespace TestWorkStealingDeque
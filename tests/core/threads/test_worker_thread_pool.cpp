@@ -174,4 +174,113 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+static SafeNumeric<uint32_t> stage_counter;
+static SafeFlag stage_order_broken;
+
+static void static_stage_setup(void *p_arg) {
+	OS::get_singleton()->delay_usec(1000); // Give dependents a chance to start too early, if they could.
+	stage_counter.set(1);
+}
+
+static void static_stage_solve(void *p_arg, uint32_t p_index) {
+	if (stage_counter.get() < 1) {
+		stage_order_broken.set();
+	}
+	counter[p_index].increment();
+}
+
+static void static_stage_integrate(void *p_arg) {
+	for (uint32_t i = 0; i < counter.size(); i++) {
+		if (counter[i].get() != 1) {
+			stage_order_broken.set();
+		}
+	}
+	stage_counter.set(2);
+}
+
+TEST_CASE("[WorkerThreadPool] Tasks and groups with dependencies") {
+	SUBCASE("Pipeline only awaited at the end") {
+		for (int iterations = 0; iterations < 100; iterations++) {
+			const int count = Math::pow(2.0f, Math::random(0.0f, 5.0f));
+			counter.clear();
+			counter.resize(count);
+			stage_counter.set(0);
+			stage_order_broken.clear();
+
+			WorkerThreadPool::TaskID setup = WorkerThreadPool::get_singleton()->add_native_task(static_stage_setup, nullptr, true);
+			const WorkerThreadPool::TaskID solve_deps[] = { setup };
+			WorkerThreadPool::GroupID solve = WorkerThreadPool::get_singleton()->add_native_group_task(static_stage_solve, nullptr, count, -1, true, String(), solve_deps);
+			const WorkerThreadPool::TaskID integrate_deps[] = { solve };
+			WorkerThreadPool::TaskID integrate = WorkerThreadPool::get_singleton()->add_native_task(static_stage_integrate, nullptr, true, String(), integrate_deps);
+
+			CHECK_EQ(WorkerThreadPool::get_singleton()->wait_for_task_completion(integrate), OK);
+			CHECK_EQ(stage_counter.get(), 2u);
+			CHECK_FALSE(stage_order_broken.is_set());
+		}
+	}
+
+	SUBCASE("Empty group as join point") {
+		counter.clear();
+		counter.resize(8);
+		Vector<WorkerThreadPool::TaskID> joined;
+		for (int i = 0; i < 8; i++) {
+			joined.push_back(WorkerThreadPool::get_singleton()->add_native_task(static_test, (void *)(uintptr_t)i, i % 2));
+		}
+		WorkerThreadPool::GroupID join = WorkerThreadPool::get_singleton()->add_native_group_task(static_group_test, nullptr, 0, -1, true, String(), joined);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(join);
+
+		for (int i = 1; i < 8; i++) {
+			CHECK_EQ(counter[i].get(), 1);
+		}
+		CHECK_EQ(counter[0].get(), 1 + 2 * 8);
+	}
+
+	SUBCASE("Depending on already completed tasks") {
+		counter.clear();
+		counter.resize(1);
+		WorkerThreadPool::TaskID first = WorkerThreadPool::get_singleton()->add_native_task(static_test, nullptr, true);
+		while (!WorkerThreadPool::get_singleton()->is_task_completed(first)) {
+			OS::get_singleton()->delay_usec(10);
+		}
+		const WorkerThreadPool::TaskID deps[] = { first };
+		WorkerThreadPool::TaskID second = WorkerThreadPool::get_singleton()->add_native_task(static_test, nullptr, true, String(), deps);
+		CHECK_EQ(WorkerThreadPool::get_singleton()->wait_for_task_completion(second), OK);
+		CHECK_EQ(counter[0].get(), 2 * 3);
+
+		ERR_PRINT_OFF;
+		CHECK_MESSAGE(WorkerThreadPool::get_singleton()->wait_for_task_completion(first) == ERR_INVALID_PARAMETER, "Consumed dependencies should have been disposed of.");
+		ERR_PRINT_ON;
+	}
+}
+
+static SafeNumeric<uint32_t> nested_counter;
+
+static void static_nested_leaf(void *p_arg) {
+	nested_counter.increment();
+}
+
+static void static_nested_spawner(void *p_arg, uint32_t p_index) {
+	// Posted from a pool thread, so these go to its work queue and are stolen by the others.
+	const uint32_t leaves = (uint32_t)(uintptr_t)p_arg;
+	WorkerThreadPool::TaskID *ids = (WorkerThreadPool::TaskID *)alloca(sizeof(WorkerThreadPool::TaskID) * leaves);
+	for (uint32_t i = 0; i < leaves; i++) {
+		ids[i] = WorkerThreadPool::get_singleton()->add_native_task(static_nested_leaf, nullptr, true);
+	}
+	for (uint32_t i = 0; i < leaves; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(ids[i]);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Nested tasks posted from pool threads") {
+	const uint32_t spawners = WorkerThreadPool::get_singleton()->get_thread_count() * 8;
+	const uint32_t leaves = 64;
+
+	for (int round = 0; round < 4; round++) {
+		nested_counter.set(0);
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_nested_spawner, (void *)(uintptr_t)leaves, spawners, -1, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		CHECK_EQ(nested_counter.get(), spawners * leaves);
+	}
+}
+
 } // namespace TestWorkerThreadPool
@@ -43,6 +43,7 @@
 #include "servers/audio/audio_server.h"
 #include "servers/display/accessibility_server.h"
 #include "servers/rendering/rendering_server.h"
+#include "tests/benchmark.h"
 #include "tests/display_server_mock.h"
 #include "tests/force_link.gen.h"
 #include "tests/signal_watcher.h"
@@ -95,6 +96,11 @@ int test_main(int argc, char *argv[]) {
 		ERR_FAIL_COND_V_MSG(da->erase_contents_recursive() != OK, 0, "Failed to delete files");
 	}
 
+	// Run benchmarks instead of unit tests.
+	if (args.find("--benchmark")) {
+		return run_benchmarks(args);
+	}
+
 	// Run custom test tools.
 	if (test_commands) {
 		for (const KeyValue<String, TestFunc> &E : (*test_commands)) {